@@ -0,0 +1,237 @@
+///////////////////////////////////////////////////////////////////////////////
+// boundingvolumetree.cpp
+// ============
+// group the scene bounding boxes into a tree so whole groups of nodes can be
+// culled with one frustum test
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "BoundingVolumeTree.h"
+
+#include <algorithm>
+
+// declaration of global variables
+namespace
+{
+	// deepest tree walked by Cull() - a median split tree of
+	// this depth holds far more boxes than any scene
+	const int MAX_TREE_DEPTH = 64;
+}
+
+/***********************************************************
+ *  BoundingVolumeTree()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+BoundingVolumeTree::BoundingVolumeTree()
+{
+}
+
+/***********************************************************
+ *  Build()
+ *
+ *  This method is used for building the tree over a list
+ *  of bounding boxes.  The box indices are what Cull()
+ *  flags as visible.
+ ***********************************************************/
+void BoundingVolumeTree::Build(const std::vector<ViewFrustum::BOUNDING_BOX>& boxes)
+{
+	m_boxes = boxes;
+	m_nodes.clear();
+	m_items.resize(boxes.size());
+	for (int i = 0; i < m_items.size(); i++)
+	{
+		m_items[i] = i;
+	}
+
+	if (m_items.size() == 0)
+	{
+		return;
+	}
+
+	m_nodes.reserve(m_items.size() * 2);
+	m_nodes.push_back(TREE_NODE());
+	BuildNode(0, 0, (int)m_items.size());
+}
+
+/***********************************************************
+ *  BuildNode()
+ *
+ *  This method is used for building one tree node over a
+ *  range of the box list.  Ranges larger than a leaf are
+ *  split in half at the median box center along the axis
+ *  the centers spread the most on.
+ ***********************************************************/
+void BoundingVolumeTree::BuildNode(int nodeIndex, int firstItem, int itemCount)
+{
+	ViewFrustum::BOUNDING_BOX bounds = m_boxes[m_items[firstItem]];
+	glm::vec3 centerMinimum = glm::vec3(1.0e30f);
+	glm::vec3 centerMaximum = glm::vec3(-1.0e30f);
+	for (int i = firstItem; i < firstItem + itemCount; i++)
+	{
+		const ViewFrustum::BOUNDING_BOX& box = m_boxes[m_items[i]];
+		bounds.minimum = glm::min(bounds.minimum, box.minimum);
+		bounds.maximum = glm::max(bounds.maximum, box.maximum);
+
+		glm::vec3 center = (box.minimum + box.maximum) * 0.5f;
+		centerMinimum = glm::min(centerMinimum, center);
+		centerMaximum = glm::max(centerMaximum, center);
+	}
+
+	// m_nodes may grow below, so the node is only written by index
+	m_nodes[nodeIndex].bounds = bounds;
+	m_nodes[nodeIndex].firstItem = firstItem;
+	m_nodes[nodeIndex].itemCount = itemCount;
+	m_nodes[nodeIndex].firstChild = -1;
+
+	if (itemCount <= MAX_LEAF_ITEMS)
+	{
+		return;
+	}
+
+	glm::vec3 spread = centerMaximum - centerMinimum;
+	int axis = 0;
+	if (spread.y > spread[axis])
+	{
+		axis = 1;
+	}
+	if (spread.z > spread[axis])
+	{
+		axis = 2;
+	}
+
+	int half = itemCount / 2;
+	const std::vector<ViewFrustum::BOUNDING_BOX>& boxes = m_boxes;
+	std::nth_element(
+		m_items.begin() + firstItem,
+		m_items.begin() + firstItem + half,
+		m_items.begin() + firstItem + itemCount,
+		[&boxes, axis](int a, int b)
+		{
+			return((boxes[a].minimum[axis] + boxes[a].maximum[axis]) <
+				(boxes[b].minimum[axis] + boxes[b].maximum[axis]));
+		});
+
+	int firstChild = (int)m_nodes.size();
+	m_nodes[nodeIndex].firstChild = firstChild;
+	m_nodes.push_back(TREE_NODE());
+	m_nodes.push_back(TREE_NODE());
+
+	BuildNode(firstChild, firstItem, half);
+	BuildNode(firstChild + 1, firstItem + half, itemCount - half);
+}
+
+/***********************************************************
+ *  Cull()
+ *
+ *  This method is used for flagging every box that is not
+ *  outside the frustum, walking the whole tree from its
+ *  root.
+ ***********************************************************/
+int BoundingVolumeTree::Cull(const ViewFrustum& frustum, std::vector<unsigned char>& visible) const
+{
+	visible.assign(m_boxes.size(), 0);
+	if (m_nodes.size() == 0)
+	{
+		return(0);
+	}
+
+	return(CullSubtree(frustum, 0, visible));
+}
+
+/***********************************************************
+ *  GetSubtrees()
+ *
+ *  This method is used for splitting the tree into about
+ *  the passed in number of subtrees, by replacing the
+ *  largest subtree with its children until there are
+ *  enough.  Leaves are kept as they are.  The subtrees do
+ *  not share any box, so they can be culled at the same
+ *  time into one list of flags.
+ ***********************************************************/
+void BoundingVolumeTree::GetSubtrees(int subtreeCount, std::vector<int>& roots) const
+{
+	roots.clear();
+	if (m_nodes.size() == 0)
+	{
+		return;
+	}
+
+	roots.push_back(0);
+	while (roots.size() < subtreeCount)
+	{
+		int largest = -1;
+		for (int i = 0; i < roots.size(); i++)
+		{
+			const TREE_NODE& node = m_nodes[roots[i]];
+			if ((node.firstChild >= 0) &&
+				((largest < 0) || (node.itemCount > m_nodes[roots[largest]].itemCount)))
+			{
+				largest = i;
+			}
+		}
+		if (largest < 0)
+		{
+			break;
+		}
+
+		int firstChild = m_nodes[roots[largest]].firstChild;
+		roots[largest] = firstChild;
+		roots.push_back(firstChild + 1);
+	}
+}
+
+/***********************************************************
+ *  CullSubtree()
+ *
+ *  This method is used for flagging every box of the
+ *  subtree under a tree node that is not outside the
+ *  frustum.  Subtrees outside the frustum are skipped
+ *  whole, and subtrees fully inside it are flagged without
+ *  testing their boxes.
+ ***********************************************************/
+int BoundingVolumeTree::CullSubtree(const ViewFrustum& frustum, int root, std::vector<unsigned char>& visible) const
+{
+	int testCount = 0;
+	int stack[MAX_TREE_DEPTH * 2];
+	int stackSize = 0;
+	stack[stackSize++] = root;
+
+	while (stackSize > 0)
+	{
+		const TREE_NODE& node = m_nodes[stack[--stackSize]];
+
+		ViewFrustum::TEST_RESULT result = frustum.TestBox(node.bounds);
+		testCount++;
+		if (result == ViewFrustum::TEST_OUTSIDE)
+		{
+			continue;
+		}
+
+		if (result == ViewFrustum::TEST_INSIDE)
+		{
+			for (int i = node.firstItem; i < node.firstItem + node.itemCount; i++)
+			{
+				visible[m_items[i]] = 1;
+			}
+		}
+		else if (node.firstChild < 0)
+		{
+			for (int i = node.firstItem; i < node.firstItem + node.itemCount; i++)
+			{
+				int item = m_items[i];
+				visible[item] = (frustum.TestBox(m_boxes[item]) != ViewFrustum::TEST_OUTSIDE) ? 1 : 0;
+				testCount++;
+			}
+		}
+		else
+		{
+			stack[stackSize++] = node.firstChild;
+			stack[stackSize++] = node.firstChild + 1;
+		}
+	}
+
+	return(testCount);
+}
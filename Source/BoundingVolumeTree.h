@@ -0,0 +1,77 @@
+///////////////////////////////////////////////////////////////////////////////
+// boundingvolumetree.h
+// ============
+// group the scene bounding boxes into a tree so whole groups of nodes can be
+// culled with one frustum test
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+//  Notes: The tree is built top down by splitting the boxes at the median
+//         of the longest axis of their centers, until a few are left in
+//         each leaf.  Culling walks the tree from the root - a subtree
+//         outside the frustum is skipped, and one fully inside is marked
+//         visible without testing any of its boxes.  The tree is only
+//         rebuilt when a node moves.  The subtrees a few levels down can
+//         also be culled one by one, so they can be spread over threads.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ViewFrustum.h"
+
+#include <vector>
+
+/***********************************************************
+ *  BoundingVolumeTree
+ *
+ *  This class holds the tree nodes built over a list of
+ *  bounding boxes, and the order the boxes were sorted in.
+ ***********************************************************/
+class BoundingVolumeTree
+{
+public:
+	// most boxes held by one leaf
+	static const int MAX_LEAF_ITEMS = 4;
+
+	// constructor
+	BoundingVolumeTree();
+
+	// build the tree over a list of boxes
+	void Build(const std::vector<ViewFrustum::BOUNDING_BOX>& boxes);
+	// set a flag for each box that is not outside the frustum and
+	// return the number of frustum tests it took
+	int Cull(const ViewFrustum& frustum, std::vector<unsigned char>& visible) const;
+	// get the roots of the subtrees that split the tree into about
+	// subtreeCount parts - culling each of them with CullSubtree()
+	// flags the same boxes as Cull()
+	void GetSubtrees(int subtreeCount, std::vector<int>& roots) const;
+	// set a flag for each box of a subtree that is not outside the
+	// frustum - the flags of the other boxes are left alone, and
+	// must have been cleared to the box count
+	int CullSubtree(const ViewFrustum& frustum, int root, std::vector<unsigned char>& visible) const;
+
+	// get the number of boxes the tree was built over
+	int GetItemCount() const { return((int)m_items.size()); }
+
+private:
+	struct TREE_NODE
+	{
+		ViewFrustum::BOUNDING_BOX bounds;
+		// the node holds m_items[firstItem] to [firstItem + itemCount) -
+		// an inner node splits them between its children at firstChild
+		// and firstChild + 1, a leaf has a firstChild of -1
+		int firstItem;
+		int itemCount;
+		int firstChild;
+	};
+
+	std::vector<TREE_NODE> m_nodes;
+	// box indices, in leaf order
+	std::vector<int> m_items;
+	// the boxes the tree was built over
+	std::vector<ViewFrustum::BOUNDING_BOX> m_boxes;
+
+	// build the subtree of m_items[firstItem] to [firstItem + itemCount)
+	// into an already added tree node
+	void BuildNode(int nodeIndex, int firstItem, int itemCount);
+};
@@ -0,0 +1,555 @@
+///////////////////////////////////////////////////////////////////////////////
+// compressedtexture.cpp
+// ============
+// bake decoded images into BC7 compressed, pre-mipmapped KTX2 files and read
+// them back for upload
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "CompressedTexture.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+// declaration of global variables
+namespace
+{
+	// KTX2 file identifier
+	const unsigned char g_KTX2Identifier[12] =
+	{
+		0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'
+	};
+	// VK_FORMAT_BC7_UNORM_BLOCK
+	const uint32_t g_VkFormatBC7 = 145;
+	// KHR_DF_MODEL_BC7
+	const unsigned char g_DataFormatModelBC7 = 134;
+	// bytes in one 4x4 BC7 block
+	const int g_BlockBytes = 16;
+	// level data offsets are aligned to the block size
+	const int g_LevelAlignment = 16;
+
+	// BC7 interpolation weights for 4 bit indices
+	const int g_BC7Weights4[16] =
+	{
+		0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64
+	};
+
+	// the fixed size part of a KTX2 file
+	struct KTX2_HEADER
+	{
+		unsigned char identifier[12];
+		uint32_t vkFormat;
+		uint32_t typeSize;
+		uint32_t pixelWidth;
+		uint32_t pixelHeight;
+		uint32_t pixelDepth;
+		uint32_t layerCount;
+		uint32_t faceCount;
+		uint32_t levelCount;
+		uint32_t supercompressionScheme;
+		uint32_t dfdByteOffset;
+		uint32_t dfdByteLength;
+		uint32_t kvdByteOffset;
+		uint32_t kvdByteLength;
+		uint64_t sgdByteOffset;
+		uint64_t sgdByteLength;
+	};
+	static_assert(sizeof(KTX2_HEADER) == 80, "KTX2_HEADER must match the KTX2 file layout");
+
+	struct KTX2_LEVEL
+	{
+		uint64_t byteOffset;
+		uint64_t byteLength;
+		uint64_t uncompressedByteLength;
+	};
+
+	/***********************************************************
+	 *  WriteBits()
+	 *
+	 *  Write the low bitCount bits of a value into a block,
+	 *  least significant bit first.
+	 ***********************************************************/
+	void WriteBits(unsigned char* pBlock, int& bitPosition, int value, int bitCount)
+	{
+		for (int i = 0; i < bitCount; i++)
+		{
+			if ((value >> i) & 1)
+			{
+				pBlock[bitPosition >> 3] |= (unsigned char)(1 << (bitPosition & 7));
+			}
+			bitPosition++;
+		}
+	}
+
+	/***********************************************************
+	 *  QuantizeEndpoint()
+	 *
+	 *  Quantize an RGBA endpoint to 7 bits per channel plus the
+	 *  shared low bit that gives the best match.
+	 ***********************************************************/
+	void QuantizeEndpoint(const int color[4], int quantized[4], int& pBit)
+	{
+		int bestError = -1;
+
+		for (int p = 0; p < 2; p++)
+		{
+			int values[4];
+			int error = 0;
+			for (int c = 0; c < 4; c++)
+			{
+				values[c] = std::min(127, std::max(0, (color[c] - p + 1) / 2));
+				int difference = ((values[c] << 1) | p) - color[c];
+				error += difference * difference;
+			}
+
+			if ((bestError < 0) || (error < bestError))
+			{
+				bestError = error;
+				pBit = p;
+				memcpy(quantized, values, sizeof(values));
+			}
+		}
+	}
+
+	/***********************************************************
+	 *  EncodeBlockBC7()
+	 *
+	 *  Encode 16 RGBA texels as one BC7 mode 6 block.  The
+	 *  endpoints are the two texels furthest apart along the
+	 *  principal axis of the block's colors.
+	 ***********************************************************/
+	void EncodeBlockBC7(const unsigned char texels[16][4], unsigned char* pBlock)
+	{
+		// mean and covariance of the block colors
+		float mean[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		for (int i = 0; i < 16; i++)
+		{
+			for (int c = 0; c < 4; c++)
+			{
+				mean[c] += texels[i][c] / 16.0f;
+			}
+		}
+
+		float covariance[4][4] = {};
+		for (int i = 0; i < 16; i++)
+		{
+			for (int a = 0; a < 4; a++)
+			{
+				for (int b = 0; b < 4; b++)
+				{
+					covariance[a][b] += (texels[i][a] - mean[a]) * (texels[i][b] - mean[b]);
+				}
+			}
+		}
+
+		// a few power iterations find the principal axis
+		float axis[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+		for (int iteration = 0; iteration < 8; iteration++)
+		{
+			float next[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+			float length = 0.0f;
+			for (int a = 0; a < 4; a++)
+			{
+				for (int b = 0; b < 4; b++)
+				{
+					next[a] += covariance[a][b] * axis[b];
+				}
+				length = std::max(length, std::abs(next[a]));
+			}
+			if (length <= 0.0f)
+			{
+				break;
+			}
+			for (int a = 0; a < 4; a++)
+			{
+				axis[a] = next[a] / length;
+			}
+		}
+
+		int lowTexel = 0;
+		int highTexel = 0;
+		float lowProjection = 0.0f;
+		float highProjection = 0.0f;
+		for (int i = 0; i < 16; i++)
+		{
+			float projection = 0.0f;
+			for (int c = 0; c < 4; c++)
+			{
+				projection += (texels[i][c] - mean[c]) * axis[c];
+			}
+			if ((i == 0) || (projection < lowProjection))
+			{
+				lowProjection = projection;
+				lowTexel = i;
+			}
+			if ((i == 0) || (projection > highProjection))
+			{
+				highProjection = projection;
+				highTexel = i;
+			}
+		}
+
+		int endpoints[2][4];
+		int quantized[2][4];
+		int pBits[2];
+		for (int c = 0; c < 4; c++)
+		{
+			endpoints[0][c] = texels[lowTexel][c];
+			endpoints[1][c] = texels[highTexel][c];
+		}
+		QuantizeEndpoint(endpoints[0], quantized[0], pBits[0]);
+		QuantizeEndpoint(endpoints[1], quantized[1], pBits[1]);
+
+		// the 16 colors the decoder interpolates between the endpoints
+		int palette[16][4];
+		for (int w = 0; w < 16; w++)
+		{
+			for (int c = 0; c < 4; c++)
+			{
+				int e0 = (quantized[0][c] << 1) | pBits[0];
+				int e1 = (quantized[1][c] << 1) | pBits[1];
+				palette[w][c] = ((64 - g_BC7Weights4[w]) * e0 + g_BC7Weights4[w] * e1 + 32) >> 6;
+			}
+		}
+
+		int indices[16];
+		for (int i = 0; i < 16; i++)
+		{
+			int bestError = -1;
+			for (int w = 0; w < 16; w++)
+			{
+				int error = 0;
+				for (int c = 0; c < 4; c++)
+				{
+					int difference = palette[w][c] - texels[i][c];
+					error += difference * difference;
+				}
+				if ((bestError < 0) || (error < bestError))
+				{
+					bestError = error;
+					indices[i] = w;
+				}
+			}
+		}
+
+		// the first index is stored without its top bit, so swap
+		// the endpoints when it would be set
+		if (indices[0] >= 8)
+		{
+			for (int c = 0; c < 4; c++)
+			{
+				std::swap(quantized[0][c], quantized[1][c]);
+			}
+			std::swap(pBits[0], pBits[1]);
+			for (int i = 0; i < 16; i++)
+			{
+				indices[i] = 15 - indices[i];
+			}
+		}
+
+		memset(pBlock, 0, g_BlockBytes);
+		int bitPosition = 0;
+
+		// mode 6 is selected by a single set bit after six zeros
+		WriteBits(pBlock, bitPosition, 1 << 6, 7);
+		for (int c = 0; c < 4; c++)
+		{
+			WriteBits(pBlock, bitPosition, quantized[0][c], 7);
+			WriteBits(pBlock, bitPosition, quantized[1][c], 7);
+		}
+		WriteBits(pBlock, bitPosition, pBits[0], 1);
+		WriteBits(pBlock, bitPosition, pBits[1], 1);
+		WriteBits(pBlock, bitPosition, indices[0], 3);
+		for (int i = 1; i < 16; i++)
+		{
+			WriteBits(pBlock, bitPosition, indices[i], 4);
+		}
+	}
+
+	/***********************************************************
+	 *  AlignOffset()
+	 *
+	 *  Round a file offset up to the level alignment.
+	 ***********************************************************/
+	uint64_t AlignOffset(uint64_t offset)
+	{
+		return((offset + g_LevelAlignment - 1) / g_LevelAlignment * g_LevelAlignment);
+	}
+}
+
+/***********************************************************
+ *  CompressedTexture()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+CompressedTexture::CompressedTexture()
+{
+	m_width = 0;
+	m_height = 0;
+}
+
+/***********************************************************
+ *  Compress()
+ *
+ *  This method is used for building the full mip chain of
+ *  a decoded RGB or RGBA image with a 2x2 box filter and
+ *  encoding every level into BC7 blocks.
+ ***********************************************************/
+void CompressedTexture::Compress(const unsigned char* pixels, int width, int height, int colorChannels)
+{
+	m_width = width;
+	m_height = height;
+	m_levels.clear();
+	m_data.clear();
+
+	// widen the top level to RGBA
+	std::vector<unsigned char> level(width * height * 4);
+	for (int i = 0; i < width * height; i++)
+	{
+		for (int c = 0; c < 4; c++)
+		{
+			level[i * 4 + c] = (c < colorChannels) ? pixels[i * colorChannels + c] : 255;
+		}
+	}
+
+	int levelWidth = width;
+	int levelHeight = height;
+	while (true)
+	{
+		AddLevel(level, levelWidth, levelHeight);
+
+		if ((levelWidth == 1) && (levelHeight == 1))
+		{
+			break;
+		}
+
+		// average each 2x2 footprint into the next level - the
+		// clamp keeps odd sizes and 1 pixel wide levels in range
+		int nextWidth = std::max(1, levelWidth / 2);
+		int nextHeight = std::max(1, levelHeight / 2);
+		std::vector<unsigned char> next(nextWidth * nextHeight * 4);
+		for (int y = 0; y < nextHeight; y++)
+		{
+			int y0 = std::min(y * 2, levelHeight - 1);
+			int y1 = std::min(y * 2 + 1, levelHeight - 1);
+			for (int x = 0; x < nextWidth; x++)
+			{
+				int x0 = std::min(x * 2, levelWidth - 1);
+				int x1 = std::min(x * 2 + 1, levelWidth - 1);
+				for (int c = 0; c < 4; c++)
+				{
+					int sum = level[(y0 * levelWidth + x0) * 4 + c] +
+						level[(y0 * levelWidth + x1) * 4 + c] +
+						level[(y1 * levelWidth + x0) * 4 + c] +
+						level[(y1 * levelWidth + x1) * 4 + c];
+					next[(y * nextWidth + x) * 4 + c] = (unsigned char)((sum + 2) / 4);
+				}
+			}
+		}
+
+		level.swap(next);
+		levelWidth = nextWidth;
+		levelHeight = nextHeight;
+	}
+}
+
+/***********************************************************
+ *  AddLevel()
+ *
+ *  This method is used for encoding one RGBA mip level into
+ *  BC7 blocks and adding it after the previous levels.
+ *  Blocks that overhang the level edge repeat the edge
+ *  texels.
+ ***********************************************************/
+void CompressedTexture::AddLevel(const std::vector<unsigned char>& rgba, int width, int height)
+{
+	int blocksWide = (width + 3) / 4;
+	int blocksHigh = (height + 3) / 4;
+
+	MIP_LEVEL mipLevel;
+	mipLevel.width = width;
+	mipLevel.height = height;
+	mipLevel.offset = (int)m_data.size();
+	mipLevel.size = blocksWide * blocksHigh * g_BlockBytes;
+	m_levels.push_back(mipLevel);
+
+	m_data.resize(m_data.size() + mipLevel.size);
+	unsigned char* pBlock = &m_data[mipLevel.offset];
+
+	unsigned char texels[16][4];
+	for (int by = 0; by < blocksHigh; by++)
+	{
+		for (int bx = 0; bx < blocksWide; bx++)
+		{
+			for (int i = 0; i < 16; i++)
+			{
+				int x = std::min(bx * 4 + (i % 4), width - 1);
+				int y = std::min(by * 4 + (i / 4), height - 1);
+				memcpy(texels[i], &rgba[(y * width + x) * 4], 4);
+			}
+
+			EncodeBlockBC7(texels, pBlock);
+			pBlock += g_BlockBytes;
+		}
+	}
+}
+
+/***********************************************************
+ *  Load()
+ *
+ *  This method is used for reading a baked KTX2 file.  Only
+ *  uncompressed-container BC7 2D textures are accepted, as
+ *  written by Save().
+ ***********************************************************/
+bool CompressedTexture::Load(const std::string& filename)
+{
+	m_width = 0;
+	m_height = 0;
+	m_levels.clear();
+	m_data.clear();
+
+	FILE* pFile = fopen(filename.c_str(), "rb");
+	if (pFile == NULL)
+	{
+		return(false);
+	}
+
+	KTX2_HEADER header;
+	bool bValid = (fread(&header, sizeof(header), 1, pFile) == 1) &&
+		(memcmp(header.identifier, g_KTX2Identifier, sizeof(g_KTX2Identifier)) == 0) &&
+		(header.vkFormat == g_VkFormatBC7) &&
+		(header.pixelDepth == 0) &&
+		(header.layerCount == 0) &&
+		(header.faceCount == 1) &&
+		(header.supercompressionScheme == 0) &&
+		(header.levelCount > 0);
+
+	std::vector<KTX2_LEVEL> fileLevels;
+	if (bValid == true)
+	{
+		fileLevels.resize(header.levelCount);
+		bValid = (fread(&fileLevels[0], sizeof(KTX2_LEVEL), header.levelCount, pFile) == header.levelCount);
+	}
+
+	int levelWidth = (int)header.pixelWidth;
+	int levelHeight = (int)header.pixelHeight;
+	for (int i = 0; (bValid == true) && (i < fileLevels.size()); i++)
+	{
+		MIP_LEVEL mipLevel;
+		mipLevel.width = levelWidth;
+		mipLevel.height = levelHeight;
+		mipLevel.offset = (int)m_data.size();
+		mipLevel.size = (int)fileLevels[i].byteLength;
+
+		int expectedSize = ((levelWidth + 3) / 4) * ((levelHeight + 3) / 4) * g_BlockBytes;
+		bValid = (mipLevel.size == expectedSize) &&
+			(fseek(pFile, (long)fileLevels[i].byteOffset, SEEK_SET) == 0);
+		if (bValid == true)
+		{
+			m_data.resize(m_data.size() + mipLevel.size);
+			bValid = (fread(&m_data[mipLevel.offset], 1, mipLevel.size, pFile) == mipLevel.size);
+			m_levels.push_back(mipLevel);
+		}
+
+		levelWidth = std::max(1, levelWidth / 2);
+		levelHeight = std::max(1, levelHeight / 2);
+	}
+
+	fclose(pFile);
+
+	if (bValid == false)
+	{
+		m_levels.clear();
+		m_data.clear();
+		return(false);
+	}
+
+	m_width = (int)header.pixelWidth;
+	m_height = (int)header.pixelHeight;
+
+	return(true);
+}
+
+/***********************************************************
+ *  Save()
+ *
+ *  This method is used for writing the levels into a KTX2
+ *  file with a BC7 data format descriptor.  The level data
+ *  is stored smallest level first, as KTX2 requires.
+ ***********************************************************/
+bool CompressedTexture::Save(const std::string& filename) const
+{
+	if (m_levels.size() == 0)
+	{
+		return(false);
+	}
+
+	// basic data format descriptor with one BC7 sample
+	uint32_t dfd[11] = {};
+	unsigned char* pDescriptor = (unsigned char*)&dfd[3];
+	dfd[0] = sizeof(dfd);                                   // dfdTotalSize
+	dfd[1] = 0;                                             // Khronos vendor, basic descriptor
+	dfd[2] = 2 | ((sizeof(dfd) - 4) << 16);                 // version 2, descriptor block size
+	pDescriptor[0] = g_DataFormatModelBC7;                  // color model
+	pDescriptor[1] = 1;                                     // BT.709 primaries
+	pDescriptor[2] = 1;                                     // linear transfer
+	pDescriptor[3] = 0;                                     // flags
+	pDescriptor[4] = 3;                                     // 4x4 texel blocks
+	pDescriptor[5] = 3;
+	pDescriptor[8] = g_BlockBytes;                          // bytes in plane 0
+	dfd[7] = (127 << 16);                                   // 128 bit color sample
+	dfd[9] = 0;                                             // sample lower
+	dfd[10] = 0xFFFFFFFF;                                   // sample upper
+
+	KTX2_HEADER header = {};
+	memcpy(header.identifier, g_KTX2Identifier, sizeof(g_KTX2Identifier));
+	header.vkFormat = g_VkFormatBC7;
+	header.typeSize = 1;
+	header.pixelWidth = m_width;
+	header.pixelHeight = m_height;
+	header.faceCount = 1;
+	header.levelCount = (uint32_t)m_levels.size();
+	header.dfdByteOffset = (uint32_t)(sizeof(KTX2_HEADER) + m_levels.size() * sizeof(KTX2_LEVEL));
+	header.dfdByteLength = sizeof(dfd);
+
+	// lay the levels out from the smallest up
+	std::vector<KTX2_LEVEL> fileLevels(m_levels.size());
+	uint64_t offset = header.dfdByteOffset + header.dfdByteLength;
+	for (int i = (int)m_levels.size() - 1; i >= 0; i--)
+	{
+		offset = AlignOffset(offset);
+		fileLevels[i].byteOffset = offset;
+		fileLevels[i].byteLength = m_levels[i].size;
+		fileLevels[i].uncompressedByteLength = m_levels[i].size;
+		offset += m_levels[i].size;
+	}
+
+	FILE* pFile = fopen(filename.c_str(), "wb");
+	if (pFile == NULL)
+	{
+		return(false);
+	}
+
+	bool bWritten = (fwrite(&header, sizeof(header), 1, pFile) == 1) &&
+		(fwrite(&fileLevels[0], sizeof(KTX2_LEVEL), fileLevels.size(), pFile) == fileLevels.size()) &&
+		(fwrite(dfd, sizeof(dfd), 1, pFile) == 1);
+
+	const unsigned char padding[g_LevelAlignment] = {};
+	uint64_t position = header.dfdByteOffset + header.dfdByteLength;
+	for (int i = (int)m_levels.size() - 1; (bWritten == true) && (i >= 0); i--)
+	{
+		int paddingSize = (int)(fileLevels[i].byteOffset - position);
+		bWritten = ((paddingSize == 0) || (fwrite(padding, 1, paddingSize, pFile) == paddingSize)) &&
+			(fwrite(&m_data[m_levels[i].offset], 1, m_levels[i].size, pFile) == m_levels[i].size);
+		position = fileLevels[i].byteOffset + m_levels[i].size;
+	}
+
+	fclose(pFile);
+
+	return(bWritten);
+}
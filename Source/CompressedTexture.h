@@ -0,0 +1,65 @@
+///////////////////////////////////////////////////////////////////////////////
+// compressedtexture.h
+// ============
+// bake decoded images into BC7 compressed, pre-mipmapped KTX2 files and read
+// them back for upload
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+//  Notes: A baked texture holds its whole mip chain as BC7 blocks, so it is
+//         uploaded with glCompressedTexImage2D() and needs no image decode
+//         or glGenerateMipmap() at startup.  The blocks are encoded with
+//         BC7 mode 6 - one RGBA endpoint pair per 4x4 block - which keeps
+//         the encoder small enough to run on the texture loader threads.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  CompressedTexture
+ *
+ *  This class holds the BC7 blocks of every mip level of
+ *  one texture, along with the size of each level.
+ ***********************************************************/
+class CompressedTexture
+{
+public:
+	struct MIP_LEVEL
+	{
+		int width;
+		int height;
+		// byte range of the level in GetData()
+		int offset;
+		int size;
+	};
+
+	// constructor
+	CompressedTexture();
+
+	// build the mip chain of a decoded image and encode every level
+	void Compress(const unsigned char* pixels, int width, int height, int colorChannels);
+	// read a baked KTX2 file - false when missing or not BC7
+	bool Load(const std::string& filename);
+	// write the levels into a KTX2 file
+	bool Save(const std::string& filename) const;
+
+	// get the size of the top mip level
+	int GetWidth() const { return(m_width); }
+	int GetHeight() const { return(m_height); }
+	// get the mip levels, largest first
+	const std::vector<MIP_LEVEL>& GetLevels() const { return(m_levels); }
+	// get the BC7 blocks of all the levels
+	const std::vector<unsigned char>& GetData() const { return(m_data); }
+
+private:
+	int m_width;
+	int m_height;
+	std::vector<MIP_LEVEL> m_levels;
+	std::vector<unsigned char> m_data;
+
+	// add a level and encode its RGBA pixels into BC7 blocks
+	void AddLevel(const std::vector<unsigned char>& rgba, int width, int height);
+};
@@ -0,0 +1,121 @@
+///////////////////////////////////////////////////////////////////////////////
+// filewatcher.cpp
+// ============
+// notice when the scene, shader and texture files change on disk
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "FileWatcher.h"
+
+#include <sys/stat.h>
+
+#include <algorithm>
+
+// a few looks a second is plenty for files saved by hand
+const double FileWatcher::POLL_SECONDS = 0.25;
+
+/***********************************************************
+ *  FileWatcher()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+FileWatcher::FileWatcher()
+{
+	m_nextPoll = std::chrono::steady_clock::now();
+}
+
+/***********************************************************
+ *  Watch()
+ *
+ *  This method is used for adding a file to the watched
+ *  list.  The file's current stamp is taken as unchanged.
+ ***********************************************************/
+void FileWatcher::Watch(const std::string& filename, int id)
+{
+	WATCHED_FILE file;
+	file.filename = filename;
+	file.id = id;
+	file.reported = ReadStamp(filename);
+	file.seen = file.reported;
+
+	m_files.push_back(file);
+}
+
+/***********************************************************
+ *  Poll()
+ *
+ *  This method is used for finding the files that have
+ *  changed.  A file is reported when its stamp differs
+ *  from the last reported one and matches the stamp of
+ *  the previous poll, so it is not reported while it is
+ *  still being written.  A file that goes missing, as an
+ *  editor that saves through a temporary file may leave it
+ *  for a moment, is not reported until it is back.
+ ***********************************************************/
+bool FileWatcher::Poll(std::vector<int>& changedIDs)
+{
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	if (now < m_nextPoll)
+	{
+		return(false);
+	}
+	m_nextPoll = now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+		std::chrono::duration<double>(POLL_SECONDS));
+
+	bool bChanged = false;
+	for (int i = 0; i < m_files.size(); i++)
+	{
+		WATCHED_FILE& file = m_files[i];
+		FILE_STAMP stamp = ReadStamp(file.filename);
+
+		bool bSettled = IsSameStamp(stamp, file.seen);
+		file.seen = stamp;
+		if ((bSettled == false) || (stamp.size == 0) || (IsSameStamp(stamp, file.reported) == true))
+		{
+			continue;
+		}
+
+		file.reported = stamp;
+		if (std::find(changedIDs.begin(), changedIDs.end(), file.id) == changedIDs.end())
+		{
+			changedIDs.push_back(file.id);
+		}
+		bChanged = true;
+	}
+
+	return(bChanged);
+}
+
+/***********************************************************
+ *  ReadStamp()
+ *
+ *  This method is used for reading the modification time
+ *  and size of a file.
+ ***********************************************************/
+FileWatcher::FILE_STAMP FileWatcher::ReadStamp(const std::string& filename)
+{
+	FILE_STAMP stamp;
+	stamp.time = 0;
+	stamp.size = 0;
+
+	struct stat fileInfo;
+	if (stat(filename.c_str(), &fileInfo) == 0)
+	{
+		stamp.time = (long long)fileInfo.st_mtime;
+		stamp.size = (long long)fileInfo.st_size;
+	}
+
+	return(stamp);
+}
+
+/***********************************************************
+ *  IsSameStamp()
+ *
+ *  This method is used for comparing two file stamps.
+ ***********************************************************/
+bool FileWatcher::IsSameStamp(const FILE_STAMP& a, const FILE_STAMP& b)
+{
+	return((a.time == b.time) && (a.size == b.size));
+}
@@ -0,0 +1,73 @@
+///////////////////////////////////////////////////////////////////////////////
+// filewatcher.h
+// ============
+// notice when the scene, shader and texture files change on disk
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+//  Notes: Each watched file is registered with an ID, and Poll() reports
+//         the IDs of the files whose modification time or size changed.
+//         The files are only looked at a few times a second, and a change
+//         is only reported once the file has held still for a whole poll,
+//         so an editor that saves in several writes is not read half way.
+//         Several files may share one ID - it is reported once however
+//         many of them changed.  Poll() is meant to be called from the
+//         main thread at the start of a frame, so whatever reacts to a
+//         change swaps its GL resources between two frames.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  FileWatcher
+ *
+ *  This class holds the watched files and the time and
+ *  size each one was last seen with.
+ ***********************************************************/
+class FileWatcher
+{
+public:
+	// constructor
+	FileWatcher();
+
+	// start watching a file - the ID is what Poll() reports
+	void Watch(const std::string& filename, int id);
+
+	// add the IDs of the files that changed since the last report,
+	// once per ID - false when nothing changed or it is not yet
+	// time to look
+	bool Poll(std::vector<int>& changedIDs);
+
+private:
+	// modification time and size of a file, zero when it is missing
+	struct FILE_STAMP
+	{
+		long long time;
+		long long size;
+	};
+
+	struct WATCHED_FILE
+	{
+		std::string filename;
+		int id;
+		// stamp of the version last reported, or first seen
+		FILE_STAMP reported;
+		// stamp seen by the last poll, checked for holding still
+		FILE_STAMP seen;
+	};
+
+	// seconds between looking at the files
+	static const double POLL_SECONDS;
+
+	std::vector<WATCHED_FILE> m_files;
+	std::chrono::steady_clock::time_point m_nextPoll;
+
+	// read the stamp of a file
+	static FILE_STAMP ReadStamp(const std::string& filename);
+	// check whether two stamps are the same
+	static bool IsSameStamp(const FILE_STAMP& a, const FILE_STAMP& b);
+};
@@ -0,0 +1,658 @@
+///////////////////////////////////////////////////////////////////////////////
+// frameprofiler.cpp
+// ============
+// time named sections of each frame on the CPU and the GPU
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "FrameProfiler.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	// weight of the newest frame in the averaged times
+	const float AVERAGE_WEIGHT = 0.1f;
+
+	// overlay layout in pixels, and the time the full bar length
+	// stands for - one frame at 60 Hz
+	const int OVERLAY_MARGIN = 8;
+	const int OVERLAY_BAR_HEIGHT = 6;
+	const int OVERLAY_ROW_GAP = 4;
+	const int OVERLAY_BAR_LENGTH = 320;
+	const float OVERLAY_FRAME_MILLISECONDS = 1000.0f / 60.0f;
+
+	// bar color of each overlay row, repeated when there are more rows
+	const float g_OverlayColors[][3] =
+	{
+		{ 0.90f, 0.35f, 0.25f },
+		{ 0.30f, 0.70f, 0.95f },
+		{ 0.95f, 0.80f, 0.25f },
+		{ 0.45f, 0.85f, 0.40f },
+		{ 0.80f, 0.45f, 0.90f },
+		{ 0.95f, 0.55f, 0.75f }
+	};
+	const int OVERLAY_COLOR_COUNT = sizeof(g_OverlayColors) / sizeof(g_OverlayColors[0]);
+
+	/***********************************************************
+	 *  FillRect()
+	 *
+	 *  Fill a rectangle of the bound framebuffer with a color,
+	 *  measured from the top left corner.  A scissored clear
+	 *  needs no shader or vertices.
+	 ***********************************************************/
+	void FillRect(int x, int y, int width, int height, int viewportHeight, float r, float g, float b)
+	{
+		if ((width <= 0) || (height <= 0))
+		{
+			return;
+		}
+		glScissor(x, viewportHeight - y - height, width, height);
+		glClearColor(r, g, b, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT);
+	}
+
+	/***********************************************************
+	 *  WriteTraceEvent()
+	 *
+	 *  Write one complete event of the Chrome trace format,
+	 *  with its times in microseconds.
+	 ***********************************************************/
+	void WriteTraceEvent(
+		std::ofstream& file,
+		bool& bFirstEvent,
+		const char* name,
+		int threadID,
+		double beginMicroseconds,
+		double durationMicroseconds,
+		int frameNumber)
+	{
+		char line[256];
+		snprintf(line, sizeof(line),
+			"%s\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"frame\":%d}}",
+			(bFirstEvent == true) ? "" : ",",
+			name,
+			(threadID == 1) ? "cpu" : "gpu",
+			threadID,
+			beginMicroseconds,
+			durationMicroseconds,
+			frameNumber);
+		file << line;
+		bFirstEvent = false;
+	}
+}
+
+/***********************************************************
+ *  FrameProfiler()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+FrameProfiler::FrameProfiler()
+{
+	for (int i = 0; i < QUERY_FRAMES; i++)
+	{
+		for (int j = 0; j < MAX_SCOPES; j++)
+		{
+			m_slots[i].queries[j] = 0;
+		}
+		m_slots[i].queryCount = 0;
+		m_slots[i].bPending = false;
+	}
+	m_bQueriesCreated = false;
+	m_frameNumber = 0;
+	m_currentFrame.frameNumber = 0;
+	m_currentFrame.cpuBegin = 0.0;
+	m_currentFrame.cpuEnd = 0.0;
+	m_gpuScope = -1;
+	m_historyLength = TRACE_FRAMES;
+	m_startTime = std::chrono::steady_clock::now();
+}
+
+/***********************************************************
+ *  ~FrameProfiler()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+FrameProfiler::~FrameProfiler()
+{
+	if (m_bQueriesCreated == true)
+	{
+		for (int i = 0; i < QUERY_FRAMES; i++)
+		{
+			glDeleteQueries(MAX_SCOPES, m_slots[i].queries);
+		}
+		m_bQueriesCreated = false;
+	}
+}
+
+/***********************************************************
+ *  GetTime()
+ *
+ *  This method is used for getting the seconds since the
+ *  profiler was created.
+ ***********************************************************/
+double FrameProfiler::GetTime() const
+{
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - m_startTime;
+	return(elapsed.count());
+}
+
+/***********************************************************
+ *  BeginFrame()
+ *
+ *  This method is used for starting to record a frame into
+ *  the next slot of the query ring.  The frame that used
+ *  the slot QUERY_FRAMES frames ago is read back first.
+ *  The queries are created on the first frame, once there
+ *  is a current context.
+ ***********************************************************/
+void FrameProfiler::BeginFrame()
+{
+	if (m_bQueriesCreated == false)
+	{
+		for (int i = 0; i < QUERY_FRAMES; i++)
+		{
+			glGenQueries(MAX_SCOPES, m_slots[i].queries);
+		}
+		m_bQueriesCreated = true;
+	}
+
+	QUERY_SLOT& slot = m_slots[m_frameNumber % QUERY_FRAMES];
+	if (slot.bPending == true)
+	{
+		ResolveSlot(slot);
+	}
+	slot.queryCount = 0;
+
+	m_currentFrame.frameNumber = m_frameNumber;
+	m_currentFrame.cpuBegin = GetTime();
+	m_currentFrame.cpuEnd = m_currentFrame.cpuBegin;
+	m_currentFrame.scopes.clear();
+	m_openScopes.clear();
+	m_gpuScope = -1;
+}
+
+/***********************************************************
+ *  EndFrame()
+ *
+ *  This method is used for closing any scope left open and
+ *  parking the frame in its ring slot until its queries
+ *  can be read.
+ ***********************************************************/
+void FrameProfiler::EndFrame()
+{
+	while (m_openScopes.size() > 0)
+	{
+		EndScope();
+	}
+	m_currentFrame.cpuEnd = GetTime();
+
+	QUERY_SLOT& slot = m_slots[m_frameNumber % QUERY_FRAMES];
+	slot.frame = m_currentFrame;
+	slot.bPending = true;
+
+	m_frameNumber++;
+}
+
+/***********************************************************
+ *  BeginScope()
+ *
+ *  This method is used for opening a named scope.  Its GPU
+ *  time is only measured when no other scope of the frame
+ *  holds the elapsed query, and the frame has a query left.
+ ***********************************************************/
+void FrameProfiler::BeginScope(const char* name)
+{
+	if (m_currentFrame.scopes.size() >= MAX_SCOPES)
+	{
+		return;
+	}
+
+	RECORDED_SCOPE scope;
+	scope.name = name;
+	scope.depth = (int)m_openScopes.size();
+	scope.cpuBegin = GetTime();
+	scope.cpuEnd = scope.cpuBegin;
+	scope.queryIndex = -1;
+	scope.gpuMilliseconds = -1.0;
+
+	QUERY_SLOT& slot = m_slots[m_frameNumber % QUERY_FRAMES];
+	if ((m_bQueriesCreated == true) && (m_gpuScope < 0) && (slot.queryCount < MAX_SCOPES))
+	{
+		scope.queryIndex = slot.queryCount++;
+		glBeginQuery(GL_TIME_ELAPSED, slot.queries[scope.queryIndex]);
+		m_gpuScope = (int)m_currentFrame.scopes.size();
+	}
+
+	m_openScopes.push_back((int)m_currentFrame.scopes.size());
+	m_currentFrame.scopes.push_back(scope);
+}
+
+/***********************************************************
+ *  EndScope()
+ *
+ *  This method is used for closing the innermost open scope.
+ ***********************************************************/
+void FrameProfiler::EndScope()
+{
+	if (m_openScopes.size() == 0)
+	{
+		return;
+	}
+
+	int scopeIndex = m_openScopes.back();
+	m_openScopes.pop_back();
+
+	RECORDED_SCOPE& scope = m_currentFrame.scopes[scopeIndex];
+	scope.cpuEnd = GetTime();
+	if (scopeIndex == m_gpuScope)
+	{
+		glEndQuery(GL_TIME_ELAPSED);
+		m_gpuScope = -1;
+	}
+}
+
+/***********************************************************
+ *  ResolveSlot()
+ *
+ *  This method is used for reading the query results of a
+ *  ring slot.  Each result is only read once it is
+ *  available, so this never waits on the GPU - a scope
+ *  whose query is not ready keeps no GPU time.  The frame
+ *  then joins the trace history and the averages.
+ ***********************************************************/
+void FrameProfiler::ResolveSlot(QUERY_SLOT& slot)
+{
+	for (int i = 0; i < slot.frame.scopes.size(); i++)
+	{
+		RECORDED_SCOPE& scope = slot.frame.scopes[i];
+		if (scope.queryIndex < 0)
+		{
+			continue;
+		}
+
+		GLuint query = slot.queries[scope.queryIndex];
+		GLint available = GL_FALSE;
+		glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+		if (available == GL_TRUE)
+		{
+			GLuint64 nanoseconds = 0;
+			glGetQueryObjectui64v(query, GL_QUERY_RESULT, &nanoseconds);
+			scope.gpuMilliseconds = (double)nanoseconds / 1.0e6;
+		}
+	}
+	slot.bPending = false;
+
+	UpdateAverages(slot.frame);
+
+	m_history.push_back(slot.frame);
+	while (m_history.size() > m_historyLength)
+	{
+		m_history.pop_front();
+	}
+}
+
+/***********************************************************
+ *  Flush()
+ *
+ *  This method is used for reading back the frames still
+ *  waiting in the query ring, oldest first.  It waits for
+ *  the GPU to finish, so every result is available - it is
+ *  meant for the end of a benchmark run, not for a frame.
+ ***********************************************************/
+void FrameProfiler::Flush()
+{
+	glFinish();
+
+	for (int i = 0; i < QUERY_FRAMES; i++)
+	{
+		QUERY_SLOT& slot = m_slots[(m_frameNumber + i) % QUERY_FRAMES];
+		if (slot.bPending == true)
+		{
+			ResolveSlot(slot);
+		}
+	}
+}
+
+/***********************************************************
+ *  SetHistoryLength()
+ *
+ *  This method is used for setting how many finished frames
+ *  are kept for the trace and the history statistics.
+ ***********************************************************/
+void FrameProfiler::SetHistoryLength(int frameCount)
+{
+	m_historyLength = std::max(frameCount, 1);
+	while (m_history.size() > m_historyLength)
+	{
+		m_history.pop_front();
+	}
+}
+
+/***********************************************************
+ *  GetHistoryAverages()
+ *
+ *  This method is used for getting the mean CPU and GPU
+ *  time of each scope over the kept frames, counting only
+ *  the frames the scope was recorded in.
+ ***********************************************************/
+void FrameProfiler::GetHistoryAverages(std::vector<SCOPE_AVERAGE>& averages) const
+{
+	averages.clear();
+	std::vector<int> cpuCounts;
+	std::vector<int> gpuCounts;
+
+	for (int i = 0; i < m_history.size(); i++)
+	{
+		const FRAME_RECORD& frame = m_history[i];
+		for (int j = 0; j < frame.scopes.size(); j++)
+		{
+			const RECORDED_SCOPE& scope = frame.scopes[j];
+
+			int index = 0;
+			while ((index < averages.size()) && (std::strcmp(averages[index].name, scope.name) != 0))
+			{
+				index++;
+			}
+			if (index == averages.size())
+			{
+				SCOPE_AVERAGE average;
+				average.name = scope.name;
+				average.cpuMilliseconds = 0.0f;
+				average.gpuMilliseconds = 0.0f;
+				averages.push_back(average);
+				cpuCounts.push_back(0);
+				gpuCounts.push_back(0);
+			}
+
+			averages[index].cpuMilliseconds += (float)((scope.cpuEnd - scope.cpuBegin) * 1000.0);
+			cpuCounts[index]++;
+			if (scope.gpuMilliseconds >= 0.0)
+			{
+				averages[index].gpuMilliseconds += (float)scope.gpuMilliseconds;
+				gpuCounts[index]++;
+			}
+		}
+	}
+
+	for (int i = 0; i < averages.size(); i++)
+	{
+		averages[i].cpuMilliseconds /= cpuCounts[i];
+		averages[i].gpuMilliseconds = (gpuCounts[i] > 0) ? averages[i].gpuMilliseconds / gpuCounts[i] : -1.0f;
+	}
+}
+
+/***********************************************************
+ *  GetFrameGpuTimes()
+ *
+ *  This method is used for getting the GPU time of each
+ *  kept frame - the sum of its timed scopes, which never
+ *  overlap.
+ ***********************************************************/
+void FrameProfiler::GetFrameGpuTimes(std::vector<double>& times) const
+{
+	times.clear();
+
+	for (int i = 0; i < m_history.size(); i++)
+	{
+		const FRAME_RECORD& frame = m_history[i];
+
+		double total = 0.0;
+		for (int j = 0; j < frame.scopes.size(); j++)
+		{
+			const RECORDED_SCOPE& scope = frame.scopes[j];
+			if (scope.queryIndex < 0)
+			{
+				continue;
+			}
+			if (scope.gpuMilliseconds < 0.0)
+			{
+				total = -1.0;
+				break;
+			}
+			total += scope.gpuMilliseconds;
+		}
+		times.push_back(total);
+	}
+}
+
+/***********************************************************
+ *  GetLastFrameGpuTime()
+ *
+ *  This method is used for getting the GPU time of the
+ *  newest kept frame without a named scope, such as the
+ *  buffer swap, whose time waits on the display instead
+ *  of drawing.
+ ***********************************************************/
+double FrameProfiler::GetLastFrameGpuTime(const char* excludedScope) const
+{
+	if (m_history.size() == 0)
+	{
+		return(-1.0);
+	}
+
+	const FRAME_RECORD& frame = m_history.back();
+	double total = 0.0;
+	for (int i = 0; i < frame.scopes.size(); i++)
+	{
+		const RECORDED_SCOPE& scope = frame.scopes[i];
+		if ((scope.queryIndex < 0) || (std::strcmp(scope.name, excludedScope) == 0))
+		{
+			continue;
+		}
+		if (scope.gpuMilliseconds < 0.0)
+		{
+			return(-1.0);
+		}
+		total += scope.gpuMilliseconds;
+	}
+
+	return(total);
+}
+
+/***********************************************************
+ *  UpdateAverages()
+ *
+ *  This method is used for folding the scope times of a
+ *  finished frame into the running averages.  Scopes with
+ *  the same name in one frame are added together first.
+ ***********************************************************/
+void FrameProfiler::UpdateAverages(const FRAME_RECORD& frame)
+{
+	std::vector<SCOPE_AVERAGE> frameTimes;
+	for (int i = 0; i < frame.scopes.size(); i++)
+	{
+		const RECORDED_SCOPE& scope = frame.scopes[i];
+
+		int index = 0;
+		while ((index < frameTimes.size()) && (std::strcmp(frameTimes[index].name, scope.name) != 0))
+		{
+			index++;
+		}
+		if (index == frameTimes.size())
+		{
+			SCOPE_AVERAGE times;
+			times.name = scope.name;
+			times.cpuMilliseconds = 0.0f;
+			times.gpuMilliseconds = -1.0f;
+			frameTimes.push_back(times);
+		}
+
+		frameTimes[index].cpuMilliseconds += (float)((scope.cpuEnd - scope.cpuBegin) * 1000.0);
+		if (scope.gpuMilliseconds >= 0.0)
+		{
+			frameTimes[index].gpuMilliseconds = std::max(frameTimes[index].gpuMilliseconds, 0.0f) + (float)scope.gpuMilliseconds;
+		}
+	}
+
+	for (int i = 0; i < frameTimes.size(); i++)
+	{
+		int index = 0;
+		while ((index < m_averages.size()) && (std::strcmp(m_averages[index].name, frameTimes[i].name) != 0))
+		{
+			index++;
+		}
+		if (index == m_averages.size())
+		{
+			// a new scope starts at its first times
+			m_averages.push_back(frameTimes[i]);
+			continue;
+		}
+
+		SCOPE_AVERAGE& average = m_averages[index];
+		average.cpuMilliseconds += (frameTimes[i].cpuMilliseconds - average.cpuMilliseconds) * AVERAGE_WEIGHT;
+		if (frameTimes[i].gpuMilliseconds >= 0.0f)
+		{
+			if (average.gpuMilliseconds < 0.0f)
+			{
+				average.gpuMilliseconds = frameTimes[i].gpuMilliseconds;
+			}
+			else
+			{
+				average.gpuMilliseconds += (frameTimes[i].gpuMilliseconds - average.gpuMilliseconds) * AVERAGE_WEIGHT;
+			}
+		}
+	}
+}
+
+/***********************************************************
+ *  GetSummary()
+ *
+ *  This method is used for getting the averaged GPU time
+ *  of each scope as one line of text, for the window title
+ *  or the console.
+ ***********************************************************/
+std::string FrameProfiler::GetSummary() const
+{
+	std::string summary;
+
+	for (int i = 0; i < m_averages.size(); i++)
+	{
+		const SCOPE_AVERAGE& average = m_averages[i];
+
+		char text[96];
+		if (average.gpuMilliseconds >= 0.0f)
+		{
+			snprintf(text, sizeof(text), "%s %.2f/%.2f ms", average.name, average.cpuMilliseconds, average.gpuMilliseconds);
+		}
+		else
+		{
+			snprintf(text, sizeof(text), "%s %.2f ms", average.name, average.cpuMilliseconds);
+		}
+
+		if (summary.empty() == false)
+		{
+			summary += ", ";
+		}
+		summary += text;
+	}
+
+	return(summary);
+}
+
+/***********************************************************
+ *  DrawOverlay()
+ *
+ *  This method is used for drawing one row per scope in the
+ *  top left corner of the bound framebuffer - a colored bar
+ *  for the averaged GPU time over a grey one for the CPU
+ *  time, both against a dark track that stands for one 60 Hz
+ *  frame.  Times that run past the frame fill the track.
+ *  The bars are scissored clears, so no program, vertex
+ *  array or blend state is touched.
+ ***********************************************************/
+void FrameProfiler::DrawOverlay() const
+{
+	GLint viewport[4] = { 0, 0, 0, 0 };
+	glGetIntegerv(GL_VIEWPORT, viewport);
+	GLfloat clearColor[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+	glGetFloatv(GL_COLOR_CLEAR_VALUE, clearColor);
+
+	glEnable(GL_SCISSOR_TEST);
+
+	float pixelsPerMillisecond = OVERLAY_BAR_LENGTH / OVERLAY_FRAME_MILLISECONDS;
+	int rowHeight = OVERLAY_BAR_HEIGHT * 2 + OVERLAY_ROW_GAP;
+	for (int i = 0; i < m_averages.size(); i++)
+	{
+		const SCOPE_AVERAGE& average = m_averages[i];
+		const float* color = g_OverlayColors[i % OVERLAY_COLOR_COUNT];
+
+		int x = OVERLAY_MARGIN;
+		int y = OVERLAY_MARGIN + i * rowHeight;
+		int gpuLength = std::min((int)(std::max(average.gpuMilliseconds, 0.0f) * pixelsPerMillisecond), OVERLAY_BAR_LENGTH);
+		int cpuLength = std::min((int)(average.cpuMilliseconds * pixelsPerMillisecond), OVERLAY_BAR_LENGTH);
+
+		FillRect(x, y, OVERLAY_BAR_LENGTH, OVERLAY_BAR_HEIGHT * 2, viewport[3], 0.08f, 0.08f, 0.08f);
+		FillRect(x, y, gpuLength, OVERLAY_BAR_HEIGHT, viewport[3], color[0], color[1], color[2]);
+		FillRect(x, y + OVERLAY_BAR_HEIGHT, cpuLength, OVERLAY_BAR_HEIGHT, viewport[3], 0.6f, 0.6f, 0.6f);
+	}
+
+	glDisable(GL_SCISSOR_TEST);
+	glClearColor(clearColor[0], clearColor[1], clearColor[2], clearColor[3]);
+}
+
+/***********************************************************
+ *  WriteChromeTrace()
+ *
+ *  This method is used for writing the recorded frames to a
+ *  JSON file in the Chrome trace event format.  The CPU
+ *  scopes are on thread 1 and the GPU scopes on thread 2.
+ *  An elapsed query only measures a duration, so each GPU
+ *  scope is placed at the CPU time its scope opened, or
+ *  right after the GPU scope before it if that ran later.
+ ***********************************************************/
+bool FrameProfiler::WriteChromeTrace(const char* filename) const
+{
+	std::ofstream file(filename);
+	if (!file)
+	{
+		std::cout << "Could not write the frame trace: " << filename << std::endl;
+		return(false);
+	}
+
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	file << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"CPU\"}}";
+	file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"GPU\"}}";
+	bool bFirstEvent = false;
+
+	double gpuEnd = 0.0;
+	for (int i = 0; i < m_history.size(); i++)
+	{
+		const FRAME_RECORD& frame = m_history[i];
+
+		WriteTraceEvent(file, bFirstEvent, "frame", 1,
+			frame.cpuBegin * 1.0e6,
+			(frame.cpuEnd - frame.cpuBegin) * 1.0e6,
+			frame.frameNumber);
+
+		for (int j = 0; j < frame.scopes.size(); j++)
+		{
+			const RECORDED_SCOPE& scope = frame.scopes[j];
+
+			WriteTraceEvent(file, bFirstEvent, scope.name, 1,
+				scope.cpuBegin * 1.0e6,
+				(scope.cpuEnd - scope.cpuBegin) * 1.0e6,
+				frame.frameNumber);
+
+			if (scope.gpuMilliseconds >= 0.0)
+			{
+				double begin = std::max(scope.cpuBegin * 1.0e6, gpuEnd);
+				double duration = scope.gpuMilliseconds * 1.0e3;
+				WriteTraceEvent(file, bFirstEvent, scope.name, 2, begin, duration, frame.frameNumber);
+				gpuEnd = begin + duration;
+			}
+		}
+	}
+
+	file << "\n]}\n";
+
+	std::cout << "Wrote " << m_history.size() << " frames to " << filename << std::endl;
+	return(true);
+}
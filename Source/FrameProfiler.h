@@ -0,0 +1,144 @@
+///////////////////////////////////////////////////////////////////////////////
+// frameprofiler.h
+// ============
+// time named sections of each frame on the CPU and the GPU
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+//  Notes: Each scope records its CPU time from a steady clock and its GPU
+//         time from a GL_TIME_ELAPSED query.  The queries of a frame are
+//         only read back QUERY_FRAMES frames later, when the GPU has long
+//         finished them, so the profiler never waits on the GPU - a query
+//         that is still not ready by then is dropped.  Elapsed queries
+//         cannot overlap, so only the outermost open scope is timed on
+//         the GPU.  The averaged times can be drawn as bars over the
+//         frame, and the last TRACE_FRAMES frames written out as a
+//         Chrome trace (chrome://tracing or ui.perfetto.dev).
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <chrono>
+#include <deque>
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  FrameProfiler
+ *
+ *  This class owns the timer query ring and the recorded
+ *  scopes of the last frames.
+ ***********************************************************/
+class FrameProfiler
+{
+public:
+	// most scopes recorded in one frame
+	static const int MAX_SCOPES = 32;
+	// frames between issuing a frame's queries and reading them
+	static const int QUERY_FRAMES = 4;
+	// frames kept for the Chrome trace, unless changed with
+	// SetHistoryLength()
+	static const int TRACE_FRAMES = 300;
+
+	// averaged times of one named scope
+	struct SCOPE_AVERAGE
+	{
+		const char* name;
+		float cpuMilliseconds;
+		float gpuMilliseconds;
+	};
+
+	// constructor
+	FrameProfiler();
+	// destructor
+	~FrameProfiler();
+
+	// start and finish recording a frame
+	void BeginFrame();
+	void EndFrame();
+	// open and close a named scope of the current frame - the
+	// name must be a string literal, it is kept by pointer
+	void BeginScope(const char* name);
+	void EndScope();
+
+	// wait for the GPU and read back every frame still in the
+	// query ring - only for the end of a run, it stalls
+	void Flush();
+	// set how many finished frames are kept
+	void SetHistoryLength(int frameCount);
+
+	// get the averaged times of every scope seen so far
+	const std::vector<SCOPE_AVERAGE>& GetAverages() const { return(m_averages); }
+	// get the mean times of every scope over the kept frames
+	void GetHistoryAverages(std::vector<SCOPE_AVERAGE>& averages) const;
+	// get the total GPU time of each kept frame, oldest first -
+	// -1 for a frame that lost a query result
+	void GetFrameGpuTimes(std::vector<double>& times) const;
+	// get the GPU time of the newest kept frame, leaving out the
+	// scopes with one name - -1 when it lost a query result
+	double GetLastFrameGpuTime(const char* excludedScope) const;
+	// get the averaged GPU times as one line of text
+	std::string GetSummary() const;
+	// draw the averaged times as bars in the corner of the
+	// bound framebuffer
+	void DrawOverlay() const;
+	// write the recorded frames out in the Chrome trace format
+	bool WriteChromeTrace(const char* filename) const;
+
+private:
+	// one closed or open scope of a frame
+	struct RECORDED_SCOPE
+	{
+		const char* name;
+		int depth;
+		// seconds since the profiler was created
+		double cpuBegin;
+		double cpuEnd;
+		// index of the scope's query in its ring slot, -1 for none
+		int queryIndex;
+		// -1 until the query result has been read
+		double gpuMilliseconds;
+	};
+
+	struct FRAME_RECORD
+	{
+		int frameNumber;
+		double cpuBegin;
+		double cpuEnd;
+		std::vector<RECORDED_SCOPE> scopes;
+	};
+
+	// one frame of the query ring
+	struct QUERY_SLOT
+	{
+		GLuint queries[MAX_SCOPES];
+		int queryCount;
+		// true while the slot holds a frame waiting to be read
+		bool bPending;
+		FRAME_RECORD frame;
+	};
+
+	QUERY_SLOT m_slots[QUERY_FRAMES];
+	bool m_bQueriesCreated;
+	int m_frameNumber;
+	// the frame being recorded, and its open scopes
+	FRAME_RECORD m_currentFrame;
+	std::vector<int> m_openScopes;
+	// scope holding the running elapsed query, -1 for none
+	int m_gpuScope;
+	// finished frames, oldest first
+	std::deque<FRAME_RECORD> m_history;
+	int m_historyLength;
+	std::vector<SCOPE_AVERAGE> m_averages;
+	std::chrono::steady_clock::time_point m_startTime;
+
+	// get the seconds since the profiler was created
+	double GetTime() const;
+	// read back the queries of a ring slot without waiting, and
+	// move its frame into the history
+	void ResolveSlot(QUERY_SLOT& slot);
+	// fold the times of a finished frame into the averages
+	void UpdateAverages(const FRAME_RECORD& frame);
+};
@@ -0,0 +1,198 @@
+///////////////////////////////////////////////////////////////////////////////
+// frameringbuffer.cpp
+// ============
+// hand out per-frame ranges of one persistently mapped buffer for the data
+// that is rewritten every frame
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "FrameRingBuffer.h"
+
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	// nanoseconds to wait on a fence before reporting a stall and
+	// waiting again
+	const GLuint64 FENCE_TIMEOUT = 1000000000;
+}
+
+/***********************************************************
+ *  FrameRingBuffer()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+FrameRingBuffer::FrameRingBuffer()
+{
+	m_buffer = 0;
+	m_pMapped = NULL;
+	m_frameSize = 0;
+	m_frameIndex = 0;
+	m_usedSize = 0;
+	for (int i = 0; i < FRAME_COUNT; i++)
+	{
+		m_fences[i] = 0;
+	}
+	m_bOverflowReported = false;
+}
+
+/***********************************************************
+ *  ~FrameRingBuffer()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+FrameRingBuffer::~FrameRingBuffer()
+{
+	for (int i = 0; i < FRAME_COUNT; i++)
+	{
+		if (m_fences[i] != 0)
+		{
+			glDeleteSync(m_fences[i]);
+			m_fences[i] = 0;
+		}
+	}
+
+	if (m_buffer != 0)
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+		glUnmapBuffer(GL_ARRAY_BUFFER);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		glDeleteBuffers(1, &m_buffer);
+		m_buffer = 0;
+		m_pMapped = NULL;
+	}
+}
+
+/***********************************************************
+ *  Create()
+ *
+ *  This method is used for making the immutable buffer of
+ *  all of the regions and mapping it for the life of the
+ *  ring.  The mapping is coherent, so the CPU writes are
+ *  seen by the next draw without any flush.
+ ***********************************************************/
+bool FrameRingBuffer::Create(GLsizeiptr frameSize)
+{
+	if ((GLEW_VERSION_4_4 == GL_FALSE) && (GLEW_ARB_buffer_storage == GL_FALSE))
+	{
+		std::cout << "Persistent buffer mapping is not supported, per-frame data is uploaded instead" << std::endl;
+		return(false);
+	}
+
+	const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+	m_frameSize = frameSize;
+	glGenBuffers(1, &m_buffer);
+	glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+	glBufferStorage(GL_ARRAY_BUFFER, m_frameSize * FRAME_COUNT, NULL, flags);
+	m_pMapped = (unsigned char*)glMapBufferRange(GL_ARRAY_BUFFER, 0, m_frameSize * FRAME_COUNT, flags);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	if (m_pMapped == NULL)
+	{
+		std::cout << "Could not map the frame ring buffer, per-frame data is uploaded instead" << std::endl;
+		glDeleteBuffers(1, &m_buffer);
+		m_buffer = 0;
+		return(false);
+	}
+
+	// the first BeginFrame() moves on to region 0
+	m_frameIndex = FRAME_COUNT - 1;
+	m_usedSize = m_frameSize;
+
+	return(true);
+}
+
+/***********************************************************
+ *  BeginFrame()
+ *
+ *  This method is used for moving on to the next region.
+ *  The GPU may still be reading it for the frame from
+ *  FRAME_COUNT frames ago, so its fence is waited on first
+ *  - normally it signalled long ago and the wait returns
+ *  at once.
+ ***********************************************************/
+void FrameRingBuffer::BeginFrame()
+{
+	m_frameIndex = (m_frameIndex + 1) % FRAME_COUNT;
+	m_usedSize = 0;
+
+	GLsync& fence = m_fences[m_frameIndex];
+	if (fence == 0)
+	{
+		return;
+	}
+
+	GLenum result = glClientWaitSync(fence, 0, 0);
+	while ((result != GL_ALREADY_SIGNALED) && (result != GL_CONDITION_SATISFIED) && (result != GL_WAIT_FAILED))
+	{
+		// flush, so the fence is sure to be reached
+		result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT);
+		if (result == GL_TIMEOUT_EXPIRED)
+		{
+			std::cout << "Still waiting on the GPU for frame ring region " << m_frameIndex << std::endl;
+		}
+	}
+
+	glDeleteSync(fence);
+	fence = 0;
+}
+
+/***********************************************************
+ *  EndFrame()
+ *
+ *  This method is used for placing the fence of the
+ *  current region after the draws that read it.
+ ***********************************************************/
+void FrameRingBuffer::EndFrame()
+{
+	if (m_buffer == 0)
+	{
+		return;
+	}
+
+	if (m_fences[m_frameIndex] != 0)
+	{
+		glDeleteSync(m_fences[m_frameIndex]);
+	}
+	m_fences[m_frameIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+/***********************************************************
+ *  Allocate()
+ *
+ *  This method is used for reserving the next range of the
+ *  current region.  The alignment must be a power of two -
+ *  the uniform and storage buffer offset alignments are.
+ ***********************************************************/
+bool FrameRingBuffer::Allocate(GLsizeiptr size, GLsizeiptr alignment, ALLOCATION& allocation)
+{
+	if (m_pMapped == NULL)
+	{
+		return(false);
+	}
+
+	GLsizeiptr regionStart = m_frameSize * m_frameIndex;
+	// align the absolute offset, which the binding calls check
+	GLsizeiptr start = regionStart + m_usedSize;
+	start = (start + alignment - 1) & ~(alignment - 1);
+
+	if (start + size > regionStart + m_frameSize)
+	{
+		if (m_bOverflowReported == false)
+		{
+			std::cout << "The frame ring buffer is full, the rest of the frame is uploaded instead" << std::endl;
+			m_bOverflowReported = true;
+		}
+		return(false);
+	}
+
+	allocation.pData = m_pMapped + start;
+	allocation.offset = (GLintptr)start;
+	m_usedSize = start + size - regionStart;
+
+	return(true);
+}
@@ -0,0 +1,82 @@
+///////////////////////////////////////////////////////////////////////////////
+// frameringbuffer.h
+// ============
+// hand out per-frame ranges of one persistently mapped buffer for the data
+// that is rewritten every frame
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+//  Notes: The buffer is made with glBufferStorage, mapped once as
+//         persistent and coherent, and split into FRAME_COUNT regions.
+//         Each frame writes its instances, frame block and light cluster
+//         lists straight into the next region and binds them by offset,
+//         so nothing goes through glBufferSubData and the driver never has
+//         to sync on a buffer the GPU still reads.  A fence is placed after
+//         each frame's draws, and a region is only reused once the fence of
+//         the frame that last wrote it has signalled - with three regions
+//         the CPU can be two frames ahead of the GPU before it waits.
+//         Allocate() fails once a frame's region is full, and the caller
+//         then falls back to its own buffer for the rest of the frame.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+/***********************************************************
+ *  FrameRingBuffer
+ *
+ *  This class owns the mapped ring buffer and the fence of
+ *  each of its regions.
+ ***********************************************************/
+class FrameRingBuffer
+{
+public:
+	// regions of the ring, one per frame in flight
+	static const int FRAME_COUNT = 3;
+	// bytes of each region, unless passed to Create()
+	static const GLsizeiptr DEFAULT_FRAME_SIZE = 8 * 1024 * 1024;
+
+	// a range of the current region
+	struct ALLOCATION
+	{
+		// where the CPU writes the data
+		void* pData;
+		// where the GPU reads it, from the start of GetBuffer()
+		GLintptr offset;
+	};
+
+	// constructor
+	FrameRingBuffer();
+	// destructor
+	~FrameRingBuffer();
+
+	// create and map the buffer - false when the driver cannot
+	// make a persistent mapping
+	bool Create(GLsizeiptr frameSize = DEFAULT_FRAME_SIZE);
+
+	// move to the next region, waiting until the GPU has finished
+	// the frame that last used it
+	void BeginFrame();
+	// fence the current region after the frame's last draw
+	void EndFrame();
+
+	// reserve a range of the current region, with its offset a
+	// multiple of the alignment - false when the region is full
+	bool Allocate(GLsizeiptr size, GLsizeiptr alignment, ALLOCATION& allocation);
+
+	// get the buffer the allocations are made in
+	GLuint GetBuffer() const { return(m_buffer); }
+
+private:
+	GLuint m_buffer;
+	unsigned char* m_pMapped;
+	GLsizeiptr m_frameSize;
+	// the region being written and the bytes used of it
+	int m_frameIndex;
+	GLsizeiptr m_usedSize;
+	// fence of the last frame written to each region, 0 for none
+	GLsync m_fences[FRAME_COUNT];
+	// true once a full region has been reported
+	bool m_bOverflowReported;
+};
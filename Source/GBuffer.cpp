@@ -0,0 +1,245 @@
+///////////////////////////////////////////////////////////////////////////////
+// gbuffer.cpp
+// ============
+// hold the geometry buffer render targets of the deferred shading path
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "GBuffer.h"
+#include "RenderStats.h"
+
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	// internal format of each color target, in TARGET order - the
+	// position needs full precision, the normal half precision
+	const GLenum g_TargetFormats[GBuffer::TARGET_COUNT] =
+	{
+		GL_RGBA32F,
+		GL_RGBA16F,
+		GL_RGBA8
+	};
+
+	// sampler names in the lighting shader, in texture unit order
+	const char* g_SamplerNames[GBuffer::TEXTURE_COUNT] =
+	{
+		"gPositionTexture",
+		"gNormalTexture",
+		"gAlbedoTexture",
+		"gDepthTexture"
+	};
+}
+
+/***********************************************************
+ *  GBuffer()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+GBuffer::GBuffer()
+{
+	m_framebuffer = 0;
+	for (int i = 0; i < TARGET_COUNT; i++)
+	{
+		m_targets[i] = 0;
+	}
+	m_depthTexture = 0;
+	m_emptyVertexArray = 0;
+	m_previousFramebuffer = 0;
+	m_width = 0;
+	m_height = 0;
+}
+
+/***********************************************************
+ *  ~GBuffer()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+GBuffer::~GBuffer()
+{
+	Destroy();
+
+	if (m_emptyVertexArray != 0)
+	{
+		glDeleteVertexArrays(1, &m_emptyVertexArray);
+		m_emptyVertexArray = 0;
+	}
+}
+
+/***********************************************************
+ *  Destroy()
+ *
+ *  This method is used for freeing the framebuffer and the
+ *  textures attached to it.
+ ***********************************************************/
+void GBuffer::Destroy()
+{
+	if (m_framebuffer != 0)
+	{
+		glDeleteFramebuffers(1, &m_framebuffer);
+		glDeleteTextures(TARGET_COUNT, m_targets);
+		glDeleteTextures(1, &m_depthTexture);
+		m_framebuffer = 0;
+		for (int i = 0; i < TARGET_COUNT; i++)
+		{
+			m_targets[i] = 0;
+		}
+		m_depthTexture = 0;
+	}
+	m_width = 0;
+	m_height = 0;
+}
+
+/***********************************************************
+ *  Resize()
+ *
+ *  This method is used for creating the framebuffer and
+ *  its targets at the size of the viewport.  Nothing is
+ *  done while the size stays the same.
+ ***********************************************************/
+bool GBuffer::Resize(int width, int height)
+{
+	if ((width <= 0) || (height <= 0))
+	{
+		return(false);
+	}
+	if ((m_framebuffer != 0) && (width == m_width) && (height == m_height))
+	{
+		return(true);
+	}
+
+	Destroy();
+
+	if (m_emptyVertexArray == 0)
+	{
+		glGenVertexArrays(1, &m_emptyVertexArray);
+	}
+
+	GLint previousFramebuffer = 0;
+	glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFramebuffer);
+
+	glGenFramebuffers(1, &m_framebuffer);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_framebuffer);
+
+	// every target is read back one texel per pixel, so
+	// no filtering or mipmaps are needed
+	glGenTextures(TARGET_COUNT, m_targets);
+	GLenum drawBuffers[TARGET_COUNT];
+	for (int i = 0; i < TARGET_COUNT; i++)
+	{
+		glBindTexture(GL_TEXTURE_2D, m_targets[i]);
+		glTexStorage2D(GL_TEXTURE_2D, 1, g_TargetFormats[i], width, height);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, GL_TEXTURE_2D, m_targets[i], 0);
+		drawBuffers[i] = GL_COLOR_ATTACHMENT0 + i;
+	}
+	glDrawBuffers(TARGET_COUNT, drawBuffers);
+
+	glGenTextures(1, &m_depthTexture);
+	glBindTexture(GL_TEXTURE_2D, m_depthTexture);
+	glTexStorage2D(GL_TEXTURE_2D, 1, GL_DEPTH_COMPONENT24, width, height);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_depthTexture, 0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	GLenum status = glCheckFramebufferStatus(GL_DRAW_FRAMEBUFFER);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, previousFramebuffer);
+
+	if (status != GL_FRAMEBUFFER_COMPLETE)
+	{
+		std::cout << "G-buffer framebuffer is incomplete, status: " << status << std::endl;
+		Destroy();
+		return(false);
+	}
+
+	m_width = width;
+	m_height = height;
+	return(true);
+}
+
+/***********************************************************
+ *  BindForGeometry()
+ *
+ *  This method is used for drawing the geometry pass into
+ *  the G-buffer.  The framebuffer that was bound is kept,
+ *  so Unbind() can return to it.
+ ***********************************************************/
+void GBuffer::BindForGeometry()
+{
+	glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &m_previousFramebuffer);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_framebuffer);
+
+	// the lighting pass skips pixels left at the far depth, so
+	// the color targets do not need a particular clear value
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+}
+
+/***********************************************************
+ *  Unbind()
+ *
+ *  This method is used for binding back the framebuffer
+ *  that was bound before the geometry pass.
+ ***********************************************************/
+void GBuffer::Unbind()
+{
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_previousFramebuffer);
+}
+
+/***********************************************************
+ *  BindTextures()
+ *
+ *  This method is used for binding the targets and the
+ *  depth texture to consecutive texture units for the
+ *  lighting pass.
+ ***********************************************************/
+void GBuffer::BindTextures(int firstUnit) const
+{
+	for (int i = 0; i < TARGET_COUNT; i++)
+	{
+		glActiveTexture(GL_TEXTURE0 + firstUnit + i);
+		glBindTexture(GL_TEXTURE_2D, m_targets[i]);
+	}
+	glActiveTexture(GL_TEXTURE0 + firstUnit + TARGET_COUNT);
+	glBindTexture(GL_TEXTURE_2D, m_depthTexture);
+	glActiveTexture(GL_TEXTURE0);
+
+	RenderStats::Add(RenderStats::COUNTER_TEXTURE_BINDS, TARGET_COUNT + 1);
+}
+
+/***********************************************************
+ *  DrawFullScreenTriangle()
+ *
+ *  This method is used for drawing the lighting pass.  The
+ *  vertex shader places the three corners from gl_VertexID.
+ ***********************************************************/
+void GBuffer::DrawFullScreenTriangle() const
+{
+	glBindVertexArray(m_emptyVertexArray);
+	glDrawArrays(GL_TRIANGLES, 0, 3);
+	glBindVertexArray(0);
+
+	RenderStats::Add(RenderStats::COUNTER_DRAW_CALLS);
+	RenderStats::Add(RenderStats::COUNTER_TRIANGLES);
+}
+
+/***********************************************************
+ *  SetSamplerUnits()
+ *
+ *  This method is used for setting the G-buffer sampler
+ *  uniforms of a linked lighting program, once after it
+ *  has been linked.
+ ***********************************************************/
+void GBuffer::SetSamplerUnits(GLuint programID, int firstUnit)
+{
+	glUseProgram(programID);
+	RenderStats::Add(RenderStats::COUNTER_PROGRAM_BINDS);
+	for (int i = 0; i < TEXTURE_COUNT; i++)
+	{
+		glUniform1i(glGetUniformLocation(programID, g_SamplerNames[i]), firstUnit + i);
+	}
+}
@@ -0,0 +1,77 @@
+///////////////////////////////////////////////////////////////////////////////
+// gbuffer.h
+// ============
+// hold the geometry buffer render targets of the deferred shading path
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+//  Notes: The deferred geometry pass writes the world position, normal,
+//         material and albedo of the nearest opaque surface of every
+//         pixel into these targets, without any lighting.  The lighting
+//         pass then reads them back with one full screen triangle, so
+//         each pixel is lit once however many surfaces were drawn over
+//         it.  The targets follow the size of the viewport.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+/***********************************************************
+ *  GBuffer
+ *
+ *  This class owns the framebuffer of the deferred geometry
+ *  pass along with its color and depth textures.
+ ***********************************************************/
+class GBuffer
+{
+public:
+	// color targets, in fragment shader output location order
+	enum TARGET
+	{
+		TARGET_POSITION = 0,   // world position
+		TARGET_NORMAL,         // world normal, material index in .w
+		TARGET_ALBEDO,         // surface color and alpha
+		TARGET_COUNT
+	};
+
+	// textures the lighting pass samples - the targets and the depth
+	static const int TEXTURE_COUNT = TARGET_COUNT + 1;
+
+	// constructor
+	GBuffer();
+	// destructor
+	~GBuffer();
+
+	// create the targets for a viewport size - they are only
+	// rebuilt when the size changes, false when incomplete
+	bool Resize(int width, int height);
+	// bind the framebuffer and clear it for the geometry pass
+	void BindForGeometry();
+	// bind back the framebuffer that was bound before
+	void Unbind();
+	// bind the targets and the depth to TEXTURE_COUNT texture
+	// units, starting at firstUnit
+	void BindTextures(int firstUnit) const;
+	// draw one triangle that covers the viewport
+	void DrawFullScreenTriangle() const;
+
+	// point the G-buffer samplers of a lighting program at the
+	// texture units used by BindTextures()
+	static void SetSamplerUnits(GLuint programID, int firstUnit);
+
+private:
+	GLuint m_framebuffer;
+	GLuint m_targets[TARGET_COUNT];
+	GLuint m_depthTexture;
+	// the full screen triangle has no vertex attributes, but a
+	// core context still needs a vertex array bound
+	GLuint m_emptyVertexArray;
+	// framebuffer bound before BindForGeometry()
+	GLint m_previousFramebuffer;
+	int m_width;
+	int m_height;
+
+	// free the framebuffer and its textures
+	void Destroy();
+};
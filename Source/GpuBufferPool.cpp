@@ -0,0 +1,301 @@
+///////////////////////////////////////////////////////////////////////////////
+// gpubufferpool.cpp
+// ============
+// hand out aligned ranges of a few large buffers for the long lived uniform
+// and storage blocks
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "GpuBufferPool.h"
+#include "RenderStats.h"
+
+#include <algorithm>
+#include <iostream>
+
+/***********************************************************
+ *  GpuBufferPool()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+GpuBufferPool::GpuBufferPool()
+{
+	m_alignment = GetOffsetAlignment();
+	m_usedBytes = 0;
+}
+
+/***********************************************************
+ *  ~GpuBufferPool()
+ *
+ *  The destructor for the class - the blocks free their
+ *  buffers.
+ ***********************************************************/
+GpuBufferPool::~GpuBufferPool()
+{
+	GpuResources::AddPooled(-(long long)m_usedBytes);
+	m_usedBytes = 0;
+}
+
+/***********************************************************
+ *  GetEmptyAllocation()
+ *
+ *  This method is used for getting an allocation that
+ *  holds no range.
+ ***********************************************************/
+GpuBufferPool::POOL_ALLOCATION GpuBufferPool::GetEmptyAllocation()
+{
+	POOL_ALLOCATION allocation;
+	allocation.buffer = 0;
+	allocation.offset = 0;
+	allocation.size = 0;
+	allocation.block = -1;
+
+	return(allocation);
+}
+
+/***********************************************************
+ *  GetOffsetAlignment()
+ *
+ *  This method is used for getting the offset alignment a
+ *  range needs to be bound as a uniform block, or as a
+ *  storage block where those are supported.
+ ***********************************************************/
+GLint GpuBufferPool::GetOffsetAlignment()
+{
+	GLint alignment = 256;
+	glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+
+	if (GLEW_VERSION_4_3)
+	{
+		GLint storageAlignment = 256;
+		glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &storageAlignment);
+		alignment = std::max(alignment, storageAlignment);
+	}
+
+	return(std::max(alignment, 1));
+}
+
+/***********************************************************
+ *  Allocate()
+ *
+ *  This method is used for getting a range from the first
+ *  block with room for it.  The size is rounded up to the
+ *  alignment, so every free range stays aligned.
+ ***********************************************************/
+bool GpuBufferPool::Allocate(GLsizeiptr size, POOL_ALLOCATION& allocation)
+{
+	GLsizeiptr alignedSize = ((std::max(size, (GLsizeiptr)1) + m_alignment - 1) / m_alignment) * m_alignment;
+
+	GLintptr offset = 0;
+	int blockIndex = -1;
+	for (int i = 0; (i < m_blocks.size()) && (blockIndex < 0); i++)
+	{
+		if ((m_blocks[i].buffer.GetName() != 0) && (TakeRange(m_blocks[i], alignedSize, offset) == true))
+		{
+			blockIndex = i;
+		}
+	}
+
+	if (blockIndex < 0)
+	{
+		blockIndex = CreateBlock(alignedSize);
+		if ((blockIndex < 0) || (TakeRange(m_blocks[blockIndex], alignedSize, offset) == false))
+		{
+			return(false);
+		}
+	}
+
+	BLOCK& block = m_blocks[blockIndex];
+	block.usedBytes += alignedSize;
+	m_usedBytes += alignedSize;
+	GpuResources::AddPooled(alignedSize);
+
+	allocation.buffer = block.buffer.GetName();
+	allocation.offset = offset;
+	allocation.size = alignedSize;
+	allocation.block = blockIndex;
+
+	return(true);
+}
+
+/***********************************************************
+ *  TakeRange()
+ *
+ *  This method is used for cutting a range off the front
+ *  of the first free range of a block that is big enough.
+ ***********************************************************/
+bool GpuBufferPool::TakeRange(BLOCK& block, GLsizeiptr size, GLintptr& offset)
+{
+	for (int i = 0; i < block.freeRanges.size(); i++)
+	{
+		FREE_RANGE& range = block.freeRanges[i];
+		if (range.size < size)
+		{
+			continue;
+		}
+
+		offset = range.offset;
+		range.offset += size;
+		range.size -= size;
+		if (range.size == 0)
+		{
+			block.freeRanges.erase(block.freeRanges.begin() + i);
+		}
+		return(true);
+	}
+
+	return(false);
+}
+
+/***********************************************************
+ *  CreateBlock()
+ *
+ *  This method is used for creating a block buffer in the
+ *  first deleted slot, or a new one.
+ ***********************************************************/
+int GpuBufferPool::CreateBlock(GLsizeiptr size)
+{
+	GLsizeiptr blockSize = (size > BLOCK_SIZE) ? size : BLOCK_SIZE;
+
+	int blockIndex = -1;
+	for (int i = 0; (i < m_blocks.size()) && (blockIndex < 0); i++)
+	{
+		if (m_blocks[i].buffer.GetName() == 0)
+		{
+			blockIndex = i;
+		}
+	}
+	if (blockIndex < 0)
+	{
+		m_blocks.push_back(BLOCK());
+		blockIndex = (int)m_blocks.size() - 1;
+	}
+
+	GLuint buffer = 0;
+	glGenBuffers(1, &buffer);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+	glBufferData(GL_COPY_WRITE_BUFFER, blockSize, NULL, GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	if (buffer == 0)
+	{
+		std::cout << "Could not create a pooled buffer block of " << blockSize << " bytes" << std::endl;
+		return(-1);
+	}
+
+	BLOCK& block = m_blocks[blockIndex];
+	block.buffer.Reset(buffer, blockSize);
+	block.size = blockSize;
+	block.usedBytes = 0;
+	block.freeRanges.clear();
+	FREE_RANGE range;
+	range.offset = 0;
+	range.size = blockSize;
+	block.freeRanges.push_back(range);
+
+	return(blockIndex);
+}
+
+/***********************************************************
+ *  Free()
+ *
+ *  This method is used for returning a range to the free
+ *  ranges of its block, merged with the ones it touches.
+ *  A block other than the first is deleted once nothing is
+ *  left in it.
+ ***********************************************************/
+void GpuBufferPool::Free(POOL_ALLOCATION& allocation)
+{
+	if ((allocation.block < 0) || (allocation.block >= m_blocks.size()))
+	{
+		allocation = GetEmptyAllocation();
+		return;
+	}
+
+	BLOCK& block = m_blocks[allocation.block];
+
+	// the first free range past the freed one
+	int next = 0;
+	while ((next < block.freeRanges.size()) && (block.freeRanges[next].offset < allocation.offset))
+	{
+		next++;
+	}
+
+	FREE_RANGE range;
+	range.offset = allocation.offset;
+	range.size = allocation.size;
+	block.freeRanges.insert(block.freeRanges.begin() + next, range);
+
+	if ((next + 1 < block.freeRanges.size()) &&
+		(block.freeRanges[next].offset + block.freeRanges[next].size == block.freeRanges[next + 1].offset))
+	{
+		block.freeRanges[next].size += block.freeRanges[next + 1].size;
+		block.freeRanges.erase(block.freeRanges.begin() + next + 1);
+	}
+	if ((next > 0) &&
+		(block.freeRanges[next - 1].offset + block.freeRanges[next - 1].size == block.freeRanges[next].offset))
+	{
+		block.freeRanges[next - 1].size += block.freeRanges[next].size;
+		block.freeRanges.erase(block.freeRanges.begin() + next);
+	}
+
+	block.usedBytes -= allocation.size;
+	m_usedBytes -= allocation.size;
+	GpuResources::AddPooled(-(long long)allocation.size);
+
+	if ((block.usedBytes == 0) && (allocation.block > 0))
+	{
+		block.buffer.Reset();
+		block.size = 0;
+		block.freeRanges.clear();
+	}
+
+	allocation = GetEmptyAllocation();
+}
+
+/***********************************************************
+ *  Upload()
+ *
+ *  This method is used for copying data into part of a
+ *  range.
+ ***********************************************************/
+void GpuBufferPool::Upload(const POOL_ALLOCATION& allocation, GLintptr offset, GLsizeiptr size, const void* pData) const
+{
+	if ((allocation.buffer == 0) || (offset + size > allocation.size))
+	{
+		return;
+	}
+
+	glBindBuffer(GL_COPY_WRITE_BUFFER, allocation.buffer);
+	glBufferSubData(GL_COPY_WRITE_BUFFER, allocation.offset + offset, size, pData);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	RenderStats::Add(RenderStats::COUNTER_BYTES_UPLOADED, size);
+}
+
+/***********************************************************
+ *  BindRange()
+ *
+ *  This method is used for binding a whole range to an
+ *  indexed uniform or storage block binding.
+ ***********************************************************/
+void GpuBufferPool::BindRange(GLenum target, GLuint index, const POOL_ALLOCATION& allocation)
+{
+	glBindBufferRange(target, index, allocation.buffer, allocation.offset, allocation.size);
+}
+
+/***********************************************************
+ *  GetReservedBytes()
+ *
+ *  This method is used for getting the bytes of every live
+ *  block, used or not.
+ ***********************************************************/
+GLsizeiptr GpuBufferPool::GetReservedBytes() const
+{
+	GLsizeiptr reservedBytes = 0;
+	for (int i = 0; i < m_blocks.size(); i++)
+	{
+		reservedBytes += m_blocks[i].size;
+	}
+
+	return(reservedBytes);
+}
@@ -0,0 +1,108 @@
+///////////////////////////////////////////////////////////////////////////////
+// gpubufferpool.h
+// ============
+// hand out aligned ranges of a few large buffers for the long lived uniform
+// and storage blocks
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+//  Notes: Each block is one buffer of BLOCK_SIZE bytes, or the size of a
+//         single larger request.  Allocate() takes the first free range
+//         of a block that fits, aligned for binding as a uniform or a
+//         storage block, and only creates a new block when none does.
+//         Free() hands the range back and merges it with its free
+//         neighbours, and a block left empty is deleted - except the
+//         first - so a block only stays while something lives in it.  A
+//         range that must grow is freed and allocated again, which the
+//         merging turns back into one range when it was the last thing in
+//         its block.  The per-frame data does not come from here - it is
+//         written into the FrameRingBuffer.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "GpuResources.h"
+
+#include <GL/glew.h>
+
+#include <vector>
+
+/***********************************************************
+ *  GpuBufferPool
+ *
+ *  This class owns the pooled buffer blocks and the free
+ *  ranges of each.
+ ***********************************************************/
+class GpuBufferPool
+{
+public:
+	// bytes of each block, unless a request is larger
+	static const GLsizeiptr BLOCK_SIZE = 1024 * 1024;
+
+	// a range of one block
+	struct POOL_ALLOCATION
+	{
+		GLuint buffer;
+		GLintptr offset;
+		GLsizeiptr size;
+		// index of the block, -1 while nothing is allocated
+		int block;
+	};
+
+	// constructor
+	GpuBufferPool();
+	// destructor
+	~GpuBufferPool();
+
+	// get an empty allocation to pass to Allocate()
+	static POOL_ALLOCATION GetEmptyAllocation();
+
+	// get an aligned range of a block - the allocation must be
+	// empty, false when no block can be created
+	bool Allocate(GLsizeiptr size, POOL_ALLOCATION& allocation);
+	// hand a range back and empty the allocation
+	void Free(POOL_ALLOCATION& allocation);
+
+	// copy data into a range, at an offset from its start
+	void Upload(const POOL_ALLOCATION& allocation, GLintptr offset, GLsizeiptr size, const void* pData) const;
+	// bind a range to an indexed uniform or storage block binding
+	static void BindRange(GLenum target, GLuint index, const POOL_ALLOCATION& allocation);
+
+	// get the bytes of every block, and the bytes handed out
+	GLsizeiptr GetReservedBytes() const;
+	GLsizeiptr GetUsedBytes() const { return(m_usedBytes); }
+
+private:
+	// an unused range of a block
+	struct FREE_RANGE
+	{
+		GLintptr offset;
+		GLsizeiptr size;
+	};
+
+	struct BLOCK
+	{
+		GpuResource buffer;
+		GLsizeiptr size;
+		GLsizeiptr usedBytes;
+		// in offset order, never touching each other
+		std::vector<FREE_RANGE> freeRanges;
+
+		BLOCK() : buffer(GpuResource::RESOURCE_BUFFER), size(0), usedBytes(0) {}
+	};
+
+	// deleted blocks keep their slot, so the block index of the
+	// live allocations never changes
+	std::vector<BLOCK> m_blocks;
+	// offset alignment every range starts on
+	GLint m_alignment;
+	GLsizeiptr m_usedBytes;
+
+	// get the alignment of the uniform and storage block bindings
+	static GLint GetOffsetAlignment();
+	// create a block of at least a size in a free slot
+	int CreateBlock(GLsizeiptr size);
+	// take an aligned range out of a block's free ranges - false
+	// when none fits
+	bool TakeRange(BLOCK& block, GLsizeiptr size, GLintptr& offset);
+};
@@ -0,0 +1,277 @@
+///////////////////////////////////////////////////////////////////////////////
+// gpuresources.cpp
+// ============
+// own the OpenGL textures, buffers and programs and keep a tally of the
+// memory they hold
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "GpuResources.h"
+
+#include <cstdio>
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	// resource kind names, in RESOURCE_KIND order
+	const char* g_KindNames[GpuResource::RESOURCE_KIND_COUNT] =
+	{
+		"textures",
+		"buffers",
+		"programs"
+	};
+
+	/***********************************************************
+	 *  FormatMegabytes()
+	 *
+	 *  Get a byte count as megabytes with one decimal.
+	 ***********************************************************/
+	std::string FormatMegabytes(long long bytes)
+	{
+		char text[32];
+		std::snprintf(text, sizeof(text), "%.1f MB", (double)bytes / (1024.0 * 1024.0));
+		return(std::string(text));
+	}
+}
+
+int GpuResources::s_counts[GpuResource::RESOURCE_KIND_COUNT] = { 0 };
+long long GpuResources::s_bytes[GpuResource::RESOURCE_KIND_COUNT] = { 0 };
+long long GpuResources::s_pooledBytes = 0;
+long long GpuResources::s_budget = GpuResources::DEFAULT_BUDGET;
+bool GpuResources::s_bOverBudget = false;
+
+/***********************************************************
+ *  GpuResource()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+GpuResource::GpuResource(RESOURCE_KIND kind)
+{
+	m_kind = kind;
+	m_name = 0;
+	m_bytes = 0;
+}
+
+/***********************************************************
+ *  ~GpuResource()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+GpuResource::~GpuResource()
+{
+	Reset();
+}
+
+/***********************************************************
+ *  GpuResource(GpuResource&&)
+ *
+ *  The move constructor for the class - the other resource
+ *  is left empty.
+ ***********************************************************/
+GpuResource::GpuResource(GpuResource&& other)
+{
+	m_kind = other.m_kind;
+	m_name = other.m_name;
+	m_bytes = other.m_bytes;
+	other.m_name = 0;
+	other.m_bytes = 0;
+}
+
+/***********************************************************
+ *  operator=(GpuResource&&)
+ *
+ *  This method is used for freeing the owned object and
+ *  taking over the other resource's.
+ ***********************************************************/
+GpuResource& GpuResource::operator=(GpuResource&& other)
+{
+	if (this != &other)
+	{
+		Reset();
+		m_kind = other.m_kind;
+		m_name = other.m_name;
+		m_bytes = other.m_bytes;
+		other.m_name = 0;
+		other.m_bytes = 0;
+	}
+
+	return(*this);
+}
+
+/***********************************************************
+ *  Reset()
+ *
+ *  This method is used for deleting the owned object and
+ *  taking ownership of a new one.  A bindless handle of a
+ *  deleted texture goes with it, so it needs no separate
+ *  release.
+ ***********************************************************/
+void GpuResource::Reset(GLuint name, long long bytes)
+{
+	if (m_name != 0)
+	{
+		if (m_kind == RESOURCE_TEXTURE)
+		{
+			glDeleteTextures(1, &m_name);
+		}
+		else if (m_kind == RESOURCE_BUFFER)
+		{
+			glDeleteBuffers(1, &m_name);
+		}
+		else
+		{
+			glDeleteProgram(m_name);
+		}
+		GpuResources::Remove(m_kind, m_bytes);
+	}
+
+	m_name = name;
+	m_bytes = (name != 0) ? bytes : 0;
+	if (m_name != 0)
+	{
+		GpuResources::Add(m_kind, m_bytes);
+	}
+}
+
+/***********************************************************
+ *  Release()
+ *
+ *  This method is used for giving up the owned object
+ *  without deleting it.  It leaves the tally as well.
+ ***********************************************************/
+GLuint GpuResource::Release()
+{
+	GLuint name = m_name;
+	if (m_name != 0)
+	{
+		GpuResources::Remove(m_kind, m_bytes);
+	}
+	m_name = 0;
+	m_bytes = 0;
+
+	return(name);
+}
+
+/***********************************************************
+ *  Add()
+ *
+ *  This method is used for counting a new resource into
+ *  the tally.  The first time the tally goes past the
+ *  budget a warning is written.
+ ***********************************************************/
+void GpuResources::Add(GpuResource::RESOURCE_KIND kind, long long bytes)
+{
+	s_counts[kind]++;
+	s_bytes[kind] += bytes;
+
+	long long totalBytes = GetTotalBytes();
+	if ((totalBytes > s_budget) && (s_bOverBudget == false))
+	{
+		std::cout << "GPU resources are over budget: " << FormatMegabytes(totalBytes)
+			<< " of " << FormatMegabytes(s_budget) << std::endl;
+		s_bOverBudget = true;
+	}
+}
+
+/***********************************************************
+ *  Remove()
+ *
+ *  This method is used for counting a freed resource out
+ *  of the tally.
+ ***********************************************************/
+void GpuResources::Remove(GpuResource::RESOURCE_KIND kind, long long bytes)
+{
+	s_counts[kind]--;
+	s_bytes[kind] -= bytes;
+
+	if (GetTotalBytes() <= s_budget)
+	{
+		s_bOverBudget = false;
+	}
+}
+
+/***********************************************************
+ *  SetBudget()
+ *
+ *  This method is used for setting the bytes the live
+ *  resources may hold before the warning.
+ ***********************************************************/
+void GpuResources::SetBudget(long long bytes)
+{
+	s_budget = bytes;
+	s_bOverBudget = (GetTotalBytes() > s_budget);
+}
+
+/***********************************************************
+ *  GetTotalBytes()
+ *
+ *  This method is used for getting the bytes held by every
+ *  live resource.
+ ***********************************************************/
+long long GpuResources::GetTotalBytes()
+{
+	long long totalBytes = 0;
+	for (int i = 0; i < GpuResource::RESOURCE_KIND_COUNT; i++)
+	{
+		totalBytes += s_bytes[i];
+	}
+
+	return(totalBytes);
+}
+
+/***********************************************************
+ *  GetDriverFreeKilobytes()
+ *
+ *  This method is used for asking the driver how much video
+ *  memory it has free, through whichever memory info
+ *  extension it has, in kilobytes.  The first of the four
+ *  values of the ATI query is the total free.
+ ***********************************************************/
+long long GpuResources::GetDriverFreeKilobytes()
+{
+	if (GLEW_NVX_gpu_memory_info)
+	{
+		GLint kilobytes = 0;
+		glGetIntegerv(GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX, &kilobytes);
+		return(kilobytes);
+	}
+	if (GLEW_ATI_meminfo)
+	{
+		GLint values[4] = { 0, 0, 0, 0 };
+		glGetIntegerv(GL_TEXTURE_FREE_MEMORY_ATI, values);
+		return(values[0]);
+	}
+
+	return(-1);
+}
+
+/***********************************************************
+ *  GetSummary()
+ *
+ *  This method is used for getting the count and bytes of
+ *  each kind, the pooled bytes in use and the budget as
+ *  one line of text.
+ ***********************************************************/
+std::string GpuResources::GetSummary()
+{
+	std::string summary;
+
+	for (int i = 0; i < GpuResource::RESOURCE_KIND_COUNT; i++)
+	{
+		summary += std::string(g_KindNames[i]) + " " + std::to_string(s_counts[i]) +
+			" (" + FormatMegabytes(s_bytes[i]) + "), ";
+	}
+	summary += "pooled " + FormatMegabytes(s_pooledBytes) + ", total " +
+		FormatMegabytes(GetTotalBytes()) + " of " + FormatMegabytes(s_budget);
+
+	long long freeKilobytes = GetDriverFreeKilobytes();
+	if (freeKilobytes >= 0)
+	{
+		summary += ", driver free " + FormatMegabytes(freeKilobytes * 1024);
+	}
+
+	return(summary);
+}
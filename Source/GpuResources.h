@@ -0,0 +1,120 @@
+///////////////////////////////////////////////////////////////////////////////
+// gpuresources.h
+// ============
+// own the OpenGL textures, buffers and programs and keep a tally of the
+// memory they hold
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+//  Notes: A GpuResource deletes its OpenGL object when it goes out of
+//         scope or is given a new one, so a texture the hot reload swaps
+//         out, a rebuilt program or a regrown buffer is freed the moment
+//         it is replaced instead of waiting on a matching delete call.
+//         It can be moved but not copied, which leaves exactly one owner
+//         for each object.  Every live resource is counted here by kind
+//         together with the bytes it was created with, so the totals can
+//         be watched against a budget over a long session - they must
+//         level off once the scene is in, however often it reloads.  When
+//         the driver has GL_NVX_gpu_memory_info or GL_ATI_meminfo, the
+//         video memory it still has free is reported along with them.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <string>
+
+/***********************************************************
+ *  GpuResource
+ *
+ *  This class owns one OpenGL texture, buffer or program.
+ ***********************************************************/
+class GpuResource
+{
+public:
+	// kinds of OpenGL objects a resource can own
+	enum RESOURCE_KIND
+	{
+		RESOURCE_TEXTURE = 0,
+		RESOURCE_BUFFER,
+		RESOURCE_PROGRAM,
+		RESOURCE_KIND_COUNT
+	};
+
+	// constructor
+	GpuResource(RESOURCE_KIND kind);
+	// destructor
+	~GpuResource();
+
+	// take over the object of another resource of the same kind -
+	// a resource has a single owner, so it cannot be copied
+	GpuResource(GpuResource&& other);
+	GpuResource& operator=(GpuResource&& other);
+	GpuResource(const GpuResource&) = delete;
+	GpuResource& operator=(const GpuResource&) = delete;
+
+	// free the owned object, if any, and take a new one that
+	// holds the given bytes - no name just frees it
+	void Reset(GLuint name = 0, long long bytes = 0);
+	// hand the owned object back to the caller without freeing it
+	GLuint Release();
+
+	// get the owned object, 0 for none
+	GLuint GetName() const { return(m_name); }
+	// get the bytes the owned object was created with
+	long long GetBytes() const { return(m_bytes); }
+	RESOURCE_KIND GetKind() const { return(m_kind); }
+
+private:
+	RESOURCE_KIND m_kind;
+	GLuint m_name;
+	long long m_bytes;
+};
+
+/***********************************************************
+ *  GpuResources
+ *
+ *  This class holds the tally of the live resources.  They
+ *  are shared by the whole renderer, so the methods are
+ *  static.
+ ***********************************************************/
+class GpuResources
+{
+public:
+	// bytes the live resources may hold before a warning, unless
+	// changed with SetBudget()
+	static const long long DEFAULT_BUDGET = 256LL * 1024 * 1024;
+
+	// count a resource in or out of the tally - called by
+	// GpuResource as it takes and frees its objects
+	static void Add(GpuResource::RESOURCE_KIND kind, long long bytes);
+	static void Remove(GpuResource::RESOURCE_KIND kind, long long bytes);
+	// count bytes of the GpuBufferPool blocks handed out, or
+	// given back when negative
+	static void AddPooled(long long bytes) { s_pooledBytes += bytes; }
+
+	// set the bytes the live resources may hold
+	static void SetBudget(long long bytes);
+
+	// get the live resources of a kind and the bytes they hold
+	static int GetCount(GpuResource::RESOURCE_KIND kind) { return(s_counts[kind]); }
+	static long long GetBytes(GpuResource::RESOURCE_KIND kind) { return(s_bytes[kind]); }
+	// get the bytes held by every live resource
+	static long long GetTotalBytes();
+	// get the kilobytes of video memory the driver has free, -1
+	// when it does not say
+	static long long GetDriverFreeKilobytes();
+	// get the tally and the budget as one line of text
+	static std::string GetSummary();
+
+private:
+	static int s_counts[GpuResource::RESOURCE_KIND_COUNT];
+	static long long s_bytes[GpuResource::RESOURCE_KIND_COUNT];
+	// bytes of the pooled buffer blocks that are handed out
+	static long long s_pooledBytes;
+	static long long s_budget;
+	// true once the budget warning has been written, until the
+	// tally is back under it
+	static bool s_bOverBudget;
+};
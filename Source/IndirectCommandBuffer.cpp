@@ -0,0 +1,154 @@
+///////////////////////////////////////////////////////////////////////////////
+// indirectcommandbuffer.cpp
+// ============
+// keep the draw commands and per-draw values of the multi-draw indirect path
+// in GPU buffers
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "IndirectCommandBuffer.h"
+#include "RenderStats.h"
+
+/***********************************************************
+ *  IndirectCommandBuffer()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+IndirectCommandBuffer::IndirectCommandBuffer()
+{
+	m_commandBuffer = 0;
+	m_drawDataBuffer = 0;
+	m_capacity = 0;
+}
+
+/***********************************************************
+ *  ~IndirectCommandBuffer()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+IndirectCommandBuffer::~IndirectCommandBuffer()
+{
+	if (m_commandBuffer != 0)
+	{
+		glDeleteBuffers(1, &m_commandBuffer);
+		glDeleteBuffers(1, &m_drawDataBuffer);
+	}
+}
+
+/***********************************************************
+ *  Clear()
+ *
+ *  This method is used for removing all of the draws.  The
+ *  GPU buffers are kept for the next Upload().
+ ***********************************************************/
+void IndirectCommandBuffer::Clear()
+{
+	m_commands.clear();
+	m_drawData.clear();
+}
+
+/***********************************************************
+ *  AddDraw()
+ *
+ *  This method is used for adding one draw of a mesh.  The
+ *  command index is also the gl_DrawID offset of the draw
+ *  data.
+ ***********************************************************/
+int IndirectCommandBuffer::AddDraw(
+	const MeshBuffers::MESH_RANGE& mesh,
+	const MeshBuffers::INSTANCE_DATA& drawData)
+{
+	DRAW_COMMAND command;
+
+	command.count = mesh.indexCount;
+	command.instanceCount = 1;
+	command.firstIndex = mesh.firstIndex;
+	command.baseVertex = mesh.baseVertex;
+	command.baseInstance = 0;
+
+	m_commands.push_back(command);
+	m_drawData.push_back(drawData);
+
+	return((int)m_commands.size() - 1);
+}
+
+/***********************************************************
+ *  Upload()
+ *
+ *  This method is used for copying the draws into the GPU
+ *  buffers.  The buffers use immutable storage, so they are
+ *  only remade when the draws outgrow them.
+ ***********************************************************/
+void IndirectCommandBuffer::Upload()
+{
+	int commandCount = (int)m_commands.size();
+	if (commandCount == 0)
+	{
+		return;
+	}
+
+	if (commandCount > m_capacity)
+	{
+		if (m_commandBuffer != 0)
+		{
+			glDeleteBuffers(1, &m_commandBuffer);
+			glDeleteBuffers(1, &m_drawDataBuffer);
+		}
+
+		// leave room to grow without remaking the buffers
+		m_capacity = commandCount + commandCount / 2;
+
+		glGenBuffers(1, &m_commandBuffer);
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_commandBuffer);
+		glBufferStorage(GL_DRAW_INDIRECT_BUFFER, sizeof(DRAW_COMMAND) * m_capacity, NULL, GL_DYNAMIC_STORAGE_BIT);
+
+		glGenBuffers(1, &m_drawDataBuffer);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_drawDataBuffer);
+		glBufferStorage(GL_SHADER_STORAGE_BUFFER, sizeof(MeshBuffers::INSTANCE_DATA) * m_capacity, NULL, GL_DYNAMIC_STORAGE_BIT);
+	}
+
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_commandBuffer);
+	glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, sizeof(DRAW_COMMAND) * commandCount, m_commands.data());
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_drawDataBuffer);
+	glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(MeshBuffers::INSTANCE_DATA) * commandCount, m_drawData.data());
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+	RenderStats::Add(
+		RenderStats::COUNTER_BYTES_UPLOADED,
+		(sizeof(DRAW_COMMAND) + sizeof(MeshBuffers::INSTANCE_DATA)) * commandCount);
+}
+
+/***********************************************************
+ *  CountTriangles()
+ *
+ *  This method is used for adding up the triangles of a
+ *  run of the commands, for the render statistics.
+ ***********************************************************/
+long long IndirectCommandBuffer::CountTriangles(int firstCommand, int commandCount) const
+{
+	long long triangles = 0;
+
+	for (int i = firstCommand; i < firstCommand + commandCount; i++)
+	{
+		triangles += (long long)(m_commands[i].count / 3) * m_commands[i].instanceCount;
+	}
+
+	return(triangles);
+}
+
+/***********************************************************
+ *  Bind()
+ *
+ *  This method is used for binding the command buffer for
+ *  the indirect draws and the draw data buffer for the
+ *  vertex shader.
+ ***********************************************************/
+void IndirectCommandBuffer::Bind() const
+{
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_commandBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, DRAW_DATA_BINDING, m_drawDataBuffer);
+}
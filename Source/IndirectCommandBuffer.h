@@ -0,0 +1,73 @@
+///////////////////////////////////////////////////////////////////////////////
+// indirectcommandbuffer.h
+// ============
+// keep the draw commands and per-draw values of the multi-draw indirect path
+// in GPU buffers
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+//  Notes: Each draw is one DrawElementsIndirectCommand into the shared mesh
+//         buffers plus one entry in a shader storage buffer that the vertex
+//         shader reads with gl_DrawID.  The buffers persist between frames
+//         and are only refilled when the scene changes.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "MeshBuffers.h"
+
+#include <GL/glew.h>
+
+#include <vector>
+
+/***********************************************************
+ *  IndirectCommandBuffer
+ *
+ *  This class holds the command buffer and the draw data
+ *  storage buffer of the indirect draws.
+ ***********************************************************/
+class IndirectCommandBuffer
+{
+public:
+	// storage buffer binding point of the DrawBlock in vertexShader.glsl
+	static const GLuint DRAW_DATA_BINDING = 0;
+
+	// the layout glMultiDrawElementsIndirect reads
+	struct DRAW_COMMAND
+	{
+		GLuint count;
+		GLuint instanceCount;
+		GLuint firstIndex;
+		GLint baseVertex;
+		GLuint baseInstance;
+	};
+
+	// constructor
+	IndirectCommandBuffer();
+	// destructor
+	~IndirectCommandBuffer();
+
+	// remove all of the draws
+	void Clear();
+	// add a draw of a mesh and return its command index
+	int AddDraw(
+		const MeshBuffers::MESH_RANGE& mesh,
+		const MeshBuffers::INSTANCE_DATA& drawData);
+	// copy the draws into the GPU buffers
+	void Upload();
+	// bind the command buffer and the draw data buffer
+	void Bind() const;
+
+	// get the number of draws
+	int GetCommandCount() const { return((int)m_commands.size()); }
+	// get the number of triangles drawn by a run of the commands
+	long long CountTriangles(int firstCommand, int commandCount) const;
+
+private:
+	std::vector<DRAW_COMMAND> m_commands;
+	std::vector<MeshBuffers::INSTANCE_DATA> m_drawData;
+	GLuint m_commandBuffer;
+	GLuint m_drawDataBuffer;
+	// number of draws the GPU buffers have room for
+	int m_capacity;
+};
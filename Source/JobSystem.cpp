@@ -0,0 +1,208 @@
+///////////////////////////////////////////////////////////////////////////////
+// jobsystem.cpp
+// ============
+// split loops over the scene into jobs run by a pool of worker threads
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "JobSystem.h"
+
+#include <algorithm>
+
+// declaration of global variables
+namespace
+{
+	// most worker threads started, however many cores there are
+	const int MAX_WORKERS = 15;
+}
+
+/***********************************************************
+ *  JobSystem()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+JobSystem::JobSystem(int workerCount)
+{
+	if (workerCount < 0)
+	{
+		workerCount = (int)std::thread::hardware_concurrency() - 1;
+	}
+	workerCount = std::max(0, std::min(workerCount, MAX_WORKERS));
+
+	m_queuedJobs = 0;
+	m_bStopping = false;
+	m_pQueues = new JOB_QUEUE[workerCount + 1];
+	for (int i = 0; i < workerCount; i++)
+	{
+		m_workers.push_back(std::thread(&JobSystem::RunWorker, this, i + 1));
+	}
+}
+
+/***********************************************************
+ *  ~JobSystem()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_wakeMutex);
+		m_bStopping = true;
+	}
+	m_wakeCondition.notify_all();
+
+	for (int i = 0; i < m_workers.size(); i++)
+	{
+		m_workers[i].join();
+	}
+	m_workers.clear();
+
+	delete[] m_pQueues;
+	m_pQueues = NULL;
+}
+
+/***********************************************************
+ *  ParallelFor()
+ *
+ *  This method is used for running a function over the
+ *  items [0, count) in batches of batchSize items, spread
+ *  over the worker threads and the calling thread.  The
+ *  batches are dealt out over the thread queues in turn,
+ *  and the idle threads steal from the busy ones.  It
+ *  returns once every batch has run.  Only one thread may
+ *  call it.
+ ***********************************************************/
+void JobSystem::ParallelFor(int count, int batchSize, const RANGE_FUNCTION& function)
+{
+	if (count <= 0)
+	{
+		return;
+	}
+
+	batchSize = std::max(batchSize, 1);
+	int batchCount = (count + batchSize - 1) / batchSize;
+	if ((batchCount == 1) || (m_workers.size() == 0))
+	{
+		function(0, count);
+		return;
+	}
+
+	JOB_GROUP group;
+	group.pFunction = &function;
+	group.remaining = batchCount;
+
+	int queueCount = GetThreadCount();
+	for (int i = 0; i < batchCount; i++)
+	{
+		JOB job;
+		job.pGroup = &group;
+		job.first = i * batchSize;
+		job.count = std::min(batchSize, count - job.first);
+
+		JOB_QUEUE& queue = m_pQueues[i % queueCount];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.jobs.push_back(job);
+		m_queuedJobs++;
+	}
+
+	// the count is raised before the lock, so a worker that
+	// checks it under the lock cannot miss the notify
+	{
+		std::lock_guard<std::mutex> lock(m_wakeMutex);
+	}
+	m_wakeCondition.notify_all();
+
+	// work through the batches alongside the workers - once
+	// none are left to take, the last ones are still running
+	while (group.remaining > 0)
+	{
+		if (RunNextJob(0) == false)
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+/***********************************************************
+ *  RunNextJob()
+ *
+ *  This method is used for running one job.  The thread
+ *  takes the newest job of its own queue, which was dealt
+ *  last and is least likely to be stolen, or else the
+ *  oldest job of the next queue that has one.
+ ***********************************************************/
+bool JobSystem::RunNextJob(int queueIndex)
+{
+	if (m_queuedJobs == 0)
+	{
+		return(false);
+	}
+
+	int queueCount = GetThreadCount();
+	JOB job;
+	bool bFound = false;
+	for (int i = 0; (i < queueCount) && (bFound == false); i++)
+	{
+		JOB_QUEUE& queue = m_pQueues[(queueIndex + i) % queueCount];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (queue.jobs.size() == 0)
+		{
+			continue;
+		}
+
+		if (i == 0)
+		{
+			job = queue.jobs.back();
+			queue.jobs.pop_back();
+		}
+		else
+		{
+			job = queue.jobs.front();
+			queue.jobs.pop_front();
+		}
+		m_queuedJobs--;
+		bFound = true;
+	}
+
+	if (bFound == false)
+	{
+		return(false);
+	}
+
+	(*job.pGroup->pFunction)(job.first, job.count);
+	// the group lives on the caller's stack, so it is not
+	// touched again once the count reaches zero
+	job.pGroup->remaining--;
+
+	return(true);
+}
+
+/***********************************************************
+ *  RunWorker()
+ *
+ *  This method is the loop of each worker thread.  It runs
+ *  jobs while there are any, and sleeps until more are
+ *  queued or the job system is destroyed.
+ ***********************************************************/
+void JobSystem::RunWorker(int queueIndex)
+{
+	while (true)
+	{
+		if (RunNextJob(queueIndex) == true)
+		{
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_wakeMutex);
+		m_wakeCondition.wait(lock, [this]()
+			{
+				return((m_queuedJobs > 0) || (m_bStopping == true));
+			});
+		if (m_bStopping == true)
+		{
+			return;
+		}
+	}
+}
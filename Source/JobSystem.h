@@ -0,0 +1,89 @@
+///////////////////////////////////////////////////////////////////////////////
+// jobsystem.h
+// ============
+// split loops over the scene into jobs run by a pool of worker threads
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+//  Notes: ParallelFor() cuts a range into batches and deals them out over
+//         one job queue per thread.  Each thread takes its own jobs from
+//         the back of its queue and, once it runs dry, steals the oldest
+//         jobs from the front of the others, so a thread that drew cheap
+//         batches helps the ones that drew expensive ones.  The calling
+//         thread runs jobs too, and only returns once every batch of its
+//         range is done.  A range of one batch, or a pool without workers,
+//         is run inline with no locking at all.  Jobs must not throw or
+//         start another ParallelFor().
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/***********************************************************
+ *  JobSystem
+ *
+ *  This class holds the worker threads and the job queue
+ *  of every thread that runs jobs.
+ ***********************************************************/
+class JobSystem
+{
+public:
+	// work on the items [first, first + count) of a range
+	typedef std::function<void(int first, int count)> RANGE_FUNCTION;
+
+	// constructor - a worker count below zero leaves one core
+	// for the calling thread and uses the rest
+	JobSystem(int workerCount = -1);
+	// destructor
+	~JobSystem();
+
+	// run a function over [0, count) in batches of batchSize items
+	// and wait for all of them to finish
+	void ParallelFor(int count, int batchSize, const RANGE_FUNCTION& function);
+
+	// get the number of threads that run jobs, the caller included
+	int GetThreadCount() const { return((int)m_workers.size() + 1); }
+
+private:
+	// the batches of one ParallelFor() call still to finish
+	struct JOB_GROUP
+	{
+		const RANGE_FUNCTION* pFunction;
+		std::atomic<int> remaining;
+	};
+
+	struct JOB
+	{
+		JOB_GROUP* pGroup;
+		int first;
+		int count;
+	};
+
+	// jobs of one thread - index 0 belongs to the calling thread
+	struct JOB_QUEUE
+	{
+		std::mutex mutex;
+		std::deque<JOB> jobs;
+	};
+
+	std::vector<std::thread> m_workers;
+	JOB_QUEUE* m_pQueues;
+	// jobs queued and not taken yet, and the workers waiting for them
+	std::atomic<int> m_queuedJobs;
+	std::mutex m_wakeMutex;
+	std::condition_variable m_wakeCondition;
+	bool m_bStopping;
+
+	// take a job from the thread's own queue, or steal one from
+	// another, and run it - false when every queue was empty
+	bool RunNextJob(int queueIndex);
+	// loop of a worker thread, until the destructor
+	void RunWorker(int queueIndex);
+};
@@ -0,0 +1,318 @@
+///////////////////////////////////////////////////////////////////////////////
+// lightclusters.cpp
+// ============
+// assign the scene point lights to a froxel grid so each fragment only
+// evaluates the lights that can reach it
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "LightClusters.h"
+#include "RenderStats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+/***********************************************************
+ *  LightClusters()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+LightClusters::LightClusters()
+{
+	m_clusterBuffer = 0;
+	m_lightIndexBuffer = 0;
+	m_clusterRange.buffer = 0;
+	m_clusterRange.offset = 0;
+	m_clusterRange.size = 0;
+	m_lightIndexRange = m_clusterRange;
+	m_pFrameRing = NULL;
+	m_storageAlignment = 256;
+	m_projection = glm::mat4(0.0f);
+	m_viewportWidth = 0;
+	m_viewportHeight = 0;
+	m_nearDepth = 0.1f;
+	m_farDepth = 100.0f;
+	m_clusterScale = glm::vec4(0.0f);
+
+	m_bounds.resize(CLUSTER_COUNT);
+	m_clusterCounts.resize(CLUSTER_COUNT);
+	m_clusterLights.resize(CLUSTER_COUNT * MAX_LIGHTS_PER_CLUSTER);
+	m_clusterRanges.resize(CLUSTER_COUNT * 2);
+}
+
+/***********************************************************
+ *  ~LightClusters()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+LightClusters::~LightClusters()
+{
+	if (m_clusterBuffer != 0)
+	{
+		glDeleteBuffers(1, &m_clusterBuffer);
+		glDeleteBuffers(1, &m_lightIndexBuffer);
+	}
+}
+
+/***********************************************************
+ *  SetProjection()
+ *
+ *  This method is used for setting the projection and the
+ *  viewport size of the frame.  The near and far depths are
+ *  read back out of the projection matrix, and the cluster
+ *  bounds are rebuilt when anything has changed.
+ ***********************************************************/
+void LightClusters::SetProjection(const glm::mat4& projection, int viewportWidth, int viewportHeight)
+{
+	if ((projection == m_projection) &&
+		(viewportWidth == m_viewportWidth) &&
+		(viewportHeight == m_viewportHeight))
+	{
+		return;
+	}
+
+	m_projection = projection;
+	m_viewportWidth = std::max(1, viewportWidth);
+	m_viewportHeight = std::max(1, viewportHeight);
+
+	if (projection[3][3] == 0.0f)
+	{
+		// perspective projection
+		m_nearDepth = projection[3][2] / (projection[2][2] - 1.0f);
+		m_farDepth = projection[3][2] / (projection[2][2] + 1.0f);
+	}
+	else
+	{
+		// orthographic projection
+		m_nearDepth = (projection[3][2] + 1.0f) / projection[2][2];
+		m_farDepth = (projection[3][2] - 1.0f) / projection[2][2];
+	}
+
+	// the slices are spaced on a log scale, which needs a depth
+	// range in front of the camera
+	m_nearDepth = std::max(m_nearDepth, 0.01f);
+	m_farDepth = std::max(m_farDepth, m_nearDepth * 2.0f);
+
+	float sliceScale = GRID_Z / std::log(m_farDepth / m_nearDepth);
+	m_clusterScale = glm::vec4(
+		(float)GRID_X / m_viewportWidth,
+		(float)GRID_Y / m_viewportHeight,
+		sliceScale,
+		sliceScale * std::log(m_nearDepth));
+
+	BuildBounds();
+}
+
+/***********************************************************
+ *  GetSliceDepth()
+ *
+ *  This method is used for getting the view depth where a
+ *  depth slice starts.
+ ***********************************************************/
+float LightClusters::GetSliceDepth(int slice) const
+{
+	return(m_nearDepth * std::pow(m_farDepth / m_nearDepth, (float)slice / GRID_Z));
+}
+
+/***********************************************************
+ *  GetSlice()
+ *
+ *  This method is used for getting the depth slice of a
+ *  view depth, the same way the fragment shader does.
+ ***********************************************************/
+int LightClusters::GetSlice(float depth) const
+{
+	if (depth <= m_nearDepth)
+	{
+		return(0);
+	}
+
+	int slice = (int)std::floor(std::log(depth) * m_clusterScale.z - m_clusterScale.w);
+	return(std::min(std::max(slice, 0), GRID_Z - 1));
+}
+
+/***********************************************************
+ *  BuildBounds()
+ *
+ *  This method is used for building the view space bounds
+ *  of every cluster from the corners of its screen tile at
+ *  the start and end depth of its slice.
+ ***********************************************************/
+void LightClusters::BuildBounds()
+{
+	glm::mat4 inverseProjection = glm::inverse(m_projection);
+
+	for (int z = 0; z < GRID_Z; z++)
+	{
+		float depths[2] = { GetSliceDepth(z), GetSliceDepth(z + 1) };
+
+		// the NDC depth of the two slice planes
+		float ndcDepths[2];
+		for (int i = 0; i < 2; i++)
+		{
+			glm::vec4 clip = m_projection * glm::vec4(0.0f, 0.0f, -depths[i], 1.0f);
+			ndcDepths[i] = clip.z / clip.w;
+		}
+
+		for (int y = 0; y < GRID_Y; y++)
+		{
+			for (int x = 0; x < GRID_X; x++)
+			{
+				CLUSTER_BOUNDS& bounds = m_bounds[x + GRID_X * (y + GRID_Y * z)];
+				bounds.minimum = glm::vec3(1.0e30f);
+				bounds.maximum = glm::vec3(-1.0e30f);
+
+				for (int corner = 0; corner < 8; corner++)
+				{
+					float ndcX = -1.0f + 2.0f * (x + (corner & 1)) / GRID_X;
+					float ndcY = -1.0f + 2.0f * (y + ((corner >> 1) & 1)) / GRID_Y;
+					glm::vec4 point = inverseProjection * glm::vec4(ndcX, ndcY, ndcDepths[corner >> 2], 1.0f);
+					glm::vec3 viewPoint = glm::vec3(point) / point.w;
+
+					bounds.minimum = glm::min(bounds.minimum, viewPoint);
+					bounds.maximum = glm::max(bounds.maximum, viewPoint);
+				}
+			}
+		}
+	}
+}
+
+/***********************************************************
+ *  Build()
+ *
+ *  This method is used for assigning every light to the
+ *  clusters its sphere overlaps and uploading the packed
+ *  light lists.  Only the depth slices a light spans are
+ *  tested, so the cost grows with the lights, not with the
+ *  number of clusters times lights.
+ ***********************************************************/
+void LightClusters::Build(const std::vector<LIGHT_SPHERE>& lights, const glm::mat4& view)
+{
+	std::fill(m_clusterCounts.begin(), m_clusterCounts.end(), 0);
+
+	for (int i = 0; i < lights.size(); i++)
+	{
+		glm::vec3 center = glm::vec3(view * glm::vec4(lights[i].position, 1.0f));
+		float radius = lights[i].radius;
+		float depth = -center.z;
+
+		// nothing to light when the sphere is behind the camera
+		// or past the far plane
+		if ((depth + radius < m_nearDepth) || (depth - radius > m_farDepth))
+		{
+			continue;
+		}
+
+		int firstSlice = GetSlice(depth - radius);
+		int lastSlice = GetSlice(depth + radius);
+		for (int z = firstSlice; z <= lastSlice; z++)
+		{
+			for (int cluster = z * GRID_X * GRID_Y; cluster < (z + 1) * GRID_X * GRID_Y; cluster++)
+			{
+				// distance from the sphere center to the cluster box
+				const CLUSTER_BOUNDS& bounds = m_bounds[cluster];
+				glm::vec3 closest = glm::min(glm::max(center, bounds.minimum), bounds.maximum);
+				glm::vec3 offset = closest - center;
+				if (glm::dot(offset, offset) > radius * radius)
+				{
+					continue;
+				}
+
+				int& count = m_clusterCounts[cluster];
+				if (count < MAX_LIGHTS_PER_CLUSTER)
+				{
+					m_clusterLights[cluster * MAX_LIGHTS_PER_CLUSTER + count] = (GLuint)i;
+					count++;
+				}
+			}
+		}
+	}
+
+	// pack the lists end to end
+	m_lightIndices.clear();
+	for (int cluster = 0; cluster < CLUSTER_COUNT; cluster++)
+	{
+		int count = m_clusterCounts[cluster];
+		m_clusterRanges[cluster * 2] = (GLuint)m_lightIndices.size();
+		m_clusterRanges[cluster * 2 + 1] = (GLuint)count;
+		m_lightIndices.insert(
+			m_lightIndices.end(),
+			m_clusterLights.begin() + cluster * MAX_LIGHTS_PER_CLUSTER,
+			m_clusterLights.begin() + cluster * MAX_LIGHTS_PER_CLUSTER + count);
+	}
+	// keep the storage buffer from being empty
+	if (m_lightIndices.size() == 0)
+	{
+		m_lightIndices.push_back(0);
+	}
+
+	if (m_clusterBuffer == 0)
+	{
+		glGenBuffers(1, &m_clusterBuffer);
+		glGenBuffers(1, &m_lightIndexBuffer);
+	}
+
+	UploadList(m_clusterRanges, m_clusterBuffer, m_clusterRange);
+	UploadList(m_lightIndices, m_lightIndexBuffer, m_lightIndexRange);
+}
+
+/***********************************************************
+ *  UploadList()
+ *
+ *  This method is used for uploading a light list for the
+ *  frame.  The lists change every frame, so they are
+ *  written into the frame ring, or else the list's own
+ *  buffer is orphaned rather than waited on.
+ ***********************************************************/
+void LightClusters::UploadList(const std::vector<GLuint>& list, GLuint buffer, BUFFER_RANGE& range)
+{
+	GLsizeiptr size = list.size() * sizeof(GLuint);
+
+	FrameRingBuffer::ALLOCATION allocation;
+	if ((m_pFrameRing != NULL) && (m_pFrameRing->Allocate(size, m_storageAlignment, allocation) == true))
+	{
+		memcpy(allocation.pData, list.data(), size);
+		range.buffer = m_pFrameRing->GetBuffer();
+		range.offset = allocation.offset;
+	}
+	else
+	{
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, size, list.data(), GL_STREAM_DRAW);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+		range.buffer = buffer;
+		range.offset = 0;
+	}
+	range.size = size;
+
+	RenderStats::Add(RenderStats::COUNTER_BYTES_UPLOADED, size);
+}
+
+/***********************************************************
+ *  SetFrameRing()
+ *
+ *  This method is used for setting the frame ring the
+ *  lists are written to.  Storage buffer ranges must start
+ *  at the driver's offset alignment, which is read here.
+ ***********************************************************/
+void LightClusters::SetFrameRing(FrameRingBuffer* pFrameRing)
+{
+	m_pFrameRing = pFrameRing;
+	glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &m_storageAlignment);
+}
+
+/***********************************************************
+ *  Bind()
+ *
+ *  This method is used for binding the ranges of the last
+ *  uploaded cluster and light index lists to their binding
+ *  points.
+ ***********************************************************/
+void LightClusters::Bind() const
+{
+	glBindBufferRange(GL_SHADER_STORAGE_BUFFER, CLUSTER_BINDING, m_clusterRange.buffer, m_clusterRange.offset, m_clusterRange.size);
+	glBindBufferRange(GL_SHADER_STORAGE_BUFFER, LIGHT_INDEX_BINDING, m_lightIndexRange.buffer, m_lightIndexRange.offset, m_lightIndexRange.size);
+}
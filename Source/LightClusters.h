@@ -0,0 +1,125 @@
+///////////////////////////////////////////////////////////////////////////////
+// lightclusters.h
+// ============
+// assign the scene point lights to a froxel grid so each fragment only
+// evaluates the lights that can reach it
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+//  Notes: The view frustum is split into GRID_X by GRID_Y screen tiles and
+//         GRID_Z depth slices, spaced exponentially so near clusters are
+//         not stretched.  Each frame the light spheres are tested against
+//         the view space bounds of the clusters they overlap, and the
+//         per-cluster light lists are written into two storage buffers
+//         that the clustered fragment shader reads.  With a frame ring
+//         the lists are written into its current region instead and
+//         bound by range.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "FrameRingBuffer.h"
+
+#include <GL/glew.h>
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+/***********************************************************
+ *  LightClusters
+ *
+ *  This class holds the cluster bounds of the current
+ *  projection, the light lists built from them and the
+ *  storage buffers the lists are uploaded into.
+ ***********************************************************/
+class LightClusters
+{
+public:
+	// storage buffer binding points, shared with fragmentShader.glsl
+	static const GLuint POINT_LIGHT_BINDING = 1;
+	static const GLuint CLUSTER_BINDING = 2;
+	static const GLuint LIGHT_INDEX_BINDING = 3;
+
+	// cluster grid size
+	static const int GRID_X = 16;
+	static const int GRID_Y = 9;
+	static const int GRID_Z = 24;
+	static const int CLUSTER_COUNT = GRID_X * GRID_Y * GRID_Z;
+	// lights beyond this many in one cluster are dropped
+	static const int MAX_LIGHTS_PER_CLUSTER = 64;
+
+	// a point light's reach, in world space
+	struct LIGHT_SPHERE
+	{
+		glm::vec3 position;
+		float radius;
+	};
+
+	// constructor
+	LightClusters();
+	// destructor
+	~LightClusters();
+
+	// set the projection and viewport of the frame - the cluster
+	// bounds are only rebuilt when either one changes
+	void SetProjection(const glm::mat4& projection, int viewportWidth, int viewportHeight);
+	// assign the lights to the clusters and upload the lists
+	void Build(const std::vector<LIGHT_SPHERE>& lights, const glm::mat4& view);
+	// bind the storage buffers to their binding points
+	void Bind() const;
+	// set the ring the lists of each frame are written to, NULL
+	// to upload them into the storage buffers instead
+	void SetFrameRing(FrameRingBuffer* pFrameRing);
+
+	// get the scales the shader maps a fragment to its cluster with -
+	// x and y turn window coordinates into tiles, z and w turn the
+	// log of the view depth into a slice
+	glm::vec4 GetClusterScale() const { return(m_clusterScale); }
+
+private:
+	// view space bounds of one cluster
+	struct CLUSTER_BOUNDS
+	{
+		glm::vec3 minimum;
+		glm::vec3 maximum;
+	};
+
+	std::vector<CLUSTER_BOUNDS> m_bounds;
+	// light count and light list of each cluster
+	std::vector<int> m_clusterCounts;
+	std::vector<GLuint> m_clusterLights;
+	// offset and count of each cluster in m_lightIndices
+	std::vector<GLuint> m_clusterRanges;
+	std::vector<GLuint> m_lightIndices;
+	GLuint m_clusterBuffer;
+	GLuint m_lightIndexBuffer;
+
+	// where the last uploaded copy of a list is bound from
+	struct BUFFER_RANGE
+	{
+		GLuint buffer;
+		GLintptr offset;
+		GLsizeiptr size;
+	};
+	BUFFER_RANGE m_clusterRange;
+	BUFFER_RANGE m_lightIndexRange;
+	FrameRingBuffer* m_pFrameRing;
+	GLint m_storageAlignment;
+	glm::mat4 m_projection;
+	int m_viewportWidth;
+	int m_viewportHeight;
+	float m_nearDepth;
+	float m_farDepth;
+	glm::vec4 m_clusterScale;
+
+	// rebuild the view space bounds of every cluster
+	void BuildBounds();
+	// write a list into the frame ring, or into its own buffer
+	// when the ring has no room
+	void UploadList(const std::vector<GLuint>& list, GLuint buffer, BUFFER_RANGE& range);
+	// get the view depth where a depth slice starts
+	float GetSliceDepth(int slice) const;
+	// get the depth slice of a view depth
+	int GetSlice(float depth) const;
+};
@@ -5,10 +5,44 @@
 //
 //  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
 //	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+//
+//  Date: October 14, 2026
+//  Notes: Pass the shading options selected in the view manager to the
+//         scene manager every frame, and show the frame statistics in
+//         the window title.
+//         Time each frame with the FrameProfiler - the scene sections
+//         and the buffer swap - and draw its overlay or write a frame
+//         trace when the view manager keys ask for them.
+//         With --benchmark the window is hidden, vsync is off and the
+//         camera follows the SceneBenchmark path for a fixed number of
+//         frames, after which the report is written and the program exits.
+//         Close the RenderStats counters of every frame, show them in the
+//         window title when the view manager asks, and hand them to the
+//         benchmark.
+//         Enable the depth test through the RenderState cache, so the
+//         driver only sees it when something else turned it off.
+//         Write the per-frame scene data into a triple-buffered
+//         FrameRingBuffer, moved on at the start of each frame and fenced
+//         before the swap.
+//         Move the camera on the view manager's fixed-tick update
+//         thread, unless the benchmark path is placing it.
+//         Load the scene file passed with --scene instead of the default.
+//         Reload the scene file, shaders and textures when they change on
+//         disk, unless benchmarking.
+//         The scene manager builds every shader program it draws with,
+//         so the ShaderManager and its unused program were removed.
+//         Pass the transparency mode selected in the view manager on too.
+//         Open the window at the size given with --width and --height, or
+//         full screen with --fullscreen, and draw the scene through the
+//         ResolutionScaler - offscreen at a scale that holds the frame
+//         rate given with --target-fps, then stretched and sharpened over
+//         the window before the swap.
+//         Show the GpuResources tally and budget with the render stats.
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <iostream>         // error handling and output
 #include <cstdlib>          // EXIT_FAILURE
+#include <string>           // window title statistics
 
 #include <GL/glew.h>        // GLEW library
 #include "GLFW/glfw3.h"     // GLFW library
@@ -20,8 +54,13 @@
 
 #include "SceneManager.h"
 #include "ViewManager.h"
-#include "ShapeMeshes.h"
-#include "ShaderManager.h"
+#include "FrameProfiler.h"
+#include "SceneBenchmark.h"
+#include "RenderStats.h"
+#include "RenderState.h"
+#include "FrameRingBuffer.h"
+#include "ResolutionScaler.h"
+#include "GpuResources.h"
 
 // Namespace for declaring global variables
 namespace
@@ -34,10 +73,26 @@ namespace
 
 	// scene manager object for managing the 3D scene prepare and render
 	SceneManager* g_SceneManager = nullptr;
-	// shader manager object for dynamic interaction with the shader code
-	ShaderManager* g_ShaderManager = nullptr;
 	// view manager object for managing the 3D view setup and projection to 2D
 	ViewManager* g_ViewManager = nullptr;
+	// frame profiler object for timing the sections of each frame
+	FrameProfiler* g_FrameProfiler = nullptr;
+	// benchmark run object, only created with --benchmark
+	SceneBenchmark* g_Benchmark = nullptr;
+	// persistently mapped ring for the per-frame scene data, only
+	// kept when the driver supports it
+	FrameRingBuffer* g_FrameRing = nullptr;
+	// offscreen target the scene is drawn into at a scaled
+	// resolution, only kept when its upscale program builds
+	ResolutionScaler* g_ResolutionScaler = nullptr;
+
+	// seconds between updates of the statistics in the window title
+	const double STATS_UPDATE_INTERVAL = 0.5;
+	// file the T key writes the recorded frames to
+	const char* const FRAME_TRACE_FILE = "frame_trace.json";
+	// profiler scope of the buffer swap, whose GPU time is the wait
+	// for the display and is left out of the resolution scaling
+	const char* const SWAP_SCOPE = "swap";
 }
 
 // Function declarations - all functions that are called manually
@@ -60,14 +115,33 @@ int main(int argc, char* argv[])
 		return(EXIT_FAILURE);
 	}
 
-	// try to create a new shader manager object
-	g_ShaderManager = new ShaderManager();
+	// a benchmark run draws offscreen into a hidden window
+	SceneBenchmark::BENCHMARK_SETTINGS benchmarkSettings;
+	if (SceneBenchmark::ParseArguments(argc, argv, benchmarkSettings) == true)
+	{
+		g_Benchmark = new SceneBenchmark(benchmarkSettings);
+		glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	}
+
 	// try to create a new view manager object
-	g_ViewManager = new ViewManager(
-		g_ShaderManager);
+	g_ViewManager = new ViewManager();
 
 	// try to create the main display window
-	g_Window = g_ViewManager->CreateDisplayWindow(WINDOW_TITLE);
+	g_Window = g_ViewManager->CreateDisplayWindow(
+		WINDOW_TITLE,
+		benchmarkSettings.windowWidth,
+		benchmarkSettings.windowHeight,
+		benchmarkSettings.bFullScreen);
+	if (g_Window == NULL)
+	{
+		return(EXIT_FAILURE);
+	}
+
+	// a benchmark frame must not wait for the display refresh
+	if (NULL != g_Benchmark)
+	{
+		glfwSwapInterval(0);
+	}
 
 	// if GLEW fails initialization, then terminate the application
 	if (InitializeGLEW() == false)
@@ -75,60 +149,265 @@ int main(int argc, char* argv[])
 		return(EXIT_FAILURE);
 	}
 
-	// load the shader code from the external GLSL files
-	g_ShaderManager->LoadShaders(
-		"shaders/vertexShader.glsl",
-		"shaders/fragmentShader.glsl");
-	g_ShaderManager->use();
-
 	// try to create a new scene manager object and prepare the 3D scene
-	g_SceneManager = new SceneManager(g_ShaderManager);
+	g_SceneManager = new SceneManager();
+	g_FrameRing = new FrameRingBuffer();
+	if (g_FrameRing->Create() == true)
+	{
+		g_SceneManager->SetFrameRing(g_FrameRing);
+	}
+	else
+	{
+		delete g_FrameRing;
+		g_FrameRing = NULL;
+	}
+	if (NULL != g_Benchmark)
+	{
+		g_SceneManager->SetSceneCopies(benchmarkSettings.sceneCopies);
+	}
+	if (benchmarkSettings.sceneFile.empty() == false)
+	{
+		g_SceneManager->SetSceneFile(benchmarkSettings.sceneFile);
+	}
 	g_SceneManager->PrepareScene();
+	// a benchmark must draw the same scene every run
+	if (NULL == g_Benchmark)
+	{
+		g_SceneManager->EnableHotReload();
+	}
+
+	// draw the scene at the resolution that holds the target frame
+	// rate - a benchmark measures it at the full resolution
+	g_ResolutionScaler = new ResolutionScaler();
+	if (g_ResolutionScaler->Create(
+		"shaders/vertexShader.glsl",
+		"shaders/fragmentShader.glsl") == true)
+	{
+		g_ResolutionScaler->SetTargetFrameRate((NULL != g_Benchmark) ? 0 : benchmarkSettings.targetFrameRate);
+		g_SceneManager->SetResolutionScaler(g_ResolutionScaler);
+	}
+	else
+	{
+		delete g_ResolutionScaler;
+		g_ResolutionScaler = NULL;
+	}
+
+	// time the scene sections of every frame - a benchmark keeps
+	// every measured frame for its report
+	g_FrameProfiler = new FrameProfiler();
+	g_SceneManager->SetFrameProfiler(g_FrameProfiler);
+	if (NULL != g_Benchmark)
+	{
+		g_FrameProfiler->SetHistoryLength(benchmarkSettings.frameCount);
+	}
+
+	// time the window title statistics were last updated
+	double lastStatsTime = 0.0;
+
+	// benchmark progress - the warm up frames drawn, whether the
+	// measured frames have started, and when the last frame ended
+	int warmupFrames = 0;
+	bool bMeasuring = false;
+	double lastFrameEndTime = glfwGetTime();
+
+	// the camera moves at a fixed tick on its own thread - the
+	// benchmark camera is placed every frame instead
+	if (NULL == g_Benchmark)
+	{
+		g_ViewManager->StartUpdateThread();
+	}
 
 	// loop will keep running until the application is closed 
 	// or until an error has occurred
 	while (!glfwWindowShouldClose(g_Window))
 	{
+		g_FrameProfiler->BeginFrame();
+
+		// reuse the ring region of three frames ago, once the GPU
+		// has finished reading it
+		if (NULL != g_FrameRing)
+		{
+			g_FrameRing->BeginFrame();
+		}
+
+		// follow the window size, and pick the scale of this frame
+		// from the newest GPU time, before the scene is bound
+		int framebufferWidth = 0;
+		int framebufferHeight = 0;
+		g_ViewManager->GetFramebufferSize(framebufferWidth, framebufferHeight);
+		if (NULL != g_ResolutionScaler)
+		{
+			g_ResolutionScaler->Resize(framebufferWidth, framebufferHeight);
+			g_ResolutionScaler->Update(g_FrameProfiler->GetLastFrameGpuTime(SWAP_SCOPE));
+			g_ResolutionScaler->BeginScene();
+		}
+		else
+		{
+			glViewport(0, 0, framebufferWidth, framebufferHeight);
+		}
+
 		// Enable z-depth
-		glEnable(GL_DEPTH_TEST);
+		RenderState::SetDepthTest(true);
 
 		// Clear the frame and z buffers
 		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
+		// the benchmark camera holds the first pose of its path
+		// until the measured frames start
+		if (NULL != g_Benchmark)
+		{
+			glm::vec3 cameraPosition;
+			glm::vec3 cameraFront;
+			int pathFrame = (bMeasuring == true) ? g_Benchmark->GetFrameCount() : 0;
+			g_Benchmark->GetCameraPose(pathFrame, cameraPosition, cameraFront);
+			g_ViewManager->SetCameraPose(cameraPosition, cameraFront);
+		}
+
 		// convert from 3D object space to 2D view
 		g_ViewManager->PrepareSceneView();
 
 		// refresh the 3D scene
+		g_SceneManager->SetSceneView(
+			g_ViewManager->GetViewMatrix(),
+			g_ViewManager->GetProjectionMatrix(),
+			g_ViewManager->GetCameraPosition());
+		g_SceneManager->SetDeferredShading(g_ViewManager->IsDeferredShading());
+		g_SceneManager->SetDepthPrePass(g_ViewManager->IsDepthPrePass());
+		g_SceneManager->SetTransparencyMode((SceneManager::TRANSPARENCY_MODE)g_ViewManager->GetTransparencyMode());
 		g_SceneManager->RenderScene();
 
+		// stretch the scaled scene over the window
+		if (NULL != g_ResolutionScaler)
+		{
+			g_FrameProfiler->BeginScope("upscale");
+			g_ResolutionScaler->EndScene();
+			g_FrameProfiler->EndScope();
+		}
+
+		// draw the section times over the frame
+		if (g_ViewManager->IsProfilerOverlay() == true)
+		{
+			g_FrameProfiler->DrawOverlay();
+		}
+
+		// show how many scene nodes the view culled, and the
+		// section times while the overlay is shown
+		double currentTime = glfwGetTime();
+		if (currentTime - lastStatsTime >= STATS_UPDATE_INTERVAL)
+		{
+			int nodeCount = g_SceneManager->GetSceneNodeCount();
+			int culledCount = g_SceneManager->GetCulledNodeCount();
+			std::string title = std::string(WINDOW_TITLE) +
+				" - nodes drawn: " + std::to_string(nodeCount - culledCount) +
+				", culled: " + std::to_string(culledCount);
+			if (g_ViewManager->IsProfilerOverlay() == true)
+			{
+				title += " - cpu/gpu: " + g_FrameProfiler->GetSummary();
+			}
+			if (g_ViewManager->IsRenderStats() == true)
+			{
+				title += " - " + RenderStats::GetSummary();
+				if (NULL != g_ResolutionScaler)
+				{
+					title += ", resolution: " + std::to_string((int)(g_ResolutionScaler->GetScale() * 100.0f + 0.5f)) + "%";
+				}
+				title += " - gpu memory: " + GpuResources::GetSummary();
+			}
+			glfwSetWindowTitle(g_Window, title.c_str());
+			lastStatsTime = currentTime;
+		}
+
+		// fence the ring region behind the frame's draws
+		if (NULL != g_FrameRing)
+		{
+			g_FrameRing->EndFrame();
+		}
 
 		// Flips the the back buffer with the front buffer every frame.
+		g_FrameProfiler->BeginScope(SWAP_SCOPE);
 		glfwSwapBuffers(g_Window);
+		g_FrameProfiler->EndScope();
+
+		g_FrameProfiler->EndFrame();
+		RenderStats::EndFrame();
+		if (g_ViewManager->ConsumeTraceRequest() == true)
+		{
+			g_FrameProfiler->WriteChromeTrace(FRAME_TRACE_FILE);
+		}
+
+		// time the benchmark frames once the scene has warmed up
+		// and every texture is in
+		if (NULL != g_Benchmark)
+		{
+			double frameEndTime = glfwGetTime();
+			if (bMeasuring == true)
+			{
+				g_Benchmark->AddFrame((frameEndTime - lastFrameEndTime) * 1000.0);
+			}
+			else if ((++warmupFrames >= SceneBenchmark::WARMUP_FRAMES) &&
+				(g_SceneManager->IsTextureLoading() == false))
+			{
+				bMeasuring = true;
+			}
+			lastFrameEndTime = frameEndTime;
+
+			if (g_Benchmark->IsFinished() == true)
+			{
+				break;
+			}
+		}
 
 		// query the latest GLFW events
 		glfwPollEvents();
 	}
 
+	// the camera stops moving before anything is torn down
+	g_ViewManager->StopUpdateThread();
+
+	// the last frames' GPU times are read back before the report
+	int exitCode = EXIT_SUCCESS;
+	if (NULL != g_Benchmark)
+	{
+		g_FrameProfiler->Flush();
+		if (g_Benchmark->WriteReport(*g_FrameProfiler, g_SceneManager->GetSceneNodeCount()) == false)
+		{
+			exitCode = EXIT_FAILURE;
+		}
+		delete g_Benchmark;
+		g_Benchmark = NULL;
+	}
+
 	// clear the allocated manager objects from memory
 	if (NULL != g_SceneManager)
 	{
 		delete g_SceneManager;
 		g_SceneManager = NULL;
 	}
+	if (NULL != g_FrameRing)
+	{
+		delete g_FrameRing;
+		g_FrameRing = NULL;
+	}
+	if (NULL != g_ResolutionScaler)
+	{
+		delete g_ResolutionScaler;
+		g_ResolutionScaler = NULL;
+	}
+	if (NULL != g_FrameProfiler)
+	{
+		delete g_FrameProfiler;
+		g_FrameProfiler = NULL;
+	}
 	if (NULL != g_ViewManager)
 	{
 		delete g_ViewManager;
 		g_ViewManager = NULL;
 	}
-	if (NULL != g_ShaderManager)
-	{
-		delete g_ShaderManager;
-		g_ShaderManager = NULL;
-	}
 
-	// Terminates the program successfully
-	exit(EXIT_SUCCESS); 
+	// Terminates the program, successfully unless the benchmark
+	// report could not be written
+	exit(exitCode); 
 }
 
 /***********************************************************
@@ -0,0 +1,786 @@
+///////////////////////////////////////////////////////////////////////////////
+// meshbuffers.cpp
+// ============
+// build the basic shape meshes into vertex buffers and draw them instanced
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "MeshBuffers.h"
+#include "RenderStats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+// declaration of global variables
+namespace
+{
+	// tessellation of the round shapes at each level of detail,
+	// from the full detail of level 0 down
+	const int CYLINDER_SIDES[MeshBuffers::LOD_COUNT] = { 36, 18, 10 };
+	const int SPHERE_STACKS[MeshBuffers::LOD_COUNT] = { 30, 16, 8 };
+	const int SPHERE_SECTORS[MeshBuffers::LOD_COUNT] = { 36, 18, 10 };
+	const int TORUS_MAIN_SEGMENTS[MeshBuffers::LOD_COUNT] = { 36, 18, 12 };
+	const int TORUS_TUBE_SEGMENTS[MeshBuffers::LOD_COUNT] = { 18, 10, 6 };
+	const float TORUS_MAIN_RADIUS = 1.0f;
+	const float TORUS_TUBE_RADIUS = 0.1f;
+
+	const float TWO_PI = 6.28318530718f;
+	const float PI = 3.14159265359f;
+
+	// vertex buffer binding of the per-instance attributes - the
+	// per-vertex attributes are set with glVertexAttribPointer(),
+	// which uses the binding of each attribute's own location, so
+	// the first instance location is free for it
+	const GLuint INSTANCE_BINDING = MeshBuffers::ATTRIBUTE_INSTANCE_MODEL;
+	// alignment of the instances in the frame ring
+	const GLsizeiptr INSTANCE_ALIGNMENT = 16;
+
+	/***********************************************************
+	 *  SetInstanceAttribute()
+	 *
+	 *  Set one per-instance attribute, through the instance
+	 *  binding or, without it, as a pointer at an offset of
+	 *  the bound GL_ARRAY_BUFFER that advances per instance.
+	 *  GL_INT attributes are read as integers.
+	 ***********************************************************/
+	void SetInstanceAttribute(
+		bool bAttribBinding,
+		GLuint location,
+		GLint size,
+		GLenum type,
+		GLuint relativeOffset,
+		GLintptr bufferOffset)
+	{
+		glEnableVertexAttribArray(location);
+
+		if (bAttribBinding == true)
+		{
+			if (type == GL_INT)
+			{
+				glVertexAttribIFormat(location, size, type, relativeOffset);
+			}
+			else
+			{
+				glVertexAttribFormat(location, size, type, GL_FALSE, relativeOffset);
+			}
+			glVertexAttribBinding(location, INSTANCE_BINDING);
+			return;
+		}
+
+		const void* pointer = (const void*)(bufferOffset + relativeOffset);
+		if (type == GL_INT)
+		{
+			glVertexAttribIPointer(location, size, type, sizeof(MeshBuffers::INSTANCE_DATA), pointer);
+		}
+		else
+		{
+			glVertexAttribPointer(location, size, type, GL_FALSE, sizeof(MeshBuffers::INSTANCE_DATA), pointer);
+		}
+		glVertexAttribDivisor(location, 1);
+	}
+
+	/***********************************************************
+	 *  AddVertex()
+	 *
+	 *  Append a vertex and return its index.
+	 ***********************************************************/
+	template <class VERTEX>
+	GLuint AddVertex(
+		std::vector<VERTEX>& vertices,
+		glm::vec3 position,
+		glm::vec3 normal,
+		glm::vec2 textureCoordinate)
+	{
+		VERTEX vertex;
+		vertex.position = position;
+		vertex.normal = normal;
+		vertex.textureCoordinate = textureCoordinate;
+		vertices.push_back(vertex);
+
+		return((GLuint)vertices.size() - 1);
+	}
+
+	/***********************************************************
+	 *  AddQuad()
+	 *
+	 *  Append a flat quad centered on the passed in point,
+	 *  spanning the u and v half axes, facing along u x v.
+	 ***********************************************************/
+	template <class VERTEX>
+	void AddQuad(
+		std::vector<VERTEX>& vertices,
+		std::vector<GLuint>& indices,
+		glm::vec3 center,
+		glm::vec3 u,
+		glm::vec3 v)
+	{
+		glm::vec3 normal = glm::normalize(glm::cross(u, v));
+
+		GLuint i0 = AddVertex(vertices, center - u - v, normal, glm::vec2(0.0f, 0.0f));
+		GLuint i1 = AddVertex(vertices, center + u - v, normal, glm::vec2(1.0f, 0.0f));
+		GLuint i2 = AddVertex(vertices, center + u + v, normal, glm::vec2(1.0f, 1.0f));
+		GLuint i3 = AddVertex(vertices, center - u + v, normal, glm::vec2(0.0f, 1.0f));
+
+		indices.push_back(i0); indices.push_back(i1); indices.push_back(i2);
+		indices.push_back(i0); indices.push_back(i2); indices.push_back(i3);
+	}
+
+	/***********************************************************
+	 *  AddFlatTriangle()
+	 *
+	 *  Append a flat shaded triangle of a convex shape that is
+	 *  centered on the origin.  The triangle is turned to face
+	 *  away from the origin.
+	 ***********************************************************/
+	template <class VERTEX>
+	void AddFlatTriangle(
+		std::vector<VERTEX>& vertices,
+		std::vector<GLuint>& indices,
+		glm::vec3 p0, glm::vec2 uv0,
+		glm::vec3 p1, glm::vec2 uv1,
+		glm::vec3 p2, glm::vec2 uv2)
+	{
+		glm::vec3 normal = glm::normalize(glm::cross(p1 - p0, p2 - p0));
+		if (glm::dot(normal, p0 + p1 + p2) < 0.0f)
+		{
+			glm::vec3 p = p1; p1 = p2; p2 = p;
+			glm::vec2 uv = uv1; uv1 = uv2; uv2 = uv;
+			normal = -normal;
+		}
+
+		indices.push_back(AddVertex(vertices, p0, normal, uv0));
+		indices.push_back(AddVertex(vertices, p1, normal, uv1));
+		indices.push_back(AddVertex(vertices, p2, normal, uv2));
+	}
+
+	/***********************************************************
+	 *  AddFrustum()
+	 *
+	 *  Append a round frustum from Y 0 to 1 with the passed in
+	 *  bottom and top radius and number of sides, including
+	 *  the end caps.  Equal radii make a cylinder.
+	 ***********************************************************/
+	template <class VERTEX>
+	void AddFrustum(
+		std::vector<VERTEX>& vertices,
+		std::vector<GLuint>& indices,
+		float bottomRadius,
+		float topRadius,
+		int sides)
+	{
+		// sides - the normal leans up as the radius shrinks
+		GLuint sideStart = (GLuint)vertices.size();
+		for (int i = 0; i <= sides; i++)
+		{
+			float u = (float)i / sides;
+			float x = std::cos(u * TWO_PI);
+			float z = std::sin(u * TWO_PI);
+			glm::vec3 normal = glm::normalize(glm::vec3(x, bottomRadius - topRadius, z));
+
+			AddVertex(vertices, glm::vec3(x * bottomRadius, 0.0f, z * bottomRadius), normal, glm::vec2(u, 0.0f));
+			AddVertex(vertices, glm::vec3(x * topRadius, 1.0f, z * topRadius), normal, glm::vec2(u, 1.0f));
+		}
+		for (int i = 0; i < sides; i++)
+		{
+			GLuint bottom = sideStart + i * 2;
+			indices.push_back(bottom); indices.push_back(bottom + 1); indices.push_back(bottom + 3);
+			indices.push_back(bottom); indices.push_back(bottom + 3); indices.push_back(bottom + 2);
+		}
+
+		// end caps
+		for (int cap = 0; cap < 2; cap++)
+		{
+			float y = (float)cap;
+			float radius = (cap == 0) ? bottomRadius : topRadius;
+			glm::vec3 normal = glm::vec3(0.0f, (cap == 0) ? -1.0f : 1.0f, 0.0f);
+
+			GLuint center = AddVertex(vertices, glm::vec3(0.0f, y, 0.0f), normal, glm::vec2(0.5f, 0.5f));
+			for (int i = 0; i <= sides; i++)
+			{
+				float u = (float)i / sides;
+				float x = std::cos(u * TWO_PI);
+				float z = std::sin(u * TWO_PI);
+				AddVertex(vertices, glm::vec3(x * radius, y, z * radius), normal, glm::vec2(0.5f + 0.5f * x, 0.5f + 0.5f * z));
+			}
+			for (int i = 0; i < sides; i++)
+			{
+				indices.push_back(center);
+				indices.push_back(center + 1 + i);
+				indices.push_back(center + 2 + i);
+			}
+		}
+	}
+
+	/***********************************************************
+	 *  AddSphere()
+	 *
+	 *  Append a sphere of radius 1 with the passed in number
+	 *  of stacks from pole to pole and sectors around Y.
+	 ***********************************************************/
+	template <class VERTEX>
+	void AddSphere(
+		std::vector<VERTEX>& vertices,
+		std::vector<GLuint>& indices,
+		int stacks,
+		int sectors)
+	{
+		for (int stack = 0; stack <= stacks; stack++)
+		{
+			float v = (float)stack / stacks;
+			float phi = v * PI;
+			for (int sector = 0; sector <= sectors; sector++)
+			{
+				float u = (float)sector / sectors;
+				float theta = u * TWO_PI;
+				glm::vec3 position = glm::vec3(
+					std::sin(phi) * std::cos(theta),
+					std::cos(phi),
+					std::sin(phi) * std::sin(theta));
+				AddVertex(vertices, position, position, glm::vec2(u, 1.0f - v));
+			}
+		}
+		for (int stack = 0; stack < stacks; stack++)
+		{
+			for (int sector = 0; sector < sectors; sector++)
+			{
+				GLuint i0 = stack * (sectors + 1) + sector;
+				GLuint i1 = i0 + sectors + 1;
+				indices.push_back(i0); indices.push_back(i1); indices.push_back(i0 + 1);
+				indices.push_back(i0 + 1); indices.push_back(i1); indices.push_back(i1 + 1);
+			}
+		}
+	}
+
+	/***********************************************************
+	 *  AddTorus()
+	 *
+	 *  Append a torus of main radius 1 around the Z axis with
+	 *  the passed in number of segments around the ring and
+	 *  around the tube.
+	 ***********************************************************/
+	template <class VERTEX>
+	void AddTorus(
+		std::vector<VERTEX>& vertices,
+		std::vector<GLuint>& indices,
+		int mainSegments,
+		int tubeSegments)
+	{
+		for (int i = 0; i <= mainSegments; i++)
+		{
+			float u = (float)i / mainSegments;
+			float mainAngle = u * TWO_PI;
+			glm::vec3 ringDirection = glm::vec3(std::cos(mainAngle), std::sin(mainAngle), 0.0f);
+			for (int j = 0; j <= tubeSegments; j++)
+			{
+				float v = (float)j / tubeSegments;
+				float tubeAngle = v * TWO_PI;
+				glm::vec3 normal = ringDirection * std::cos(tubeAngle) + glm::vec3(0.0f, 0.0f, std::sin(tubeAngle));
+				glm::vec3 position = ringDirection * TORUS_MAIN_RADIUS + normal * TORUS_TUBE_RADIUS;
+				AddVertex(vertices, position, normal, glm::vec2(u, v));
+			}
+		}
+		for (int i = 0; i < mainSegments; i++)
+		{
+			for (int j = 0; j < tubeSegments; j++)
+			{
+				GLuint i0 = i * (tubeSegments + 1) + j;
+				GLuint i1 = i0 + tubeSegments + 1;
+				indices.push_back(i0); indices.push_back(i1); indices.push_back(i0 + 1);
+				indices.push_back(i0 + 1); indices.push_back(i1); indices.push_back(i1 + 1);
+			}
+		}
+	}
+
+	/***********************************************************
+	 *  FixWinding()
+	 *
+	 *  Turn every triangle so that it winds counter clockwise
+	 *  when seen from the side its vertex normals face, which
+	 *  is what the glass face culling relies on.
+	 ***********************************************************/
+	template <class VERTEX>
+	void FixWinding(
+		const std::vector<VERTEX>& vertices,
+		std::vector<GLuint>& indices)
+	{
+		for (size_t i = 0; i + 2 < indices.size(); i += 3)
+		{
+			const VERTEX& v0 = vertices[indices[i]];
+			const VERTEX& v1 = vertices[indices[i + 1]];
+			const VERTEX& v2 = vertices[indices[i + 2]];
+
+			glm::vec3 faceNormal = glm::cross(v1.position - v0.position, v2.position - v0.position);
+			if (glm::dot(faceNormal, v0.normal + v1.normal + v2.normal) < 0.0f)
+			{
+				GLuint index = indices[i + 1];
+				indices[i + 1] = indices[i + 2];
+				indices[i + 2] = index;
+			}
+		}
+	}
+}
+
+/***********************************************************
+ *  MeshBuffers()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+MeshBuffers::MeshBuffers()
+{
+	for (int i = 0; i < SHAPE_COUNT; i++)
+	{
+		for (int lod = 0; lod < LOD_COUNT; lod++)
+		{
+			m_meshes[i][lod].indexCount = 0;
+			m_meshes[i][lod].firstIndex = 0;
+			m_meshes[i][lod].baseVertex = 0;
+		}
+		m_lodCounts[i] = 0;
+		m_meshBoxes[i].minimum = glm::vec3(0.0f);
+		m_meshBoxes[i].maximum = glm::vec3(0.0f);
+	}
+	m_vertexBuffer = 0;
+	m_indexBuffer = 0;
+	m_positionBuffer = 0;
+	m_instanceBuffer = 0;
+	m_pFrameRing = NULL;
+	for (int i = 0; i < STREAM_COUNT; i++)
+	{
+		m_instancedVAO[i] = 0;
+		m_indirectVAO[i] = 0;
+	}
+	m_bAttribBinding = false;
+}
+
+/***********************************************************
+ *  ~MeshBuffers()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+MeshBuffers::~MeshBuffers()
+{
+	if (m_instancedVAO[STREAM_ALL] != 0)
+	{
+		glDeleteVertexArrays(STREAM_COUNT, m_instancedVAO);
+		glDeleteVertexArrays(STREAM_COUNT, m_indirectVAO);
+		glDeleteBuffers(1, &m_vertexBuffer);
+		glDeleteBuffers(1, &m_positionBuffer);
+		glDeleteBuffers(1, &m_indexBuffer);
+		glDeleteBuffers(1, &m_instanceBuffer);
+	}
+}
+
+/***********************************************************
+ *  LoadMeshes()
+ *
+ *  This method is used for building the vertices of every
+ *  basic shape and uploading them into the shared vertex
+ *  and index buffers.
+ ***********************************************************/
+void MeshBuffers::LoadMeshes()
+{
+	std::vector<MESH_VERTEX> vertices;
+	std::vector<GLuint> indices;
+
+	// box - six faces from -0.5 to 0.5
+	AddQuad(vertices, indices, glm::vec3(0.0f, 0.0f, 0.5f), glm::vec3(0.5f, 0.0f, 0.0f), glm::vec3(0.0f, 0.5f, 0.0f));
+	AddQuad(vertices, indices, glm::vec3(0.0f, 0.0f, -0.5f), glm::vec3(-0.5f, 0.0f, 0.0f), glm::vec3(0.0f, 0.5f, 0.0f));
+	AddQuad(vertices, indices, glm::vec3(0.5f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, -0.5f), glm::vec3(0.0f, 0.5f, 0.0f));
+	AddQuad(vertices, indices, glm::vec3(-0.5f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.5f), glm::vec3(0.0f, 0.5f, 0.0f));
+	AddQuad(vertices, indices, glm::vec3(0.0f, 0.5f, 0.0f), glm::vec3(0.5f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, -0.5f));
+	AddQuad(vertices, indices, glm::vec3(0.0f, -0.5f, 0.0f), glm::vec3(0.5f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.5f));
+	AddMesh(SHAPE_BOX, 0, vertices, indices);
+
+	// cylinder - radius 1 from Y 0 to 1
+	for (int lod = 0; lod < LOD_COUNT; lod++)
+	{
+		AddFrustum(vertices, indices, 1.0f, 1.0f, CYLINDER_SIDES[lod]);
+		AddMesh(SHAPE_CYLINDER, lod, vertices, indices);
+	}
+
+	// sphere - radius 1
+	for (int lod = 0; lod < LOD_COUNT; lod++)
+	{
+		AddSphere(vertices, indices, SPHERE_STACKS[lod], SPHERE_SECTORS[lod]);
+		AddMesh(SHAPE_SPHERE, lod, vertices, indices);
+	}
+
+	// prism - triangular cross section in X and Y, from Z -0.5 to 0.5
+	{
+		glm::vec3 corners[3] =
+		{
+			glm::vec3(-0.5f, -0.5f, 0.0f),
+			glm::vec3(0.5f, -0.5f, 0.0f),
+			glm::vec3(0.0f, 0.5f, 0.0f)
+		};
+		glm::vec3 front = glm::vec3(0.0f, 0.0f, 0.5f);
+
+		AddFlatTriangle(vertices, indices,
+			corners[0] + front, glm::vec2(0.0f, 0.0f),
+			corners[1] + front, glm::vec2(1.0f, 0.0f),
+			corners[2] + front, glm::vec2(0.5f, 1.0f));
+		AddFlatTriangle(vertices, indices,
+			corners[0] - front, glm::vec2(1.0f, 0.0f),
+			corners[1] - front, glm::vec2(0.0f, 0.0f),
+			corners[2] - front, glm::vec2(0.5f, 1.0f));
+		for (int i = 0; i < 3; i++)
+		{
+			glm::vec3 a = corners[i];
+			glm::vec3 b = corners[(i + 1) % 3];
+			AddFlatTriangle(vertices, indices,
+				a + front, glm::vec2(0.0f, 0.0f),
+				b + front, glm::vec2(1.0f, 0.0f),
+				b - front, glm::vec2(1.0f, 1.0f));
+			AddFlatTriangle(vertices, indices,
+				a + front, glm::vec2(0.0f, 0.0f),
+				b - front, glm::vec2(1.0f, 1.0f),
+				a - front, glm::vec2(0.0f, 1.0f));
+		}
+	}
+	AddMesh(SHAPE_PRISM, 0, vertices, indices);
+
+	// plane - from -1 to 1 in X and Z, facing up
+	AddQuad(vertices, indices, glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, -1.0f));
+	AddMesh(SHAPE_PLANE, 0, vertices, indices);
+
+	// torus - main radius 1 around the Z axis
+	for (int lod = 0; lod < LOD_COUNT; lod++)
+	{
+		AddTorus(vertices, indices, TORUS_MAIN_SEGMENTS[lod], TORUS_TUBE_SEGMENTS[lod]);
+		AddMesh(SHAPE_TORUS, lod, vertices, indices);
+	}
+
+	// three sided pyramid - base at Y -0.5, apex at Y 0.5
+	{
+		glm::vec3 apex = glm::vec3(0.0f, 0.5f, 0.0f);
+		glm::vec3 base[3] =
+		{
+			glm::vec3(-0.5f, -0.5f, 0.5f),
+			glm::vec3(0.5f, -0.5f, 0.5f),
+			glm::vec3(0.0f, -0.5f, -0.5f)
+		};
+
+		AddFlatTriangle(vertices, indices,
+			base[0], glm::vec2(0.0f, 0.0f),
+			base[1], glm::vec2(1.0f, 0.0f),
+			base[2], glm::vec2(0.5f, 1.0f));
+		for (int i = 0; i < 3; i++)
+		{
+			AddFlatTriangle(vertices, indices,
+				base[i], glm::vec2(0.0f, 0.0f),
+				base[(i + 1) % 3], glm::vec2(1.0f, 0.0f),
+				apex, glm::vec2(0.5f, 1.0f));
+		}
+	}
+	AddMesh(SHAPE_PYRAMID3, 0, vertices, indices);
+
+	// tapered cylinder - base radius 1 at Y 0, top radius 0.5 at Y 1
+	for (int lod = 0; lod < LOD_COUNT; lod++)
+	{
+		AddFrustum(vertices, indices, 1.0f, 0.5f, CYLINDER_SIDES[lod]);
+		AddMesh(SHAPE_TAPERED_CYLINDER, lod, vertices, indices);
+	}
+
+	// the levels a shape was not built with draw its last level,
+	// so any level index can be drawn for any shape
+	for (int i = 0; i < SHAPE_COUNT; i++)
+	{
+		for (int lod = m_lodCounts[i]; lod < LOD_COUNT; lod++)
+		{
+			m_meshes[i][lod] = m_meshes[i][m_lodCounts[i] - 1];
+		}
+	}
+
+	CreateBuffers();
+}
+
+/***********************************************************
+ *  AddMesh()
+ *
+ *  This method is used for moving the vertices and indices
+ *  of one level of a shape into the shared lists.  The
+ *  indices stay relative to the level, and its first
+ *  vertex is kept as the base vertex of its draws.  The
+ *  bounding box of the full detail level is kept for
+ *  culling - the coarser levels have their corners on the
+ *  same surface, so they fit inside it.  The passed in
+ *  lists are cleared for the next level.
+ ***********************************************************/
+void MeshBuffers::AddMesh(
+	MESH_SHAPE shape,
+	int lodLevel,
+	std::vector<MESH_VERTEX>& vertices,
+	std::vector<GLuint>& indices)
+{
+	MESH_RANGE& mesh = m_meshes[shape][lodLevel];
+
+	FixWinding(vertices, indices);
+
+	mesh.indexCount = (GLsizei)indices.size();
+	mesh.firstIndex = (GLuint)m_allIndices.size();
+	mesh.baseVertex = (GLint)m_allVertices.size();
+	m_lodCounts[shape] = std::max(m_lodCounts[shape], lodLevel + 1);
+
+	if (lodLevel == 0)
+	{
+		MESH_BOX& box = m_meshBoxes[shape];
+		box.minimum = glm::vec3(1.0e30f);
+		box.maximum = glm::vec3(-1.0e30f);
+		for (int i = 0; i < vertices.size(); i++)
+		{
+			box.minimum = glm::min(box.minimum, vertices[i].position);
+			box.maximum = glm::max(box.maximum, vertices[i].position);
+		}
+	}
+
+	m_allVertices.insert(m_allVertices.end(), vertices.begin(), vertices.end());
+	m_allIndices.insert(m_allIndices.end(), indices.begin(), indices.end());
+
+	vertices.clear();
+	indices.clear();
+}
+
+/***********************************************************
+ *  SetVertexAttributes()
+ *
+ *  This method is used for pointing the per-vertex
+ *  attributes of the bound vertex array at the shared
+ *  vertex buffer, or only the position at the position
+ *  buffer.
+ ***********************************************************/
+void MeshBuffers::SetVertexAttributes(VERTEX_STREAM stream)
+{
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBuffer);
+
+	if (stream == STREAM_POSITION)
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, m_positionBuffer);
+		glEnableVertexAttribArray(ATTRIBUTE_POSITION);
+		glVertexAttribPointer(ATTRIBUTE_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
+		return;
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+
+	glEnableVertexAttribArray(ATTRIBUTE_POSITION);
+	glVertexAttribPointer(ATTRIBUTE_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(MESH_VERTEX), (void*)offsetof(MESH_VERTEX, position));
+	glEnableVertexAttribArray(ATTRIBUTE_NORMAL);
+	glVertexAttribPointer(ATTRIBUTE_NORMAL, 3, GL_FLOAT, GL_FALSE, sizeof(MESH_VERTEX), (void*)offsetof(MESH_VERTEX, normal));
+	glEnableVertexAttribArray(ATTRIBUTE_TEXTURE_COORDINATE);
+	glVertexAttribPointer(ATTRIBUTE_TEXTURE_COORDINATE, 2, GL_FLOAT, GL_FALSE, sizeof(MESH_VERTEX), (void*)offsetof(MESH_VERTEX, textureCoordinate));
+}
+
+/***********************************************************
+ *  SetInstanceAttributes()
+ *
+ *  This method is used for setting the per-instance
+ *  attributes of the bound instanced vertex array.  The
+ *  model matrix takes one location for each of its
+ *  columns, and the position stream only reads it.
+ ***********************************************************/
+void MeshBuffers::SetInstanceAttributes(VERTEX_STREAM stream, GLintptr offset)
+{
+	for (int column = 0; column < 4; column++)
+	{
+		SetInstanceAttribute(m_bAttribBinding, ATTRIBUTE_INSTANCE_MODEL + column, 4, GL_FLOAT,
+			(GLuint)(offsetof(INSTANCE_DATA, model) + sizeof(glm::vec4) * column), offset);
+	}
+	if (stream != STREAM_ALL)
+	{
+		return;
+	}
+
+	SetInstanceAttribute(m_bAttribBinding, ATTRIBUTE_INSTANCE_COLOR, 4, GL_FLOAT, offsetof(INSTANCE_DATA, color), offset);
+	SetInstanceAttribute(m_bAttribBinding, ATTRIBUTE_INSTANCE_UV_SCALE, 2, GL_FLOAT, offsetof(INSTANCE_DATA, UVscale), offset);
+	SetInstanceAttribute(m_bAttribBinding, ATTRIBUTE_INSTANCE_MATERIAL, 1, GL_INT, offsetof(INSTANCE_DATA, materialIndex), offset);
+	SetInstanceAttribute(m_bAttribBinding, ATTRIBUTE_INSTANCE_TEXTURE, 1, GL_INT, offsetof(INSTANCE_DATA, textureIndex), offset);
+	for (int column = 0; column < 3; column++)
+	{
+		SetInstanceAttribute(m_bAttribBinding, ATTRIBUTE_INSTANCE_NORMAL_MATRIX + column, 3, GL_FLOAT,
+			(GLuint)(offsetof(INSTANCE_DATA, normalMatrix) + sizeof(glm::vec4) * column), offset);
+	}
+}
+
+/***********************************************************
+ *  BindInstanceBuffer()
+ *
+ *  This method is used for pointing the instance attributes
+ *  of the bound instanced vertex array at a range of a
+ *  buffer - by moving the instance binding when there is
+ *  one, otherwise by setting the attribute pointers again.
+ ***********************************************************/
+void MeshBuffers::BindInstanceBuffer(VERTEX_STREAM stream, GLuint buffer, GLintptr offset)
+{
+	if (m_bAttribBinding == true)
+	{
+		glBindVertexBuffer(INSTANCE_BINDING, buffer, offset, sizeof(INSTANCE_DATA));
+		return;
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, buffer);
+	SetInstanceAttributes(stream, offset);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+/***********************************************************
+ *  CreateBuffers()
+ *
+ *  This method is used for uploading the shared vertex and
+ *  index lists and building the vertex arrays - the
+ *  instanced ones also read the per-instance attributes,
+ *  the indirect ones only the per-vertex attributes.  The
+ *  position stream arrays skip everything a depth only
+ *  draw does not read.
+ ***********************************************************/
+void MeshBuffers::CreateBuffers()
+{
+	m_bAttribBinding = (GLEW_VERSION_4_3 || GLEW_ARB_vertex_attrib_binding);
+
+	glGenBuffers(1, &m_vertexBuffer);
+	glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+	glBufferData(GL_ARRAY_BUFFER, m_allVertices.size() * sizeof(MESH_VERTEX), m_allVertices.data(), GL_STATIC_DRAW);
+	RenderStats::Add(RenderStats::COUNTER_BYTES_UPLOADED, m_allVertices.size() * sizeof(MESH_VERTEX));
+
+	glGenBuffers(1, &m_indexBuffer);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBuffer);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_allIndices.size() * sizeof(GLuint), m_allIndices.data(), GL_STATIC_DRAW);
+	RenderStats::Add(RenderStats::COUNTER_BYTES_UPLOADED, m_allIndices.size() * sizeof(GLuint));
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+	// the positions again, without the other attributes
+	std::vector<glm::vec3> positions(m_allVertices.size());
+	for (int i = 0; i < m_allVertices.size(); i++)
+	{
+		positions[i] = m_allVertices[i].position;
+	}
+	glGenBuffers(1, &m_positionBuffer);
+	glBindBuffer(GL_ARRAY_BUFFER, m_positionBuffer);
+	glBufferData(GL_ARRAY_BUFFER, positions.size() * sizeof(glm::vec3), positions.data(), GL_STATIC_DRAW);
+	RenderStats::Add(RenderStats::COUNTER_BYTES_UPLOADED, positions.size() * sizeof(glm::vec3));
+
+	glGenBuffers(1, &m_instanceBuffer);
+
+	glGenVertexArrays(STREAM_COUNT, m_instancedVAO);
+	glGenVertexArrays(STREAM_COUNT, m_indirectVAO);
+	for (int stream = 0; stream < STREAM_COUNT; stream++)
+	{
+		// instanced vertex array
+		glBindVertexArray(m_instancedVAO[stream]);
+		SetVertexAttributes((VERTEX_STREAM)stream);
+
+		// per-instance attributes, read through the instance
+		// binding where the context has one
+		glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+		SetInstanceAttributes((VERTEX_STREAM)stream, 0);
+		if (m_bAttribBinding == true)
+		{
+			glVertexBindingDivisor(INSTANCE_BINDING, 1);
+			glBindVertexBuffer(INSTANCE_BINDING, m_instanceBuffer, 0, sizeof(INSTANCE_DATA));
+		}
+
+		// indirect vertex array - the per-draw values come from
+		// the draw data storage buffer instead
+		glBindVertexArray(m_indirectVAO[stream]);
+		SetVertexAttributes((VERTEX_STREAM)stream);
+	}
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	// the lists are no longer needed once uploaded
+	m_allVertices.clear();
+	m_allVertices.shrink_to_fit();
+	m_allIndices.clear();
+	m_allIndices.shrink_to_fit();
+}
+
+/***********************************************************
+ *  DrawInstanced()
+ *
+ *  This method is used for drawing a number of copies of
+ *  one level of a shape with one draw call.  The instances
+ *  are written into the frame ring and the instance
+ *  attributes pointed at them.  Without room in a ring the
+ *  instance buffer is orphaned before it is refilled, so
+ *  the driver does not wait on draws that still read the
+ *  previous contents.
+ ***********************************************************/
+void MeshBuffers::DrawInstanced(
+	MESH_SHAPE shape,
+	int lodLevel,
+	const INSTANCE_DATA* instances,
+	int instanceCount,
+	VERTEX_STREAM stream)
+{
+	const MESH_RANGE& mesh = m_meshes[shape][lodLevel];
+	if ((instanceCount <= 0) || (mesh.indexCount == 0))
+	{
+		return;
+	}
+
+	GLsizeiptr size = sizeof(INSTANCE_DATA) * instanceCount;
+	glBindVertexArray(m_instancedVAO[stream]);
+
+	FrameRingBuffer::ALLOCATION allocation;
+	if ((m_pFrameRing != NULL) && (m_pFrameRing->Allocate(size, INSTANCE_ALIGNMENT, allocation) == true))
+	{
+		memcpy(allocation.pData, instances, size);
+		BindInstanceBuffer(stream, m_pFrameRing->GetBuffer(), allocation.offset);
+	}
+	else
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+		glBufferData(GL_ARRAY_BUFFER, size, NULL, GL_STREAM_DRAW);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, size, instances);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		BindInstanceBuffer(stream, m_instanceBuffer, 0);
+	}
+
+	glDrawElementsInstancedBaseVertex(
+		GL_TRIANGLES,
+		mesh.indexCount,
+		GL_UNSIGNED_INT,
+		(void*)(sizeof(GLuint) * mesh.firstIndex),
+		instanceCount,
+		mesh.baseVertex);
+	glBindVertexArray(0);
+
+	RenderStats::Add(RenderStats::COUNTER_DRAW_CALLS);
+	RenderStats::Add(RenderStats::COUNTER_TRIANGLES, (long long)(mesh.indexCount / 3) * instanceCount);
+	RenderStats::Add(RenderStats::COUNTER_BYTES_UPLOADED, size);
+}
+
+/***********************************************************
+ *  DrawIndirect()
+ *
+ *  This method is used for drawing a run of the commands
+ *  in the bound GL_DRAW_INDIRECT_BUFFER with one call.
+ *  The commands address the shared index buffer through
+ *  the ranges from GetMeshRange().  The caller counts the
+ *  triangles, since only the command buffer knows them.
+ ***********************************************************/
+void MeshBuffers::DrawIndirect(int firstCommand, int commandCount, VERTEX_STREAM stream)
+{
+	if (commandCount <= 0)
+	{
+		return;
+	}
+
+	// the five GLuint fields of a DrawElementsIndirectCommand
+	const GLsizeiptr commandSize = sizeof(GLuint) * 5;
+
+	glBindVertexArray(m_indirectVAO[stream]);
+	glMultiDrawElementsIndirect(
+		GL_TRIANGLES,
+		GL_UNSIGNED_INT,
+		(void*)(commandSize * firstCommand),
+		commandCount,
+		0);
+	glBindVertexArray(0);
+
+	RenderStats::Add(RenderStats::COUNTER_DRAW_CALLS);
+}
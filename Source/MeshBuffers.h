@@ -0,0 +1,204 @@
+///////////////////////////////////////////////////////////////////////////////
+// meshbuffers.h
+// ============
+// build the basic shape meshes into vertex buffers and draw them instanced
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+//  Notes: The shapes match the unit sizes of the ShapeMeshes primitives -
+//         a box from -0.5 to 0.5, a plane from -1 to 1 in X and Z, a
+//         cylinder of radius 1 from Y 0 to 1, a sphere of radius 1 and so
+//         on - so the scene transforms are unchanged.  All of the shapes
+//         share one vertex and one index buffer.  The instanced VAO also
+//         reads a per-instance model matrix, color, UV scale, material
+//         index and texture index, so any number of copies of a shape are
+//         one draw call, and the indirect VAO lets a single multi-draw call
+//         mix shapes.  The positions are also kept in a tightly packed
+//         stream of their own for the depth pre-pass.
+//         The round shapes are built at LOD_COUNT levels of detail, each
+//         with about half the segments of the one before, so small or
+//         distant copies can be drawn with far fewer vertices.  The flat
+//         shapes have one level, which every level index falls back to.
+//         The per-instance attributes read a vertex buffer binding of
+//         their own, which each draw points at the range of the frame
+//         ring its instances were written to.  Without a ring they are
+//         refilled into one orphaned buffer for every draw.  A context
+//         without GL 4.3 or ARB_vertex_attrib_binding has no separate
+//         binding, so each draw points the instance attributes at the
+//         range with glVertexAttribPointer() instead.
+//         Each instance also carries the normal matrix of its model
+//         matrix, built once per node on the CPU, so the vertex shader
+//         turns the normals into world space without an inverse.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "FrameRingBuffer.h"
+
+#include <GL/glew.h>
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+/***********************************************************
+ *  MeshBuffers
+ *
+ *  This class owns the vertex, index and instance buffers
+ *  of the basic shape meshes.
+ ***********************************************************/
+class MeshBuffers
+{
+public:
+	// the basic shapes, in the same order as the scene mesh types
+	enum MESH_SHAPE
+	{
+		SHAPE_BOX = 0,
+		SHAPE_CYLINDER,
+		SHAPE_SPHERE,
+		SHAPE_PRISM,
+		SHAPE_PLANE,
+		SHAPE_TORUS,
+		SHAPE_PYRAMID3,
+		SHAPE_TAPERED_CYLINDER,
+		SHAPE_COUNT
+	};
+
+	// levels of detail built for the round shapes, level 0 is
+	// the full tessellation
+	static const int LOD_COUNT = 3;
+
+	// vertex attribute locations, shared with vertexShader.glsl
+	enum ATTRIBUTE_LOCATION
+	{
+		ATTRIBUTE_POSITION = 0,
+		ATTRIBUTE_NORMAL = 1,
+		ATTRIBUTE_TEXTURE_COORDINATE = 2,
+		ATTRIBUTE_INSTANCE_MODEL = 3,        // a mat4 takes locations 3 to 6
+		ATTRIBUTE_INSTANCE_COLOR = 7,
+		ATTRIBUTE_INSTANCE_UV_SCALE = 8,
+		ATTRIBUTE_INSTANCE_MATERIAL = 9,
+		ATTRIBUTE_INSTANCE_TEXTURE = 10,
+		ATTRIBUTE_INSTANCE_NORMAL_MATRIX = 11 // a mat3 takes locations 11 to 13
+	};
+
+	// vertex streams a draw can read from
+	enum VERTEX_STREAM
+	{
+		STREAM_ALL = 0,      // interleaved position, normal and texture coordinate
+		STREAM_POSITION,     // positions only - for depth only draws
+		STREAM_COUNT
+	};
+
+	// the values that change between copies of a shape - the
+	// layout also matches the std430 DrawData of the indirect path
+	struct INSTANCE_DATA
+	{
+		glm::mat4 model;
+		glm::vec4 color;
+		glm::vec2 UVscale;
+		int materialIndex;
+		// scene texture slot, -1 for a solid color
+		int textureIndex;
+		// inverse transpose of the upper 3x3 of the model matrix,
+		// one column per vec4 as std430 lays out a mat3
+		glm::vec4 normalMatrix[3];
+	};
+
+	// constructor
+	MeshBuffers();
+	// destructor
+	~MeshBuffers();
+
+	// build every shape and upload it to the GPU
+	void LoadMeshes();
+	// set the ring the instances of each draw are written to,
+	// NULL to upload them into the instance buffer instead
+	void SetFrameRing(FrameRingBuffer* pFrameRing) { m_pFrameRing = pFrameRing; }
+	// draw a number of copies of a shape in one draw call
+	void DrawInstanced(
+		MESH_SHAPE shape,
+		int lodLevel,
+		const INSTANCE_DATA* instances,
+		int instanceCount,
+		VERTEX_STREAM stream);
+	// draw the commands of the bound GL_DRAW_INDIRECT_BUFFER,
+	// starting at the passed in command, in one call
+	void DrawIndirect(int firstCommand, int commandCount, VERTEX_STREAM stream);
+
+	// the part of the shared index buffer that holds a shape
+	struct MESH_RANGE
+	{
+		GLsizei indexCount;
+		GLuint firstIndex;
+		GLint baseVertex;
+	};
+	const MESH_RANGE& GetMeshRange(MESH_SHAPE shape, int lodLevel) const { return(m_meshes[shape][lodLevel]); }
+	// get the number of distinct levels of detail of a shape
+	int GetLodCount(MESH_SHAPE shape) const { return(m_lodCounts[shape]); }
+
+	// the object space bounding box of a shape, from the vertices
+	// of its full detail level
+	struct MESH_BOX
+	{
+		glm::vec3 minimum;
+		glm::vec3 maximum;
+	};
+	const MESH_BOX& GetMeshBox(MESH_SHAPE shape) const { return(m_meshBoxes[shape]); }
+
+private:
+
+	// interleaved vertex - position, normal, texture coordinate
+	struct MESH_VERTEX
+	{
+		glm::vec3 position;
+		glm::vec3 normal;
+		glm::vec2 textureCoordinate;
+	};
+
+	MESH_RANGE m_meshes[SHAPE_COUNT][LOD_COUNT];
+	int m_lodCounts[SHAPE_COUNT];
+	MESH_BOX m_meshBoxes[SHAPE_COUNT];
+	// vertices and indices of every shape
+	GLuint m_vertexBuffer;
+	GLuint m_indexBuffer;
+	// the vertex positions alone, in the same order
+	GLuint m_positionBuffer;
+	// per-instance values, refilled for every draw when there
+	// is no frame ring or its region is full
+	GLuint m_instanceBuffer;
+	FrameRingBuffer* m_pFrameRing;
+	// vertex arrays for the instanced and the indirect draws,
+	// one of each per vertex stream
+	GLuint m_instancedVAO[STREAM_COUNT];
+	GLuint m_indirectVAO[STREAM_COUNT];
+	// true when the instance attributes read a vertex buffer
+	// binding of their own
+	bool m_bAttribBinding;
+	// every shape is gathered here before the buffers are made
+	std::vector<MESH_VERTEX> m_allVertices;
+	std::vector<GLuint> m_allIndices;
+
+	// move the vertices and indices of a level of a shape into
+	// the shared lists and record its range - the lists are cleared
+	void AddMesh(
+		MESH_SHAPE shape,
+		int lodLevel,
+		std::vector<MESH_VERTEX>& vertices,
+		std::vector<GLuint>& indices);
+	// upload the shared lists and build both vertex arrays
+	void CreateBuffers();
+	// point the per-vertex attributes of the bound vertex
+	// array at the buffer of a vertex stream
+	void SetVertexAttributes(VERTEX_STREAM stream);
+	// set the per-instance attributes of the bound instanced
+	// vertex array - without a binding of their own they are
+	// pointed at an offset of the bound GL_ARRAY_BUFFER
+	void SetInstanceAttributes(VERTEX_STREAM stream, GLintptr offset);
+	// point the instance attributes of the bound instanced
+	// vertex array at a range of a buffer
+	void BindInstanceBuffer(VERTEX_STREAM stream, GLuint buffer, GLintptr offset);
+};
+
+// the instances are read as the std430 DrawData array of the indirect path
+static_assert(sizeof(MeshBuffers::INSTANCE_DATA) == 144, "INSTANCE_DATA must match the std430 DrawData layout");
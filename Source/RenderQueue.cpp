@@ -0,0 +1,275 @@
+///////////////////////////////////////////////////////////////////////////////
+// renderqueue.cpp
+// ============
+// collect the draws of a frame and order them for submission - opaque draws
+// by render state, translucent draws back to front
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "RenderQueue.h"
+
+#include <algorithm>
+#include <cmath>
+
+// declaration of global variables
+namespace
+{
+	// bit positions and widths of the sort key fields, from the
+	// most significant field down
+	const int KEY_PASS_SHIFT = 60;       // 4 bits
+	const int KEY_SHADER_SHIFT = 52;     // 8 bits
+	const int KEY_DEPTH_SHIFT = 48;      // 4 bits
+	const int KEY_TEXTURE_SHIFT = 36;    // 12 bits
+	const int KEY_MESH_SHIFT = 28;       // 8 bits
+	const int KEY_CULL_SHIFT = 24;       // 4 bits
+	const int KEY_MATERIAL_SHIFT = 8;    // 16 bits
+
+	// smaller queues sort faster on one thread
+	const int MIN_PARALLEL_SORT_ITEMS = 4096;
+	// depth buckets per doubling of the view depth
+	const float DEPTH_BUCKETS_PER_OCTAVE = 2.0f;
+
+	/***********************************************************
+	 *  KeyField()
+	 *
+	 *  Mask a value to the number of bits of its key field and
+	 *  move it into position.
+	 ***********************************************************/
+	unsigned long long KeyField(int value, int bits, int shift)
+	{
+		unsigned long long mask = (1ULL << bits) - 1;
+		return(((unsigned long long)value & mask) << shift);
+	}
+
+	/***********************************************************
+	 *  CompareItems()
+	 *
+	 *  Order two queued items - by pass first, then by depth
+	 *  for back to front items, otherwise by sort key.  The
+	 *  node index keeps the order stable.
+	 ***********************************************************/
+	bool CompareItems(const RenderQueue::RENDER_ITEM& a, const RenderQueue::RENDER_ITEM& b)
+	{
+		int passA = RenderQueue::GetKeyPass(a.sortKey);
+		int passB = RenderQueue::GetKeyPass(b.sortKey);
+		if (passA != passB)
+		{
+			return(passA < passB);
+		}
+
+		if ((a.depthOrder == RenderQueue::ORDER_BACK_TO_FRONT) &&
+			(b.depthOrder == RenderQueue::ORDER_BACK_TO_FRONT) &&
+			(a.viewDepth != b.viewDepth))
+		{
+			return(a.viewDepth > b.viewDepth);
+		}
+
+		if (a.sortKey != b.sortKey)
+		{
+			return(a.sortKey < b.sortKey);
+		}
+
+		return(a.nodeIndex < b.nodeIndex);
+	}
+}
+
+/***********************************************************
+ *  RenderQueue()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+RenderQueue::RenderQueue()
+{
+}
+
+/***********************************************************
+ *  MakeSortKey()
+ *
+ *  This method is used for packing the render state of a
+ *  draw into a sort key.  The fields are ordered by the
+ *  cost of changing them, so sorted keys change the most
+ *  expensive state the fewest times.  The material is a
+ *  per-instance value, so it sorts below the mesh and
+ *  culling that end an instanced batch.  A texture or
+ *  material of -1 sorts ahead of every real one.  The
+ *  depth bucket sits below the shader, so the nearer
+ *  buckets draw first without changing programs more.
+ ***********************************************************/
+unsigned long long RenderQueue::MakeSortKey(
+	int pass,
+	int shader,
+	int texture,
+	int material,
+	int mesh,
+	int cullState,
+	int depthBucket)
+{
+	unsigned long long sortKey = 0;
+
+	sortKey |= KeyField(pass, 4, KEY_PASS_SHIFT);
+	sortKey |= KeyField(shader, 8, KEY_SHADER_SHIFT);
+	sortKey |= KeyField(depthBucket, 4, KEY_DEPTH_SHIFT);
+	sortKey |= KeyField(texture + 1, 12, KEY_TEXTURE_SHIFT);
+	sortKey |= KeyField(mesh, 8, KEY_MESH_SHIFT);
+	sortKey |= KeyField(cullState, 4, KEY_CULL_SHIFT);
+	sortKey |= KeyField(material + 1, 16, KEY_MATERIAL_SHIFT);
+
+	return(sortKey);
+}
+
+/***********************************************************
+ *  GetDepthBucket()
+ *
+ *  This method is used for getting the bucket of a view
+ *  depth.  The buckets grow with the distance, a couple
+ *  per doubling, so the near surfaces that cover the most
+ *  of the screen are told apart finest.
+ ***********************************************************/
+int RenderQueue::GetDepthBucket(float viewDepth)
+{
+	float depth = std::max(viewDepth, 0.0f);
+	int bucket = (int)(std::log2(1.0f + depth) * DEPTH_BUCKETS_PER_OCTAVE);
+
+	return(std::min(bucket, DEPTH_BUCKET_COUNT - 1));
+}
+
+/***********************************************************
+ *  GetKeyPass()
+ *
+ *  This method is used for getting the render pass that
+ *  was packed into a sort key.
+ ***********************************************************/
+int RenderQueue::GetKeyPass(unsigned long long sortKey)
+{
+	return((int)(sortKey >> KEY_PASS_SHIFT));
+}
+
+/***********************************************************
+ *  Clear()
+ *
+ *  This method is used for removing all of the queued
+ *  items.  The storage is kept for the next frame.
+ ***********************************************************/
+void RenderQueue::Clear()
+{
+	m_items.clear();
+}
+
+/***********************************************************
+ *  AddItem()
+ *
+ *  This method is used for queueing a draw that is
+ *  grouped with the draws that share its render state.
+ ***********************************************************/
+void RenderQueue::AddItem(unsigned long long sortKey, int nodeIndex)
+{
+	AddDepthItem(sortKey, 0.0f, ORDER_STATE, nodeIndex);
+}
+
+/***********************************************************
+ *  AddBackToFrontItem()
+ *
+ *  This method is used for queueing a blended draw that
+ *  must be drawn after the draws behind it.
+ ***********************************************************/
+void RenderQueue::AddBackToFrontItem(unsigned long long sortKey, float viewDepth, int nodeIndex)
+{
+	AddDepthItem(sortKey, viewDepth, ORDER_BACK_TO_FRONT, nodeIndex);
+}
+
+/***********************************************************
+ *  AddDepthItem()
+ *
+ *  This method is used for adding an item to the queue
+ *  with the order it is sorted by.
+ ***********************************************************/
+void RenderQueue::AddDepthItem(unsigned long long sortKey, float viewDepth, DEPTH_ORDER depthOrder, int nodeIndex)
+{
+	m_items.push_back(MakeItem(sortKey, viewDepth, depthOrder, nodeIndex));
+}
+
+/***********************************************************
+ *  MakeItem()
+ *
+ *  This method is used for filling in a queue item, for
+ *  lists of items built away from the queue.
+ ***********************************************************/
+RenderQueue::RENDER_ITEM RenderQueue::MakeItem(unsigned long long sortKey, float viewDepth, DEPTH_ORDER depthOrder, int nodeIndex)
+{
+	RENDER_ITEM item;
+
+	item.sortKey = sortKey;
+	item.viewDepth = viewDepth;
+	item.depthOrder = depthOrder;
+	item.nodeIndex = nodeIndex;
+
+	return(item);
+}
+
+/***********************************************************
+ *  AddItems()
+ *
+ *  This method is used for queueing a list of items made
+ *  with MakeItem(), such as one item per scene node filled
+ *  in by job threads.  Items with a node index of -1 are
+ *  left out.
+ ***********************************************************/
+void RenderQueue::AddItems(const std::vector<RENDER_ITEM>& items)
+{
+	for (int i = 0; i < items.size(); i++)
+	{
+		if (items[i].nodeIndex >= 0)
+		{
+			m_items.push_back(items[i]);
+		}
+	}
+}
+
+/***********************************************************
+ *  Sort()
+ *
+ *  This method is used for sorting the queued items into
+ *  the order they are submitted in.  Large queues are cut
+ *  into one run per job thread, sorted at the same time
+ *  and then merged.
+ ***********************************************************/
+void RenderQueue::Sort(JobSystem* pJobSystem)
+{
+	int threadCount = (pJobSystem != NULL) ? pJobSystem->GetThreadCount() : 1;
+	int itemCount = (int)m_items.size();
+	if ((threadCount == 1) || (itemCount < MIN_PARALLEL_SORT_ITEMS))
+	{
+		std::sort(m_items.begin(), m_items.end(), CompareItems);
+		return;
+	}
+
+	// sort one run of the items per thread
+	int runSize = (itemCount + threadCount - 1) / threadCount;
+	std::vector<RENDER_ITEM>& items = m_items;
+	pJobSystem->ParallelFor(itemCount, runSize, [&items](int first, int count)
+		{
+			std::sort(items.begin() + first, items.begin() + first + count, CompareItems);
+		});
+
+	// merge neighbouring runs until one is left - the compare
+	// is a total order, so the merged order is the same as one
+	// sort of the whole queue
+	while (runSize < itemCount)
+	{
+		int mergeSize = runSize * 2;
+		pJobSystem->ParallelFor(itemCount, mergeSize, [&items, runSize](int first, int count)
+			{
+				if (count > runSize)
+				{
+					std::inplace_merge(
+						items.begin() + first,
+						items.begin() + first + runSize,
+						items.begin() + first + count,
+						CompareItems);
+				}
+			});
+		runSize = mergeSize;
+	}
+}
@@ -0,0 +1,104 @@
+///////////////////////////////////////////////////////////////////////////////
+// renderqueue.h
+// ============
+// collect the draws of a frame and order them for submission - opaque draws
+// by render state, translucent draws back to front
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+//  Notes: Each draw is described by a 64 bit sort key with the render pass
+//         in the highest bits, followed by the shader, a depth bucket, the
+//         texture, mesh, face culling and material.  Sorting the keys
+//         groups draws that share state, so each texture is bound a few
+//         times a frame and copies of a mesh end up next to each other for
+//         instancing.  Opaque draws can be given a coarse view depth bucket
+//         from GetDepthBucket(), so the nearest surfaces roughly fill the
+//         depth buffer first while the state below the bucket still
+//         batches, and the order only changes when a draw crosses into
+//         another bucket.  Passes flagged back to front are ordered by
+//         their exact view depth instead.
+//         Items can be made on job threads and queued as a list, and the
+//         queue sorted over a JobSystem - each thread sorts a run of the
+//         items and the runs are merged pairwise.  The order comes out
+//         the same as a single threaded sort.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "JobSystem.h"
+
+#include <vector>
+
+/***********************************************************
+ *  RenderQueue
+ *
+ *  This class holds the draws of one frame and sorts them
+ *  into submission order.
+ ***********************************************************/
+class RenderQueue
+{
+public:
+	// how the items of one pass are ordered
+	enum DEPTH_ORDER
+	{
+		ORDER_STATE = 0,          // grouped by render state
+		ORDER_BACK_TO_FRONT       // farthest first, for blending
+	};
+
+	// number of view depth buckets an opaque sort key can hold
+	static const int DEPTH_BUCKET_COUNT = 16;
+
+	struct RENDER_ITEM
+	{
+		// packed render state - see MakeSortKey()
+		unsigned long long sortKey;
+		// distance in front of the camera, used by depth ordered items
+		float viewDepth;
+		DEPTH_ORDER depthOrder;
+		// index of the scene node to draw
+		int nodeIndex;
+	};
+
+	// constructor
+	RenderQueue();
+
+	// pack the render state of a draw into a sort key - the
+	// texture and material may be -1 for none, and the depth
+	// bucket is 0 for draws that are not depth ordered
+	static unsigned long long MakeSortKey(
+		int pass,
+		int shader,
+		int texture,
+		int material,
+		int mesh,
+		int cullState,
+		int depthBucket = 0);
+	// get the coarse bucket of a view depth, nearest first
+	static int GetDepthBucket(float viewDepth);
+	// get the render pass that a sort key was made with
+	static int GetKeyPass(unsigned long long sortKey);
+	// make an item to queue with AddItems()
+	static RENDER_ITEM MakeItem(unsigned long long sortKey, float viewDepth, DEPTH_ORDER depthOrder, int nodeIndex);
+
+	// remove all of the queued items
+	void Clear();
+	// queue a draw that is grouped by render state
+	void AddItem(unsigned long long sortKey, int nodeIndex);
+	// queue a blended draw that is ordered back to front
+	void AddBackToFrontItem(unsigned long long sortKey, float viewDepth, int nodeIndex);
+	// queue a list of items, leaving out those with a node
+	// index of -1
+	void AddItems(const std::vector<RENDER_ITEM>& items);
+	// sort the queued items into submission order - spread over
+	// the job threads when a job system is passed in
+	void Sort(JobSystem* pJobSystem = NULL);
+
+	// get the queued items
+	const std::vector<RENDER_ITEM>& GetItems() const { return(m_items); }
+
+private:
+	std::vector<RENDER_ITEM> m_items;
+
+	// queue an item with its order
+	void AddDepthItem(unsigned long long sortKey, float viewDepth, DEPTH_ORDER depthOrder, int nodeIndex);
+};
@@ -0,0 +1,225 @@
+///////////////////////////////////////////////////////////////////////////////
+// renderstate.cpp
+// ============
+// keep a copy of the fixed function OpenGL state so only real changes of it
+// reach the driver
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "RenderState.h"
+#include "RenderStats.h"
+
+RenderState::PIPELINE_STATE RenderState::s_current =
+{
+	false, GL_ONE, GL_ZERO, false, true, GL_LESS, true
+};
+GLenum RenderState::s_cullFace = GL_NONE;
+unsigned int RenderState::s_knownFields = 0;
+
+/***********************************************************
+ *  IsCurrent()
+ *
+ *  This method is used for checking whether a set can be
+ *  skipped - the field is known and already holds the new
+ *  value.  A skipped set is counted as redundant, and an
+ *  unknown field is marked known, since the caller is
+ *  about to send it.
+ ***********************************************************/
+bool RenderState::IsCurrent(STATE_FIELD field, bool bSame)
+{
+	if (((s_knownFields & field) != 0) && (bSame == true))
+	{
+		RenderStats::Add(RenderStats::COUNTER_STATE_REDUNDANT);
+		return(true);
+	}
+
+	s_knownFields |= field;
+	return(false);
+}
+
+/***********************************************************
+ *  Apply()
+ *
+ *  This method is used for setting every value of a
+ *  pipeline state block.  Only the values that differ from
+ *  the current state are sent.
+ ***********************************************************/
+void RenderState::Apply(const PIPELINE_STATE& state)
+{
+	SetBlend(state.bBlend);
+	SetBlendFunc(state.blendSource, state.blendDestination);
+	SetDepthTest(state.bDepthTest);
+	SetDepthWrite(state.bDepthWrite);
+	SetDepthFunc(state.depthFunc);
+	SetColorWrite(state.bColorWrite);
+}
+
+/***********************************************************
+ *  SetBlend()
+ *
+ *  This method is used for turning blending on or off.
+ ***********************************************************/
+void RenderState::SetBlend(bool bBlend)
+{
+	if (IsCurrent(FIELD_BLEND, s_current.bBlend == bBlend) == true)
+	{
+		return;
+	}
+
+	if (bBlend == true)
+	{
+		glEnable(GL_BLEND);
+	}
+	else
+	{
+		glDisable(GL_BLEND);
+	}
+	s_current.bBlend = bBlend;
+	RenderStats::Add(RenderStats::COUNTER_BLEND_STATE);
+}
+
+/***********************************************************
+ *  SetBlendFunc()
+ *
+ *  This method is used for setting the blend factors.
+ ***********************************************************/
+void RenderState::SetBlendFunc(GLenum source, GLenum destination)
+{
+	bool bSame = (s_current.blendSource == source) && (s_current.blendDestination == destination);
+	if (IsCurrent(FIELD_BLEND_FUNC, bSame) == true)
+	{
+		return;
+	}
+
+	glBlendFunc(source, destination);
+	s_current.blendSource = source;
+	s_current.blendDestination = destination;
+	RenderStats::Add(RenderStats::COUNTER_BLEND_STATE);
+}
+
+/***********************************************************
+ *  SetDepthTest()
+ *
+ *  This method is used for turning the depth test on or
+ *  off.
+ ***********************************************************/
+void RenderState::SetDepthTest(bool bDepthTest)
+{
+	if (IsCurrent(FIELD_DEPTH_TEST, s_current.bDepthTest == bDepthTest) == true)
+	{
+		return;
+	}
+
+	if (bDepthTest == true)
+	{
+		glEnable(GL_DEPTH_TEST);
+	}
+	else
+	{
+		glDisable(GL_DEPTH_TEST);
+	}
+	s_current.bDepthTest = bDepthTest;
+	RenderStats::Add(RenderStats::COUNTER_DEPTH_STATE);
+}
+
+/***********************************************************
+ *  SetDepthWrite()
+ *
+ *  This method is used for turning depth writes on or off.
+ ***********************************************************/
+void RenderState::SetDepthWrite(bool bDepthWrite)
+{
+	if (IsCurrent(FIELD_DEPTH_WRITE, s_current.bDepthWrite == bDepthWrite) == true)
+	{
+		return;
+	}
+
+	glDepthMask(bDepthWrite ? GL_TRUE : GL_FALSE);
+	s_current.bDepthWrite = bDepthWrite;
+	RenderStats::Add(RenderStats::COUNTER_DEPTH_STATE);
+}
+
+/***********************************************************
+ *  SetDepthFunc()
+ *
+ *  This method is used for setting the depth comparison.
+ ***********************************************************/
+void RenderState::SetDepthFunc(GLenum depthFunc)
+{
+	if (IsCurrent(FIELD_DEPTH_FUNC, s_current.depthFunc == depthFunc) == true)
+	{
+		return;
+	}
+
+	glDepthFunc(depthFunc);
+	s_current.depthFunc = depthFunc;
+	RenderStats::Add(RenderStats::COUNTER_DEPTH_STATE);
+}
+
+/***********************************************************
+ *  SetColorWrite()
+ *
+ *  This method is used for turning color writes on or off
+ *  for all four channels at once.
+ ***********************************************************/
+void RenderState::SetColorWrite(bool bColorWrite)
+{
+	if (IsCurrent(FIELD_COLOR_WRITE, s_current.bColorWrite == bColorWrite) == true)
+	{
+		return;
+	}
+
+	GLboolean mask = bColorWrite ? GL_TRUE : GL_FALSE;
+	glColorMask(mask, mask, mask, mask);
+	s_current.bColorWrite = bColorWrite;
+}
+
+/***********************************************************
+ *  SetCullFace()
+ *
+ *  This method is used for setting the face culling for
+ *  the next draws.  GL_NONE turns face culling off, and
+ *  switching between the front and back faces leaves it
+ *  enabled.
+ ***********************************************************/
+void RenderState::SetCullFace(GLenum cullFace)
+{
+	if (IsCurrent(FIELD_CULL_FACE, s_cullFace == cullFace) == true)
+	{
+		return;
+	}
+
+	// Invalidate() leaves GL_NONE, so culling is always enabled
+	// again after it
+	bool bWasEnabled = (s_cullFace != GL_NONE);
+	if (cullFace == GL_NONE)
+	{
+		glDisable(GL_CULL_FACE);
+		RenderStats::Add(RenderStats::COUNTER_CULL_STATE);
+	}
+	else
+	{
+		if (bWasEnabled == false)
+		{
+			glEnable(GL_CULL_FACE);
+			RenderStats::Add(RenderStats::COUNTER_CULL_STATE);
+		}
+		glCullFace(cullFace);
+		RenderStats::Add(RenderStats::COUNTER_CULL_STATE);
+	}
+	s_cullFace = cullFace;
+}
+
+/***********************************************************
+ *  Invalidate()
+ *
+ *  This method is used for forgetting the cached values,
+ *  after code outside the cache has changed the state.
+ ***********************************************************/
+void RenderState::Invalidate()
+{
+	s_knownFields = 0;
+	s_cullFace = GL_NONE;
+}
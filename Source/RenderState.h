@@ -0,0 +1,82 @@
+///////////////////////////////////////////////////////////////////////////////
+// renderstate.h
+// ============
+// keep a copy of the fixed function OpenGL state so only real changes of it
+// reach the driver
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+//  Notes: The blend, depth, face culling and color write state is set
+//         through this class instead of glEnable(), glBlendFunc() and the
+//         rest.  A set that matches the value OpenGL already holds is
+//         skipped and counted as redundant in RenderStats.  The render
+//         passes declare their state as PIPELINE_STATE blocks and apply
+//         them whole.  Face culling changes from node to node, so it is
+//         set on its own and is not part of a block.  Code that changes
+//         this state behind the cache's back must call Invalidate().
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+/***********************************************************
+ *  RenderState
+ *
+ *  This class holds the cached OpenGL state.  There is a
+ *  single GL context, so the methods are static.
+ ***********************************************************/
+class RenderState
+{
+public:
+	// the blend and depth state of a render pass
+	struct PIPELINE_STATE
+	{
+		bool bBlend;
+		GLenum blendSource;
+		GLenum blendDestination;
+		bool bDepthTest;
+		bool bDepthWrite;
+		GLenum depthFunc;
+		bool bColorWrite;
+	};
+
+	// set every value of a pipeline state block
+	static void Apply(const PIPELINE_STATE& state);
+
+	// set a single value
+	static void SetBlend(bool bBlend);
+	static void SetBlendFunc(GLenum source, GLenum destination);
+	static void SetDepthTest(bool bDepthTest);
+	static void SetDepthWrite(bool bDepthWrite);
+	static void SetDepthFunc(GLenum depthFunc);
+	static void SetColorWrite(bool bColorWrite);
+	// set the culled faces - GL_NONE turns face culling off
+	static void SetCullFace(GLenum cullFace);
+
+	// forget the cached values, so the next set of each one is
+	// sent to OpenGL whatever it is
+	static void Invalidate();
+
+private:
+	// the values the cache can hold, as bits of s_knownFields
+	enum STATE_FIELD
+	{
+		FIELD_BLEND = 1 << 0,
+		FIELD_BLEND_FUNC = 1 << 1,
+		FIELD_DEPTH_TEST = 1 << 2,
+		FIELD_DEPTH_WRITE = 1 << 3,
+		FIELD_DEPTH_FUNC = 1 << 4,
+		FIELD_COLOR_WRITE = 1 << 5,
+		FIELD_CULL_FACE = 1 << 6
+	};
+
+	static PIPELINE_STATE s_current;
+	static GLenum s_cullFace;
+	// the fields whose value in s_current is known to be in OpenGL
+	static unsigned int s_knownFields;
+
+	// check whether a field already holds a value, and mark it
+	// known when it does not - true when the set can be skipped
+	static bool IsCurrent(STATE_FIELD field, bool bSame);
+};
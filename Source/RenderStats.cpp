@@ -0,0 +1,81 @@
+///////////////////////////////////////////////////////////////////////////////
+// renderstats.cpp
+// ============
+// count the work the renderer hands to OpenGL each frame
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "RenderStats.h"
+
+// declaration of global variables
+namespace
+{
+	// counter names, in COUNTER order
+	const char* g_CounterNames[RenderStats::COUNTER_COUNT] =
+	{
+		"draws",
+		"triangles",
+		"texture binds",
+		"uniforms",
+		"redundant uniforms",
+		"programs",
+		"blend",
+		"cull",
+		"depth",
+		"redundant state",
+		"bytes"
+	};
+}
+
+long long RenderStats::s_counters[RenderStats::COUNTER_COUNT] = { 0 };
+long long RenderStats::s_frameValues[RenderStats::COUNTER_COUNT] = { 0 };
+
+/***********************************************************
+ *  EndFrame()
+ *
+ *  This method is used for keeping the counters of the
+ *  frame that just finished and clearing them for the next.
+ ***********************************************************/
+void RenderStats::EndFrame()
+{
+	for (int i = 0; i < COUNTER_COUNT; i++)
+	{
+		s_frameValues[i] = s_counters[i];
+		s_counters[i] = 0;
+	}
+}
+
+/***********************************************************
+ *  GetName()
+ *
+ *  This method is used for getting the short name of a
+ *  counter, for text output.
+ ***********************************************************/
+const char* RenderStats::GetName(COUNTER counter)
+{
+	return(g_CounterNames[counter]);
+}
+
+/***********************************************************
+ *  GetSummary()
+ *
+ *  This method is used for getting every counter of the
+ *  last finished frame as one line of text.
+ ***********************************************************/
+std::string RenderStats::GetSummary()
+{
+	std::string summary;
+
+	for (int i = 0; i < COUNTER_COUNT; i++)
+	{
+		if (i > 0)
+		{
+			summary += ", ";
+		}
+		summary += std::string(g_CounterNames[i]) + " " + std::to_string(s_frameValues[i]);
+	}
+
+	return(summary);
+}
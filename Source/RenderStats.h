@@ -0,0 +1,62 @@
+///////////////////////////////////////////////////////////////////////////////
+// renderstats.h
+// ============
+// count the work the renderer hands to OpenGL each frame
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+//  Notes: The counters are bumped where the work is issued - the draws in
+//         MeshBuffers, the uniform sets in ShaderUniforms, the buffer and
+//         texture uploads where they are made, and the blend, cull and
+//         depth state in RenderState.  A uniform set that ShaderUniforms
+//         skips because the value is unchanged is counted as redundant
+//         instead of uploaded.  EndFrame() keeps the totals of the frame
+//         that just finished for the window title and the benchmark.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <string>
+
+/***********************************************************
+ *  RenderStats
+ *
+ *  This class holds the per-frame render counters.  They
+ *  are shared by the whole renderer, so the methods are
+ *  static.
+ ***********************************************************/
+class RenderStats
+{
+public:
+	enum COUNTER
+	{
+		COUNTER_DRAW_CALLS = 0,
+		COUNTER_TRIANGLES,
+		COUNTER_TEXTURE_BINDS,
+		COUNTER_UNIFORM_UPLOADS,
+		COUNTER_UNIFORM_REDUNDANT,    // sets skipped as unchanged
+		COUNTER_PROGRAM_BINDS,
+		COUNTER_BLEND_STATE,          // blend enables and functions
+		COUNTER_CULL_STATE,           // face culling enables and faces
+		COUNTER_DEPTH_STATE,          // depth test, mask and function
+		COUNTER_STATE_REDUNDANT,      // state sets skipped as unchanged
+		COUNTER_BYTES_UPLOADED,       // buffer and texture data
+		COUNTER_COUNT
+	};
+
+	// add to a counter of the current frame
+	static void Add(COUNTER counter, long long amount = 1) { s_counters[counter] += amount; }
+	// keep the totals of the finished frame and start the next
+	static void EndFrame();
+
+	// get a total of the last finished frame
+	static long long GetFrameValue(COUNTER counter) { return(s_frameValues[counter]); }
+	// get the short name of a counter
+	static const char* GetName(COUNTER counter);
+	// get the totals of the last finished frame as one line of text
+	static std::string GetSummary();
+
+private:
+	static long long s_counters[COUNTER_COUNT];
+	static long long s_frameValues[COUNTER_COUNT];
+};
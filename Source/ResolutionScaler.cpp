@@ -0,0 +1,382 @@
+///////////////////////////////////////////////////////////////////////////////
+// resolutionscaler.cpp
+// ============
+// draw the scene offscreen at a resolution that follows the GPU frame time,
+// and stretch it over the window
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ResolutionScaler.h"
+#include "FrameProfiler.h"
+#include "RenderState.h"
+#include "RenderStats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	// share of the frame budget the GPU time is brought down to
+	// when it runs over, and the share it must stay under for the
+	// scale to step back up - the gap keeps the scale from going
+	// back and forth between two steps
+	const double TARGET_LOAD = 0.85;
+	const double RAISE_LOAD = 0.7;
+	// weight of each new GPU time in the running average
+	const double AVERAGE_WEIGHT = 0.25;
+	// sharpening strength at the lowest scale, none at full scale
+	const float MAX_SHARPNESS = 0.25f;
+
+	// upscale triangle - every pixel of the window is written, the
+	// depth mask stays on for the next frame's clear
+	const RenderState::PIPELINE_STATE UPSCALE_STATE =
+		{ false, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, false, true, GL_LESS, true };
+}
+
+const float ResolutionScaler::MIN_SCALE = 0.5f;
+const float ResolutionScaler::SCALE_STEP = 0.05f;
+
+/***********************************************************
+ *  ResolutionScaler()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ResolutionScaler::ResolutionScaler()
+{
+	m_framebuffer = 0;
+	m_colorTexture = 0;
+	m_depthBuffer = 0;
+	m_emptyVertexArray = 0;
+	m_pUpscaleProgram = new ShaderProgram();
+	m_textureUnit = 0;
+	m_regionLocation = -1;
+	m_sharpnessLocation = -1;
+	m_windowWidth = 0;
+	m_windowHeight = 0;
+	m_sceneWidth = 0;
+	m_sceneHeight = 0;
+	m_scale = 1.0f;
+	m_frameBudget = 0.0;
+	m_averageMilliseconds = -1.0;
+	m_settleFrames = 0;
+}
+
+/***********************************************************
+ *  ~ResolutionScaler()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+ResolutionScaler::~ResolutionScaler()
+{
+	Destroy();
+
+	if (m_emptyVertexArray != 0)
+	{
+		glDeleteVertexArrays(1, &m_emptyVertexArray);
+		m_emptyVertexArray = 0;
+	}
+	if (NULL != m_pUpscaleProgram)
+	{
+		delete m_pUpscaleProgram;
+		m_pUpscaleProgram = NULL;
+	}
+}
+
+/***********************************************************
+ *  Destroy()
+ *
+ *  This method is used for freeing the framebuffer and the
+ *  target attached to it.
+ ***********************************************************/
+void ResolutionScaler::Destroy()
+{
+	if (m_framebuffer != 0)
+	{
+		glDeleteFramebuffers(1, &m_framebuffer);
+		glDeleteTextures(1, &m_colorTexture);
+		glDeleteRenderbuffers(1, &m_depthBuffer);
+		m_framebuffer = 0;
+		m_colorTexture = 0;
+		m_depthBuffer = 0;
+	}
+	m_windowWidth = 0;
+	m_windowHeight = 0;
+}
+
+/***********************************************************
+ *  Create()
+ *
+ *  This method is used for building the upscale program
+ *  from the scene shader files.  The target is sampled
+ *  from the last texture unit, which the G-buffer binds
+ *  again in every frame that reads it.
+ ***********************************************************/
+bool ResolutionScaler::Create(const char* vertexShaderPath, const char* fragmentShaderPath)
+{
+	GLint textureUnits = 16;
+	glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &textureUnits);
+	m_textureUnit = textureUnits - 1;
+
+	if (m_pUpscaleProgram->Load(
+		vertexShaderPath,
+		fragmentShaderPath,
+		"#version 330 core",
+		"#define USE_UPSCALE_SHARPEN\n") == false)
+	{
+		std::cout << "Upscale shaders failed to build, the scene is drawn at full resolution" << std::endl;
+		return(false);
+	}
+
+	glGenVertexArrays(1, &m_emptyVertexArray);
+	ResolveLocations();
+
+	return(true);
+}
+
+/***********************************************************
+ *  Reload()
+ *
+ *  This method is used for building the upscale program
+ *  again from the changed shader files.
+ ***********************************************************/
+bool ResolutionScaler::Reload()
+{
+	bool bLoaded = m_pUpscaleProgram->Reload();
+	ResolveLocations();
+
+	return(bLoaded);
+}
+
+/***********************************************************
+ *  ResolveLocations()
+ *
+ *  This method is used for pointing the sampler of a newly
+ *  linked upscale program at the target's texture unit
+ *  and looking up its other uniforms.
+ ***********************************************************/
+void ResolutionScaler::ResolveLocations()
+{
+	GLint previousProgram = 0;
+	glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+
+	GLuint programID = m_pUpscaleProgram->GetProgramID();
+	glUseProgram(programID);
+	RenderStats::Add(RenderStats::COUNTER_PROGRAM_BINDS);
+	glUniform1i(glGetUniformLocation(programID, "sceneColorTexture"), m_textureUnit);
+	m_regionLocation = glGetUniformLocation(programID, "upscaleRegion");
+	m_sharpnessLocation = glGetUniformLocation(programID, "upscaleSharpness");
+
+	glUseProgram(previousProgram);
+}
+
+/***********************************************************
+ *  SetTargetFrameRate()
+ *
+ *  This method is used for setting the frame rate the scale
+ *  is chosen for.  Zero puts the scale back at full.
+ ***********************************************************/
+void ResolutionScaler::SetTargetFrameRate(int framesPerSecond)
+{
+	m_frameBudget = (framesPerSecond > 0) ? 1000.0 / framesPerSecond : 0.0;
+	m_averageMilliseconds = -1.0;
+	m_settleFrames = 0;
+	if (m_frameBudget <= 0.0)
+	{
+		m_scale = 1.0f;
+	}
+}
+
+/***********************************************************
+ *  Resize()
+ *
+ *  This method is used for creating the target at the size
+ *  of the window framebuffer.  The scene only draws into a
+ *  corner of it below the full scale, so a scale change
+ *  never rebuilds it.  When the target cannot be created
+ *  the scene is drawn straight into the window.
+ ***********************************************************/
+void ResolutionScaler::Resize(int windowWidth, int windowHeight)
+{
+	if ((windowWidth <= 0) || (windowHeight <= 0))
+	{
+		return;
+	}
+	if ((windowWidth == m_windowWidth) && (windowHeight == m_windowHeight))
+	{
+		return;
+	}
+
+	Destroy();
+	m_windowWidth = windowWidth;
+	m_windowHeight = windowHeight;
+
+	if (m_emptyVertexArray == 0)
+	{
+		return;
+	}
+
+	GLint previousFramebuffer = 0;
+	glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFramebuffer);
+
+	glGenFramebuffers(1, &m_framebuffer);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_framebuffer);
+
+	// filtered and clamped, so the stretch blends the texels
+	// without reading past the drawn corner's edge - it is only
+	// made again when the window size changes, so plain
+	// glTexImage2D() serves the 3.3 context as well
+	glGenTextures(1, &m_colorTexture);
+	glBindTexture(GL_TEXTURE_2D, m_colorTexture);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, windowWidth, windowHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_colorTexture, 0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	// the same format as the window's depth, which the weighted
+	// transparency targets copy their depth from
+	glGenRenderbuffers(1, &m_depthBuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, m_depthBuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, windowWidth, windowHeight);
+	glFramebufferRenderbuffer(GL_DRAW_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_depthBuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+	GLenum status = glCheckFramebufferStatus(GL_DRAW_FRAMEBUFFER);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, previousFramebuffer);
+
+	if (status != GL_FRAMEBUFFER_COMPLETE)
+	{
+		std::cout << "Scaled scene framebuffer is incomplete, status: " << status << std::endl;
+		Destroy();
+		m_windowWidth = windowWidth;
+		m_windowHeight = windowHeight;
+	}
+}
+
+/***********************************************************
+ *  Update()
+ *
+ *  This method is used for moving the scale by a measured
+ *  GPU frame time.  The GPU time goes with the number of
+ *  pixels drawn, the square of the scale, so a frame over
+ *  budget drops straight to the step that should bring it
+ *  back under, while a frame with room to spare only
+ *  raises it one step.  The times of the frames still
+ *  drawn at the old scale are skipped after a change.
+ ***********************************************************/
+void ResolutionScaler::Update(double gpuMilliseconds)
+{
+	if (m_frameBudget <= 0.0)
+	{
+		return;
+	}
+
+	m_settleFrames++;
+	if ((gpuMilliseconds < 0.0) || (m_settleFrames <= FrameProfiler::QUERY_FRAMES))
+	{
+		return;
+	}
+
+	if (m_averageMilliseconds < 0.0)
+	{
+		m_averageMilliseconds = gpuMilliseconds;
+	}
+	else
+	{
+		m_averageMilliseconds += (gpuMilliseconds - m_averageMilliseconds) * AVERAGE_WEIGHT;
+	}
+	if (m_settleFrames < SETTLE_FRAMES)
+	{
+		return;
+	}
+
+	float scale = m_scale;
+	if (m_averageMilliseconds > m_frameBudget)
+	{
+		scale *= (float)std::sqrt(m_frameBudget * TARGET_LOAD / m_averageMilliseconds);
+		scale = std::floor(scale / SCALE_STEP) * SCALE_STEP;
+	}
+	else if (m_averageMilliseconds < m_frameBudget * RAISE_LOAD)
+	{
+		scale += SCALE_STEP;
+	}
+	scale = std::min(std::max(scale, MIN_SCALE), 1.0f);
+
+	if (std::fabs(scale - m_scale) >= SCALE_STEP * 0.5f)
+	{
+		m_scale = scale;
+		m_averageMilliseconds = -1.0;
+		m_settleFrames = 0;
+	}
+}
+
+/***********************************************************
+ *  BeginScene()
+ *
+ *  This method is used for binding the target for the
+ *  frame's scene draws, with the viewport at the scaled
+ *  size in its corner.
+ ***********************************************************/
+void ResolutionScaler::BeginScene()
+{
+	m_sceneWidth = std::max((int)(m_windowWidth * m_scale + 0.5f), 1);
+	m_sceneHeight = std::max((int)(m_windowHeight * m_scale + 0.5f), 1);
+
+	if (m_framebuffer == 0)
+	{
+		glViewport(0, 0, m_windowWidth, m_windowHeight);
+		return;
+	}
+
+	glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+	glViewport(0, 0, m_sceneWidth, m_sceneHeight);
+}
+
+/***********************************************************
+ *  EndScene()
+ *
+ *  This method is used for stretching the drawn corner of
+ *  the target over the window with one full screen
+ *  triangle.  The program that was in use is bound back
+ *  for the scene manager's next frame.
+ ***********************************************************/
+void ResolutionScaler::EndScene()
+{
+	if (m_framebuffer == 0)
+	{
+		return;
+	}
+
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glViewport(0, 0, m_windowWidth, m_windowHeight);
+	RenderState::Apply(UPSCALE_STATE);
+
+	GLint previousProgram = 0;
+	glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+	m_pUpscaleProgram->Use();
+	glUniform2f(
+		m_regionLocation,
+		(GLfloat)m_sceneWidth / (GLfloat)m_windowWidth,
+		(GLfloat)m_sceneHeight / (GLfloat)m_windowHeight);
+	glUniform1f(m_sharpnessLocation, MAX_SHARPNESS * (1.0f - m_scale) / (1.0f - MIN_SCALE));
+
+	glActiveTexture(GL_TEXTURE0 + m_textureUnit);
+	glBindTexture(GL_TEXTURE_2D, m_colorTexture);
+	glActiveTexture(GL_TEXTURE0);
+	RenderStats::Add(RenderStats::COUNTER_TEXTURE_BINDS);
+
+	glBindVertexArray(m_emptyVertexArray);
+	glDrawArrays(GL_TRIANGLES, 0, 3);
+	glBindVertexArray(0);
+	RenderStats::Add(RenderStats::COUNTER_DRAW_CALLS);
+	RenderStats::Add(RenderStats::COUNTER_TRIANGLES);
+
+	glUseProgram(previousProgram);
+	RenderStats::Add(RenderStats::COUNTER_PROGRAM_BINDS);
+}
@@ -0,0 +1,109 @@
+///////////////////////////////////////////////////////////////////////////////
+// resolutionscaler.h
+// ============
+// draw the scene offscreen at a resolution that follows the GPU frame time,
+// and stretch it over the window
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+//  Notes: The scene is drawn into a color and depth target the size of the
+//         window, but only into a corner of it - the scale times the window
+//         size.  Once a frame the measured GPU time of a recent frame moves
+//         the scale down when it went past the frame time of the target
+//         frame rate, and back up one step when there is room again.  The
+//         scale comes in steps of SCALE_STEP and waits SETTLE_FRAMES after
+//         each change, since the GPU times arrive some frames late and the
+//         G-buffer and the transparency targets are rebuilt for every new
+//         size.  The finished frame is stretched over the window with
+//         bilinear filtering and sharpened by a clamped five tap filter,
+//         harder the lower the scale, which takes back most of the blur
+//         without ringing around the edges.  A target frame rate of zero
+//         keeps the full resolution.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShaderProgram.h"
+
+#include <GL/glew.h>
+
+/***********************************************************
+ *  ResolutionScaler
+ *
+ *  This class owns the offscreen scene target and the
+ *  program that stretches it over the window.
+ ***********************************************************/
+class ResolutionScaler
+{
+public:
+	// lowest scale of the window size the scene is drawn at, and
+	// the step the scale moves by
+	static const float MIN_SCALE;
+	static const float SCALE_STEP;
+	// frames drawn at a new scale before it can change again
+	static const int SETTLE_FRAMES = 8;
+
+	// constructor
+	ResolutionScaler();
+	// destructor
+	~ResolutionScaler();
+
+	// build the upscale program from the scene shader files -
+	// false when it does not build
+	bool Create(const char* vertexShaderPath, const char* fragmentShaderPath);
+	// build the upscale program again after the files changed
+	bool Reload();
+
+	// set the frame rate the scale is chosen for - zero keeps
+	// the full resolution
+	void SetTargetFrameRate(int framesPerSecond);
+	// create the target for a window framebuffer size - it is
+	// only rebuilt when the size changes
+	void Resize(int windowWidth, int windowHeight);
+	// move the scale by the GPU time of a recent frame, -1 when
+	// it is not known
+	void Update(double gpuMilliseconds);
+
+	// bind the target and set the viewport to the scaled size
+	void BeginScene();
+	// stretch the target over the window framebuffer, which is
+	// bound with the viewport of the whole window
+	void EndScene();
+
+	// get the scale the scene is drawn at
+	float GetScale() const { return(m_scale); }
+
+private:
+	GLuint m_framebuffer;
+	GLuint m_colorTexture;
+	GLuint m_depthBuffer;
+	// the full screen triangle has no vertex attributes, but a
+	// core context still needs a vertex array bound
+	GLuint m_emptyVertexArray;
+	ShaderProgram* m_pUpscaleProgram;
+	// texture unit the target is sampled from, and the upscale
+	// uniforms set every frame
+	int m_textureUnit;
+	GLint m_regionLocation;
+	GLint m_sharpnessLocation;
+	// window framebuffer size the target was created for
+	int m_windowWidth;
+	int m_windowHeight;
+	// size the scene is drawn at this frame
+	int m_sceneWidth;
+	int m_sceneHeight;
+	float m_scale;
+	// milliseconds of GPU time per frame at the target frame
+	// rate, zero for a fixed full resolution
+	double m_frameBudget;
+	// running average of the measured GPU times
+	double m_averageMilliseconds;
+	// frames drawn since the scale last changed
+	int m_settleFrames;
+
+	// set the sampler and look up the uniforms of the linked
+	// upscale program
+	void ResolveLocations();
+	// free the framebuffer and its attachments
+	void Destroy();
+};
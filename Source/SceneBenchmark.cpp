@@ -0,0 +1,346 @@
+///////////////////////////////////////////////////////////////////////////////
+// scenebenchmark.cpp
+// ============
+// play a scripted camera path through the scene and report the frame times
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "SceneBenchmark.h"
+
+#include <GL/glew.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	const int DEFAULT_FRAME_COUNT = 600;
+	const char* const DEFAULT_OUTPUT_FILE = "benchmark.json";
+	const int DEFAULT_TARGET_FRAME_RATE = 60;
+
+	// the path swings the camera around the lamp in front of the
+	// cabinet, rising and falling a little as it goes
+	const glm::vec3 PATH_PIVOT = glm::vec3(0.0f, 7.0f, -3.5f);
+	const float PATH_RADIUS = 18.0f;
+	const float PATH_HEIGHT = 8.5f;
+	const float PATH_HEIGHT_SWING = 1.5f;
+	const float PATH_SWING_DEGREES = 50.0f;
+	const float PATH_SWING_PERIOD = 12.0f;
+	const float PATH_HEIGHT_PERIOD = 7.0f;
+
+	const float TWO_PI = 6.28318530718f;
+
+	/***********************************************************
+	 *  TIME_SUMMARY
+	 *
+	 *  The statistics of a list of frame times.
+	 ***********************************************************/
+	struct TIME_SUMMARY
+	{
+		double minimum;
+		double average;
+		double p99;
+		double maximum;
+	};
+
+	/***********************************************************
+	 *  SummarizeTimes()
+	 *
+	 *  Get the minimum, average, 99th percentile and maximum
+	 *  of a list of times.  The percentile is the time that
+	 *  99% of the frames came in at or under.
+	 ***********************************************************/
+	TIME_SUMMARY SummarizeTimes(std::vector<double> times)
+	{
+		TIME_SUMMARY summary = { 0.0, 0.0, 0.0, 0.0 };
+		if (times.size() == 0)
+		{
+			return(summary);
+		}
+
+		std::sort(times.begin(), times.end());
+		summary.minimum = times.front();
+		summary.maximum = times.back();
+		for (int i = 0; i < times.size(); i++)
+		{
+			summary.average += times[i];
+		}
+		summary.average /= times.size();
+
+		size_t p99Index = (size_t)std::ceil(times.size() * 0.99) - 1;
+		summary.p99 = times[std::min(p99Index, times.size() - 1)];
+
+		return(summary);
+	}
+
+	/***********************************************************
+	 *  EscapeJson()
+	 *
+	 *  Get a string with the quotes, backslashes and control
+	 *  characters escaped, to be written inside a JSON string.
+	 ***********************************************************/
+	std::string EscapeJson(const char* text)
+	{
+		std::string escaped;
+		for (const char* c = text; *c != '\0'; c++)
+		{
+			if ((*c == '"') || (*c == '\\'))
+			{
+				escaped += '\\';
+				escaped += *c;
+			}
+			else if ((unsigned char)*c < 0x20)
+			{
+				char code[8];
+				snprintf(code, sizeof(code), "\\u%04x", (unsigned char)*c);
+				escaped += code;
+			}
+			else
+			{
+				escaped += *c;
+			}
+		}
+
+		return(escaped);
+	}
+
+	/***********************************************************
+	 *  WriteSummary()
+	 *
+	 *  Write a time summary as a JSON object member.
+	 ***********************************************************/
+	void WriteSummary(std::ofstream& file, const char* name, const TIME_SUMMARY& summary)
+	{
+		char text[256];
+		snprintf(text, sizeof(text),
+			"  \"%s\": { \"min\": %.4f, \"avg\": %.4f, \"p99\": %.4f, \"max\": %.4f },\n",
+			name, summary.minimum, summary.average, summary.p99, summary.maximum);
+		file << text;
+	}
+}
+
+// 60 simulated frames per second
+const double SceneBenchmark::FIXED_TIME_STEP = 1.0 / 60.0;
+
+/***********************************************************
+ *  ParseArguments()
+ *
+ *  This method is used for reading the benchmark options
+ *  from the command line.  Unknown options are reported
+ *  and ignored.
+ ***********************************************************/
+bool SceneBenchmark::ParseArguments(int argc, char* argv[], BENCHMARK_SETTINGS& settings)
+{
+	bool bBenchmark = false;
+
+	settings.frameCount = DEFAULT_FRAME_COUNT;
+	settings.sceneCopies = 1;
+	settings.outputFile = DEFAULT_OUTPUT_FILE;
+	settings.sceneFile = "";
+	settings.windowWidth = 0;
+	settings.windowHeight = 0;
+	settings.bFullScreen = false;
+	settings.targetFrameRate = DEFAULT_TARGET_FRAME_RATE;
+
+	for (int i = 1; i < argc; i++)
+	{
+		bool bHasValue = (i + 1 < argc);
+
+		if (std::strcmp(argv[i], "--benchmark") == 0)
+		{
+			bBenchmark = true;
+		}
+		else if ((std::strcmp(argv[i], "--frames") == 0) && (bHasValue == true))
+		{
+			settings.frameCount = std::max(std::atoi(argv[++i]), 1);
+		}
+		else if ((std::strcmp(argv[i], "--stress") == 0) && (bHasValue == true))
+		{
+			settings.sceneCopies = std::max(std::atoi(argv[++i]), 1);
+		}
+		else if ((std::strcmp(argv[i], "--output") == 0) && (bHasValue == true))
+		{
+			settings.outputFile = argv[++i];
+		}
+		else if ((std::strcmp(argv[i], "--scene") == 0) && (bHasValue == true))
+		{
+			settings.sceneFile = argv[++i];
+		}
+		else if ((std::strcmp(argv[i], "--width") == 0) && (bHasValue == true))
+		{
+			settings.windowWidth = std::max(std::atoi(argv[++i]), 0);
+		}
+		else if ((std::strcmp(argv[i], "--height") == 0) && (bHasValue == true))
+		{
+			settings.windowHeight = std::max(std::atoi(argv[++i]), 0);
+		}
+		else if (std::strcmp(argv[i], "--fullscreen") == 0)
+		{
+			settings.bFullScreen = true;
+		}
+		else if ((std::strcmp(argv[i], "--target-fps") == 0) && (bHasValue == true))
+		{
+			settings.targetFrameRate = std::max(std::atoi(argv[++i]), 0);
+		}
+		else
+		{
+			std::cout << "Unknown option ignored: " << argv[i] << std::endl;
+		}
+	}
+
+	return(bBenchmark);
+}
+
+/***********************************************************
+ *  SceneBenchmark()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+SceneBenchmark::SceneBenchmark(const BENCHMARK_SETTINGS& settings)
+{
+	m_settings = settings;
+	m_frameMilliseconds.reserve(settings.frameCount);
+	for (int i = 0; i < RenderStats::COUNTER_COUNT; i++)
+	{
+		m_counterValues[i].reserve(settings.frameCount);
+	}
+}
+
+/***********************************************************
+ *  GetCameraPose()
+ *
+ *  This method is used for getting the camera position and
+ *  direction of a frame.  The pose only depends on the
+ *  frame number times the fixed time step, so every run
+ *  and every machine sees the same frames.
+ ***********************************************************/
+void SceneBenchmark::GetCameraPose(int frame, glm::vec3& position, glm::vec3& front) const
+{
+	float time = (float)(frame * FIXED_TIME_STEP);
+
+	float swing = std::sin(time * TWO_PI / PATH_SWING_PERIOD);
+	float angle = glm::radians(PATH_SWING_DEGREES) * swing;
+	float height = PATH_HEIGHT + PATH_HEIGHT_SWING * std::sin(time * TWO_PI / PATH_HEIGHT_PERIOD);
+
+	position = glm::vec3(
+		PATH_PIVOT.x + std::sin(angle) * PATH_RADIUS,
+		height,
+		PATH_PIVOT.z + std::cos(angle) * PATH_RADIUS);
+	front = glm::normalize(PATH_PIVOT - position);
+}
+
+/***********************************************************
+ *  AddFrame()
+ *
+ *  This method is used for recording the wall time and the
+ *  render counters of a measured frame.  RenderStats must
+ *  have closed the frame already.
+ ***********************************************************/
+void SceneBenchmark::AddFrame(double frameMilliseconds)
+{
+	m_frameMilliseconds.push_back(frameMilliseconds);
+	for (int i = 0; i < RenderStats::COUNTER_COUNT; i++)
+	{
+		m_counterValues[i].push_back(RenderStats::GetFrameValue((RenderStats::COUNTER)i));
+	}
+}
+
+/***********************************************************
+ *  WriteReport()
+ *
+ *  This method is used for writing the measured frames to
+ *  the JSON report - the frame time and GPU time
+ *  statistics, the render counters, and the averaged times of
+ *  each profiled section.  The profiler must have been
+ *  flushed, so the GPU times of the last frames are in.
+ ***********************************************************/
+bool SceneBenchmark::WriteReport(const FrameProfiler& profiler, int sceneNodeCount) const
+{
+	std::ofstream file(m_settings.outputFile.c_str());
+	if (!file)
+	{
+		std::cout << "Could not write the benchmark report: " << m_settings.outputFile << std::endl;
+		return(false);
+	}
+
+	// the GPU time of every measured frame that has one
+	std::vector<double> gpuMilliseconds;
+	profiler.GetFrameGpuTimes(gpuMilliseconds);
+	if (gpuMilliseconds.size() > m_frameMilliseconds.size())
+	{
+		gpuMilliseconds.erase(gpuMilliseconds.begin(), gpuMilliseconds.end() - m_frameMilliseconds.size());
+	}
+	std::vector<double> measuredGpu;
+	for (int i = 0; i < gpuMilliseconds.size(); i++)
+	{
+		if (gpuMilliseconds[i] >= 0.0)
+		{
+			measuredGpu.push_back(gpuMilliseconds[i]);
+		}
+	}
+
+	// the driver strings are copied whole and escaped, as any
+	// text may come back in them
+	const GLubyte* renderer = glGetString(GL_RENDERER);
+	const GLubyte* version = glGetString(GL_VERSION);
+	char text[256];
+
+	file << "{\n";
+	file << "  \"renderer\": \"" << EscapeJson((renderer != NULL) ? (const char*)renderer : "unknown") << "\",\n";
+	file << "  \"version\": \"" << EscapeJson((version != NULL) ? (const char*)version : "unknown") << "\",\n";
+	snprintf(text, sizeof(text), "  \"frames\": %d,\n  \"sceneCopies\": %d,\n  \"sceneNodes\": %d,\n  \"fixedTimeStep\": %.6f,\n",
+		(int)m_frameMilliseconds.size(), m_settings.sceneCopies, sceneNodeCount, FIXED_TIME_STEP);
+	file << text;
+	WriteSummary(file, "frameTimeMs", SummarizeTimes(m_frameMilliseconds));
+	WriteSummary(file, "gpuTimeMs", SummarizeTimes(measuredGpu));
+	snprintf(text, sizeof(text), "  \"gpuFramesMissing\": %d,\n",
+		(int)(m_frameMilliseconds.size() - measuredGpu.size()));
+	file << text;
+
+	file << "  \"counters\": {";
+	for (int i = 0; i < RenderStats::COUNTER_COUNT; i++)
+	{
+		const std::vector<long long>& values = m_counterValues[i];
+		double total = 0.0;
+		long long maximum = 0;
+		for (int j = 0; j < values.size(); j++)
+		{
+			total += (double)values[j];
+			maximum = std::max(maximum, values[j]);
+		}
+		double average = (values.size() > 0) ? total / values.size() : 0.0;
+
+		snprintf(text, sizeof(text), "%s\n    \"%s\": { \"avg\": %.2f, \"max\": %lld }",
+			(i == 0) ? "" : ",",
+			RenderStats::GetName((RenderStats::COUNTER)i),
+			average,
+			maximum);
+		file << text;
+	}
+	file << "\n  },\n";
+
+	file << "  \"sections\": [";
+	std::vector<FrameProfiler::SCOPE_AVERAGE> sections;
+	profiler.GetHistoryAverages(sections);
+	for (int i = 0; i < sections.size(); i++)
+	{
+		snprintf(text, sizeof(text), "%s\n    { \"name\": \"%s\", \"cpuMs\": %.4f, \"gpuMs\": %.4f }",
+			(i == 0) ? "" : ",",
+			EscapeJson(sections[i].name).c_str(),
+			sections[i].cpuMilliseconds,
+			sections[i].gpuMilliseconds);
+		file << text;
+	}
+	file << "\n  ]\n}\n";
+
+	std::cout << "Wrote the benchmark report to " << m_settings.outputFile << std::endl;
+	return(true);
+}
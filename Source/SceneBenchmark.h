@@ -0,0 +1,98 @@
+///////////////////////////////////////////////////////////////////////////////
+// scenebenchmark.h
+// ============
+// play a scripted camera path through the scene and report the frame times
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+//  Notes: Started with --benchmark on the command line.  The camera pose of
+//         each frame comes from the frame number and a fixed time step, not
+//         from the clock or the input, so every run draws the same frames.
+//         Warm up frames are drawn until the scene textures have finished
+//         loading, then the measured frames are timed and the report is
+//         written as JSON.  --stress copies the whole scene a number of
+//         times, to track how the renderer scales with the scene size.
+//         The RenderStats counters of each measured frame are kept too,
+//         and reported as their average and maximum.
+//
+//         Options: --benchmark       run the benchmark and exit
+//                  --frames N        measured frames, 600 by default
+//                  --stress K        draw K copies of the scene
+//                  --output FILE     report file, benchmark.json by default
+//                  --scene FILE      scene file, read with or without
+//                                    --benchmark
+//                  --width W         window width, with or without
+//                  --height H        --benchmark, 1000 x 800 by default
+//                  --fullscreen      full screen on the primary monitor
+//                  --target-fps N    frame rate the resolution scale is
+//                                    held for, 60 by default - 0 keeps
+//                                    the full resolution, as a benchmark
+//                                    run always does
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "FrameProfiler.h"
+#include "RenderStats.h"
+
+#include <glm/glm.hpp>
+
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  SceneBenchmark
+ *
+ *  This class holds the benchmark settings, the scripted
+ *  camera path and the measured frames.
+ ***********************************************************/
+class SceneBenchmark
+{
+public:
+	struct BENCHMARK_SETTINGS
+	{
+		int frameCount;
+		int sceneCopies;
+		std::string outputFile;
+		// empty for the default scene
+		std::string sceneFile;
+		// zero for the default window size
+		int windowWidth;
+		int windowHeight;
+		bool bFullScreen;
+		// zero for a fixed full resolution
+		int targetFrameRate;
+	};
+
+	// simulated seconds between frames
+	static const double FIXED_TIME_STEP;
+	// frames drawn before the measured ones, at the least
+	static const int WARMUP_FRAMES = 30;
+
+	// read the benchmark options from the command line - false
+	// when --benchmark was not passed
+	static bool ParseArguments(int argc, char* argv[], BENCHMARK_SETTINGS& settings);
+
+	// constructor
+	SceneBenchmark(const BENCHMARK_SETTINGS& settings);
+
+	// get the camera pose of a frame of the scripted path
+	void GetCameraPose(int frame, glm::vec3& position, glm::vec3& front) const;
+
+	// record the time and the render counters of a measured frame
+	void AddFrame(double frameMilliseconds);
+	// check whether every measured frame has been recorded
+	bool IsFinished() const { return((int)m_frameMilliseconds.size() >= m_settings.frameCount); }
+	// get the number of measured frames recorded so far
+	int GetFrameCount() const { return((int)m_frameMilliseconds.size()); }
+
+	// write the JSON report, with the GPU times of the measured
+	// frames taken from the profiler
+	bool WriteReport(const FrameProfiler& profiler, int sceneNodeCount) const;
+
+private:
+	BENCHMARK_SETTINGS m_settings;
+	// wall time and render counters of each measured frame
+	std::vector<double> m_frameMilliseconds;
+	std::vector<long long> m_counterValues[RenderStats::COUNTER_COUNT];
+};
@@ -0,0 +1,839 @@
+///////////////////////////////////////////////////////////////////////////////
+// scenefile.cpp
+// ============
+// read a scene description file through a compiled, memory mapped copy
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "SceneFile.h"
+#include "MeshBuffers.h"
+
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <unordered_map>
+
+// declaration of global variables
+namespace
+{
+	// bumped whenever the compiled layout changes, so older
+	// compiled files are rebuilt from their text
+	const uint32_t COMPILED_VERSION = 2;
+	const char g_CompiledMagic[4] = { 'S', 'C', 'N', 'B' };
+	// every array in the compiled file starts on this boundary
+	const uint32_t ARRAY_ALIGNMENT = 16;
+
+	// the arrays of a compiled file, in file order
+	enum COMPILED_ARRAY
+	{
+		ARRAY_MESHES = 0,
+		ARRAY_PASSES,
+		ARRAY_CULL_FACES,
+		ARRAY_SCALES,
+		ARRAY_ROTATIONS,
+		ARRAY_POSITIONS,
+		ARRAY_UV_SCALES,
+		ARRAY_COLORS,
+		ARRAY_MATERIAL_TAGS,
+		ARRAY_TEXTURE_TAGS,
+		ARRAY_LIGHTING,
+		ARRAY_POINT_LIGHTS,
+		ARRAY_DIRECTIONAL_LIGHTS,
+		ARRAY_MATERIALS,
+		ARRAY_TAG_OFFSETS,
+		ARRAY_TAG_TEXT,
+		ARRAY_COUNT
+	};
+
+	struct COMPILED_HEADER
+	{
+		char magic[4];
+		uint32_t version;
+		// modification time and size of the text file compiled
+		int64_t sourceTime;
+		int64_t sourceSize;
+		uint32_t fileSize;
+		uint32_t nodeCount;
+		uint32_t pointLightCount;
+		uint32_t directionalLightCount;
+		uint32_t materialCount;
+		uint32_t tagCount;
+		uint32_t tagTextSize;
+		// byte offset and size of each array
+		uint32_t arrayOffsets[ARRAY_COUNT];
+		uint32_t arraySizes[ARRAY_COUNT];
+	};
+	static_assert(sizeof(SceneFile::LIGHT_RECORD) == 64, "LIGHT_RECORD must match the std140 light layout");
+	static_assert(sizeof(SceneFile::MATERIAL_RECORD) == 32, "MATERIAL_RECORD must have no padding");
+
+	// mesh names of the text format, in MeshBuffers::MESH_SHAPE order
+	const char* const g_MeshNames[MeshBuffers::SHAPE_COUNT] =
+	{
+		"box", "cylinder", "sphere", "prism", "plane", "torus", "pyramid3", "tapered_cylinder"
+	};
+	// pass names, in SceneManager::RENDER_PASS order
+	const char* const g_PassNames[] = { "opaque", "translucent", "additive" };
+	const int PASS_NAME_COUNT = 3;
+
+	/***********************************************************
+	 *  FindName()
+	 *
+	 *  Find a name in a list of names and return its index,
+	 *  or -1 when it is not there.
+	 ***********************************************************/
+	int FindName(const std::string& name, const char* const* names, int nameCount)
+	{
+		for (int i = 0; i < nameCount; i++)
+		{
+			if (name == names[i])
+			{
+				return(i);
+			}
+		}
+
+		return(-1);
+	}
+
+	/***********************************************************
+	 *  ReadOnOff()
+	 *
+	 *  Read an "on" or "off" word from a line as 1 or 0.
+	 ***********************************************************/
+	bool ReadOnOff(std::istringstream& line, int& value)
+	{
+		std::string word;
+		line >> word;
+		if (word == "on")
+		{
+			value = 1;
+			return(true);
+		}
+		if (word == "off")
+		{
+			value = 0;
+			return(true);
+		}
+
+		return(false);
+	}
+
+	/***********************************************************
+	 *  ReadVector()
+	 *
+	 *  Read the passed in number of floats from a line.
+	 ***********************************************************/
+	bool ReadVector(std::istringstream& line, float* values, int count)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			line >> values[i];
+		}
+
+		return(!line.fail());
+	}
+
+	/***********************************************************
+	 *  GetSourceStamp()
+	 *
+	 *  Get the modification time and size of a text file -
+	 *  false when the file is not there.
+	 ***********************************************************/
+	bool GetSourceStamp(const std::string& filename, long long& sourceTime, long long& sourceSize)
+	{
+		struct stat sourceInfo;
+		if (stat(filename.c_str(), &sourceInfo) != 0)
+		{
+			return(false);
+		}
+
+		sourceTime = (long long)sourceInfo.st_mtime;
+		sourceSize = (long long)sourceInfo.st_size;
+		return(true);
+	}
+
+	/***********************************************************
+	 *  AddTag()
+	 *
+	 *  Get the index of a tag name, adding it to the tag table
+	 *  the first time it is seen.
+	 ***********************************************************/
+	int AddTag(
+		const std::string& tag,
+		std::unordered_map<std::string, int>& tagLookup,
+		std::vector<int>& tagOffsets,
+		std::vector<char>& tagText)
+	{
+		std::unordered_map<std::string, int>::const_iterator found = tagLookup.find(tag);
+		if (found != tagLookup.end())
+		{
+			return(found->second);
+		}
+
+		int tagIndex = (int)tagOffsets.size();
+		tagLookup[tag] = tagIndex;
+		tagOffsets.push_back((int)tagText.size());
+		tagText.insert(tagText.end(), tag.begin(), tag.end());
+		tagText.push_back('\0');
+
+		return(tagIndex);
+	}
+
+	/***********************************************************
+	 *  AlignOffset()
+	 *
+	 *  Round a file offset up to the array alignment.
+	 ***********************************************************/
+	uint32_t AlignOffset(uint32_t offset)
+	{
+		return((offset + ARRAY_ALIGNMENT - 1) & ~(ARRAY_ALIGNMENT - 1));
+	}
+}
+
+/***********************************************************
+ *  SceneFile()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+SceneFile::SceneFile()
+{
+	m_pMapping = NULL;
+	m_mappingSize = 0;
+#ifdef _WIN32
+	m_fileHandle = INVALID_HANDLE_VALUE;
+	m_mappingHandle = NULL;
+#endif
+	std::memset(&m_arrays, 0, sizeof(m_arrays));
+}
+
+/***********************************************************
+ *  ~SceneFile()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+SceneFile::~SceneFile()
+{
+	Close();
+}
+
+/***********************************************************
+ *  GetCompiledFilename()
+ *
+ *  This method is used for getting the name of the compiled
+ *  file of a scene file - the same name with a .scenebin
+ *  extension.
+ ***********************************************************/
+std::string SceneFile::GetCompiledFilename(const std::string& filename)
+{
+	size_t extension = filename.find_last_of('.');
+	size_t directory = filename.find_last_of("/\\");
+	if ((extension == std::string::npos) ||
+		((directory != std::string::npos) && (extension < directory)))
+	{
+		return(filename + ".scenebin");
+	}
+
+	return(filename.substr(0, extension) + ".scenebin");
+}
+
+/***********************************************************
+ *  Load()
+ *
+ *  This method is used for loading a scene.  A compiled
+ *  file stamped with the text file's current time and size
+ *  is mapped as it is, as is any compiled file whose text
+ *  file is gone.  Otherwise the text file is parsed and
+ *  compiled first, and when the compiled file cannot be
+ *  written or mapped the parsed arrays are used instead.
+ ***********************************************************/
+bool SceneFile::Load(const std::string& filename)
+{
+	Close();
+
+	long long sourceTime = 0;
+	long long sourceSize = 0;
+	bool bHasSource = GetSourceStamp(filename, sourceTime, sourceSize);
+
+	std::string compiledFilename = GetCompiledFilename(filename);
+	if (MapCompiled(compiledFilename, bHasSource, sourceTime, sourceSize) == true)
+	{
+		return(true);
+	}
+
+	if (ParseText(filename, m_parsed) == false)
+	{
+		return(false);
+	}
+
+	if (WriteCompiled(compiledFilename, m_parsed, sourceTime, sourceSize) == false)
+	{
+		std::cout << "Could not write the compiled scene: " << compiledFilename << std::endl;
+	}
+	else if (MapCompiled(compiledFilename, true, sourceTime, sourceSize) == true)
+	{
+		m_parsed = PARSED_SCENE();
+		return(true);
+	}
+
+	UseParsed();
+	return(true);
+}
+
+/***********************************************************
+ *  Close()
+ *
+ *  This method is used for releasing the mapped file and
+ *  the parsed arrays.  The arrays are empty afterwards.
+ ***********************************************************/
+void SceneFile::Close()
+{
+	Unmap();
+	m_parsed = PARSED_SCENE();
+	std::memset(&m_arrays, 0, sizeof(m_arrays));
+}
+
+/***********************************************************
+ *  Unmap()
+ *
+ *  This method is used for releasing the mapped file, when
+ *  there is one.
+ ***********************************************************/
+void SceneFile::Unmap()
+{
+	if (m_pMapping != NULL)
+	{
+#ifdef _WIN32
+		UnmapViewOfFile(m_pMapping);
+		CloseHandle(m_mappingHandle);
+		CloseHandle(m_fileHandle);
+		m_mappingHandle = NULL;
+		m_fileHandle = INVALID_HANDLE_VALUE;
+#else
+		munmap((void*)m_pMapping, m_mappingSize);
+#endif
+		m_pMapping = NULL;
+		m_mappingSize = 0;
+	}
+}
+
+/***********************************************************
+ *  ParseText()
+ *
+ *  This method is used for reading a scene text file into
+ *  its arrays.  Each line holds one keyword and its values.
+ *  A "node", light or "object_material" keyword starts a
+ *  new entry with the default values, and the lines after
+ *  it set them.  Lines
+ *  that cannot be read are reported with their number and
+ *  skipped, so one typo does not lose the whole scene.
+ ***********************************************************/
+bool SceneFile::ParseText(const std::string& filename, PARSED_SCENE& scene)
+{
+	std::ifstream file(filename.c_str());
+	if (!file)
+	{
+		std::cout << "Could not open the scene file: " << filename << std::endl;
+		return(false);
+	}
+
+	std::unordered_map<std::string, int> tagLookup;
+	// the light or material the value keywords set, NULL
+	// outside of one
+	LIGHT_RECORD* pLight = NULL;
+	MATERIAL_RECORD* pMaterial = NULL;
+	bool bNode = false;
+
+	std::string text;
+	int lineNumber = 0;
+	while (std::getline(file, text))
+	{
+		lineNumber++;
+
+		size_t comment = text.find('#');
+		if (comment != std::string::npos)
+		{
+			text.erase(comment);
+		}
+
+		std::istringstream line(text);
+		std::string keyword;
+		if (!(line >> keyword))
+		{
+			continue;
+		}
+
+		bool bValid = true;
+		int last = (int)scene.meshes.size() - 1;
+		float values[4];
+
+		if (keyword == "node")
+		{
+			std::string meshName;
+			line >> meshName;
+			int mesh = FindName(meshName, g_MeshNames, MeshBuffers::SHAPE_COUNT);
+			bValid = (mesh >= 0);
+			if (bValid == true)
+			{
+				scene.meshes.push_back(mesh);
+				scene.passes.push_back(0);
+				scene.cullFaces.push_back(GL_NONE);
+				scene.scales.push_back(glm::vec3(1.0f));
+				scene.rotations.push_back(glm::vec3(0.0f));
+				scene.positions.push_back(glm::vec3(0.0f));
+				scene.uvScales.push_back(glm::vec2(1.0f));
+				scene.colors.push_back(glm::vec4(1.0f));
+				scene.materialTags.push_back(-1);
+				scene.textureTags.push_back(-1);
+				scene.lighting.push_back(1);
+			}
+			// the values of a node that could not be read are
+			// reported too, rather than set on the node before it
+			bNode = bValid;
+			pLight = NULL;
+			pMaterial = NULL;
+		}
+		else if ((keyword == "point_light") || (keyword == "directional_light"))
+		{
+			std::vector<LIGHT_RECORD>& lights =
+				(keyword == "point_light") ? scene.pointLights : scene.directionalLights;
+			LIGHT_RECORD light;
+			light.position = glm::vec3(0.0f);
+			light.pad0 = 0.0f;
+			light.ambient = glm::vec3(0.0f);
+			light.pad1 = 0.0f;
+			light.diffuse = glm::vec3(0.0f);
+			light.pad2 = 0.0f;
+			light.specular = glm::vec3(0.0f);
+			light.bActive = 1;
+			lights.push_back(light);
+			pLight = &lights.back();
+			pMaterial = NULL;
+			bNode = false;
+		}
+		else if (keyword == "object_material")
+		{
+			std::string tag;
+			bValid = !!(line >> tag);
+			pMaterial = NULL;
+			if (bValid == true)
+			{
+				MATERIAL_RECORD material;
+				material.diffuseColor = glm::vec3(1.0f);
+				material.shininess = 32.0f;
+				material.specularColor = glm::vec3(0.0f);
+				material.tagIndex = AddTag(tag, tagLookup, scene.tagOffsets, scene.tagText);
+				scene.materials.push_back(material);
+				pMaterial = &scene.materials.back();
+			}
+			pLight = NULL;
+			bNode = false;
+		}
+		else if ((pMaterial != NULL) && (keyword == "diffuse"))
+		{
+			bValid = ReadVector(line, values, 3);
+			pMaterial->diffuseColor = glm::vec3(values[0], values[1], values[2]);
+		}
+		else if ((pMaterial != NULL) && (keyword == "specular"))
+		{
+			bValid = ReadVector(line, values, 3);
+			pMaterial->specularColor = glm::vec3(values[0], values[1], values[2]);
+		}
+		else if ((pMaterial != NULL) && (keyword == "shininess"))
+		{
+			bValid = ReadVector(line, values, 1);
+			pMaterial->shininess = values[0];
+		}
+		else if ((pLight != NULL) &&
+			((keyword == "position") || (keyword == "direction")))
+		{
+			bValid = ReadVector(line, values, 3);
+			pLight->position = glm::vec3(values[0], values[1], values[2]);
+		}
+		else if ((pLight != NULL) && (keyword == "ambient"))
+		{
+			bValid = ReadVector(line, values, 3);
+			pLight->ambient = glm::vec3(values[0], values[1], values[2]);
+		}
+		else if ((pLight != NULL) && (keyword == "diffuse"))
+		{
+			bValid = ReadVector(line, values, 3);
+			pLight->diffuse = glm::vec3(values[0], values[1], values[2]);
+		}
+		else if ((pLight != NULL) && (keyword == "specular"))
+		{
+			bValid = ReadVector(line, values, 3);
+			pLight->specular = glm::vec3(values[0], values[1], values[2]);
+		}
+		else if ((pLight != NULL) && (keyword == "active"))
+		{
+			bValid = ReadOnOff(line, pLight->bActive);
+		}
+		else if ((bNode == true) && (keyword == "scale"))
+		{
+			bValid = ReadVector(line, values, 3);
+			scene.scales[last] = glm::vec3(values[0], values[1], values[2]);
+		}
+		else if ((bNode == true) && (keyword == "rotation"))
+		{
+			bValid = ReadVector(line, values, 3);
+			scene.rotations[last] = glm::vec3(values[0], values[1], values[2]);
+		}
+		else if ((bNode == true) && (keyword == "position"))
+		{
+			bValid = ReadVector(line, values, 3);
+			scene.positions[last] = glm::vec3(values[0], values[1], values[2]);
+		}
+		else if ((bNode == true) && (keyword == "uv"))
+		{
+			bValid = ReadVector(line, values, 2);
+			scene.uvScales[last] = glm::vec2(values[0], values[1]);
+		}
+		else if ((bNode == true) && (keyword == "color"))
+		{
+			bValid = ReadVector(line, values, 4);
+			scene.colors[last] = glm::vec4(values[0], values[1], values[2], values[3]);
+		}
+		else if ((bNode == true) && (keyword == "lighting"))
+		{
+			bValid = ReadOnOff(line, scene.lighting[last]);
+		}
+		else if ((bNode == true) && (keyword == "pass"))
+		{
+			std::string passName;
+			std::string cullName;
+			line >> passName >> cullName;
+			int pass = FindName(passName, g_PassNames, PASS_NAME_COUNT);
+			const char* const cullNames[] = { "none", "front", "back" };
+			const int cullFaces[] = { GL_NONE, GL_FRONT, GL_BACK };
+			int cull = FindName(cullName, cullNames, 3);
+			bValid = (pass >= 0) && (cull >= 0);
+			if (bValid == true)
+			{
+				scene.passes[last] = pass;
+				scene.cullFaces[last] = cullFaces[cull];
+			}
+		}
+		else if ((bNode == true) && ((keyword == "material") || (keyword == "texture")))
+		{
+			std::string tag;
+			bValid = !!(line >> tag);
+			if (bValid == true)
+			{
+				int tagIndex = AddTag(tag, tagLookup, scene.tagOffsets, scene.tagText);
+				if (keyword == "material")
+				{
+					scene.materialTags[last] = tagIndex;
+				}
+				else
+				{
+					scene.textureTags[last] = tagIndex;
+				}
+			}
+		}
+		else
+		{
+			bValid = false;
+		}
+
+		if (bValid == false)
+		{
+			std::cout << "Scene file " << filename << " line " << lineNumber
+				<< " could not be read: " << text << std::endl;
+		}
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  WriteCompiled()
+ *
+ *  This method is used for writing a parsed scene out as a
+ *  compiled file - the header, then each array on its own
+ *  aligned offset.
+ ***********************************************************/
+bool SceneFile::WriteCompiled(
+	const std::string& filename,
+	const PARSED_SCENE& scene,
+	long long sourceTime,
+	long long sourceSize)
+{
+	const void* arrayData[ARRAY_COUNT] =
+	{
+		scene.meshes.data(),
+		scene.passes.data(),
+		scene.cullFaces.data(),
+		scene.scales.data(),
+		scene.rotations.data(),
+		scene.positions.data(),
+		scene.uvScales.data(),
+		scene.colors.data(),
+		scene.materialTags.data(),
+		scene.textureTags.data(),
+		scene.lighting.data(),
+		scene.pointLights.data(),
+		scene.directionalLights.data(),
+		scene.materials.data(),
+		scene.tagOffsets.data(),
+		scene.tagText.data()
+	};
+	size_t nodeCount = scene.meshes.size();
+
+	COMPILED_HEADER header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, g_CompiledMagic, sizeof(g_CompiledMagic));
+	header.version = COMPILED_VERSION;
+	header.sourceTime = sourceTime;
+	header.sourceSize = sourceSize;
+	header.nodeCount = (uint32_t)nodeCount;
+	header.pointLightCount = (uint32_t)scene.pointLights.size();
+	header.directionalLightCount = (uint32_t)scene.directionalLights.size();
+	header.materialCount = (uint32_t)scene.materials.size();
+	header.tagCount = (uint32_t)scene.tagOffsets.size();
+	header.tagTextSize = (uint32_t)scene.tagText.size();
+
+	header.arraySizes[ARRAY_MESHES] = (uint32_t)(nodeCount * sizeof(int));
+	header.arraySizes[ARRAY_PASSES] = (uint32_t)(nodeCount * sizeof(int));
+	header.arraySizes[ARRAY_CULL_FACES] = (uint32_t)(nodeCount * sizeof(int));
+	header.arraySizes[ARRAY_SCALES] = (uint32_t)(nodeCount * sizeof(glm::vec3));
+	header.arraySizes[ARRAY_ROTATIONS] = (uint32_t)(nodeCount * sizeof(glm::vec3));
+	header.arraySizes[ARRAY_POSITIONS] = (uint32_t)(nodeCount * sizeof(glm::vec3));
+	header.arraySizes[ARRAY_UV_SCALES] = (uint32_t)(nodeCount * sizeof(glm::vec2));
+	header.arraySizes[ARRAY_COLORS] = (uint32_t)(nodeCount * sizeof(glm::vec4));
+	header.arraySizes[ARRAY_MATERIAL_TAGS] = (uint32_t)(nodeCount * sizeof(int));
+	header.arraySizes[ARRAY_TEXTURE_TAGS] = (uint32_t)(nodeCount * sizeof(int));
+	header.arraySizes[ARRAY_LIGHTING] = (uint32_t)(nodeCount * sizeof(int));
+	header.arraySizes[ARRAY_POINT_LIGHTS] = (uint32_t)(scene.pointLights.size() * sizeof(LIGHT_RECORD));
+	header.arraySizes[ARRAY_DIRECTIONAL_LIGHTS] = (uint32_t)(scene.directionalLights.size() * sizeof(LIGHT_RECORD));
+	header.arraySizes[ARRAY_MATERIALS] = (uint32_t)(scene.materials.size() * sizeof(MATERIAL_RECORD));
+	header.arraySizes[ARRAY_TAG_OFFSETS] = (uint32_t)(scene.tagOffsets.size() * sizeof(int));
+	header.arraySizes[ARRAY_TAG_TEXT] = (uint32_t)scene.tagText.size();
+
+	uint32_t offset = AlignOffset(sizeof(header));
+	for (int i = 0; i < ARRAY_COUNT; i++)
+	{
+		header.arrayOffsets[i] = offset;
+		offset = AlignOffset(offset + header.arraySizes[i]);
+	}
+	header.fileSize = offset;
+
+	FILE* pFile = fopen(filename.c_str(), "wb");
+	if (pFile == NULL)
+	{
+		return(false);
+	}
+
+	const unsigned char padding[ARRAY_ALIGNMENT] = {};
+	bool bWritten = (fwrite(&header, sizeof(header), 1, pFile) == 1);
+	uint32_t position = sizeof(header);
+	for (int i = 0; (bWritten == true) && (i < ARRAY_COUNT); i++)
+	{
+		uint32_t paddingSize = header.arrayOffsets[i] - position;
+		bWritten = ((paddingSize == 0) || (fwrite(padding, 1, paddingSize, pFile) == paddingSize)) &&
+			((header.arraySizes[i] == 0) || (fwrite(arrayData[i], 1, header.arraySizes[i], pFile) == header.arraySizes[i]));
+		position = header.arrayOffsets[i] + header.arraySizes[i];
+	}
+	uint32_t paddingSize = header.fileSize - position;
+	bWritten = (bWritten == true) && ((paddingSize == 0) || (fwrite(padding, 1, paddingSize, pFile) == paddingSize));
+
+	fclose(pFile);
+
+	if (bWritten == false)
+	{
+		remove(filename.c_str());
+	}
+
+	return(bWritten);
+}
+
+/***********************************************************
+ *  MapCompiled()
+ *
+ *  This method is used for mapping a compiled file into
+ *  memory read only, and pointing the scene arrays at its
+ *  contents.  The header is checked against the file size
+ *  before any array is used, so a damaged or older file is
+ *  rejected instead of read past its end.  With bCheckStamp
+ *  a file compiled from another version of the text file is
+ *  rejected too.
+ ***********************************************************/
+bool SceneFile::MapCompiled(const std::string& filename, bool bCheckStamp, long long sourceTime, long long sourceSize)
+{
+#ifdef _WIN32
+	HANDLE fileHandle = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		return(false);
+	}
+	LARGE_INTEGER fileSize;
+	HANDLE mappingHandle = NULL;
+	const unsigned char* pMapping = NULL;
+	if ((GetFileSizeEx(fileHandle, &fileSize) == TRUE) && (fileSize.QuadPart >= (LONGLONG)sizeof(COMPILED_HEADER)))
+	{
+		mappingHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+	}
+	if (mappingHandle != NULL)
+	{
+		pMapping = (const unsigned char*)MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+	}
+	if (pMapping == NULL)
+	{
+		if (mappingHandle != NULL)
+		{
+			CloseHandle(mappingHandle);
+		}
+		CloseHandle(fileHandle);
+		return(false);
+	}
+	m_fileHandle = fileHandle;
+	m_mappingHandle = mappingHandle;
+	m_pMapping = pMapping;
+	m_mappingSize = (size_t)fileSize.QuadPart;
+#else
+	int file = open(filename.c_str(), O_RDONLY);
+	if (file < 0)
+	{
+		return(false);
+	}
+	struct stat fileInfo;
+	void* pMapping = MAP_FAILED;
+	if ((fstat(file, &fileInfo) == 0) && (fileInfo.st_size >= (off_t)sizeof(COMPILED_HEADER)))
+	{
+		pMapping = mmap(NULL, (size_t)fileInfo.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	}
+	// the mapping stays valid once the file is closed
+	close(file);
+	if (pMapping == MAP_FAILED)
+	{
+		return(false);
+	}
+	m_pMapping = (const unsigned char*)pMapping;
+	m_mappingSize = (size_t)fileInfo.st_size;
+#endif
+
+	COMPILED_HEADER header;
+	std::memcpy(&header, m_pMapping, sizeof(header));
+	uint32_t nodeCount = header.nodeCount;
+	uint32_t expectedSizes[ARRAY_COUNT] =
+	{
+		(uint32_t)(nodeCount * sizeof(int)),
+		(uint32_t)(nodeCount * sizeof(int)),
+		(uint32_t)(nodeCount * sizeof(int)),
+		(uint32_t)(nodeCount * sizeof(glm::vec3)),
+		(uint32_t)(nodeCount * sizeof(glm::vec3)),
+		(uint32_t)(nodeCount * sizeof(glm::vec3)),
+		(uint32_t)(nodeCount * sizeof(glm::vec2)),
+		(uint32_t)(nodeCount * sizeof(glm::vec4)),
+		(uint32_t)(nodeCount * sizeof(int)),
+		(uint32_t)(nodeCount * sizeof(int)),
+		(uint32_t)(nodeCount * sizeof(int)),
+		(uint32_t)(header.pointLightCount * sizeof(LIGHT_RECORD)),
+		(uint32_t)(header.directionalLightCount * sizeof(LIGHT_RECORD)),
+		(uint32_t)(header.materialCount * sizeof(MATERIAL_RECORD)),
+		(uint32_t)(header.tagCount * sizeof(int)),
+		header.tagTextSize
+	};
+
+	bool bValid = (std::memcmp(header.magic, g_CompiledMagic, sizeof(g_CompiledMagic)) == 0) &&
+		(header.version == COMPILED_VERSION) &&
+		(header.fileSize == m_mappingSize) &&
+		((bCheckStamp == false) || ((header.sourceTime == sourceTime) && (header.sourceSize == sourceSize)));
+	for (int i = 0; (bValid == true) && (i < ARRAY_COUNT); i++)
+	{
+		bValid = (header.arraySizes[i] == expectedSizes[i]) &&
+			(header.arrayOffsets[i] % ARRAY_ALIGNMENT == 0) &&
+			(header.arrayOffsets[i] <= header.fileSize) &&
+			(header.arraySizes[i] <= header.fileSize - header.arrayOffsets[i]);
+	}
+	// every tag name must end inside the tag text
+	bValid = (bValid == true) &&
+		((header.tagTextSize == 0) || (m_pMapping[header.arrayOffsets[ARRAY_TAG_TEXT] + header.tagTextSize - 1] == '\0'));
+	const int* tagOffsets = (const int*)(m_pMapping + header.arrayOffsets[ARRAY_TAG_OFFSETS]);
+	for (uint32_t i = 0; (bValid == true) && (i < header.tagCount); i++)
+	{
+		bValid = (tagOffsets[i] >= 0) && ((uint32_t)tagOffsets[i] < header.tagTextSize);
+	}
+	const MATERIAL_RECORD* materials = (const MATERIAL_RECORD*)(m_pMapping + header.arrayOffsets[ARRAY_MATERIALS]);
+	for (uint32_t i = 0; (bValid == true) && (i < header.materialCount); i++)
+	{
+		bValid = (materials[i].tagIndex >= 0) && ((uint32_t)materials[i].tagIndex < header.tagCount);
+	}
+
+	if (bValid == false)
+	{
+		Unmap();
+		return(false);
+	}
+
+	m_arrays.nodeCount = (int)nodeCount;
+	m_arrays.meshes = (const int*)(m_pMapping + header.arrayOffsets[ARRAY_MESHES]);
+	m_arrays.passes = (const int*)(m_pMapping + header.arrayOffsets[ARRAY_PASSES]);
+	m_arrays.cullFaces = (const int*)(m_pMapping + header.arrayOffsets[ARRAY_CULL_FACES]);
+	m_arrays.scales = (const glm::vec3*)(m_pMapping + header.arrayOffsets[ARRAY_SCALES]);
+	m_arrays.rotations = (const glm::vec3*)(m_pMapping + header.arrayOffsets[ARRAY_ROTATIONS]);
+	m_arrays.positions = (const glm::vec3*)(m_pMapping + header.arrayOffsets[ARRAY_POSITIONS]);
+	m_arrays.uvScales = (const glm::vec2*)(m_pMapping + header.arrayOffsets[ARRAY_UV_SCALES]);
+	m_arrays.colors = (const glm::vec4*)(m_pMapping + header.arrayOffsets[ARRAY_COLORS]);
+	m_arrays.materialTags = (const int*)(m_pMapping + header.arrayOffsets[ARRAY_MATERIAL_TAGS]);
+	m_arrays.textureTags = (const int*)(m_pMapping + header.arrayOffsets[ARRAY_TEXTURE_TAGS]);
+	m_arrays.lighting = (const int*)(m_pMapping + header.arrayOffsets[ARRAY_LIGHTING]);
+	m_arrays.pointLightCount = (int)header.pointLightCount;
+	m_arrays.pointLights = (const LIGHT_RECORD*)(m_pMapping + header.arrayOffsets[ARRAY_POINT_LIGHTS]);
+	m_arrays.pDirectionalLight = (header.directionalLightCount > 0) ?
+		(const LIGHT_RECORD*)(m_pMapping + header.arrayOffsets[ARRAY_DIRECTIONAL_LIGHTS]) : NULL;
+	m_arrays.materialCount = (int)header.materialCount;
+	m_arrays.materials = materials;
+	m_arrays.tagCount = (int)header.tagCount;
+	m_arrays.tagOffsets = tagOffsets;
+	m_arrays.tagText = (const char*)(m_pMapping + header.arrayOffsets[ARRAY_TAG_TEXT]);
+
+	return(true);
+}
+
+/***********************************************************
+ *  UseParsed()
+ *
+ *  This method is used for pointing the scene arrays into
+ *  the parsed text scene, when no compiled file could be
+ *  written.
+ ***********************************************************/
+void SceneFile::UseParsed()
+{
+	m_arrays.nodeCount = (int)m_parsed.meshes.size();
+	m_arrays.meshes = m_parsed.meshes.data();
+	m_arrays.passes = m_parsed.passes.data();
+	m_arrays.cullFaces = m_parsed.cullFaces.data();
+	m_arrays.scales = m_parsed.scales.data();
+	m_arrays.rotations = m_parsed.rotations.data();
+	m_arrays.positions = m_parsed.positions.data();
+	m_arrays.uvScales = m_parsed.uvScales.data();
+	m_arrays.colors = m_parsed.colors.data();
+	m_arrays.materialTags = m_parsed.materialTags.data();
+	m_arrays.textureTags = m_parsed.textureTags.data();
+	m_arrays.lighting = m_parsed.lighting.data();
+	m_arrays.pointLightCount = (int)m_parsed.pointLights.size();
+	m_arrays.pointLights = m_parsed.pointLights.data();
+	m_arrays.pDirectionalLight = (m_parsed.directionalLights.size() > 0) ? &m_parsed.directionalLights[0] : NULL;
+	m_arrays.materialCount = (int)m_parsed.materials.size();
+	m_arrays.materials = m_parsed.materials.data();
+	m_arrays.tagCount = (int)m_parsed.tagOffsets.size();
+	m_arrays.tagOffsets = m_parsed.tagOffsets.data();
+	m_arrays.tagText = m_parsed.tagText.data();
+}
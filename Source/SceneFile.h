@@ -0,0 +1,172 @@
+///////////////////////////////////////////////////////////////////////////////
+// scenefile.h
+// ============
+// read a scene description file through a compiled, memory mapped copy
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+//  Notes: A scene is written by hand as a .scene text file - the format is
+//         described at the top of scenes/lamp.scene - and compiled into a
+//         .scenebin file next to it the first time it is loaded after a
+//         change.  The compiled file holds each node value as its own flat
+//         array (mesh IDs, passes, scales, rotations, positions, colors,
+//         tag indices and so on), the point lights in the std140 layout of
+//         the shader light struct, and a table of the tag names.  Loading
+//         it maps the file into memory and points the arrays straight at
+//         the mapping, so nothing is parsed or copied until the scene
+//         manager reads the values out.  When the compiled file cannot be
+//         written the parsed arrays are used from memory instead.
+//         The compiled file records the time and size of the text file it
+//         was built from, so any edit to the text - even one saved within
+//         the same second as the last compile - builds it again.  The
+//         object materials are kept in the compiled file too.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  SceneFile
+ *
+ *  This class holds the mapped compiled scene, or the
+ *  parsed text scene, and the arrays pointing into it.
+ ***********************************************************/
+class SceneFile
+{
+public:
+	// matches the std140 layout of the shader light structs -
+	// vec3 members are padded out to 16 bytes
+	struct LIGHT_RECORD
+	{
+		// the direction of a directional light
+		glm::vec3 position;
+		float pad0;
+		glm::vec3 ambient;
+		float pad1;
+		glm::vec3 diffuse;
+		float pad2;
+		glm::vec3 specular;
+		int bActive;
+	};
+
+	// an object material, named by its tag
+	struct MATERIAL_RECORD
+	{
+		glm::vec3 diffuseColor;
+		float shininess;
+		glm::vec3 specularColor;
+		int tagIndex;
+	};
+
+	// the values of the scene - each node array holds nodeCount
+	// entries, in the order the nodes are listed in the file
+	struct SCENE_ARRAYS
+	{
+		int nodeCount;
+		// MeshBuffers::MESH_SHAPE of each node
+		const int* meshes;
+		// SceneManager::RENDER_PASS of each node
+		const int* passes;
+		// GL_NONE, GL_FRONT or GL_BACK
+		const int* cullFaces;
+		const glm::vec3* scales;
+		// X, Y and Z rotations in degrees
+		const glm::vec3* rotations;
+		const glm::vec3* positions;
+		const glm::vec2* uvScales;
+		const glm::vec4* colors;
+		// tag index of the material and texture, -1 for none
+		const int* materialTags;
+		const int* textureTags;
+		// nonzero when the node is lit
+		const int* lighting;
+
+		int pointLightCount;
+		const LIGHT_RECORD* pointLights;
+		// NULL when the file has no directional light
+		const LIGHT_RECORD* pDirectionalLight;
+
+		int materialCount;
+		const MATERIAL_RECORD* materials;
+
+		int tagCount;
+		// offset of each tag name into tagText, which holds the
+		// null terminated names one after another
+		const int* tagOffsets;
+		const char* tagText;
+	};
+
+	// constructor
+	SceneFile();
+	// destructor
+	~SceneFile();
+
+	// load a .scene file through its compiled .scenebin file,
+	// compiling it first when it is missing or out of date
+	bool Load(const std::string& filename);
+	// release the mapped file and the parsed arrays
+	void Close();
+
+	// get the values of the loaded scene
+	const SCENE_ARRAYS& GetArrays() const { return(m_arrays); }
+	// get the name of a tag by its index
+	const char* GetTag(int tagIndex) const { return(m_arrays.tagText + m_arrays.tagOffsets[tagIndex]); }
+
+	// get the name of the compiled file of a .scene file
+	static std::string GetCompiledFilename(const std::string& filename);
+
+private:
+	// the scene read from the text file
+	struct PARSED_SCENE
+	{
+		std::vector<int> meshes;
+		std::vector<int> passes;
+		std::vector<int> cullFaces;
+		std::vector<glm::vec3> scales;
+		std::vector<glm::vec3> rotations;
+		std::vector<glm::vec3> positions;
+		std::vector<glm::vec2> uvScales;
+		std::vector<glm::vec4> colors;
+		std::vector<int> materialTags;
+		std::vector<int> textureTags;
+		std::vector<int> lighting;
+		std::vector<LIGHT_RECORD> pointLights;
+		std::vector<LIGHT_RECORD> directionalLights;
+		std::vector<MATERIAL_RECORD> materials;
+		std::vector<int> tagOffsets;
+		std::vector<char> tagText;
+	};
+
+	SCENE_ARRAYS m_arrays;
+	// the parsed text scene, only kept when it could not be
+	// compiled to a file
+	PARSED_SCENE m_parsed;
+	// the mapped compiled file, NULL when none is mapped
+	const unsigned char* m_pMapping;
+	size_t m_mappingSize;
+#ifdef _WIN32
+	void* m_fileHandle;
+	void* m_mappingHandle;
+#endif
+
+	// read a .scene text file - bad lines are reported and skipped
+	static bool ParseText(const std::string& filename, PARSED_SCENE& scene);
+	// write a parsed scene out as a compiled file, stamped with
+	// the time and size of its text file
+	static bool WriteCompiled(
+		const std::string& filename,
+		const PARSED_SCENE& scene,
+		long long sourceTime,
+		long long sourceSize);
+	// map a compiled file and point the arrays into it - the file
+	// is rejected unless its stamp matches, when a stamp is given
+	bool MapCompiled(const std::string& filename, bool bCheckStamp, long long sourceTime, long long sourceSize);
+	// release the mapped file
+	void Unmap();
+	// point the arrays into the parsed scene
+	void UseParsed();
+};
@@ -41,9 +41,121 @@
 //         Applied and bound new textures for zebra fur, mirror glass, and stitched 
 //         felt chevron. Defined shader materials to match these textures and 
 //         integrated all components using consistent transformations and lighting.
+// 
+//  Date: October 14, 2026
+//  Notes: Moved the scene description out of RenderScene() into a retained
+//         node list built once by DefineSceneNodes(). Each node caches its
+//         model matrix (rebuilt only when flagged dirty) along with its
+//         material, texture and pass, so a frame is a single draw loop.
+//         Per-draw uniforms now go through ShaderUniforms, which resolves
+//         their locations once and skips uploads of unchanged values.
+//         Materials and lights now live in std140 uniform buffers that
+//         are filled once, so a draw only selects its material index.
+//         Texture and material tags are hashed to their slot and index
+//         when they are registered, the scene nodes resolve their tags
+//         once while the scene is prepared, and unknown tags are
+//         reported there instead of silently drawing with slot -1.
+//         RenderScene() now queues the nodes through RenderQueue, which
+//         groups the opaque draws by pass, texture, material and mesh,
+//         and orders the glass back to front from each node's cached
+//         bounding sphere instead of relying on the listed draw order.
+//         Queued nodes that share a mesh, texture and pass are drawn with
+//         one instanced call through MeshBuffers; the model matrix,
+//         color, UV scale and material index are instance attributes.
+//         The unused SetTransformations(), SetShaderColor(),
+//         SetShaderTexture(), SetTextureUVScale() and SetShaderMaterial()
+//         uniform setters were removed along with those uniforms.
+//         On an OpenGL 4.6 context the opaque pass is drawn from a
+//         persistent indirect command buffer with glMultiDrawElements-
+//         Indirect, the per-draw values read by gl_DrawID from a storage
+//         buffer.  The view now reaches every program through a frame
+//         uniform block.
+//         The scene textures are decoded by the TextureLoader worker
+//         threads and uploaded a couple per frame, with a placeholder
+//         texture bound until each one arrives.  Each image is baked once
+//         into a BC7 compressed, pre-mipmapped .ktx2 file next to it,
+//         which later runs upload instead of decoding the JPEG.
+//         With ARB_bindless_texture each draw picks its texture from a
+//         resident handle by slot index, so the scene is no longer held
+//         to 16 texture units and texture changes no longer split the
+//         multi-draw batches.
+//         On an OpenGL 4.6 context the point lights are a runtime list
+//         culled into a froxel grid each frame, and each fragment only
+//         evaluates the lights of its cluster.
+//         Added a deferred shading path for the opaque pass: the
+//         indirect batches write position, normal, material and albedo
+//         into a GBuffer, and one full screen lighting pass shades each
+//         pixel once.  The glass and glow passes stay forward shaded.
+//         Added an optional depth pre-pass that draws the opaque nodes
+//         from a position only vertex stream, after which the shading
+//         pass tests with GL_EQUAL and only shades visible fragments.
+//         Without the pre-pass the opaque nodes are queued front to
+//         back, so the wall and floor no longer shade hidden fragments.
+//         Each scene node now keeps a world bounding box built from its
+//         mesh bounds and transform, and nodes outside the view frustum
+//         are left out of the render queue.  Large scenes walk a
+//         BoundingVolumeTree that is only rebuilt when a node moves.
+//         The round meshes are drawn at one of several levels of detail,
+//         picked per node from its projected size on screen, with a
+//         margin around each switch so nodes do not flicker between two
+//         levels at the boundary.
+//         RenderScene() opens a FrameProfiler scope for the scene update,
+//         the culling and sorting, and each of the opaque, glass and halo
+//         passes, so their CPU and GPU times can be told apart.
+//         For the benchmark stress preset, ReplicateScene() repeats the
+//         finished node list and point lights into a grid of copies.
+//         The texture binds and buffer uploads made here are counted in
+//         RenderStats.  The blend, depth and culling state goes through
+//         the RenderState cache, with each pass declared as a
+//         PIPELINE_STATE block, so only real changes reach the driver.
+//         The frame block, the instances and the light cluster lists are
+//         written into the FrameRingBuffer set with SetFrameRing(), so
+//         the per-frame data never waits on the GPU reading the last.
+//         The node update, culling, level of detail selection and sort
+//         key loops are split into batches run by the JobSystem worker
+//         threads, so the CPU side of large scenes scales with the core
+//         count.  The GL thread then walks the finished, sorted queue.
+//         The scene nodes and lights are no longer built in code - they
+//         are read from a SceneFile (scenes/lamp.scene by default) through
+//         its memory mapped compiled copy, so the layout can change, or
+//         another scene be loaded with --scene, without a rebuild.
+//         The object materials moved into the scene file as well.  With
+//         EnableHotReload() a FileWatcher looks at the scene file, the
+//         shader files and the texture images, and the start of each
+//         frame reloads only what changed - the shader programs, the one
+//         texture slot, or the nodes, lights and materials that differ.
+//         The scene shaders are built as ShaderPermutations with the lit,
+//         textured and light on/off branches fixed at compile time.  Each
+//         draw picks its permutation, which is also the shader field of
+//         its sort key, and the active point lights are packed to the
+//         front of the light block so the unclustered light loop only
+//         runs over as many as are on.
+//         Each node's normal matrix is rebuilt with its model matrix and
+//         sent with its instance, and the frame block carries the view-
+//         projection product, so the vertex shader lights rotated and
+//         scaled shapes with world space normals.
+//         The directional light and the bulb cast shadows through
+//         ShadowMaps, drawn with the depth program from the opaque nodes.
+//         The maps are only drawn again when a node or a light changes,
+//         and otherwise just bound for the shaders to sample.
+//         With order independent transparency the translucent nodes are
+//         queued by render state like the opaque ones and batched, and
+//         their fragments go into the TransparencyBuffers, which one full
+//         screen pass then blends over the frame before the halo.
+//         The passes draw into whatever framebuffer and viewport are
+//         bound, which the ResolutionScaler sets to its scaled target,
+//         and its upscale program is reloaded with the scene shaders.
+//         The slot images and the placeholder texture are owned by
+//         GpuResource handles, so a reloaded image frees the one it
+//         replaces and DestroyGLTextures(), now run by the destructor,
+//         deletes every texture instead of generating new names.  The
+//         material, light, frame, texture and point light blocks are
+//         bound as ranges of one GpuBufferPool block rather than as
+//         buffers of their own.
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "SceneManager.h"
+#include "RenderStats.h"
 
 #ifndef STB_IMAGE_IMPLEMENTATION
 #define STB_IMAGE_IMPLEMENTATION
@@ -52,14 +164,189 @@
 
 #include <glm/gtx/transform.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
 // declaration of global variables
 namespace
 {
-	const char* g_ModelName = "model";
-	const char* g_ColorValueName = "objectColor";
-	const char* g_TextureValueName = "objectTexture";
-	const char* g_UseTextureName = "bUseTexture";
-	const char* g_UseLightingName = "bUseLighting";
+	// the scene loaded when none is given on the command line
+	const char* const DEFAULT_SCENE_FILE = "scenes/lamp.scene";
+	// the shader files every scene program is built from
+	const char* const VERTEX_SHADER_FILE = "shaders/vertexShader.glsl";
+	const char* const FRAGMENT_SHADER_FILE = "shaders/fragmentShader.glsl";
+
+	// file watcher IDs - each texture slot is watched as
+	// WATCH_FIRST_TEXTURE plus the slot
+	const int WATCH_SCENE_FILE = 0;
+	const int WATCH_SHADERS = 1;
+	const int WATCH_FIRST_TEXTURE = 2;
+
+	/***********************************************************
+	 *  BuildModelMatrix()
+	 *
+	 *  Build a model matrix from the passed in scale, rotation
+	 *  and position values - scale first, then X, Y and Z
+	 *  rotations, then translation.
+	 ***********************************************************/
+	glm::mat4 BuildModelMatrix(
+		glm::vec3 scaleXYZ,
+		float XrotationDegrees,
+		float YrotationDegrees,
+		float ZrotationDegrees,
+		glm::vec3 positionXYZ)
+	{
+		// variables for this method
+		glm::mat4 scale;
+		glm::mat4 rotationX;
+		glm::mat4 rotationY;
+		glm::mat4 rotationZ;
+		glm::mat4 translation;
+
+		// set the scale value in the transform buffer
+		scale = glm::scale(scaleXYZ);
+		// set the rotation values in the transform buffer
+		rotationX = glm::rotate(glm::radians(XrotationDegrees), glm::vec3(1.0f, 0.0f, 0.0f));
+		rotationY = glm::rotate(glm::radians(YrotationDegrees), glm::vec3(0.0f, 1.0f, 0.0f));
+		rotationZ = glm::rotate(glm::radians(ZrotationDegrees), glm::vec3(0.0f, 0.0f, 1.0f));
+		// set the translation value in the transform buffer
+		translation = glm::translate(positionXYZ);
+
+		return(translation * rotationZ * rotationY * rotationX * scale);
+	}
+
+	// object space bounding spheres of the basic shape meshes,
+	// in MESH_TYPE order
+	struct MESH_BOUNDS
+	{
+		glm::vec3 center;
+		float radius;
+	};
+	const MESH_BOUNDS g_MeshBounds[] =
+	{
+		{ glm::vec3(0.0f, 0.0f, 0.0f), 0.866f },   // box, -0.5 to 0.5
+		{ glm::vec3(0.0f, 0.5f, 0.0f), 1.118f },   // cylinder, radius 1, y 0 to 1
+		{ glm::vec3(0.0f, 0.0f, 0.0f), 1.0f },     // sphere, radius 1
+		{ glm::vec3(0.0f, 0.0f, 0.0f), 0.866f },   // prism, -0.5 to 0.5
+		{ glm::vec3(0.0f, 0.0f, 0.0f), 1.415f },   // plane, -1 to 1 in X and Z
+		{ glm::vec3(0.0f, 0.0f, 0.0f), 1.2f },     // torus, radius 1 plus the tube
+		{ glm::vec3(0.0f, 0.0f, 0.0f), 0.866f },   // three sided pyramid, -0.5 to 0.5
+		{ glm::vec3(0.0f, 0.5f, 0.0f), 1.118f }    // tapered cylinder, base radius 1, y 0 to 1
+	};
+
+	/***********************************************************
+	 *  GetPointLightRange()
+	 *
+	 *  Get the distance where a point light's brightest color
+	 *  drops below 1/256, from the attenuation in
+	 *  fragmentShader.glsl.  Past that distance the light adds
+	 *  nothing visible, so clustering leaves it out.
+	 ***********************************************************/
+	float GetPointLightRange(const SceneManager::POINT_LIGHT& light)
+	{
+		const float constant = 1.0f;
+		const float linear = 0.09f;
+		const float quadratic = 0.032f;
+
+		float brightest = 0.0f;
+		for (int i = 0; i < 3; i++)
+		{
+			brightest = std::max(brightest, light.ambient[i]);
+			brightest = std::max(brightest, light.diffuse[i]);
+			brightest = std::max(brightest, light.specular[i]);
+		}
+
+		// solve constant + linear * d + quadratic * d^2 = 256 * brightest
+		float c = constant - 256.0f * brightest;
+		if (c >= 0.0f)
+		{
+			return(0.0f);
+		}
+
+		return((-linear + std::sqrt(linear * linear - 4.0f * quadratic * c)) / (2.0f * quadratic));
+	}
+
+	// projected diameter in pixels below which a node drops from
+	// each level of detail to the next coarser one
+	const float LOD_SCREEN_SIZES[MeshBuffers::LOD_COUNT - 1] = { 160.0f, 48.0f };
+	// fraction a node must move past a switch size before its level
+	// changes, so a node resting near a switch size keeps its level
+	const float LOD_HYSTERESIS = 0.15f;
+
+	// profiler scope name of each render pass, in RENDER_PASS order
+	const char* g_PassScopeNames[] =
+	{
+		"opaque pass",
+		"glass pass",
+		"halo pass"
+	};
+
+	// blend and depth state of each render pass, in RENDER_PASS order
+	const RenderState::PIPELINE_STATE g_PassStates[] =
+	{
+		// opaque - depth tested and written, no blending
+		{ false, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, true, true, GL_LESS, true },
+		// glass - alpha blended, still hidden behind opaque geometry,
+		// no depth writes while blending
+		{ true, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, true, false, GL_LESS, true },
+		// halo - additive, no depth test so it shows through the glass
+		{ true, GL_ONE, GL_ONE, false, false, GL_LESS, true }
+	};
+	// depth pre-pass - depth only, no color writes
+	const RenderState::PIPELINE_STATE DEPTH_PREPASS_STATE =
+		{ false, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, true, true, GL_LESS, false };
+	// opaque shading after the pre-pass - only the fragments that
+	// match the laid down depth, which is already written
+	const RenderState::PIPELINE_STATE PREPASSED_OPAQUE_STATE =
+		{ false, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, true, false, GL_EQUAL, true };
+	// depth slope and constant offset of the shadow map draws, so
+	// the lit surfaces do not shadow themselves
+	const float SHADOW_SLOPE_BIAS = 2.0f;
+	const float SHADOW_CONSTANT_BIAS = 4.0f;
+	// weighted blended translucent draws - every fragment adds into
+	// the accumulation target, still hidden behind opaque geometry.
+	// The revealage target's own blend is set apart from the cache.
+	const RenderState::PIPELINE_STATE OIT_WEIGHTED_STATE =
+		{ true, GL_ONE, GL_ONE, true, false, GL_LESS, true };
+	// linked list translucent draws - the fragments only go into
+	// the node buffer, nothing is written to the frame
+	const RenderState::PIPELINE_STATE OIT_LINKED_LIST_STATE =
+		{ false, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, true, false, GL_LESS, false };
+	// weighted composite triangle - the average color blended by
+	// the coverage, over every pixel
+	const RenderState::PIPELINE_STATE OIT_COMPOSITE_STATE =
+		{ true, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, false, false, GL_LESS, true };
+	// linked list resolve triangle - the blended layers added over
+	// the frame scaled by what they let through
+	const RenderState::PIPELINE_STATE OIT_RESOLVE_STATE =
+		{ true, GL_ONE, GL_SRC_ALPHA, false, false, GL_LESS, true };
+	// deferred lighting triangle - every pixel passes the depth test
+	// and writes the depth of its stored surface
+	const RenderState::PIPELINE_STATE DEFERRED_LIGHTING_STATE =
+		{ false, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, true, true, GL_ALWAYS, true };
+
+	/***********************************************************
+	 *  GetCullState()
+	 *
+	 *  Get the sort key value of a face culling mode.  Nodes
+	 *  showing their back faces sort first, so when two
+	 *  blended nodes are at the same depth the inside wall is
+	 *  drawn before the outside wall.
+	 ***********************************************************/
+	int GetCullState(GLenum cullFace)
+	{
+		switch (cullFace)
+		{
+		case GL_FRONT:
+			return(0);
+		case GL_NONE:
+			return(1);
+		default:
+			return(2);
+		}
+	}
 }
 
 /***********************************************************
@@ -67,10 +354,72 @@ namespace
  *
  *  The constructor for the class
  ***********************************************************/
-SceneManager::SceneManager(ShaderManager *pShaderManager)
+SceneManager::SceneManager()
 {
-	m_pShaderManager = pShaderManager;
-	m_basicMeshes = new ShapeMeshes();
+	m_pMeshBuffers = new MeshBuffers();
+	m_pTextureLoader = new TextureLoader();
+	m_loadedTextures = 0;
+	m_pPlaceholderTexture = new GpuResource(GpuResource::RESOURCE_TEXTURE);
+	m_maxTextureSlots = 16;
+	m_bBindlessTextures = false;
+	m_pBufferPool = new GpuBufferPool();
+	m_textureBlockRange = GpuBufferPool::GetEmptyAllocation();
+	m_lights = LIGHT_BLOCK();
+	m_bLightsDirty = false;
+	m_bClusteredLighting = false;
+	m_pLightClusters = new LightClusters();
+	m_pointLightRange = GpuBufferPool::GetEmptyAllocation();
+	m_materialRange = GpuBufferPool::GetEmptyAllocation();
+	m_lightRange = GpuBufferPool::GetEmptyAllocation();
+	m_viewMatrix = glm::mat4(1.0f);
+	m_projectionMatrix = glm::mat4(1.0f);
+	m_viewPosition = glm::vec3(0.0f);
+	m_frameBlockRange = GpuBufferPool::GetEmptyAllocation();
+	m_frameBlock = FRAME_BLOCK();
+	m_programID = 0;
+	m_batchProgramID = 0;
+	m_pFrameRing = NULL;
+	m_pResolutionScaler = NULL;
+	m_uniformAlignment = 256;
+	m_pSceneShaders = new ShaderPermutations();
+	m_pIndirectShaders = new ShaderPermutations();
+	m_pIndirectCommands = new IndirectCommandBuffer();
+	m_bIndirectDraw = false;
+	m_bSceneChanged = true;
+	m_pGBufferShaders = new ShaderPermutations();
+	m_pDeferredLightingProgram = new ShaderProgram();
+	m_pGBuffer = new GBuffer();
+	m_gBufferTextureUnit = 0;
+	m_bDeferredAvailable = false;
+	m_bDeferredShading = false;
+	m_pDepthProgram = new ShaderProgram();
+	m_pIndirectDepthProgram = new ShaderProgram();
+	m_pIndirectDepthUniforms = new ShaderUniforms();
+	m_bDepthPrePassAvailable = false;
+	m_bDepthPrePass = false;
+	m_pShadowMaps = new ShadowMaps();
+	m_shadowTextureUnit = 0;
+	m_bShadowsAvailable = false;
+	m_bShadowsDirty = true;
+	m_pWeightedShaders = new ShaderPermutations();
+	m_pWeightedCompositeProgram = new ShaderProgram();
+	m_pLinkedListShaders = new ShaderPermutations();
+	m_pLinkedListResolveProgram = new ShaderProgram();
+	m_pTransparencyBuffers = new TransparencyBuffers();
+	m_bWeightedAvailable = false;
+	m_bLinkedListAvailable = false;
+	m_transparencyMode = TRANSPARENCY_SORTED;
+	m_pBatchShaders = m_pSceneShaders;
+	m_bBoundsChanged = true;
+	m_culledNodeCount = 0;
+	m_pJobSystem = new JobSystem();
+	m_viewportHeight = 1;
+	m_pProfiler = NULL;
+	m_bProfileScopeOpen = false;
+	m_sceneCopies = 1;
+	m_sceneFilename = DEFAULT_SCENE_FILE;
+	m_pFileWatcher = NULL;
+	m_bCompressedTextures = false;
 }
 
 /***********************************************************
@@ -80,98 +429,225 @@ SceneManager::SceneManager(ShaderManager *pShaderManager)
  ***********************************************************/
 SceneManager::~SceneManager()
 {
-	m_pShaderManager = NULL;
-	delete m_basicMeshes;
-	m_basicMeshes = NULL;
+	delete m_pMeshBuffers;
+	m_pMeshBuffers = NULL;
+	delete m_pTextureLoader;
+	m_pTextureLoader = NULL;
+
+	DestroyGLTextures();
+	if ((m_pPlaceholderTexture->GetName() != 0) && (m_bBindlessTextures == true))
+	{
+		glMakeTextureHandleNonResidentARB(glGetTextureHandleARB(m_pPlaceholderTexture->GetName()));
+	}
+	delete m_pPlaceholderTexture;
+	m_pPlaceholderTexture = NULL;
+	m_pBufferPool->Free(m_materialRange);
+	m_pBufferPool->Free(m_lightRange);
+	m_pBufferPool->Free(m_frameBlockRange);
+	m_pBufferPool->Free(m_textureBlockRange);
+	m_pBufferPool->Free(m_pointLightRange);
+	delete m_pBufferPool;
+	m_pBufferPool = NULL;
+
+	delete m_pSceneShaders;
+	m_pSceneShaders = NULL;
+	delete m_pLightClusters;
+	m_pLightClusters = NULL;
+	delete m_pIndirectShaders;
+	m_pIndirectShaders = NULL;
+	delete m_pIndirectCommands;
+	m_pIndirectCommands = NULL;
+	delete m_pGBufferShaders;
+	m_pGBufferShaders = NULL;
+	delete m_pDeferredLightingProgram;
+	m_pDeferredLightingProgram = NULL;
+	delete m_pGBuffer;
+	m_pGBuffer = NULL;
+	delete m_pDepthProgram;
+	m_pDepthProgram = NULL;
+	delete m_pIndirectDepthProgram;
+	m_pIndirectDepthProgram = NULL;
+	delete m_pIndirectDepthUniforms;
+	m_pIndirectDepthUniforms = NULL;
+	delete m_pShadowMaps;
+	m_pShadowMaps = NULL;
+	delete m_pWeightedShaders;
+	m_pWeightedShaders = NULL;
+	delete m_pWeightedCompositeProgram;
+	m_pWeightedCompositeProgram = NULL;
+	delete m_pLinkedListShaders;
+	m_pLinkedListShaders = NULL;
+	delete m_pLinkedListResolveProgram;
+	m_pLinkedListResolveProgram = NULL;
+	delete m_pTransparencyBuffers;
+	m_pTransparencyBuffers = NULL;
+	delete m_pJobSystem;
+	m_pJobSystem = NULL;
+	delete m_pFileWatcher;
+	m_pFileWatcher = NULL;
 }
 
 /***********************************************************
  *  CreateGLTexture()
  *
- *  This method is used for loading textures from image files,
- *  configuring the texture mapping parameters in OpenGL,
- *  generating the mipmaps, and loading the read texture into
- *  the next available texture slot in memory.
+ *  This method is used for reserving the next available
+ *  texture slot for an image file and queueing the file to
+ *  be decoded on the texture loader's worker threads.  The
+ *  slot shows the placeholder texture until the decoded
+ *  image has been uploaded by UpdateTextureUploads().
+ ***********************************************************/
+bool SceneManager::CreateGLTexture(const char* filename, const std::string& tag)
+{
+	if (m_textureSlotLookup.count(tag) > 0)
+	{
+		std::cout << "Texture tag already loaded:" << tag << std::endl;
+		return false;
+	}
+
+	if (m_loadedTextures >= m_maxTextureSlots)
+	{
+		std::cout << "No texture slot left for image:" << filename << ", the limit is " << m_maxTextureSlots << std::endl;
+		return false;
+	}
+
+	if (m_pPlaceholderTexture->GetName() == 0)
+	{
+		CreatePlaceholderTexture();
+	}
+
+	// register the texture slot and associate it with the special
+	// tag string, so scene nodes can resolve it straight away
+	TEXTURE_INFO texture;
+	texture.tag = tag;
+	texture.filename = filename;
+	m_textureIDs.push_back(std::move(texture));
+	m_textureSlotLookup[tag] = m_loadedTextures;
+	SetTextureHandle(m_loadedTextures, m_pPlaceholderTexture->GetName());
+
+	m_pTextureLoader->Request(filename, m_loadedTextures);
+	m_loadedTextures++;
+
+	return true;
+}
+
+/***********************************************************
+ *  CreatePlaceholderTexture()
+ *
+ *  This method is used for creating the single texel, mid
+ *  grey texture that is bound to a texture slot while its
+ *  image is still being decoded.
  ***********************************************************/
-bool SceneManager::CreateGLTexture(const char* filename, std::string tag)
+void SceneManager::CreatePlaceholderTexture()
 {
-	int width = 0;
-	int height = 0;
-	int colorChannels = 0;
+	const unsigned char texel[4] = { 128, 128, 128, 255 };
+
 	GLuint textureID = 0;
+	glGenTextures(1, &textureID);
+	m_pPlaceholderTexture->Reset(textureID, sizeof(texel));
+	glBindTexture(GL_TEXTURE_2D, textureID);
 
-	// indicate to always flip images vertically when loaded
-	stbi_set_flip_vertically_on_load(true);
-
-	// try to parse the image data from the specified image file
-	unsigned char* image = stbi_load(
-		filename,
-		&width,
-		&height,
-		&colorChannels,
-		0);
-
-	// if the image was successfully read from the image file
-	if (image)
-	{
-		std::cout << "Successfully loaded image:" << filename << ", width:" << width << ", height:" << height << ", channels:" << colorChannels << std::endl;
-
-		glGenTextures(1, &textureID);
-		glBindTexture(GL_TEXTURE_2D, textureID);
-
-		// set the texture wrapping parameters
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-		// set texture filtering parameters
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-		// if the loaded image is in RGB format
-		if (colorChannels == 3)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, image);
-		// if the loaded image is in RGBA format - it supports transparency
-		else if (colorChannels == 4)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
-		else
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, texel);
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+/***********************************************************
+ *  UpdateTextureUploads()
+ *
+ *  This method is used for uploading the images that the
+ *  worker threads have finished decoding and binding the
+ *  new textures in place of the placeholder.  Only a couple
+ *  of images are uploaded per frame so the frame rate holds
+ *  while the scene textures stream in.  A reloaded image
+ *  replaces the texture it was loaded from before, which is
+ *  deleted once the slot no longer uses it.
+ *
+ *  Edited on: October 14, 2026
+ *  Notes: The slot's GpuResource takes the new image, which
+ *         deletes the one it held and keeps the tally.
+ ***********************************************************/
+void SceneManager::UpdateTextureUploads()
+{
+	std::vector<TextureLoader::LOADED_TEXTURE> loaded;
+	m_pTextureLoader->ProcessUploads(MAX_TEXTURE_UPLOADS_PER_FRAME, loaded);
+
+	for (int i = 0; i < loaded.size(); i++)
+	{
+		int slot = loaded[i].slot;
+		SetTextureHandle(slot, loaded[i].textureID);
+		m_textureIDs[slot].image.Reset(loaded[i].textureID, loaded[i].bytes);
+
+		if (m_bBindlessTextures == false)
 		{
-			std::cout << "Not implemented to handle image with " << colorChannels << " channels" << std::endl;
-			return false;
+			glActiveTexture(GL_TEXTURE0 + slot);
+			glBindTexture(GL_TEXTURE_2D, m_textureIDs[slot].ID);
+			RenderStats::Add(RenderStats::COUNTER_TEXTURE_BINDS);
 		}
+	}
+}
 
-		// generate the texture mipmaps for mapping textures to lower resolutions
-		glGenerateMipmap(GL_TEXTURE_2D);
+/***********************************************************
+ *  SetTextureHandle()
+ *
+ *  This method is used for storing the texture of a slot.
+ *  With bindless textures its handle is made resident and
+ *  written into the slot's texture block entry, so draws
+ *  pick it by slot index without any binding.
+ ***********************************************************/
+void SceneManager::SetTextureHandle(int slot, GLuint textureID)
+{
+	TEXTURE_INFO& texture = m_textureIDs[slot];
+	texture.ID = textureID;
 
-		// free the image data from local memory
-		stbi_image_free(image);
-		glBindTexture(GL_TEXTURE_2D, 0); // Unbind the texture
+	if (m_bBindlessTextures == false)
+	{
+		return;
+	}
 
-		// register the loaded texture and associate it with the special tag string
-		m_textureIDs[m_loadedTextures].ID = textureID;
-		m_textureIDs[m_loadedTextures].tag = tag;
-		m_loadedTextures++;
+	// the placeholder handle is shared, so it stays resident
+	if ((texture.handle != 0) && (texture.handle != glGetTextureHandleARB(m_pPlaceholderTexture->GetName())))
+	{
+		glMakeTextureHandleNonResidentARB(texture.handle);
+	}
 
-		return true;
+	texture.handle = glGetTextureHandleARB(textureID);
+	if (glIsTextureHandleResidentARB(texture.handle) == GL_FALSE)
+	{
+		glMakeTextureHandleResidentARB(texture.handle);
 	}
 
-	std::cout << "Could not load image:" << filename << std::endl;
+	TEXTURE_HANDLE entry;
+	entry.handle = texture.handle;
+	entry.pad0 = 0;
 
-	// Error loading the image
-	return false;
+	m_pBufferPool->Upload(m_textureBlockRange, sizeof(TEXTURE_HANDLE) * slot, sizeof(TEXTURE_HANDLE), &entry);
 }
 
 /***********************************************************
  *  BindGLTextures()
  *
  *  This method is used for binding the loaded textures to
- *  OpenGL texture memory slots.  There are up to 16 slots.
+ *  OpenGL texture memory slots.  Bindless textures are
+ *  picked by handle instead and need no binding.
  ***********************************************************/
 void SceneManager::BindGLTextures()
 {
+	if (m_bBindlessTextures == true)
+	{
+		return;
+	}
+
 	for (int i = 0; i < m_loadedTextures; i++)
 	{
 		// bind textures on corresponding texture units
 		glActiveTexture(GL_TEXTURE0 + i);
 		glBindTexture(GL_TEXTURE_2D, m_textureIDs[i].ID);
+		RenderStats::Add(RenderStats::COUNTER_TEXTURE_BINDS);
 	}
 }
 
@@ -180,13 +656,34 @@ void SceneManager::BindGLTextures()
  *
  *  This method is used for freeing the memory in all the
  *  used texture memory slots.
+ *
+ *  Edited on: October 14, 2026
+ *  Notes: This generated a new texture name for every slot
+ *         instead of deleting it, and nothing called it.  It
+ *         now releases each bindless handle other than the
+ *         shared placeholder's, deletes the slot images and
+ *         empties the slots, and the destructor calls it.
  ***********************************************************/
 void SceneManager::DestroyGLTextures()
 {
+	GLuint64 placeholderHandle = 0;
+	if ((m_bBindlessTextures == true) && (m_pPlaceholderTexture->GetName() != 0))
+	{
+		placeholderHandle = glGetTextureHandleARB(m_pPlaceholderTexture->GetName());
+	}
+
 	for (int i = 0; i < m_loadedTextures; i++)
 	{
-		glGenTextures(1, &m_textureIDs[i].ID);
+		if ((m_textureIDs[i].handle != 0) && (m_textureIDs[i].handle != placeholderHandle))
+		{
+			glMakeTextureHandleNonResidentARB(m_textureIDs[i].handle);
+		}
+		m_textureIDs[i].image.Reset();
 	}
+
+	m_textureIDs.clear();
+	m_textureSlotLookup.clear();
+	m_loadedTextures = 0;
 }
 
 /***********************************************************
@@ -195,21 +692,14 @@ void SceneManager::DestroyGLTextures()
  *  This method is used for getting an ID for the previously
  *  loaded texture bitmap associated with the passed in tag.
  ***********************************************************/
-int SceneManager::FindTextureID(std::string tag)
+int SceneManager::FindTextureID(const std::string& tag)
 {
 	int textureID = -1;
-	int index = 0;
-	bool bFound = false;
+	int textureSlot = FindTextureSlot(tag);
 
-	while ((index < m_loadedTextures) && (bFound == false))
+	if (textureSlot >= 0)
 	{
-		if (m_textureIDs[index].tag.compare(tag) == 0)
-		{
-			textureID = m_textureIDs[index].ID;
-			bFound = true;
-		}
-		else
-			index++;
+		textureID = m_textureIDs[textureSlot].ID;
 	}
 
 	return(textureID);
@@ -221,21 +711,14 @@ int SceneManager::FindTextureID(std::string tag)
  *  This method is used for getting a slot index for the previously
  *  loaded texture bitmap associated with the passed in tag.
  ***********************************************************/
-int SceneManager::FindTextureSlot(std::string tag)
+int SceneManager::FindTextureSlot(const std::string& tag)
 {
 	int textureSlot = -1;
-	int index = 0;
-	bool bFound = false;
 
-	while ((index < m_loadedTextures) && (bFound == false))
+	std::unordered_map<std::string, int>::const_iterator found = m_textureSlotLookup.find(tag);
+	if (found != m_textureSlotLookup.end())
 	{
-		if (m_textureIDs[index].tag.compare(tag) == 0)
-		{
-			textureSlot = index;
-			bFound = true;
-		}
-		else
-			index++;
+		textureSlot = found->second;
 	}
 
 	return(textureSlot);
@@ -247,388 +730,1918 @@ int SceneManager::FindTextureSlot(std::string tag)
  *  This method is used for getting a material from the previously
  *  defined materials list that is associated with the passed in tag.
  ***********************************************************/
-bool SceneManager::FindMaterial(std::string tag, OBJECT_MATERIAL& material)
+bool SceneManager::FindMaterial(const std::string& tag, OBJECT_MATERIAL& material)
 {
-	if (m_objectMaterials.size() == 0)
+	int index = FindMaterialIndex(tag);
+	if (index < 0)
 	{
 		return(false);
 	}
 
-	int index = 0;
-	bool bFound = false;
-	while ((index < m_objectMaterials.size()) && (bFound == false))
+	material.diffuseColor = m_objectMaterials[index].diffuseColor;
+	material.specularColor = m_objectMaterials[index].specularColor;
+	material.shininess = m_objectMaterials[index].shininess;
+
+	return(true);
+}
+
+/***********************************************************
+ *  FindMaterialIndex()
+ *
+ *  This method is used for getting the list index of the
+ *  previously defined material associated with the passed
+ *  in tag, or -1 when no material has that tag.
+ ***********************************************************/
+int SceneManager::FindMaterialIndex(const std::string& tag)
+{
+	int materialIndex = -1;
+
+	std::unordered_map<std::string, int>::const_iterator found = m_materialLookup.find(tag);
+	if (found != m_materialLookup.end())
 	{
-		if (m_objectMaterials[index].tag.compare(tag) == 0)
-		{
-			bFound = true;
-			material.diffuseColor = m_objectMaterials[index].diffuseColor;
-			material.specularColor = m_objectMaterials[index].specularColor;
-			material.shininess = m_objectMaterials[index].shininess;
-		}
-		else
-		{
-			index++;
-		}
+		materialIndex = found->second;
 	}
 
-	return(true);
+	return(materialIndex);
+}
+
+/***********************************************************
+ *  AddSceneNode()
+ *
+ *  This method is used for appending a node to the retained
+ *  scene list.  The node starts out opaque, lit, untextured
+ *  and white; its model matrix is built on the next call
+ *  to UpdateSceneNodes().  The index of the new node is
+ *  returned for the SetNode*() methods.
+ ***********************************************************/
+int SceneManager::AddSceneNode(
+	MESH_TYPE mesh,
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ)
+{
+	SCENE_NODE node;
+
+	node.mesh = mesh;
+	node.pass = PASS_OPAQUE;
+	node.cullFace = GL_NONE;
+	node.scaleXYZ = scaleXYZ;
+	node.XrotationDegrees = XrotationDegrees;
+	node.YrotationDegrees = YrotationDegrees;
+	node.ZrotationDegrees = ZrotationDegrees;
+	node.positionXYZ = positionXYZ;
+	node.modelMatrix = glm::mat4(1.0f);
+	node.normalMatrix = glm::mat3(1.0f);
+	node.bDirty = true;
+	node.boundsCenter = positionXYZ;
+	node.boundsRadius = 0.0f;
+	node.lodLevel = 0;
+	node.materialIndex = -1;
+	node.textureSlot = -1;
+	node.color = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
+	node.UVscale = glm::vec2(1.0f, 1.0f);
+	node.bUseLighting = true;
+
+	m_sceneNodes.push_back(node);
+	m_bSceneChanged = true;
+	m_bShadowsDirty = true;
+
+	return((int)m_sceneNodes.size() - 1);
 }
 
 /***********************************************************
- *  SetTransformations()
+ *  SetNodeTransform()
  *
- *  This method is used for setting the transform buffer
- *  using the passed in transformation values.
+ *  This method is used for moving a scene node.  The model
+ *  matrix is flagged dirty and rebuilt before the next draw.
  ***********************************************************/
-void SceneManager::SetTransformations(
+void SceneManager::SetNodeTransform(
+	int nodeIndex,
 	glm::vec3 scaleXYZ,
 	float XrotationDegrees,
 	float YrotationDegrees,
 	float ZrotationDegrees,
 	glm::vec3 positionXYZ)
 {
-	// variables for this method
-	glm::mat4 modelView;
-	glm::mat4 scale;
-	glm::mat4 rotationX;
-	glm::mat4 rotationY;
-	glm::mat4 rotationZ;
-	glm::mat4 translation;
+	SCENE_NODE& node = m_sceneNodes[nodeIndex];
+
+	node.scaleXYZ = scaleXYZ;
+	node.XrotationDegrees = XrotationDegrees;
+	node.YrotationDegrees = YrotationDegrees;
+	node.ZrotationDegrees = ZrotationDegrees;
+	node.positionXYZ = positionXYZ;
+	node.bDirty = true;
+	m_bSceneChanged = true;
+}
 
-	// set the scale value in the transform buffer
-	scale = glm::scale(scaleXYZ);
-	// set the rotation values in the transform buffer
-	rotationX = glm::rotate(glm::radians(XrotationDegrees), glm::vec3(1.0f, 0.0f, 0.0f));
-	rotationY = glm::rotate(glm::radians(YrotationDegrees), glm::vec3(0.0f, 1.0f, 0.0f));
-	rotationZ = glm::rotate(glm::radians(ZrotationDegrees), glm::vec3(0.0f, 0.0f, 1.0f));
-	// set the translation value in the transform buffer
-	translation = glm::translate(positionXYZ);
+/***********************************************************
+ *  SetNodeMaterial()
+ *
+ *  This method is used for assigning a defined material
+ *  to a scene node.  The tag is resolved to its material
+ *  index here, so drawing never looks a tag up.
+ ***********************************************************/
+void SceneManager::SetNodeMaterial(int nodeIndex, const std::string& materialTag)
+{
+	int materialIndex = FindMaterialIndex(materialTag);
+	if (materialIndex < 0)
+	{
+		std::cout << "Scene node " << nodeIndex << " uses unknown material:" << materialTag << std::endl;
+	}
 
-	modelView = translation * rotationZ * rotationY * rotationX * scale;
+	m_sceneNodes[nodeIndex].materialIndex = materialIndex;
+	m_bSceneChanged = true;
+}
 
-	if (NULL != m_pShaderManager)
+/***********************************************************
+ *  SetNodeTexture()
+ *
+ *  This method is used for assigning a loaded texture to
+ *  a scene node.  The tag is resolved to its texture slot
+ *  here, so drawing never looks a tag up.
+ ***********************************************************/
+void SceneManager::SetNodeTexture(int nodeIndex, const std::string& textureTag)
+{
+	int textureSlot = FindTextureSlot(textureTag);
+	if (textureSlot < 0)
 	{
-		m_pShaderManager->setMat4Value(g_ModelName, modelView);
+		std::cout << "Scene node " << nodeIndex << " uses unknown texture:" << textureTag << std::endl;
 	}
+
+	m_sceneNodes[nodeIndex].textureSlot = textureSlot;
+	m_bSceneChanged = true;
 }
 
 /***********************************************************
- *  SetShaderColor()
+ *  SetNodeUVScale()
  *
- *  This method is used for setting the passed in color
- *  into the shader for the next draw command
+ *  This method is used for setting the texture UV scale
+ *  of a scene node.
+ ***********************************************************/
+void SceneManager::SetNodeUVScale(int nodeIndex, float u, float v)
+{
+	m_sceneNodes[nodeIndex].UVscale = glm::vec2(u, v);
+	m_bSceneChanged = true;
+}
+
+/***********************************************************
+ *  SetNodeColor()
+ *
+ *  This method is used for setting the color of a scene
+ *  node.  For textured nodes the alpha value is used as
+ *  the texture transparency.
  ***********************************************************/
-void SceneManager::SetShaderColor(
+void SceneManager::SetNodeColor(
+	int nodeIndex,
 	float redColorValue,
 	float greenColorValue,
 	float blueColorValue,
 	float alphaValue)
 {
-	// variables for this method
-	glm::vec4 currentColor;
+	SetNodeColor(nodeIndex, glm::vec4(redColorValue, greenColorValue, blueColorValue, alphaValue));
+}
+
+void SceneManager::SetNodeColor(int nodeIndex, glm::vec4 color)
+{
+	m_sceneNodes[nodeIndex].color = color;
+	m_bSceneChanged = true;
+}
+
+/***********************************************************
+ *  SetNodeLighting()
+ *
+ *  This method is used for turning the shader lighting on
+ *  or off for a scene node, such as for emissive objects.
+ ***********************************************************/
+void SceneManager::SetNodeLighting(int nodeIndex, bool bUseLighting)
+{
+	m_sceneNodes[nodeIndex].bUseLighting = bUseLighting;
+	m_bSceneChanged = true;
+}
+
+/***********************************************************
+ *  SetNodePass()
+ *
+ *  This method is used for moving a scene node into one of
+ *  the blended passes, along with the face culling that the
+ *  node needs (GL_NONE, GL_FRONT or GL_BACK).
+ ***********************************************************/
+void SceneManager::SetNodePass(int nodeIndex, RENDER_PASS pass, GLenum cullFace)
+{
+	m_sceneNodes[nodeIndex].pass = pass;
+	m_sceneNodes[nodeIndex].cullFace = cullFace;
+	m_bSceneChanged = true;
+	m_bShadowsDirty = true;
+}
 
-	currentColor.r = redColorValue;
-	currentColor.g = greenColorValue;
-	currentColor.b = blueColorValue;
-	currentColor.a = alphaValue;
+/***********************************************************
+ *  UpdateSceneNodes()
+ *
+ *  This method is used for rebuilding the model matrix,
+ *  normal matrix, bounding sphere and bounding box of every
+ *  scene node that has been flagged dirty.  Static nodes are only
+ *  built once.  Each job only writes its own nodes.
+ ***********************************************************/
+void SceneManager::UpdateSceneNodes()
+{
+	std::atomic<bool> bChanged(false);
 
-	if (NULL != m_pShaderManager)
+	m_pJobSystem->ParallelFor((int)m_sceneNodes.size(), NODE_JOB_BATCH, [this, &bChanged](int first, int count)
+		{
+			for (int i = first; i < first + count; i++)
+			{
+				SCENE_NODE& node = m_sceneNodes[i];
+
+				if (node.bDirty == true)
+				{
+					node.modelMatrix = BuildModelMatrix(
+						node.scaleXYZ,
+						node.XrotationDegrees,
+						node.YrotationDegrees,
+						node.ZrotationDegrees,
+						node.positionXYZ);
+
+					// the scales are not uniform, so the normals need the
+					// inverse transpose to stay at right angles to the faces
+					node.normalMatrix = glm::transpose(glm::inverse(glm::mat3(node.modelMatrix)));
+
+					// move the mesh bounding sphere into world space - the
+					// radius grows with the largest axis scale
+					const MESH_BOUNDS& bounds = g_MeshBounds[node.mesh];
+					glm::vec4 center = node.modelMatrix * glm::vec4(bounds.center, 1.0f);
+					float maxScale = std::max(
+						glm::length(glm::vec3(node.modelMatrix[0])),
+						std::max(
+							glm::length(glm::vec3(node.modelMatrix[1])),
+							glm::length(glm::vec3(node.modelMatrix[2]))));
+					node.boundsCenter = glm::vec3(center);
+					node.boundsRadius = bounds.radius * maxScale;
+
+					// move the mesh box into world space - each world axis
+					// spans the rotated and scaled extents of the local box
+					const MeshBuffers::MESH_BOX& meshBox = m_pMeshBuffers->GetMeshBox((MeshBuffers::MESH_SHAPE)node.mesh);
+					glm::vec3 localCenter = (meshBox.minimum + meshBox.maximum) * 0.5f;
+					glm::vec3 localExtent = (meshBox.maximum - meshBox.minimum) * 0.5f;
+					glm::vec3 worldCenter = glm::vec3(node.modelMatrix * glm::vec4(localCenter, 1.0f));
+					glm::vec3 worldExtent;
+					for (int axis = 0; axis < 3; axis++)
+					{
+						worldExtent[axis] =
+							std::abs(node.modelMatrix[0][axis]) * localExtent.x +
+							std::abs(node.modelMatrix[1][axis]) * localExtent.y +
+							std::abs(node.modelMatrix[2][axis]) * localExtent.z;
+					}
+					node.worldBox.minimum = worldCenter - worldExtent;
+					node.worldBox.maximum = worldCenter + worldExtent;
+
+					node.bDirty = false;
+					bChanged = true;
+				}
+			}
+		});
+
+	if (bChanged == true)
 	{
-		m_pShaderManager->setIntValue(g_UseTextureName, false);
-		m_pShaderManager->setVec4Value(g_ColorValueName, currentColor);
+		m_bSceneChanged = true;
+		m_bBoundsChanged = true;
+		m_bShadowsDirty = true;
 	}
 }
 
 /***********************************************************
- *  SetShaderTexture()
+ *  CullSceneNodes()
  *
- *  This method is used for setting the texture data
- *  associated with the passed in ID into the shader.
+ *  This method is used for flagging the scene nodes whose
+ *  bounding box is at least partly inside the view
+ *  frustum.  The other nodes are never queued, so they cost
+ *  no draw and no commands.  Large scenes are culled
+ *  through the bounds tree, which rejects or accepts whole
+ *  groups of nearby nodes with one test - a few subtrees
+ *  per job thread, culled as separate jobs.
  ***********************************************************/
-void SceneManager::SetShaderTexture(
-	std::string textureTag)
+void SceneManager::CullSceneNodes()
 {
-	if (NULL != m_pShaderManager)
+	m_frustum.SetMatrix(m_projectionMatrix * m_viewMatrix);
+
+	if (m_sceneNodes.size() >= MIN_TREE_NODES)
 	{
-		m_pShaderManager->setIntValue(g_UseTextureName, true);
+		if (m_bBoundsChanged == true)
+		{
+			std::vector<ViewFrustum::BOUNDING_BOX> boxes(m_sceneNodes.size());
+			for (int i = 0; i < m_sceneNodes.size(); i++)
+			{
+				boxes[i] = m_sceneNodes[i].worldBox;
+			}
+			m_boundsTree.Build(boxes);
+			m_boundsTree.GetSubtrees(m_pJobSystem->GetThreadCount() * 4, m_cullSubtrees);
+			m_bBoundsChanged = false;
+		}
 
-		int textureID = -1;
-		textureID = FindTextureSlot(textureTag);
-		m_pShaderManager->setSampler2DValue(g_TextureValueName, textureID);
+		// the subtrees share no nodes, so each job writes its own
+		// visibility flags
+		m_nodeVisible.assign(m_sceneNodes.size(), 0);
+		m_pJobSystem->ParallelFor((int)m_cullSubtrees.size(), 1, [this](int first, int count)
+			{
+				for (int i = first; i < first + count; i++)
+				{
+					m_boundsTree.CullSubtree(m_frustum, m_cullSubtrees[i], m_nodeVisible);
+				}
+			});
+	}
+	else
+	{
+		m_nodeVisible.resize(m_sceneNodes.size());
+		for (int i = 0; i < m_sceneNodes.size(); i++)
+		{
+			m_nodeVisible[i] = (m_frustum.TestBox(m_sceneNodes[i].worldBox) != ViewFrustum::TEST_OUTSIDE) ? 1 : 0;
+		}
 	}
+
+	m_culledNodeCount = (int)std::count(m_nodeVisible.begin(), m_nodeVisible.end(), 0);
 }
 
 /***********************************************************
- *  SetTextureUVScale()
+ *  SelectNodeLods()
  *
- *  This method is used for setting the texture UV scale
- *  values into the shader.
+ *  This method is used for picking the mesh level of
+ *  detail of each visible scene node from the diameter its
+ *  bounding sphere covers on screen.  A node only drops to
+ *  a coarser level once it is a margin below the switch
+ *  size, and only comes back once it is a margin above it,
+ *  so a node near a switch size does not change level
+ *  every frame.  A change of level changes the node's
+ *  draw, so the indirect commands are rebuilt.  Each job
+ *  only writes its own nodes.
  ***********************************************************/
-void SceneManager::SetTextureUVScale(float u, float v)
+void SceneManager::SelectNodeLods()
 {
-	if (NULL != m_pShaderManager)
+	// a perspective projection shrinks a node with its distance,
+	// an orthographic one does not
+	bool bPerspective = (m_projectionMatrix[3][3] == 0.0f);
+	float pixelsPerUnit = m_projectionMatrix[1][1] * (float)m_viewportHeight;
+	std::atomic<bool> bChanged(false);
+
+	m_pJobSystem->ParallelFor((int)m_sceneNodes.size(), NODE_JOB_BATCH,
+		[this, bPerspective, pixelsPerUnit, &bChanged](int first, int count)
+		{
+			for (int i = first; i < first + count; i++)
+			{
+				SCENE_NODE& node = m_sceneNodes[i];
+
+				int lodCount = m_pMeshBuffers->GetLodCount((MeshBuffers::MESH_SHAPE)node.mesh);
+				if ((m_nodeVisible[i] == 0) || (lodCount <= 1))
+				{
+					continue;
+				}
+
+				float screenSize = node.boundsRadius * pixelsPerUnit;
+				if (bPerspective == true)
+				{
+					float distance = glm::length(node.boundsCenter - m_viewPosition);
+					screenSize /= std::max(distance, 0.001f);
+				}
+
+				int lodLevel = node.lodLevel;
+				while ((lodLevel < lodCount - 1) &&
+					(screenSize < LOD_SCREEN_SIZES[lodLevel] * (1.0f - LOD_HYSTERESIS)))
+				{
+					lodLevel++;
+				}
+				while ((lodLevel > 0) &&
+					(screenSize > LOD_SCREEN_SIZES[lodLevel - 1] * (1.0f + LOD_HYSTERESIS)))
+				{
+					lodLevel--;
+				}
+
+				if (lodLevel != node.lodLevel)
+				{
+					node.lodLevel = lodLevel;
+					bChanged = true;
+				}
+			}
+		});
+
+	if (bChanged == true)
 	{
-		m_pShaderManager->setVec2Value("UVscale", glm::vec2(u, v));
+		m_bSceneChanged = true;
 	}
 }
 
 /***********************************************************
- *  SetShaderMaterial()
+ *  ProfileScope()
  *
- *  This method is used for passing the material values
- *  into the shader.
+ *  This method is used for moving the frame profiler on to
+ *  the next section of RenderScene().  The sections follow
+ *  each other without nesting, so each one gets its own
+ *  GPU elapsed time.
  ***********************************************************/
-void SceneManager::SetShaderMaterial(
-	std::string materialTag)
+void SceneManager::ProfileScope(const char* name)
 {
-	if (m_objectMaterials.size() > 0)
+	if (m_pProfiler == NULL)
 	{
-		OBJECT_MATERIAL material;
-		bool bReturn = false;
+		return;
+	}
 
-		bReturn = FindMaterial(materialTag, material);
-		if (bReturn == true)
-		{
-			m_pShaderManager->setVec3Value("material.diffuseColor", material.diffuseColor);
-			m_pShaderManager->setVec3Value("material.specularColor", material.specularColor);
-			m_pShaderManager->setFloatValue("material.shininess", material.shininess);
-		}
+	if (m_bProfileScopeOpen == true)
+	{
+		m_pProfiler->EndScope();
+		m_bProfileScopeOpen = false;
+	}
+	if (name != NULL)
+	{
+		m_pProfiler->BeginScope(name);
+		m_bProfileScopeOpen = true;
 	}
 }
 
-/**************************************************************/
-/*** STUDENTS CAN MODIFY the code in the methods BELOW for  ***/
-/*** preparing and rendering their own 3D replicated scenes.***/
-/*** Please refer to the code in the OpenGL sample project  ***/
-/*** for assistance.                                        ***/
-/**************************************************************/
-
 /***********************************************************
- *  DefineObjectMaterials()
+ *  BuildRenderQueue()
  *
- *  Purpose: Set up all surface materials used in the 3D scene.
- *           Each material defines how light interacts with
- *           the object  including base color (diffuse),
- *           shine response (specular), and gloss level (shininess).
+ *  This method is used for queueing every scene node that
+ *  survived culling with the sort key of its render state,
+ *  and sorting the queue into drawing order.  Translucent
+ *  nodes are ordered back to front by the side of their bounding sphere that they
+ *  show - the far side when only back faces are drawn and
+ *  the near side when only front faces are drawn - so a
+ *  shape nested inside another draws between its walls.
+ *  Order independent transparency needs no order, so they
+ *  keep the render state order and batch.
  *
- *  Edited by: Jerris English - SNHU CS Major
- *  Date: August 24, 2025
- *
- *  Materials defined:
- *  - Copper (lamp base): warm reflective metal
- *  - Plastic black: low-shine utility finish
- *  - Glass: smooth surface with high gloss
- *  - Floor epoxy: dark with bright specular highlights
- *  - Wall plaster: soft matte surface with subtle depth
- *  - Zebra fur: light fabric with low reflectivity
- *  - Mirror: high-gloss polished reflection
- *  - Chevron fur: patterned box with light gloss
- *  - Box fur (lid): solid gray with soft sheen
- ***********************************************************/
-void SceneManager::DefineObjectMaterials()
-{
-	// copper
-	OBJECT_MATERIAL copper;
-	copper.diffuseColor = glm::vec3(0.72f, 0.43f, 0.20f);     // diffuse color
-	copper.specularColor = glm::vec3(0.95f, 0.70f, 0.45f);    // specular color
-	copper.shininess = 256.0f;                                 // shininess factor
-	copper.tag = "copper";                                    // tag name
-	m_objectMaterials.push_back(copper);                      // store material
-
-	// plastic (black)
-	OBJECT_MATERIAL plasticBlack;
-	plasticBlack.diffuseColor = glm::vec3(0.06f, 0.06f, 0.06f);  // diffuse color
-	plasticBlack.specularColor = glm::vec3(0.20f, 0.20f, 0.20f); // specular color
-	plasticBlack.shininess = 8.0f;                               // shininess factor
-	plasticBlack.tag = "plasticBlack";                           // tag name
-	m_objectMaterials.push_back(plasticBlack);                   // store material
-
-	// glass
-	OBJECT_MATERIAL glass;
-	glass.diffuseColor = glm::vec3(0.55f, 0.60f, 0.70f);         // diffuse color
-	glass.specularColor = glm::vec3(1.5f, 1.5f, 1.5f);           // boosted specular to sharpen light pop
-	glass.shininess = 160.0f;                                    // stronger shininess for crisp reflection
-	glass.tag = "glass";                                         // tag name
-	m_objectMaterials.push_back(glass);                          // store material
-
-	// floorMat - epoxy, glossy reflective
-	OBJECT_MATERIAL floorMat;
-	floorMat.diffuseColor = glm::vec3(0.22f, 0.22f, 0.24f);      // darker base for epoxy
-	floorMat.specularColor = glm::vec3(0.85f, 0.85f, 0.90f);     // bright specular for shine
-	floorMat.shininess = 128.0f;                                 // strong gloss highlight
-	floorMat.tag = "floorMat";                                   // tag name
-	m_objectMaterials.push_back(floorMat);                       // store material
-
-	// wallMat - plaster, soft matte
-	OBJECT_MATERIAL wallMat;
-	wallMat.diffuseColor = glm::vec3(0.60f, 0.55f, 0.45f);    // darker cream base color
-	wallMat.specularColor = glm::vec3(0.02f, 0.02f, 0.02f);   // keep specular almost off
-	wallMat.shininess = 4.0f;                                 // softer, broad response
-	wallMat.tag = "wallMat";                                  // tag name
-	m_objectMaterials.push_back(wallMat);                     // store material
-
-	// zebraMat - soft specular fur/skin surface
-	OBJECT_MATERIAL zebraMat;
-	zebraMat.diffuseColor = glm::vec3(0.9f, 0.9f, 0.9f);         // bright base to help lighting show
-	zebraMat.specularColor = glm::vec3(0.2f, 0.2f, 0.2f);        // low subtle shine
-	zebraMat.shininess = 10.0f;                                  // soft reflectivity
-	zebraMat.tag = "zebraMat";                                   // tag name
-	m_objectMaterials.push_back(zebraMat);                       // store material
-
-	// mirrorMat - high-gloss reflective surface
-	OBJECT_MATERIAL mirrorMat;
-	mirrorMat.diffuseColor = glm::vec3(0.75f, 0.75f, 0.75f);      // Slightly lighter silver base
-	mirrorMat.specularColor = glm::vec3(1.0f, 1.0f, 1.0f);        // Full white specular highlight
-	mirrorMat.shininess = 256.0f;                                 // Max gloss for mirror effect
-	mirrorMat.tag = "mirrorMat";                                  // tag name
-	m_objectMaterials.push_back(mirrorMat);
-
-	// chevronMat  stitched fur with soft lighting
-	OBJECT_MATERIAL chevronMat;
-	chevronMat.diffuseColor = glm::vec3(0.85f, 0.85f, 0.85f);     // light base to help pattern show
-	chevronMat.specularColor = glm::vec3(0.15f, 0.15f, 0.15f);    // low subtle reflectivity
-	chevronMat.shininess = 12.0f;                                 // soft finish with a hint of gloss
-	chevronMat.tag = "chevronMat";                                // tag name
-	m_objectMaterials.push_back(chevronMat);                      // store material
-
-	// boxFurMat  solid dark fur with light sheen
-	OBJECT_MATERIAL boxFurMat;
-	boxFurMat.diffuseColor = glm::vec3(0.60f, 0.60f, 0.60f);      // lightened gray fur tone
-	boxFurMat.specularColor = glm::vec3(0.20f, 0.20f, 0.20f);     // very soft shine
-	boxFurMat.shininess = 10.0f;                                   // low gloss, matte texture
-	boxFurMat.tag = "boxFurMat";                                  // tag name
-	m_objectMaterials.push_back(boxFurMat);                       // store material
+ *  Without the depth pre-pass the opaque nodes are ordered
+ *  front to back by the depth bucket of their bounding
+ *  sphere centers, so the large wall and floor planes draw
+ *  late and most of their hidden fragments fail the depth
+ *  test before shading.  The bucket sits below the shader
+ *  in the sort key, so the nodes of one bucket still batch
+ *  by state, and the order only changes when a node moves
+ *  into another bucket.  With the pre-pass the depth is
+ *  already final, so they keep the plain state order.
+ *
+ *  The item of each node is made by the job threads into
+ *  its own entry of m_nodeItems, and the items are queued
+ *  in node order, so the queue is the same on any number
+ *  of threads.
+ ***********************************************************/
+void SceneManager::BuildRenderQueue()
+{
+	m_nodeItems.resize(m_sceneNodes.size());
+
+	m_pJobSystem->ParallelFor((int)m_sceneNodes.size(), NODE_JOB_BATCH, [this](int first, int count)
+		{
+			for (int i = first; i < first + count; i++)
+			{
+				const SCENE_NODE& node = m_sceneNodes[i];
+
+				if (m_nodeVisible[i] == 0)
+				{
+					m_nodeItems[i].nodeIndex = -1;
+					continue;
+				}
+
+				int depthBucket = 0;
+				if ((node.pass == PASS_OPAQUE) && (m_bDepthPrePass == false))
+				{
+					glm::vec4 viewCenter = m_viewMatrix * glm::vec4(node.boundsCenter, 1.0f);
+					depthBucket = RenderQueue::GetDepthBucket(-viewCenter.z);
+				}
+
+				unsigned long long sortKey = RenderQueue::MakeSortKey(
+					node.pass,
+					GetNodePermutation(node),
+					node.textureSlot,
+					node.materialIndex,
+					node.mesh * MeshBuffers::LOD_COUNT + node.lodLevel,
+					GetCullState(node.cullFace),
+					depthBucket);
+
+				if ((node.pass == PASS_TRANSLUCENT) && (m_transparencyMode == TRANSPARENCY_SORTED))
+				{
+					glm::vec4 viewCenter = m_viewMatrix * glm::vec4(node.boundsCenter, 1.0f);
+					float viewDepth = -viewCenter.z;
+
+					if (node.cullFace == GL_FRONT)
+					{
+						viewDepth += node.boundsRadius;
+					}
+					else if (node.cullFace == GL_BACK)
+					{
+						viewDepth -= node.boundsRadius;
+					}
+
+					m_nodeItems[i] = RenderQueue::MakeItem(sortKey, viewDepth, RenderQueue::ORDER_BACK_TO_FRONT, i);
+				}
+				else
+				{
+					m_nodeItems[i] = RenderQueue::MakeItem(sortKey, 0.0f, RenderQueue::ORDER_STATE, i);
+				}
+			}
+		});
+
+	m_renderQueue.Clear();
+	m_renderQueue.AddItems(m_nodeItems);
+	m_renderQueue.Sort(m_pJobSystem);
 }
 
 /***********************************************************
- *  SetupSceneLights()
- *
- *  Configure scene lighting.
+ *  SetRenderPass()
  *
- *  Edited by: Jerris English - 08/17/2025
- *  Edits:
- *    - Enabled shader lighting path (bUseLighting = true)
- *    - Configured a directional light for overall scene fill
- *    - Added point light [0] at the bulb for warm glow
- *    - Added point light [1] as a soft overhead fill
- *    - Disabled remaining point lights [2..4] and spotlight
+ *  This method is used for switching the blend and depth
+ *  state when the node list moves into another pass.  The
+ *  glass pass state also undoes the GL_EQUAL depth test
+ *  that the pre-pass may have left.  With order independent
+ *  transparency the glass pass draws into the buffers of
+ *  the mode instead.
  ***********************************************************/
-void SceneManager::SetupSceneLights()
+void SceneManager::SetRenderPass(RENDER_PASS pass)
 {
-	m_pShaderManager->setBoolValue("bUseLighting", true);                // enable lighting
-
-	//** Directional Light  final boost for full-room glow **//
-	m_pShaderManager->setVec3Value("directionalLight.direction", -0.2f, -1.0f, -0.3f);  // soft downward fill
-	m_pShaderManager->setVec3Value("directionalLight.ambient", 0.28f, 0.28f, 0.28f);    // more ambient warmth
-	m_pShaderManager->setVec3Value("directionalLight.diffuse", 0.38f, 0.38f, 0.38f);    // slightly richer surface fill
-	m_pShaderManager->setVec3Value("directionalLight.specular", 0.50f, 0.50f, 0.50f);   // subtle reflective boost
-	m_pShaderManager->setBoolValue("directionalLight.bActive", true);                  // ensure enabled
-
-	// point light 0 (lamp bulb glow)
-	m_pShaderManager->setVec3Value("pointLights[0].position", 0.0f, 10.15f, -3.5f);     // centered in dome
-	m_pShaderManager->setVec3Value("pointLights[0].ambient", 0.22f, 0.20f, 0.15f);      // warm baseline glow
-	m_pShaderManager->setVec3Value("pointLights[0].diffuse", 1.08f, 0.95f, 0.78f);      // slightly hotter yellow wash
-	m_pShaderManager->setVec3Value("pointLights[0].specular", 1.25f, 1.10f, 0.90f);     // even brighter reflective highlight
-	m_pShaderManager->setFloatValue("pointLights[0].constant", 1.0f);
-	m_pShaderManager->setFloatValue("pointLights[0].linear", 0.11f);                    // slightly tighter falloff
-	m_pShaderManager->setFloatValue("pointLights[0].quadratic", 0.038f);                // tighter decay for focused beam
-	
-	// point light 1 (fill)
-	m_pShaderManager->setVec3Value("pointLights[1].position", 0.0f, 5.5f, -1.0f);      // centered fill light for foreground
-	m_pShaderManager->setVec3Value("pointLights[1].ambient", 0.20f, 0.20f, 0.20f);     // soft ambient fill
-	m_pShaderManager->setVec3Value("pointLights[1].diffuse", 0.40f, 0.40f, 0.40f);     // medium diffuse fill
-	m_pShaderManager->setVec3Value("pointLights[1].specular", 0.20f, 0.20f, 0.20f);    // gentle specular reflection
-	m_pShaderManager->setFloatValue("pointLights[1].constant", 1.0f);                 // attenuation constant
-	m_pShaderManager->setFloatValue("pointLights[1].linear", 0.09f);                  // attenuation linear
-	m_pShaderManager->setFloatValue("pointLights[1].quadratic", 0.032f);              // attenuation quadratic
-	m_pShaderManager->setBoolValue("pointLights[1].bActive", true);                   // active
-
-	// point light 2 (glow boost near top of dome)
-	m_pShaderManager->setVec3Value("pointLights[2].position", 0.0f, 10.9f, -3.5f);      // lowered slightly to better reach glass dome
-	m_pShaderManager->setVec3Value("pointLights[2].ambient", 0.12f, 0.10f, 0.08f);      // soft amber ambient to match bulb warmth
-	m_pShaderManager->setVec3Value("pointLights[2].diffuse", 0.45f, 0.38f, 0.28f);      // medium-strength glow around top glass
-	m_pShaderManager->setVec3Value("pointLights[2].specular", 0.55f, 0.50f, 0.40f);     // reflective tint to catch curved glass
-	m_pShaderManager->setFloatValue("pointLights[2].constant", 1.0f);                   // attenuation constant
-	m_pShaderManager->setFloatValue("pointLights[2].linear", 0.09f);                    // attenuation linear
-	m_pShaderManager->setFloatValue("pointLights[2].quadratic", 0.032f);                // attenuation quadratic
-	m_pShaderManager->setBoolValue("pointLights[2].bActive", true);                     // keep glow boost active
-
-	// point light 3 (left wall)
-	m_pShaderManager->setVec3Value("pointLights[3].position", -1.2f, 11.5f, -6.0f);    // aligned with mirror left panel
-	m_pShaderManager->setVec3Value("pointLights[3].ambient", 0.05f, 0.045f, 0.035f);   // faint warm tone
-	m_pShaderManager->setVec3Value("pointLights[3].diffuse", 0.15f, 0.13f, 0.11f);     // soft glow on wall
-	m_pShaderManager->setVec3Value("pointLights[3].specular", 0.05f, 0.045f, 0.035f);  // gentle highlight
-	m_pShaderManager->setFloatValue("pointLights[3].constant", 1.0f);                 // attenuation constant
-	m_pShaderManager->setFloatValue("pointLights[3].linear", 0.09f);                  // attenuation linear
-	m_pShaderManager->setFloatValue("pointLights[3].quadratic", 0.032f);              // attenuation quadratic
-	m_pShaderManager->setBoolValue("pointLights[3].bActive", true);                   // active
-
-	// point light 4 (right wall)
-	m_pShaderManager->setVec3Value("pointLights[4].position", 1.2f, 11.5f, -6.0f);     // aligned with mirror right panel
-	m_pShaderManager->setVec3Value("pointLights[4].ambient", 0.05f, 0.045f, 0.035f);   // faint warm tone
-	m_pShaderManager->setVec3Value("pointLights[4].diffuse", 0.15f, 0.13f, 0.11f);     // soft glow on wall
-	m_pShaderManager->setVec3Value("pointLights[4].specular", 0.05f, 0.045f, 0.035f);  // gentle highlight
-	m_pShaderManager->setFloatValue("pointLights[4].constant", 1.0f);                 // attenuation constant
-	m_pShaderManager->setFloatValue("pointLights[4].linear", 0.09f);                  // attenuation linear
-	m_pShaderManager->setFloatValue("pointLights[4].quadratic", 0.032f);              // attenuation quadratic
-	m_pShaderManager->setBoolValue("pointLights[4].bActive", true);                   // active
+	if ((pass == PASS_TRANSLUCENT) && (m_transparencyMode != TRANSPARENCY_SORTED))
+	{
+		BeginTransparencyPass();
+		return;
+	}
 
+	RenderState::Apply(g_PassStates[pass]);
+	m_pBatchShaders = m_pSceneShaders;
+}
 
-	//** Disable unused light types **//
-	//*******************************//
-	m_pShaderManager->setBoolValue("spotLight.bActive", false);                        // off
+/***********************************************************
+ *  EndRenderPass()
+ *
+ *  This method is used for finishing a render pass once
+ *  its last batch is drawn.  Only an order independent
+ *  glass pass has anything left to do - blending what it
+ *  collected over the frame.
+ ***********************************************************/
+void SceneManager::EndRenderPass(RENDER_PASS pass)
+{
+	if ((pass == PASS_TRANSLUCENT) && (m_pBatchShaders != m_pSceneShaders))
+	{
+		ResolveTransparencyPass();
+	}
 }
 
 /***********************************************************
- *  PrepareScene()
+ *  BeginTransparencyPass()
  *
- *  This method is used for preparing the 3D scene by loading
- *  the shapes, textures in memory to support the 3D scene 
- *  rendering
- * 
- *  Edited by: Jerris English - SNHU CS Major
- *  Date: July 28, 2025
- *  Notes: Confirmed import of all necessary mesh types for lamp construction,
- *         including cylinder, tapered cylinder, torus, and sphere meshes.
- * 
- *  Edited on: August 10, 2025
- *  Notes: Added call to LoadSceneTextures() for loading all textures before 
- *         mesh setup, and enabled blending for rendering transparent objects 
- *         such as the glass dome.
- * 
- *  Edited on: August 17, 2025
- *  Notes: Added calls to DefineObjectMaterials() and SetupSceneLights() to 
- *         initialize surface properties and lighting for the scene.
- * 
- *  Edited on: August 17, 2025
- *  Notes: Added calls to DefineObjectMaterials() and SetupSceneLights() to 
- *         initialize surface properties and lighting for the scene.
+ *  This method is used for binding the buffers of the
+ *  transparency mode for the glass pass, and picking the
+ *  permutations that write into them.  A mode whose
+ *  buffers cannot be created falls back to sorted blending
+ *  for good.
  ***********************************************************/
-void SceneManager::PrepareScene()
+void SceneManager::BeginTransparencyPass()
 {
-	// Load all scene textures first
-	LoadSceneTextures();
+	GLint viewport[4] = { 0, 0, 1, 1 };
+	glGetIntegerv(GL_VIEWPORT, viewport);
 
-	DefineObjectMaterials();              // set up material tags + values
-	SetupSceneLights();                   // configure directional + bulb lights
+	if (m_transparencyMode == TRANSPARENCY_WEIGHTED)
+	{
+		if (m_pTransparencyBuffers->ResizeWeighted(viewport[2], viewport[3]) == true)
+		{
+			RenderState::Apply(OIT_WEIGHTED_STATE);
+			m_pTransparencyBuffers->BeginWeighted();
+			// the revealage target multiplies in one minus each alpha
+			glBlendFunci(TransparencyBuffers::TARGET_REVEALAGE, GL_ZERO, GL_ONE_MINUS_SRC_COLOR);
+			m_pBatchShaders = m_pWeightedShaders;
+			return;
+		}
+		m_bWeightedAvailable = false;
+	}
+	else if (m_transparencyMode == TRANSPARENCY_LINKED_LIST)
+	{
+		if (m_pTransparencyBuffers->ResizeLinkedList(viewport[2], viewport[3]) == true)
+		{
+			RenderState::Apply(OIT_LINKED_LIST_STATE);
+			m_pTransparencyBuffers->BeginLinkedList();
+			m_pBatchShaders = m_pLinkedListShaders;
+			return;
+		}
+		m_bLinkedListAvailable = false;
+	}
 
-	// only one instance of a particular mesh needs to be
-	// loaded in memory no matter how many times it is drawn
-	// in the rendered 3D scene
-	m_basicMeshes->LoadBoxMesh();
-	m_basicMeshes->LoadCylinderMesh();
-	m_basicMeshes->LoadSphereMesh();
-	m_basicMeshes->LoadPrismMesh();
-	m_basicMeshes->LoadPlaneMesh();
-	m_basicMeshes->LoadTorusMesh();
-	m_basicMeshes->LoadPyramid3Mesh();
-	m_basicMeshes->LoadTaperedCylinderMesh();
+	m_transparencyMode = TRANSPARENCY_SORTED;
+	SetRenderPass(PASS_TRANSLUCENT);
+}
+
+/***********************************************************
+ *  ResolveTransparencyPass()
+ *
+ *  This method is used for blending the collected glass
+ *  fragments over the frame with one full screen triangle -
+ *  the weighted average by its coverage, or each pixel's
+ *  list sorted by depth.
+ ***********************************************************/
+void SceneManager::ResolveTransparencyPass()
+{
+	ShaderProgram* pProgram = NULL;
+	if (m_pBatchShaders == m_pWeightedShaders)
+	{
+		m_pTransparencyBuffers->EndWeighted();
+		// the revealage blend was set behind the cache's back
+		RenderState::Invalidate();
+		RenderState::Apply(OIT_COMPOSITE_STATE);
+		m_pTransparencyBuffers->BindTextures(m_gBufferTextureUnit);
+		pProgram = m_pWeightedCompositeProgram;
+	}
+	else
+	{
+		m_pTransparencyBuffers->EndLinkedList();
+		RenderState::Apply(OIT_RESOLVE_STATE);
+		pProgram = m_pLinkedListResolveProgram;
+	}
 
-	// define materials
-	DefineObjectMaterials();    // setup surface materials
+	pProgram->Use();
+	m_batchProgramID = pProgram->GetProgramID();
+	m_pTransparencyBuffers->DrawFullScreenTriangle();
 
-	// setup lights
-	SetupSceneLights();         // initialize scene lighting
+	m_pBatchShaders = m_pSceneShaders;
+}
+
+/***********************************************************
+ *  SetTransparencyMode()
+ *
+ *  This method is used for selecting how the glass pass of
+ *  the following frames is blended.
+ ***********************************************************/
+void SceneManager::SetTransparencyMode(TRANSPARENCY_MODE mode)
+{
+	if (((mode == TRANSPARENCY_WEIGHTED) && (m_bWeightedAvailable == false)) ||
+		((mode == TRANSPARENCY_LINKED_LIST) && (m_bLinkedListAvailable == false)))
+	{
+		mode = TRANSPARENCY_SORTED;
+	}
+
+	m_transparencyMode = mode;
+}
+
+/***********************************************************
+ *  SetSceneView()
+ *
+ *  This method is used for passing in the view of the
+ *  frame that is about to be rendered, which the render
+ *  queue sorts the blended nodes against.  The view is
+ *  also copied into the frame block that every shader
+ *  program reads, along with the view-projection matrix,
+ *  so no vertex multiplies the two matrices again.  The
+ *  shadow values of the frame block are left as the last
+ *  shadow map update set them.
+ ***********************************************************/
+void SceneManager::SetSceneView(
+	const glm::mat4& view,
+	const glm::mat4& projection,
+	const glm::vec3& viewPosition)
+{
+	m_viewMatrix = view;
+	m_projectionMatrix = projection;
+	m_viewPosition = viewPosition;
+
+	m_frameBlock.view = view;
+	m_frameBlock.projection = projection;
+	m_frameBlock.viewProjection = projection * view;
+	m_frameBlock.viewPosition = viewPosition;
+	m_frameBlock.pad0 = 0.0f;
+	m_frameBlock.clusterScale = glm::vec4(0.0f);
+
+	GLint viewport[4] = { 0, 0, 1, 1 };
+	glGetIntegerv(GL_VIEWPORT, viewport);
+	m_viewportHeight = std::max((int)viewport[3], 1);
+
+	if (m_bClusteredLighting == true)
+	{
+		m_pLightClusters->SetProjection(projection, viewport[2], viewport[3]);
+		m_frameBlock.clusterScale = m_pLightClusters->GetClusterScale();
+	}
+
+	UploadFrameBlock(m_frameBlock);
+}
+
+/***********************************************************
+ *  UploadFrameBlock()
+ *
+ *  This method is used for copying a frame block into the
+ *  frame ring, or into the frame block buffer when there is
+ *  no ring, and binding it for the programs that follow.
+ ***********************************************************/
+void SceneManager::UploadFrameBlock(const FRAME_BLOCK& frame)
+{
+	FrameRingBuffer::ALLOCATION allocation;
+	if ((m_pFrameRing != NULL) && (m_pFrameRing->Allocate(sizeof(FRAME_BLOCK), m_uniformAlignment, allocation) == true))
+	{
+		memcpy(allocation.pData, &frame, sizeof(FRAME_BLOCK));
+		glBindBufferRange(GL_UNIFORM_BUFFER, ShaderUniforms::BLOCK_FRAME, m_pFrameRing->GetBuffer(), allocation.offset, sizeof(FRAME_BLOCK));
+		RenderStats::Add(RenderStats::COUNTER_BYTES_UPLOADED, sizeof(FRAME_BLOCK));
+	}
+	else
+	{
+		// the pool counts the bytes it uploads
+		m_pBufferPool->Upload(m_frameBlockRange, 0, sizeof(FRAME_BLOCK), &frame);
+		GpuBufferPool::BindRange(GL_UNIFORM_BUFFER, ShaderUniforms::BLOCK_FRAME, m_frameBlockRange);
+	}
+}
+
+/***********************************************************
+ *  SetFrameRing()
+ *
+ *  This method is used for setting the ring that the frame
+ *  block, the instances and the light cluster lists of the
+ *  following frames are written to.  The caller moves the
+ *  ring on to the next frame before SetSceneView() and
+ *  fences it after RenderScene().
+ ***********************************************************/
+void SceneManager::SetFrameRing(FrameRingBuffer* pFrameRing)
+{
+	m_pFrameRing = pFrameRing;
+	glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &m_uniformAlignment);
+	m_pMeshBuffers->SetFrameRing(pFrameRing);
+	m_pLightClusters->SetFrameRing(pFrameRing);
+}
+
+/***********************************************************
+ *  CanBatchNodes()
+ *
+ *  This method is used for checking whether two scene
+ *  nodes can be drawn by the same instanced draw call -
+ *  they must share the mesh and its level of detail, pass,
+ *  culling, texture and lighting.  The color, UV scale and material are
+ *  per-instance values.  The texture index is also an
+ *  instance value, but a bindless handle must be the same
+ *  for every instance of a draw, so the texture still
+ *  splits instanced batches.
+ ***********************************************************/
+bool SceneManager::CanBatchNodes(const SCENE_NODE& a, const SCENE_NODE& b)
+{
+	return((a.mesh == b.mesh) &&
+		(a.lodLevel == b.lodLevel) &&
+		(a.pass == b.pass) &&
+		(a.cullFace == b.cullFace) &&
+		(a.textureSlot == b.textureSlot) &&
+		(a.bUseLighting == b.bUseLighting));
+}
+
+/***********************************************************
+ *  AddNodeInstance()
+ *
+ *  This method is used for adding the per-instance values
+ *  of a scene node to the batch that is being collected.
+ ***********************************************************/
+void SceneManager::AddNodeInstance(const SCENE_NODE& node)
+{
+	MeshBuffers::INSTANCE_DATA instance;
+
+	instance.model = node.modelMatrix;
+	instance.color = node.color;
+	instance.UVscale = node.UVscale;
+	// unlit nodes have no material, any entry will do
+	instance.materialIndex = (node.materialIndex >= 0) ? node.materialIndex : 0;
+	instance.textureIndex = node.textureSlot;
+	for (int column = 0; column < 3; column++)
+	{
+		instance.normalMatrix[column] = glm::vec4(node.normalMatrix[column], 0.0f);
+	}
+
+	m_instanceData.push_back(instance);
+}
+
+/***********************************************************
+ *  GetNodePermutation()
+ *
+ *  This method is used for getting the shader permutation
+ *  a scene node is drawn with.  Nodes that share a batch
+ *  always share their permutation.
+ ***********************************************************/
+int SceneManager::GetNodePermutation(const SCENE_NODE& node)
+{
+	return(ShaderPermutations::GetPermutation(node.textureSlot >= 0, node.bUseLighting));
+}
+
+/***********************************************************
+ *  SetBatchUniforms()
+ *
+ *  This method is used for setting the shader values that
+ *  are shared by a batch of scene nodes into the passed in
+ *  program's uniforms.  Values that are unchanged since
+ *  the previous batch are not re-uploaded.  Whether the
+ *  batch is lit and textured is part of its permutation,
+ *  so only the texture units are left to set.  The shadow
+ *  samplers are set even when no map is drawn, since
+ *  samplers of different types may not share a unit.
+ ***********************************************************/
+void SceneManager::SetBatchUniforms(ShaderUniforms* pUniforms, const SCENE_NODE& node)
+{
+	if (node.textureSlot >= 0)
+	{
+		pUniforms->SetInt(ShaderUniforms::UNIFORM_OBJECT_TEXTURE, node.textureSlot);
+	}
+	pUniforms->SetInt(ShaderUniforms::UNIFORM_DIRECTIONAL_SHADOW_MAP, m_shadowTextureUnit);
+	pUniforms->SetInt(ShaderUniforms::UNIFORM_POINT_SHADOW_MAP, m_shadowTextureUnit + 1);
+}
+
+/***********************************************************
+ *  DrawNodeBatch()
+ *
+ *  This method is used for drawing the collected instances
+ *  of a batch of scene nodes with one draw call.  The
+ *  batch's permutation, from the permutations of the
+ *  current pass, is put in use when it differs from
+ *  the last batch's, which the permutation bits of the
+ *  sort key keep rare.
+ ***********************************************************/
+void SceneManager::DrawNodeBatch(const SCENE_NODE& node)
+{
+	int permutation = GetNodePermutation(node);
+	ShaderProgram* pProgram = m_pBatchShaders->GetProgram(permutation);
+	if (pProgram == NULL)
+	{
+		m_instanceData.clear();
+		return;
+	}
+
+	if (pProgram->GetProgramID() != m_batchProgramID)
+	{
+		pProgram->Use();
+		m_batchProgramID = pProgram->GetProgramID();
+	}
+	SetBatchUniforms(m_pBatchShaders->GetUniforms(permutation), node);
+
+	m_pMeshBuffers->DrawInstanced(
+		(MeshBuffers::MESH_SHAPE)node.mesh,
+		node.lodLevel,
+		m_instanceData.data(),
+		(int)m_instanceData.size(),
+		MeshBuffers::STREAM_ALL);
+
+	m_instanceData.clear();
+}
+
+/***********************************************************
+ *  LoadShaderVariants()
+ *
+ *  This method is used for building the variants of the
+ *  scene shaders that the context supports.  Both need an
+ *  OpenGL 4.6 context - otherwise the GLSL 3.30 scene
+ *  permutations draw everything, with the fixed point
+ *  light loop and one texture unit per texture slot.
+ *
+ *  The instanced draws switch to 4.6 permutations that read
+ *  the point lights of their light cluster from storage
+ *  buffers.  With ARB_bindless_texture they also pick each
+ *  texture from a resident handle by its slot index, which
+ *  lifts the texture unit limit.  The multi-draw indirect
+ *  permutations need gl_DrawID, and share the same features.
+ *
+ *  The deferred programs are built on top of the indirect
+ *  ones: the geometry pass draws the same commands into the
+ *  G-buffer, and the lighting pass reads it back from the
+ *  last texture units.
+ *
+ *  Only the lit and textured permutation of each set is
+ *  built here, to find out whether the set works at all -
+ *  the others are built as the draws first ask for them.
+ ***********************************************************/
+void SceneManager::LoadShaderVariants()
+{
+	const int defaultPermutation = ShaderPermutations::PERMUTATION_TEXTURED | ShaderPermutations::PERMUTATION_LIT;
+
+	m_bBindlessTextures = false;
+	m_bClusteredLighting = false;
+	m_bIndirectDraw = false;
+	m_bDeferredAvailable = false;
+
+	GLint textureUnits = 16;
+	glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &textureUnits);
+
+	// scene textures bound to units leave the last units free for
+	// the shadow maps, and after them the G-buffer - which the
+	// transparency composite also samples from, after the lighting
+	// pass is done with them
+	m_gBufferTextureUnit = textureUnits - GBuffer::TEXTURE_COUNT;
+	m_shadowTextureUnit = m_gBufferTextureUnit - ShadowMaps::TEXTURE_COUNT;
+	m_maxTextureSlots = std::min(m_shadowTextureUnit, MAX_SCENE_TEXTURES);
+
+	std::string defines = "#define USE_CLUSTERED_LIGHTING\n";
+	if (GLEW_ARB_bindless_texture)
+	{
+		defines += "#define USE_BINDLESS_TEXTURE\n";
+	}
+
+	bool bLoaded = false;
+	if (GLEW_VERSION_4_6)
+	{
+		m_pSceneShaders->SetSource(VERTEX_SHADER_FILE, FRAGMENT_SHADER_FILE, "#version 460 core", defines);
+		bLoaded = (m_pSceneShaders->GetProgram(defaultPermutation) != NULL);
+		if (bLoaded == false)
+		{
+			std::cout << "OpenGL 4.6 scene shaders failed to build, using the GLSL 3.30 shaders" << std::endl;
+		}
+	}
+	if (bLoaded == false)
+	{
+		m_pSceneShaders->SetSource(VERTEX_SHADER_FILE, FRAGMENT_SHADER_FILE, "#version 330 core", "");
+		UseDefaultSceneProgram();
+		return;
+	}
+
+	// the instanced draws use the 4.6 permutations from now on
+	m_bClusteredLighting = true;
+	if (GLEW_ARB_bindless_texture)
+	{
+		m_bBindlessTextures = true;
+		m_maxTextureSlots = MAX_SCENE_TEXTURES;
+	}
+
+	m_pIndirectShaders->SetSource(
+		VERTEX_SHADER_FILE,
+		FRAGMENT_SHADER_FILE,
+		"#version 460 core",
+		defines + "#define USE_INDIRECT_DRAW\n");
+	bLoaded = (m_pIndirectShaders->GetProgram(defaultPermutation) != NULL);
+	if (bLoaded == true)
+	{
+		m_bIndirectDraw = true;
+	}
+	else
+	{
+		std::cout << "Multi-draw indirect shaders failed to build, using instanced draws" << std::endl;
+	}
+
+	if (m_bIndirectDraw == true)
+	{
+		m_pGBufferShaders->SetSource(
+			VERTEX_SHADER_FILE,
+			FRAGMENT_SHADER_FILE,
+			"#version 460 core",
+			defines + "#define USE_INDIRECT_DRAW\n#define USE_DEFERRED_GBUFFER\n");
+		bLoaded = (m_pGBufferShaders->GetProgram(defaultPermutation) != NULL);
+		bLoaded = bLoaded && m_pDeferredLightingProgram->Load(
+			VERTEX_SHADER_FILE,
+			FRAGMENT_SHADER_FILE,
+			"#version 460 core",
+			"#define USE_CLUSTERED_LIGHTING\n#define USE_DEFERRED_LIGHTING\n");
+		if (bLoaded == true)
+		{
+			// the lighting pass has no per-draw uniforms, its uniform
+			// blocks only need attaching to the binding points
+			ShaderUniforms lightingUniforms;
+			lightingUniforms.ResolveLocations(m_pDeferredLightingProgram->GetProgramID());
+
+			GBuffer::SetSamplerUnits(m_pDeferredLightingProgram->GetProgramID(), m_gBufferTextureUnit);
+			ShadowMaps::SetSamplerUnits(m_pDeferredLightingProgram->GetProgramID(), m_shadowTextureUnit);
+			m_bDeferredAvailable = true;
+		}
+		else
+		{
+			std::cout << "Deferred shading shaders failed to build, using forward shading" << std::endl;
+		}
+	}
+
+	// ResolveLocations() attaches the uniform blocks, so the
+	// scene program only has to be put in use
+	UseDefaultSceneProgram();
+}
+
+/***********************************************************
+ *  UseDefaultSceneProgram()
+ *
+ *  This method is used for putting the lit and textured
+ *  scene permutation in use as the program the passes
+ *  leave bound.  It is looked up again whenever the scene
+ *  permutations are rebuilt.
+ ***********************************************************/
+void SceneManager::UseDefaultSceneProgram()
+{
+	ShaderProgram* pProgram = m_pSceneShaders->GetProgram(
+		ShaderPermutations::PERMUTATION_TEXTURED | ShaderPermutations::PERMUTATION_LIT);
+
+	// no program is left in use rather than a deleted one
+	m_programID = (pProgram != NULL) ? pProgram->GetProgramID() : 0;
+	glUseProgram(m_programID);
+	RenderStats::Add(RenderStats::COUNTER_PROGRAM_BINDS);
+}
+
+/***********************************************************
+ *  BuildIndirectCommands()
+ *
+ *  This method is used for filling the persistent command
+ *  and draw data buffers with one command per opaque node,
+ *  in render queue order.  Neighbouring commands that share
+ *  their culling and shader permutation are recorded as one
+ *  batch, which is a single multi-draw call whatever mix of
+ *  meshes it holds.  The texture only splits batches when
+ *  it is bound to a texture unit - a bindless texture is
+ *  picked by each draw's own data, so only going from
+ *  textured to untextured splits them.
+ ***********************************************************/
+void SceneManager::BuildIndirectCommands()
+{
+	m_pIndirectCommands->Clear();
+	m_indirectBatches.clear();
+	m_indirectNodeOrder.clear();
+
+	const std::vector<RenderQueue::RENDER_ITEM>& items = m_renderQueue.GetItems();
+	for (int i = 0; i < items.size(); i++)
+	{
+		const SCENE_NODE& node = m_sceneNodes[items[i].nodeIndex];
+		if (node.pass != PASS_OPAQUE)
+		{
+			continue;
+		}
+
+		bool bNewBatch = true;
+		if (m_indirectBatches.size() > 0)
+		{
+			const SCENE_NODE& batchNode = m_sceneNodes[m_indirectBatches.back().nodeIndex];
+			bNewBatch = ((batchNode.cullFace != node.cullFace) ||
+				(GetNodePermutation(batchNode) != GetNodePermutation(node)) ||
+				((m_bBindlessTextures == false) && (batchNode.textureSlot != node.textureSlot)));
+		}
+
+		m_instanceData.clear();
+		AddNodeInstance(node);
+		int command = m_pIndirectCommands->AddDraw(
+			m_pMeshBuffers->GetMeshRange((MeshBuffers::MESH_SHAPE)node.mesh, node.lodLevel),
+			m_instanceData[0]);
+		m_instanceData.clear();
+
+		if (bNewBatch == true)
+		{
+			INDIRECT_BATCH batch;
+			batch.firstCommand = command;
+			batch.commandCount = 0;
+			batch.nodeIndex = items[i].nodeIndex;
+			m_indirectBatches.push_back(batch);
+		}
+		m_indirectBatches.back().commandCount++;
+		m_indirectNodeOrder.push_back(items[i].nodeIndex);
+	}
+
+	m_pIndirectCommands->Upload();
+}
+
+/***********************************************************
+ *  IsIndirectOrderCurrent()
+ *
+ *  This method is used for checking whether the opaque
+ *  nodes of the sorted render queue are still in the order
+ *  the indirect commands were built in.  Without the depth
+ *  pre-pass the opaque sort key holds a coarse depth bucket
+ *  from the view, so the order only changes when a node
+ *  crosses into another bucket, which needs the commands
+ *  rebuilt.  With the pre-pass the key holds no depth and
+ *  the order never changes this way.
+ ***********************************************************/
+bool SceneManager::IsIndirectOrderCurrent()
+{
+	int command = 0;
+
+	const std::vector<RenderQueue::RENDER_ITEM>& items = m_renderQueue.GetItems();
+	for (int i = 0; i < items.size(); i++)
+	{
+		if (m_sceneNodes[items[i].nodeIndex].pass != PASS_OPAQUE)
+		{
+			continue;
+		}
+		if ((command >= m_indirectNodeOrder.size()) ||
+			(m_indirectNodeOrder[command] != items[i].nodeIndex))
+		{
+			return(false);
+		}
+		command++;
+	}
+
+	return(command == m_indirectNodeOrder.size());
+}
+
+/***********************************************************
+ *  LoadDepthPrograms()
+ *
+ *  This method is used for building the depth only variants
+ *  of the scene shaders for the depth pre-pass - one for
+ *  instanced draws, and one for the indirect commands when
+ *  the multi-draw indirect path is in use.  They are built
+ *  with the same GLSL version as the shading programs.
+ ***********************************************************/
+void SceneManager::LoadDepthPrograms()
+{
+	m_bDepthPrePassAvailable = false;
+
+	const char* versionLine = (m_bClusteredLighting == true) ? "#version 460 core" : "#version 330 core";
+	bool bLoaded = m_pDepthProgram->Load(
+		VERTEX_SHADER_FILE,
+		FRAGMENT_SHADER_FILE,
+		versionLine,
+		"#define USE_DEPTH_ONLY\n");
+	if ((bLoaded == true) && (m_bIndirectDraw == true))
+	{
+		bLoaded = m_pIndirectDepthProgram->Load(
+			VERTEX_SHADER_FILE,
+			FRAGMENT_SHADER_FILE,
+			"#version 460 core",
+			"#define USE_INDIRECT_DRAW\n#define USE_DEPTH_ONLY\n");
+	}
+
+	if (bLoaded == true)
+	{
+		// the instanced depth program has no per-draw uniforms,
+		// its frame block only needs attaching
+		ShaderUniforms depthUniforms;
+		depthUniforms.ResolveLocations(m_pDepthProgram->GetProgramID());
+		if (m_bIndirectDraw == true)
+		{
+			m_pIndirectDepthUniforms->ResolveLocations(m_pIndirectDepthProgram->GetProgramID());
+		}
+		m_bDepthPrePassAvailable = true;
+	}
+	else
+	{
+		std::cout << "Depth only shaders failed to build, the depth pre-pass is off" << std::endl;
+	}
+
+	glUseProgram(m_programID);
+}
+
+/***********************************************************
+ *  LoadTransparencyPrograms()
+ *
+ *  This method is used for building the programs of the
+ *  order independent transparency modes, with the same
+ *  GLSL version and features as the instanced scene
+ *  permutations.  The weighted mode needs the per-target
+ *  blending of OpenGL 4.0 and the immutable texture storage
+ *  its targets are made with, of 4.2 or
+ *  ARB_texture_storage, and the linked list mode the
+ *  storage buffers and image atomics of the 4.6 programs.
+ *  Only the lit and textured permutation of each set is
+ *  built here, like the scene permutations.
+ ***********************************************************/
+void SceneManager::LoadTransparencyPrograms()
+{
+	const int defaultPermutation = ShaderPermutations::PERMUTATION_TEXTURED | ShaderPermutations::PERMUTATION_LIT;
+
+	m_bWeightedAvailable = false;
+	m_bLinkedListAvailable = false;
+
+	const char* versionLine = (m_bClusteredLighting == true) ? "#version 460 core" : "#version 330 core";
+	std::string defines = "";
+	if (m_bClusteredLighting == true)
+	{
+		defines += "#define USE_CLUSTERED_LIGHTING\n";
+	}
+	if (m_bBindlessTextures == true)
+	{
+		defines += "#define USE_BINDLESS_TEXTURE\n";
+	}
+
+	if (GLEW_VERSION_4_2 || (GLEW_VERSION_4_0 && GLEW_ARB_texture_storage))
+	{
+		m_pWeightedShaders->SetSource(
+			VERTEX_SHADER_FILE,
+			FRAGMENT_SHADER_FILE,
+			versionLine,
+			defines + "#define USE_OIT_WEIGHTED\n");
+		bool bLoaded = (m_pWeightedShaders->GetProgram(defaultPermutation) != NULL);
+		bLoaded = bLoaded && m_pWeightedCompositeProgram->Load(
+			VERTEX_SHADER_FILE,
+			FRAGMENT_SHADER_FILE,
+			versionLine,
+			"#define USE_OIT_WEIGHTED_COMPOSITE\n");
+		if (bLoaded == true)
+		{
+			TransparencyBuffers::SetSamplerUnits(m_pWeightedCompositeProgram->GetProgramID(), m_gBufferTextureUnit);
+			m_bWeightedAvailable = true;
+		}
+		else
+		{
+			std::cout << "Weighted blended transparency shaders failed to build" << std::endl;
+		}
+	}
+
+	if (m_bClusteredLighting == true)
+	{
+		m_pLinkedListShaders->SetSource(
+			VERTEX_SHADER_FILE,
+			FRAGMENT_SHADER_FILE,
+			"#version 460 core",
+			defines + "#define USE_OIT_LINKED_LIST\n");
+		bool bLoaded = (m_pLinkedListShaders->GetProgram(defaultPermutation) != NULL);
+		bLoaded = bLoaded && m_pLinkedListResolveProgram->Load(
+			VERTEX_SHADER_FILE,
+			FRAGMENT_SHADER_FILE,
+			"#version 460 core",
+			"#define USE_OIT_LINKED_LIST_RESOLVE\n");
+		if (bLoaded == true)
+		{
+			m_bLinkedListAvailable = true;
+		}
+		else
+		{
+			std::cout << "Linked list transparency shaders failed to build" << std::endl;
+		}
+	}
+
+	glUseProgram(m_programID);
+}
+
+/***********************************************************
+ *  DrawDepthPrePass()
+ *
+ *  This method is used for filling the depth buffer with
+ *  the opaque nodes before they are shaded, when the depth
+ *  pre-pass is selected.  Only the position stream is read
+ *  and no color is written, so the pass is cheap, and the
+ *  shading pass that follows runs with GL_EQUAL and no
+ *  depth writes - each pixel is shaded once, for its
+ *  nearest surface, whatever the draw order.
+ ***********************************************************/
+void SceneManager::DrawDepthPrePass()
+{
+	if (m_bDepthPrePass == false)
+	{
+		return;
+	}
+
+	RenderState::Apply(DEPTH_PREPASS_STATE);
+
+	if (m_bIndirectDraw == true)
+	{
+		m_pIndirectDepthProgram->Use();
+		m_pIndirectCommands->Bind();
+
+		// depth only draws are only split by the face culling, so
+		// neighbouring batches that share it are drawn together
+		int batch = 0;
+		while (batch < m_indirectBatches.size())
+		{
+			int firstCommand = m_indirectBatches[batch].firstCommand;
+			int commandCount = 0;
+			GLenum cullFace = m_sceneNodes[m_indirectBatches[batch].nodeIndex].cullFace;
+			while ((batch < m_indirectBatches.size()) &&
+				(m_sceneNodes[m_indirectBatches[batch].nodeIndex].cullFace == cullFace))
+			{
+				commandCount += m_indirectBatches[batch].commandCount;
+				batch++;
+			}
+
+			RenderState::SetCullFace(cullFace);
+			m_pIndirectDepthUniforms->SetInt(ShaderUniforms::UNIFORM_FIRST_DRAW, firstCommand);
+			m_pMeshBuffers->DrawIndirect(firstCommand, commandCount, MeshBuffers::STREAM_POSITION);
+			RenderStats::Add(
+				RenderStats::COUNTER_TRIANGLES,
+				m_pIndirectCommands->CountTriangles(firstCommand, commandCount));
+		}
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+	}
+	else
+	{
+		m_pDepthProgram->Use();
+
+		// copies of a mesh level with the same culling are one draw
+		const SCENE_NODE* pBatchNode = NULL;
+		m_instanceData.clear();
+
+		const std::vector<RenderQueue::RENDER_ITEM>& items = m_renderQueue.GetItems();
+		for (int i = 0; i <= items.size(); i++)
+		{
+			const SCENE_NODE* pNode = (i < items.size()) ? &m_sceneNodes[items[i].nodeIndex] : NULL;
+			if ((pNode != NULL) && (pNode->pass != PASS_OPAQUE))
+			{
+				continue;
+			}
+
+			if ((pBatchNode != NULL) &&
+				((pNode == NULL) ||
+				(pNode->mesh != pBatchNode->mesh) ||
+				(pNode->lodLevel != pBatchNode->lodLevel) ||
+				(pNode->cullFace != pBatchNode->cullFace)))
+			{
+				RenderState::SetCullFace(pBatchNode->cullFace);
+				m_pMeshBuffers->DrawInstanced(
+					(MeshBuffers::MESH_SHAPE)pBatchNode->mesh,
+					pBatchNode->lodLevel,
+					m_instanceData.data(),
+					(int)m_instanceData.size(),
+					MeshBuffers::STREAM_POSITION);
+				m_instanceData.clear();
+				pBatchNode = NULL;
+			}
+
+			if (pNode != NULL)
+			{
+				if (pBatchNode == NULL)
+				{
+					pBatchNode = pNode;
+				}
+				AddNodeInstance(*pNode);
+			}
+		}
+	}
+
+	RenderState::SetCullFace(GL_NONE);
+	glUseProgram(m_programID);
+	RenderStats::Add(RenderStats::COUNTER_PROGRAM_BINDS);
+
+	// shade only the fragments that match the laid down depth
+	RenderState::Apply(PREPASSED_OPAQUE_STATE);
+}
+
+/***********************************************************
+ *  SetDepthPrePass()
+ *
+ *  This method is used for selecting whether the opaque
+ *  pass of the following frames starts with a depth
+ *  pre-pass.
+ ***********************************************************/
+void SceneManager::SetDepthPrePass(bool bDepthPrePass)
+{
+	m_bDepthPrePass = (bDepthPrePass && m_bDepthPrePassAvailable);
+}
+
+/***********************************************************
+ *  UpdateShadowMaps()
+ *
+ *  This method is used for drawing the shadow maps of the
+ *  directional light and the first point light, the bulb,
+ *  when they are on.  Each map's view-projection is passed
+ *  to the depth program through a frame block of its own,
+ *  and the frame block of the view is bound again after
+ *  with the light space and switches the shaders read.
+ *  The scene is static between changes, so this only runs
+ *  when a node or a light has changed.
+ ***********************************************************/
+void SceneManager::UpdateShadowMaps()
+{
+	m_frameBlock.shadowParams = glm::vec4(
+		0.0f,
+		0.0f,
+		ShadowMaps::CUBE_NEAR_PLANE,
+		1.0f / (float)ShadowMaps::DIRECTIONAL_SIZE);
+
+	RenderState::Apply(DEPTH_PREPASS_STATE);
+	// both faces cast, so the single sided planes do too
+	RenderState::SetCullFace(GL_NONE);
+	glEnable(GL_POLYGON_OFFSET_FILL);
+	glPolygonOffset(SHADOW_SLOPE_BIAS, SHADOW_CONSTANT_BIAS);
+	m_pDepthProgram->Use();
+
+	FRAME_BLOCK lightFrame = m_frameBlock;
+
+	if (m_lights.directionalLight.bActive != 0)
+	{
+		// fit the map around the opaque nodes, which are all the
+		// casters and hold the receivers
+		bool bFound = false;
+		glm::vec3 sceneMinimum(0.0f);
+		glm::vec3 sceneMaximum(0.0f);
+		for (int i = 0; i < m_sceneNodes.size(); i++)
+		{
+			const SCENE_NODE& node = m_sceneNodes[i];
+			if (node.pass != PASS_OPAQUE)
+			{
+				continue;
+			}
+			sceneMinimum = (bFound == true) ? glm::min(sceneMinimum, node.worldBox.minimum) : node.worldBox.minimum;
+			sceneMaximum = (bFound == true) ? glm::max(sceneMaximum, node.worldBox.maximum) : node.worldBox.maximum;
+			bFound = true;
+		}
+
+		if (bFound == true)
+		{
+			m_frameBlock.shadowViewProjection = ShadowMaps::GetDirectionalViewProjection(
+				m_lights.directionalLight.direction,
+				sceneMinimum,
+				sceneMaximum);
+			lightFrame.viewProjection = m_frameBlock.shadowViewProjection;
+			UploadFrameBlock(lightFrame);
+
+			m_pShadowMaps->BindDirectional();
+			DrawShadowCasters();
+			m_frameBlock.shadowParams.x = 1.0f;
+		}
+	}
+
+	if ((m_pointLights.size() > 0) && (m_pointLights[0].bActive != 0))
+	{
+		// the cube reaches as far as the light does
+		float range = GetPointLightRange(m_pointLights[0]);
+		if (range > ShadowMaps::CUBE_NEAR_PLANE)
+		{
+			for (int face = 0; face < ShadowMaps::CUBE_FACE_COUNT; face++)
+			{
+				lightFrame.viewProjection = ShadowMaps::GetCubeFaceViewProjection(m_pointLights[0].position, face, range);
+				UploadFrameBlock(lightFrame);
+
+				m_pShadowMaps->BindCubeFace(face);
+				DrawShadowCasters();
+			}
+			m_frameBlock.shadowLightPosition = glm::vec4(m_pointLights[0].position, range);
+			m_frameBlock.shadowParams.y = 1.0f;
+		}
+	}
+
+	m_pShadowMaps->Unbind();
+	glDisable(GL_POLYGON_OFFSET_FILL);
+	glUseProgram(m_programID);
+	RenderStats::Add(RenderStats::COUNTER_PROGRAM_BINDS);
+
+	UploadFrameBlock(m_frameBlock);
+	m_bShadowsDirty = false;
+}
+
+/***********************************************************
+ *  DrawShadowCasters()
+ *
+ *  This method is used for drawing the depth of every
+ *  opaque node into the bound shadow map, one instanced
+ *  draw per mesh.  The glass and the glow let the light
+ *  through, so they cast no shadow.  The nodes outside the
+ *  view still cast into it, so the culling is ignored, and
+ *  the finest level of detail keeps the shadows steady as
+ *  the camera moves.
+ ***********************************************************/
+void SceneManager::DrawShadowCasters()
+{
+	for (int shape = 0; shape < MeshBuffers::SHAPE_COUNT; shape++)
+	{
+		m_instanceData.clear();
+		for (int i = 0; i < m_sceneNodes.size(); i++)
+		{
+			if ((m_sceneNodes[i].pass == PASS_OPAQUE) && (m_sceneNodes[i].mesh == shape))
+			{
+				AddNodeInstance(m_sceneNodes[i]);
+			}
+		}
+
+		if (m_instanceData.size() > 0)
+		{
+			m_pMeshBuffers->DrawInstanced(
+				(MeshBuffers::MESH_SHAPE)shape,
+				0,
+				m_instanceData.data(),
+				(int)m_instanceData.size(),
+				MeshBuffers::STREAM_POSITION);
+		}
+	}
+	m_instanceData.clear();
+}
+
+/***********************************************************
+ *  DrawIndirectBatches()
+ *
+ *  This method is used for drawing the whole opaque pass
+ *  from the persistent command buffer - one multi-draw
+ *  call per batch, whatever the number of nodes.  The
+ *  passed in permutations are either the forward shaded
+ *  ones or the G-buffer geometry pass, and each batch is
+ *  drawn with the permutation of its nodes.
+ ***********************************************************/
+void SceneManager::DrawIndirectBatches(ShaderPermutations* pShaders)
+{
+	m_pIndirectCommands->Bind();
+
+	GLuint boundProgramID = 0;
+	for (int i = 0; i < m_indirectBatches.size(); i++)
+	{
+		const INDIRECT_BATCH& batch = m_indirectBatches[i];
+		const SCENE_NODE& node = m_sceneNodes[batch.nodeIndex];
+
+		int permutation = GetNodePermutation(node);
+		ShaderProgram* pProgram = pShaders->GetProgram(permutation);
+		if (pProgram == NULL)
+		{
+			continue;
+		}
+		if (pProgram->GetProgramID() != boundProgramID)
+		{
+			pProgram->Use();
+			boundProgramID = pProgram->GetProgramID();
+		}
+		ShaderUniforms* pUniforms = pShaders->GetUniforms(permutation);
+
+		RenderState::SetCullFace(node.cullFace);
+		SetBatchUniforms(pUniforms, node);
+		pUniforms->SetInt(ShaderUniforms::UNIFORM_FIRST_DRAW, batch.firstCommand);
+		m_pMeshBuffers->DrawIndirect(batch.firstCommand, batch.commandCount, MeshBuffers::STREAM_ALL);
+		RenderStats::Add(
+			RenderStats::COUNTER_TRIANGLES,
+			m_pIndirectCommands->CountTriangles(batch.firstCommand, batch.commandCount));
+	}
+
+	RenderState::SetCullFace(GL_NONE);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+	glUseProgram(m_programID);
+	RenderStats::Add(RenderStats::COUNTER_PROGRAM_BINDS);
+}
+
+/***********************************************************
+ *  DrawDeferredOpaquePass()
+ *
+ *  This method is used for drawing the opaque pass with
+ *  deferred shading.  The indirect batches only store their
+ *  surfaces in the G-buffer, so the overdraw of the cabinet
+ *  panels, tiles and box costs a few target writes instead
+ *  of the full light loop.  One full screen triangle then
+ *  shades every covered pixel once, and writes the G-buffer
+ *  depth into the frame for the blended passes.
+ ***********************************************************/
+void SceneManager::DrawDeferredOpaquePass()
+{
+	GLint viewport[4] = { 0, 0, 1, 1 };
+	glGetIntegerv(GL_VIEWPORT, viewport);
+	if (m_pGBuffer->Resize(viewport[2], viewport[3]) == false)
+	{
+		// fall back to forward shading for good
+		m_bDeferredAvailable = false;
+		m_bDeferredShading = false;
+		DrawIndirectBatches(m_pIndirectShaders);
+		return;
+	}
+
+	// geometry pass, after the G-buffer depth is laid down
+	// when the depth pre-pass is selected
+	m_pGBuffer->BindForGeometry();
+	DrawDepthPrePass();
+	DrawIndirectBatches(m_pGBufferShaders);
+	m_pGBuffer->Unbind();
+
+	// lighting pass - every pixel passes the depth test and
+	// writes the depth of its stored surface
+	RenderState::Apply(DEFERRED_LIGHTING_STATE);
+	m_pDeferredLightingProgram->Use();
+	m_pGBuffer->BindTextures(m_gBufferTextureUnit);
+	m_pGBuffer->DrawFullScreenTriangle();
+	RenderState::Apply(g_PassStates[PASS_OPAQUE]);
+
+	glUseProgram(m_programID);
+	RenderStats::Add(RenderStats::COUNTER_PROGRAM_BINDS);
+}
+
+/***********************************************************
+ *  SetDeferredShading()
+ *
+ *  This method is used for selecting deferred or forward
+ *  shading for the opaque pass of the following frames.
+ ***********************************************************/
+void SceneManager::SetDeferredShading(bool bDeferredShading)
+{
+	m_bDeferredShading = (bDeferredShading && m_bDeferredAvailable);
+}
+
+/**************************************************************/
+/*** STUDENTS CAN MODIFY the code in the methods BELOW for  ***/
+/*** preparing and rendering their own 3D replicated scenes.***/
+/*** Please refer to the code in the OpenGL sample project  ***/
+/*** for assistance.                                        ***/
+/**************************************************************/
+
+/***********************************************************
+ *  SetupSceneLights()
+ *
+ *  Configure scene lighting.
+ *
+ *  Edited by: Jerris English - 08/17/2025
+ *  Edits:
+ *    - Enabled shader lighting path (bUseLighting = true)
+ *    - Configured a directional light for overall scene fill
+ *    - Added point light [0] at the bulb for warm glow
+ *    - Added point light [1] as a soft overhead fill
+ *    - Disabled remaining point lights [2..4] and spotlight
+ *
+ *  Edited on: October 14, 2026
+ *  Notes: The directional and point light values moved into the
+ *         scene file, which LoadSceneFile() reads - this now only
+ *         enables lighting and starts with every light off.
+ *         Lighting is built into the lit shader permutations, so
+ *         there is no bUseLighting uniform left to enable.
+ ***********************************************************/
+void SceneManager::SetupSceneLights()
+{
+	// the directional light and the lamps are read from the
+	// scene file by LoadSceneFile() - until then every light
+	// is off
+	m_lights.directionalLight.bActive = false;
+	for (int i = 0; i < TOTAL_POINT_LIGHTS; i++)
+	{
+		m_lights.pointLights[i].bActive = false;
+	}
+
+	//** Disable unused light types **//
+	//*******************************//
+	m_lights.spotLight.bActive = false;                        // off
+	m_pointLights.clear();
+
+	// upload the light block before the next frame is drawn
+	m_bLightsDirty = true;
+}
+
+/***********************************************************
+ *  AddPointLight()
+ *
+ *  This method is used for adding a point light to the
+ *  scene.  The unclustered shaders only see the first
+ *  TOTAL_POINT_LIGHTS of them.
+ ***********************************************************/
+int SceneManager::AddPointLight(const POINT_LIGHT& light)
+{
+	m_pointLights.push_back(light);
+	m_bLightsDirty = true;
+
+	return((int)m_pointLights.size() - 1);
+}
+
+/***********************************************************
+ *  CreateUniformBuffers()
+ *
+ *  This method is used for creating the uniform buffers
+ *  that back the shader material, light, frame and texture
+ *  blocks, and attaching them to their shared binding
+ *  points.
+ *
+ *  Edited on: October 14, 2026
+ *  Notes: The blocks are ranges of the buffer pool, which
+ *         all fit in its first block.
+ ***********************************************************/
+void SceneManager::CreateUniformBuffers()
+{
+	if ((m_pBufferPool->Allocate(sizeof(MATERIAL_BLOCK_ENTRY) * MAX_OBJECT_MATERIALS, m_materialRange) == false) ||
+		(m_pBufferPool->Allocate(sizeof(LIGHT_BLOCK), m_lightRange) == false) ||
+		(m_pBufferPool->Allocate(sizeof(FRAME_BLOCK), m_frameBlockRange) == false))
+	{
+		std::cout << "Could not allocate the material, light and frame blocks" << std::endl;
+		return;
+	}
+	GpuBufferPool::BindRange(GL_UNIFORM_BUFFER, ShaderUniforms::BLOCK_MATERIALS, m_materialRange);
+	GpuBufferPool::BindRange(GL_UNIFORM_BUFFER, ShaderUniforms::BLOCK_LIGHTS, m_lightRange);
+	GpuBufferPool::BindRange(GL_UNIFORM_BUFFER, ShaderUniforms::BLOCK_FRAME, m_frameBlockRange);
+
+	if ((m_bBindlessTextures == true) && (m_pBufferPool->Allocate(sizeof(TEXTURE_BLOCK), m_textureBlockRange) == true))
+	{
+		GpuBufferPool::BindRange(GL_UNIFORM_BUFFER, ShaderUniforms::BLOCK_TEXTURES, m_textureBlockRange);
+	}
+}
+
+/***********************************************************
+ *  UploadMaterials()
+ *
+ *  This method is used for packing the defined materials
+ *  into the material block, in the same order as the
+ *  material list so a material index selects its entry.
+ ***********************************************************/
+void SceneManager::UploadMaterials()
+{
+	MATERIAL_BLOCK_ENTRY entries[MAX_OBJECT_MATERIALS] = {};
+
+	int materialCount = m_objectMaterials.size();
+	if (materialCount > MAX_OBJECT_MATERIALS)
+	{
+		std::cout << "Too many materials defined - only the first "
+			<< MAX_OBJECT_MATERIALS << " of " << materialCount
+			<< " are available to the shader" << std::endl;
+		materialCount = MAX_OBJECT_MATERIALS;
+	}
+
+	for (int i = 0; i < materialCount; i++)
+	{
+		entries[i].diffuseColor = m_objectMaterials[i].diffuseColor;
+		entries[i].specularColor = m_objectMaterials[i].specularColor;
+		entries[i].shininess = m_objectMaterials[i].shininess;
+	}
+
+	m_pBufferPool->Upload(m_materialRange, 0, sizeof(entries), entries);
+}
+
+/***********************************************************
+ *  UploadLights()
+ *
+ *  This method is used for copying the scene lights into
+ *  the light block, and with clustered lighting the active
+ *  point lights into their storage buffer along with the
+ *  reach each one is clustered by.  It only needs to run
+ *  again when a light has been changed.
+ *
+ *  The active ones of the first TOTAL_POINT_LIGHTS lights
+ *  are packed to the front of the light block, so the
+ *  unclustered shader permutations loop over exactly as
+ *  many as are on.
+ ***********************************************************/
+void SceneManager::UploadLights()
+{
+	int activePointLights = 0;
+	for (int i = 0; (i < TOTAL_POINT_LIGHTS) && (i < m_pointLights.size()); i++)
+	{
+		if (m_pointLights[i].bActive != 0)
+		{
+			m_lights.pointLights[activePointLights] = m_pointLights[i];
+			activePointLights++;
+		}
+	}
+	for (int i = activePointLights; i < TOTAL_POINT_LIGHTS; i++)
+	{
+		m_lights.pointLights[i].bActive = false;
+	}
+
+	if (m_bClusteredLighting == true)
+	{
+		std::vector<POINT_LIGHT> activeLights;
+		m_lightSpheres.clear();
+		for (int i = 0; i < m_pointLights.size(); i++)
+		{
+			LightClusters::LIGHT_SPHERE sphere;
+			sphere.position = m_pointLights[i].position;
+			sphere.radius = GetPointLightRange(m_pointLights[i]);
+			if ((m_pointLights[i].bActive == false) || (sphere.radius <= 0.0f))
+			{
+				continue;
+			}
+
+			activeLights.push_back(m_pointLights[i]);
+			m_lightSpheres.push_back(sphere);
+		}
+		// keep the storage buffer from being empty
+		if (activeLights.size() == 0)
+		{
+			activeLights.push_back(POINT_LIGHT());
+		}
+
+		GLsizeiptr lightBytes = activeLights.size() * sizeof(POINT_LIGHT);
+		if (lightBytes > m_pointLightRange.size)
+		{
+			m_pBufferPool->Free(m_pointLightRange);
+			m_pBufferPool->Allocate(lightBytes, m_pointLightRange);
+		}
+		m_pBufferPool->Upload(m_pointLightRange, 0, lightBytes, activeLights.data());
+		GpuBufferPool::BindRange(GL_SHADER_STORAGE_BUFFER, LightClusters::POINT_LIGHT_BINDING, m_pointLightRange);
+	}
+
+	m_pBufferPool->Upload(m_lightRange, 0, sizeof(LIGHT_BLOCK), &m_lights);
+
+	m_bLightsDirty = false;
+	m_bShadowsDirty = true;
+
+	UpdateLightSetup(activePointLights);
+}
+
+/***********************************************************
+ *  UpdateLightSetup()
+ *
+ *  This method is used for passing the lights that are on
+ *  to the forward shaded permutations.  A change drops the
+ *  programs built for the old lights, so switching a light
+ *  on or off costs a rebuild - from the program binary
+ *  cache once it has been seen before.  The clustered
+ *  permutations read their point lights from the clusters,
+ *  so only the directional and spot lights are built in.
+ *  The G-buffer pass does no lighting at all.
+ ***********************************************************/
+void SceneManager::UpdateLightSetup(int activePointLights)
+{
+	ShaderPermutations::LIGHT_SETUP lightSetup;
+	lightSetup.bDirectionalLight = (m_lights.directionalLight.bActive != 0);
+	lightSetup.bSpotLight = (m_lights.spotLight.bActive != 0);
+	lightSetup.pointLightCount = (m_bClusteredLighting == true) ? 0 : activePointLights;
+
+	m_pIndirectShaders->SetLightSetup(lightSetup);
+	m_pWeightedShaders->SetLightSetup(lightSetup);
+	m_pLinkedListShaders->SetLightSetup(lightSetup);
+	if (m_pSceneShaders->SetLightSetup(lightSetup) == true)
+	{
+		UseDefaultSceneProgram();
+	}
+}
+
+/***********************************************************
+ *  PrepareScene()
+ *
+ *  This method is used for preparing the 3D scene by loading
+ *  the shapes, textures in memory to support the 3D scene 
+ *  rendering
+ * 
+ *  Edited by: Jerris English - SNHU CS Major
+ *  Date: July 28, 2025
+ *  Notes: Confirmed import of all necessary mesh types for lamp construction,
+ *         including cylinder, tapered cylinder, torus, and sphere meshes.
+ * 
+ *  Edited on: August 10, 2025
+ *  Notes: Added call to LoadSceneTextures() for loading all textures before 
+ *         mesh setup, and enabled blending for rendering transparent objects 
+ *         such as the glass dome.
+ * 
+ *  Edited on: August 17, 2025
+ *  Notes: Added calls to DefineObjectMaterials() and SetupSceneLights() to 
+ *         initialize surface properties and lighting for the scene.
+ * 
+ *  Edited on: August 17, 2025
+ *  Notes: Added calls to DefineObjectMaterials() and SetupSceneLights() to 
+ *         initialize surface properties and lighting for the scene.
+ * 
+ *  Edited on: October 14, 2026
+ *  Notes: Added call to DefineSceneNodes() so the scene transforms,
+ *         materials and textures are resolved once instead of every frame,
+ *         and resolve the per-draw uniform locations before any uploads.
+ *         Create the material and light uniform buffers and fill the
+ *         material block once the materials are defined.
+ *         Removed the second DefineObjectMaterials() and
+ *         SetupSceneLights() calls, which filled the material
+ *         list with duplicates.  Build the multi-draw indirect
+ *         shader variant when the context supports it, and
+ *         the depth only variants for the depth pre-pass.
+ *         Replaced DefineSceneNodes() with LoadSceneFile(), which
+ *         reads the nodes and the lights from the scene file.
+ *         The materials are read from the scene file too, so the
+ *         material block is filled after it.
+ *         The scene shader permutations replace the main program,
+ *         whose uniforms are no longer looked up here.
+ *         Create the shadow maps once the depth program is built.
+ *         Build the order independent transparency programs.
+ ***********************************************************/
+void SceneManager::PrepareScene()
+{
+	// the scene shader permutations take over from the program
+	// the main code put in use
+	LoadShaderVariants();
+	LoadDepthPrograms();
+	CreateUniformBuffers();
+
+	LoadTransparencyPrograms();
+
+	// the shadow maps are drawn with the depth program
+	m_bShadowsAvailable = ((m_bDepthPrePassAvailable == true) && (m_pShadowMaps->Create() == true));
+
+	// Load all scene textures first
+	LoadSceneTextures();
+
+	SetupSceneLights();                   // configure directional + bulb lights
+
+	// only one instance of a particular mesh needs to be
+	// loaded in memory no matter how many times it is drawn
+	// in the rendered 3D scene
+	m_pMeshBuffers->LoadMeshes();
+
+	// build the retained scene node list, the materials and the
+	// lights once
+	LoadSceneFile();
+	if (m_sceneCopies > 1)
+	{
+		ReplicateScene();
+	}
+
+	// the material list is final, copy it into the material block
+	UploadMaterials();
+}
+
+/***********************************************************
+ *  ReplicateScene()
+ *
+ *  This method is used for repeating the scene nodes and
+ *  point lights into a square grid of m_sceneCopies copies
+ *  of the scene, laid out side by side along X and back
+ *  along -Z, for stress testing.  The copies keep the
+ *  materials and textures of the original nodes.  Only the
+ *  clustered shaders see the copied point lights - the
+ *  others stay lit by the lamps of the first copy.
+ ***********************************************************/
+void SceneManager::ReplicateScene()
+{
+	// the world boxes give the footprint of one copy
+	UpdateSceneNodes();
+
+	glm::vec3 sceneMinimum = glm::vec3(1.0e30f);
+	glm::vec3 sceneMaximum = glm::vec3(-1.0e30f);
+	for (int i = 0; i < m_sceneNodes.size(); i++)
+	{
+		sceneMinimum = glm::min(sceneMinimum, m_sceneNodes[i].worldBox.minimum);
+		sceneMaximum = glm::max(sceneMaximum, m_sceneNodes[i].worldBox.maximum);
+	}
+	glm::vec3 spacing = (sceneMaximum - sceneMinimum) * 1.1f;
+
+	int columns = (int)std::ceil(std::sqrt((float)m_sceneCopies));
+	int nodeCount = (int)m_sceneNodes.size();
+	int lightCount = (int)m_pointLights.size();
+	m_sceneNodes.reserve(nodeCount * m_sceneCopies);
+
+	for (int copy = 1; copy < m_sceneCopies; copy++)
+	{
+		glm::vec3 offset = glm::vec3(
+			(copy % columns) * spacing.x,
+			0.0f,
+			-(copy / columns) * spacing.z);
+
+		for (int i = 0; i < nodeCount; i++)
+		{
+			SCENE_NODE node = m_sceneNodes[i];
+			node.positionXYZ += offset;
+			node.bDirty = true;
+			m_sceneNodes.push_back(node);
+		}
+		for (int i = 0; i < lightCount; i++)
+		{
+			POINT_LIGHT light = m_pointLights[i];
+			light.position += offset;
+			AddPointLight(light);
+		}
+	}
+
+	m_bSceneChanged = true;
 }
 
 // =============================================================
@@ -646,6 +2659,14 @@ void SceneManager::PrepareScene()
 //     zebra fur for mirror tiles, mirror surface reflection,
 //     chevron-patterned fur for the decorative box sides, and
 //     dark box fur texture for the top lid surface.
+// 
+//  Revisions (October 14, 2026):
+//   - The images are decoded on worker threads instead of one
+//     after another before the first frame.
+//   - Baked BC7 .ktx2 files are preferred over the JPEGs when the
+//     context supports BC7.
+//   - The image of a slot is decoded again when its file changes
+//     and hot reload is enabled.
 // =============================================================
 void SceneManager::LoadSceneTextures()
 {
@@ -675,1245 +2696,640 @@ void SceneManager::LoadSceneTextures()
 	// Solid dark grey fur texture for box top
 	CreateGLTexture("textures/BoxFur.jpg", "BoxFur");
 
+	// decode the images in parallel - the slots are bound to the
+	// placeholder until each upload arrives.  BC7 needs OpenGL 4.2
+	// or the BPTC extension, otherwise the images are uploaded as is
+	m_bCompressedTextures = (GLEW_VERSION_4_2 || GLEW_ARB_texture_compression_bptc);
+	m_pTextureLoader->Start(m_bCompressedTextures);
 	BindGLTextures();
 }
 
 
 /***********************************************************
- *  RenderScene()
+ *  LoadSceneFile()
  *
- *  This method is used for rendering the 3D scene by 
- *  transforming and drawing the basic 3D shapes
+ *  This method is used for building the materials, the
+ *  retained list of scene nodes and the scene lights from
+ *  the scene file, once, when the scene is prepared.  The
+ *  file arrays are read straight out of the mapped compiled
+ *  scene.  The materials come first, so the nodes can
+ *  resolve their material tags.
+ *
+ *  Nodes are drawn in the order they are listed in the
+ *  file, within their pass.
  ***********************************************************/
-void SceneManager::RenderScene()
-{	
-	// reset render state for opaque pass
-	glDisable(GL_BLEND);                                   // blending off
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);     // standard blend
-	glDepthMask(GL_TRUE);                                   // write depth
-	m_pShaderManager->setBoolValue("bUseLighting", true);   // enable lighting
-	glEnable(GL_DEPTH_TEST);    // ensure depth testing is active for opaque geometry
-	glDisable(GL_CULL_FACE);    // default: no culling for floor/wall; enable later as needed
-
-	// declare the variables for the transformations
-	glm::vec3 scaleXYZ;
-	float XrotationDegrees = 0.0f;
-	float YrotationDegrees = 0.0f;
-	float ZrotationDegrees = 0.0f;
-	glm::vec3 positionXYZ;
-
-	/*** Set needed transformations before drawing the basic mesh.  ***/
-	/*** This same ordering of code should be used for transforming ***/
-	/*** and drawing all the basic 3D shapes.						***/
-	/******************************************************************/
-	
-	/****************************************************************
- *  3D Scene Construction - Created by Jerris English
- *  Date: July 28, 2025
+bool SceneManager::LoadSceneFile()
+{
+	SceneFile sceneFile;
+	if (sceneFile.Load(m_sceneFilename) == false)
+	{
+		std::cout << "Could not load the scene: " << m_sceneFilename << std::endl;
+		return(false);
+	}
+
+	ApplySceneMaterials(sceneFile);
+	AddSceneFileNodes(sceneFile);
+	ApplySceneLights(sceneFile);
+
+	return(true);
+}
+
+/***********************************************************
+ *  ReloadSceneFile()
  *
- *  The following shapes, positions, and materials are used to
- *  build the full 3D scene. Each section handles one part of
- *  the structure  from base to top  using basic transformations,
- *  color shaders, and mesh drawing calls.
- * 
- *  Revisions (Aug 10, 2025):
- *  - Added texture shading to the lamp base for a more realistic
- *    surface appearance.
- *  - Applied texture shading to the lamp globe (glass shade) to
- *    enhance the frosted glass effect with consistent alpha values
- *    and proper draw order for cleaner transparency.
- * 
- *   Revisions (Aug 17, 2025):
- *  - Added shader material calls to all render objects to apply
- *    proper lighting and surface response during rendering
- * 
- *	*  Revisions (Aug 24, 2025):
- *  - Constructed and textured the cabinet structure including
- *    base, doors, legs, and top mirror panel.
- *  - Designed the decorative box using chevron-patterned fur
- *    sides and a matching lid with soft fur material.
- *  - Added the full mirror panel above the lamp using zebra fur
- *    tiles with precise tile rotation and alternate textures.
- ****************************************************************/
-
- //** Floor plane **//
- //*****************//
-	scaleXYZ = glm::vec3(8.0f, 1.0f, 6.0f);           // wide flat floor
-	positionXYZ = glm::vec3(0.0f, 0.0f, 0.0f);        // sits at ground level
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderMaterial("floorMat");                    // floor material for lighting
-	SetShaderTexture("Floor");                        // epoxy floor texture
-	SetTextureUVScale(3.0f, 3.0f);                    // repeat texture for detail
-	m_basicMeshes->DrawPlaneMesh();
-
-	//** Backdrop wall **//
-	//*******************//
-	scaleXYZ = glm::vec3(8.0f, 1.0f, 12.0f);                         // Wide and tall flat wall
-	positionXYZ = glm::vec3(0.0f, 12.0f, -6.0f);                     // Push behind the rest of the scene
-	SetTransformations(scaleXYZ, -90.0f, 0.0f, 0.0f, positionXYZ);  // Rotate to vertical
-	SetShaderMaterial("wallMat");                                   // wall material for lighting
-	SetShaderTexture("Wall");                                       // Apply cream plaster wall texture
-	SetTextureUVScale(2.0f, 2.0f);                                  // Slightly tighter tiling for detail
-	m_pShaderManager->setVec4Value(g_ColorValueName,                // no extra tint (preserve texture)
-		glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
-	m_basicMeshes->DrawPlaneMesh();                                 // draw wall
-	/****************************************************************/
-
-//** MIRROR FRAME: TOP ROW **//
-//****************************//
-
-	scaleXYZ = glm::vec3(1.2f, 1.2f, 0.15f);  // Mirror tile size
-
-//** Mirror Frame: Top Left Tile **//
-	positionXYZ = glm::vec3(-1.8f, 16.0f, -5.90f);        // Far left
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, -90.0f, positionXYZ);
-	SetShaderMaterial("zebraMat");                        // Gloss finish
-	SetShaderTexture("ZebraFur");                         // Zebra pattern
-	SetTextureUVScale(1.0f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
-
-	//** Mirror Frame: Top Mid-Left Tile **//
-	positionXYZ = glm::vec3(-0.6f, 16.0f, -5.90f);        // Mid left
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);  // Rotate Z
-	SetShaderMaterial("zebraMat");
-	SetShaderTexture("ZebraFur");
-	SetTextureUVScale(1.0f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
-
-	//** Mirror Frame: Top Mid-Right Tile **//
-	positionXYZ = glm::vec3(0.6f, 16.0f, -5.90f);         // Mid right
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, -90.0f, positionXYZ);  // Rotate Z
-	SetShaderMaterial("zebraMat");
-	SetShaderTexture("ZebraFur");
-	SetTextureUVScale(1.0f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
-
-	//** Mirror Frame: Top Right Tile **//
-	positionXYZ = glm::vec3(1.8f, 16.0f, -5.90f);         // Far right
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);  // Rotate Z
-	SetShaderMaterial("zebraMat");
-	SetShaderTexture("ZebraFur");
-	SetTextureUVScale(1.0f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
-
-//** MIRROR FRAME: LEFT COLUMN **//
-//*******************************//
-
-	//** Mirror Frame: Left Tile 1 **//
-	scaleXYZ = glm::vec3(1.2f, 1.2f, 0.15f);              // Tile size
-	positionXYZ = glm::vec3(-1.8f, 14.8f, -5.90f);        // First tile under top left
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 180.0f, positionXYZ);  // Base orientation
-	SetShaderMaterial("zebraMat");
-	SetShaderTexture("ZebraFur");
-	SetTextureUVScale(1.0f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
-
-	//** Mirror Frame: Left Tile 2 **//
-	positionXYZ = glm::vec3(-1.8f, 13.6f, -5.90f);        // Middle left tile
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 270.0f, positionXYZ);  // 90 rotation
-	SetShaderMaterial("zebraMat");
-	SetShaderTexture("ZebraFur");
-	SetTextureUVScale(1.0f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
-
-	//** Mirror Frame: Left Tile 3 **//
-	positionXYZ = glm::vec3(-1.8f, 12.4f, -5.90f);        // Bottom left vertical tile
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 180.0f, positionXYZ);  // 0 rotation
-	SetShaderMaterial("zebraMat");
-	SetShaderTexture("ZebraFur");
-	SetTextureUVScale(1.0f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
-
-//** MIRROR FRAME: RIGHT COLUMN **//
-//********************************//
-
-	//** Mirror Frame: Right Tile 1 **//
-	positionXYZ = glm::vec3(1.8f, 14.8f, -5.90f);         // First tile under top right
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 90.0f, positionXYZ);  // Base orientation
-	SetShaderMaterial("zebraMat");
-	SetShaderTexture("ZebraFur");
-	SetTextureUVScale(1.0f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
-
-	//** Mirror Frame: Right Tile 2 **//
-	positionXYZ = glm::vec3(1.8f, 13.6f, -5.90f);         // Middle right tile
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);  // Opposite of 270
-	SetShaderMaterial("zebraMat");
-	SetShaderTexture("ZebraFur");
-	SetTextureUVScale(1.0f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
-
-	//** Mirror Frame: Right Tile 3 **//
-	positionXYZ = glm::vec3(1.8f, 12.4f, -5.90f);         // Bottom right vertical tile
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 90.0f, positionXYZ);  // Consistent finish
-	SetShaderMaterial("zebraMat");
-	SetShaderTexture("ZebraFur");
-	SetTextureUVScale(1.0f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
-
-//** MIRROR FRAME: BOTTOM ROW **//
-//******************************//
-
-	//** Mirror Frame: Bottom Left Tile **//
-	positionXYZ = glm::vec3(-0.6f, 12.4f, -5.90f);        // Bottom left horizontal
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 90.0f, positionXYZ);  // Match top mid-left
-	SetShaderMaterial("zebraMat");
-	SetShaderTexture("ZebraFur");
-	SetTextureUVScale(1.0f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
-
-	//** Mirror Frame: Bottom Right Tile **//
-	positionXYZ = glm::vec3(0.6f, 12.4f, -5.90f);         // Bottom right horizontal
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 180.0f, positionXYZ);  // Match top mid-right
-	SetShaderMaterial("zebraMat");
-	SetShaderTexture("ZebraFur");
-	SetTextureUVScale(1.0f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
-
-//** MIRROR: Inner Reflective Surface **//
-//*************************************//
-	scaleXYZ = glm::vec3(2.4f, 2.4f, 0.1f);               // Large central square, slightly thinner depth
-	positionXYZ = glm::vec3(0.0f, 14.2f, -5.92f);         // Slightly inlaid inside the frame
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderMaterial("mirrorMat");                      // Glossy reflective surface
-	SetShaderTexture("Mirror");                          // Smooth silver mirror image
-	SetTextureUVScale(1.0f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
-
-	//** CABINET: SUPPORT PEGS **//
-	//***************************//
-
-	scaleXYZ = glm::vec3(0.4f, 1.0f, 0.4f);               // Short wide pegs, 1/5 cabinet height
-
-	//** Front Left Peg **//
-	positionXYZ = glm::vec3(-2.8f, 0.5f, -0.7f);          // Front left corner under cabinet
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);            // Solid black color (reacts with lighting)
-	m_basicMeshes->DrawBoxMesh();
-
-	//** Front Right Peg **//
-	positionXYZ = glm::vec3(2.8f, 0.5f, -0.7f);           // Front right corner under cabinet
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
-
-	//** Back Left Peg **//
-	positionXYZ = glm::vec3(-2.8f, 0.5f, -5.3f);          // Back left corner under cabinet
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
-
-	//** Back Right Peg **//
-	positionXYZ = glm::vec3(2.8f, 0.5f, -5.3f);           // Back right corner under cabinet
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
-
-//** CABINET: MAIN BODY **//
-//*************************//
-
-	scaleXYZ = glm::vec3(6.0f, 4.5f, 5.0f);                 // Wider cabinet body with reduced height
-	positionXYZ = glm::vec3(0.0f, 3.25f, -3.0f);             // Centered and flush on top of 1.0f tall pegs
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderMaterial("mirrorMat");                        // Glossy reflective surface
-	SetShaderTexture("Mirror");                            // Mirror texture for cabinet body
-	SetTextureUVScale(1.0f, 1.0f);                          // Standard texture scale
-	m_basicMeshes->DrawBoxMesh();
-
-//** CABINET: TOP MIRROR PANEL **//
-//*******************************//
-
-	scaleXYZ = glm::vec3(5.6f, 0.325f, 4.6f);                // Thin panel, slightly inset from cabinet body
-	positionXYZ = glm::vec3(0.0f, 5.66f, -3.0f);           // Sits flush on top of 4.5f tall cabinet body
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderMaterial("mirrorMat");                       // Glossy reflective surface
-	SetShaderTexture("Mirror");                           // Same mirror texture as cabinet body
-	SetTextureUVScale(1.0f, 1.0f);                         // Standard texture scale
-	m_basicMeshes->DrawBoxMesh();
-
-//** CABINET: TOP OVERHANG STRIPS **//
-//**********************************//
-
-	//** Front Overhang Strip **//
-	//**************************//
-
-	scaleXYZ = glm::vec3(6.4f, 0.325f, 0.5f);             // Slightly wider than cabinet, thin height, front depth
-	positionXYZ = glm::vec3(0.0f, 5.66f, -0.445f);        // Aligned with front edge of cabinet
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);          // Solid black color (reflects light)
-	m_basicMeshes->DrawBoxMesh();
-
-	//** Back Overhang Strip **//
-	//*************************//
-
-	scaleXYZ = glm::vec3(6.4f, 0.325f, 0.5f);             // Matches front strip: wide, thin, deep
-	positionXYZ = glm::vec3(0.0f, 5.66f, -5.55f);         // Aligned with back edge of cabinet
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);            // Solid black color (reflects light)
-	m_basicMeshes->DrawBoxMesh();
-
-	//** Left Overhang Strip **//
-	//**************************//
-
-	scaleXYZ = glm::vec3(0.41f, 0.325f, 4.7f);             // Narrow width, thin height, matches cabinet depth
-	positionXYZ = glm::vec3(-3.0f, 5.66f, -3.0f);         // Aligned with left edge, flush with top mirror panel
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);            // Solid black color (reflects light)
-	m_basicMeshes->DrawBoxMesh();
-
-	//** Right Overhang Strip **//
-	//***************************//
-
-	positionXYZ = glm::vec3(3.0f, 5.66f, -3.0f);          // Aligned with right edge, same depth
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
-
-//** CABINET: FRONT EDGE PANELS (THIN BLACK)**//
-//********************************************//
-
-	//** Left Edge Strip **//
-	//*********************//
-
-	scaleXYZ = glm::vec3(0.2f, 4.5f, 0.5f);               // Thin strip, matches cabinet height
-	positionXYZ = glm::vec3(-3.0f, 3.25f, -0.65f);       // Aligned left, flush with mirror front
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);            // Solid black (reacts with light)
-	m_basicMeshes->DrawBoxMesh();
-
-	//** Right Edge Strip **//
-	//**********************//
-
-	positionXYZ = glm::vec3(3.0f, 3.25f, -0.65f);        // Aligned right, mirror depth
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
-
-	//** Bottom Edge Strip **//
-	//***********************//
-	scaleXYZ = glm::vec3(6.0f, 0.2f, 0.1f);               // Wide horizontal strip, matches cabinet width
-	positionXYZ = glm::vec3(0.0f, 1.1f, -0.45f);          // Aligned bottom, flush under mirror
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
-
-//** CABINET: RIGHT SIDE EDGE STRIPS **//
-//********************************//
-
-	//** Right Top Edge Strip **//
-	//**************************//
-
-	scaleXYZ = glm::vec3(0.2f, 0.5f, 4.2f);              // Thin horizontal strip on top right edge
-	positionXYZ = glm::vec3(3.0f, 5.3f, -3.0f);           // Matches height and depth of top panel
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);             // Solid black (reacts with light)
-	m_basicMeshes->DrawBoxMesh();
-
-	//** Right Back Edge Strip **//
-	//***************************//
-
-	scaleXYZ = glm::vec3(0.2f, 4.5f, 0.5f);               // Tall vertical strip, flush against right side
-	positionXYZ = glm::vec3(3.0f, 3.25f, -5.35f);         // Same Y/Z as left edge strip
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
-
-	//** Right Bottom Strip **//
-	//************************//
-
-	scaleXYZ = glm::vec3(0.2f, 0.5f, 4.2f);               // Small horizontal strip along bottom edge
-	positionXYZ = glm::vec3(3.0f, 1.25f, -3.0f);          // Flush with right base, matches bottom strip
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
-
-//** CABINET: LEFT SIDE EDGE STRIPS **//
-//************************************//
-
-	//** Left Top Edge Strip **//
-	//*************************//
-
-	scaleXYZ = glm::vec3(0.2f, 0.5f, 4.2f);              // Thin horizontal strip on top left edge
-	positionXYZ = glm::vec3(-3.0f, 5.3f, -3.0f);         // Matches height and depth of top panel
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);           // Solid black (reacts with light)
-	m_basicMeshes->DrawBoxMesh();
-
-	//** Left Back Edge Strip **//
-	//**************************//
+ *  This method is used for reading the scene file again
+ *  after it changed, and only updating what changed in it.
+ *  When the file still lists the same number of nodes,
+ *  each node is compared with its file entry, and only the
+ *  nodes that differ are changed - a moved node rebuilds
+ *  its own matrix and bounds, and the rest of the scene is
+ *  left alone.  When nodes were added or removed, or the
+ *  scene is copied for stress testing, the node list is
+ *  built again.  A file that cannot be read leaves the
+ *  current scene as it is.
+ ***********************************************************/
+bool SceneManager::ReloadSceneFile()
+{
+	SceneFile sceneFile;
+	if (sceneFile.Load(m_sceneFilename) == false)
+	{
+		std::cout << "Could not reload the scene, keeping the current one: " << m_sceneFilename << std::endl;
+		return(false);
+	}
+	const SceneFile::SCENE_ARRAYS& scene = sceneFile.GetArrays();
 
-	scaleXYZ = glm::vec3(0.2f, 4.5f, 0.5f);              // Tall vertical strip, flush against left side
-	positionXYZ = glm::vec3(-3.0f, 3.25f, -5.35f);       // Matches right back edge strip
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
-
-	//** Left Bottom Strip **//
-	//***********************//
+	if (ApplySceneMaterials(sceneFile) == true)
+	{
+		UploadMaterials();
+	}
+
+	if ((m_sceneCopies > 1) || (scene.nodeCount != m_sceneNodes.size()))
+	{
+		m_sceneNodes.clear();
+		AddSceneFileNodes(sceneFile);
+		ApplySceneLights(sceneFile);
+		if (m_sceneCopies > 1)
+		{
+			ReplicateScene();
+		}
+		m_bSceneChanged = true;
 
-	scaleXYZ = glm::vec3(0.2f, 0.5f, 4.2f);              // Small horizontal strip along bottom edge
-	positionXYZ = glm::vec3(-3.0f, 1.25f, -3.0f);        // Flush with left base, matches bottom strip
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
-
-//** CABINET: FRONT VERTICAL FRAME STRIPS **//
-//******************************************//
+		std::cout << "Reloaded scene file: " << m_sceneFilename << ", rebuilt " << m_sceneNodes.size() << " nodes" << std::endl;
+		return(true);
+	}
 
-	//** Front Left Door Frame Strip **//
-	//*********************************//
-
-	scaleXYZ = glm::vec3(0.2f, 4.3f, 0.1f);              // Thin, tall, shallow strip for door frame
-	positionXYZ = glm::vec3(-2.2f, 3.35f, -0.45f);      // Aligned to left edge, flush with front
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);           // Solid black (reacts with light)
-	m_basicMeshes->DrawBoxMesh();
+	std::vector<int> materialIndices(scene.tagCount, -2);
+	std::vector<int> textureSlots(scene.tagCount, -2);
+	int changedCount = 0;
+	for (int i = 0; i < scene.nodeCount; i++)
+	{
+		SCENE_NODE& node = m_sceneNodes[i];
+		SCENE_NODE fileNode = node;
+		if (ReadSceneFileNode(sceneFile, i, materialIndices, textureSlots, fileNode) == false)
+		{
+			continue;
+		}
 
-	//** Front Right Door Frame Strip **//
-	//**********************************//
-
-	positionXYZ = glm::vec3(2.2f, 3.35f, -0.45f);       // Aligned to right edge, flush with front
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
-
-//** CABINET: FRONT HORIZONTAL FRAME STRIPS **//
-//********************************************//
-
-	//** Top Door Frame Strip **//
-	//**************************//
-
-	scaleXYZ = glm::vec3(4.2f, 0.2f, 0.1f);             // Thin horizontal strip, spans width of door section
-	positionXYZ = glm::vec3(0.0f, 5.1f, -0.45f);        // Positioned just below the top panel
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);          // Solid black (reacts with light)
-	m_basicMeshes->DrawBoxMesh();
-
-	//** Bottom Door Frame Strip **//
-	//*****************************//
-
-	positionXYZ = glm::vec3(0.0f, 1.6f, -0.45f);        // Positioned just above the bottom panel
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
+		bool bMoved = (fileNode.mesh != node.mesh) ||
+			(fileNode.scaleXYZ != node.scaleXYZ) ||
+			(fileNode.XrotationDegrees != node.XrotationDegrees) ||
+			(fileNode.YrotationDegrees != node.YrotationDegrees) ||
+			(fileNode.ZrotationDegrees != node.ZrotationDegrees) ||
+			(fileNode.positionXYZ != node.positionXYZ);
+		bool bChanged = (bMoved == true) ||
+			(fileNode.pass != node.pass) ||
+			(fileNode.cullFace != node.cullFace) ||
+			(fileNode.materialIndex != node.materialIndex) ||
+			(fileNode.textureSlot != node.textureSlot) ||
+			(fileNode.color != node.color) ||
+			(fileNode.UVscale != node.UVscale) ||
+			(fileNode.bUseLighting != node.bUseLighting);
+		if (bChanged == false)
+		{
+			continue;
+		}
 
-//** CABINET: DOOR OUTER TRIM PIECES **//
-//**************************************//
+		// another mesh may not have the level of detail drawn
+		if (fileNode.mesh != node.mesh)
+		{
+			fileNode.lodLevel = 0;
+		}
+		fileNode.bDirty = (node.bDirty || bMoved);
+		node = fileNode;
+		m_bSceneChanged = true;
+		changedCount++;
+	}
 
-	// ===== LEFT DOOR ===== //
-
-	//** Left Door - Left Trim **//
-	//***************************//
-
-	scaleXYZ = glm::vec3(0.3f, 2.7f, 0.1f);
-	positionXYZ = glm::vec3(-2.0f, 3.35f, -0.45f);         // Left edge of left door
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
+	ApplySceneLights(sceneFile);
 
-	//** Left Door - Right Trim **//
-	//****************************//
+	std::cout << "Reloaded scene file: " << m_sceneFilename << ", " << changedCount << " of " << scene.nodeCount << " nodes changed" << std::endl;
+	return(true);
+}
 
-	positionXYZ = glm::vec3(-0.1f, 3.35f, -0.45f);         // Right edge of left door
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
-
-	//** Left Door - Top Trim **//
-	//**************************//
-
-	scaleXYZ = glm::vec3(2.2f, 0.3f, 0.1f);               // Horizontal top trim
-	positionXYZ = glm::vec3(-1.1f, 4.84f, -0.45f);          // Top of left door
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
+/***********************************************************
+ *  ApplySceneMaterials()
+ *
+ *  This method is used for adding the materials of a scene
+ *  file to the material list.  A tag that is already
+ *  defined keeps its index and only takes the new values,
+ *  so the nodes using it need no change.  Materials that
+ *  are no longer in the file stay defined.
+ ***********************************************************/
+bool SceneManager::ApplySceneMaterials(const SceneFile& sceneFile)
+{
+	const SceneFile::SCENE_ARRAYS& scene = sceneFile.GetArrays();
+	bool bChanged = false;
 
-	//** Left Door - Bottom Trim **//
-	//*****************************//
+	for (int i = 0; i < scene.materialCount; i++)
+	{
+		const SceneFile::MATERIAL_RECORD& record = scene.materials[i];
 
-	positionXYZ = glm::vec3(-1.1f, 1.86f, -0.45f);          // Bottom of left door
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
+		OBJECT_MATERIAL material;
+		material.diffuseColor = record.diffuseColor;
+		material.specularColor = record.specularColor;
+		material.shininess = record.shininess;
+		material.tag = sceneFile.GetTag(record.tagIndex);
 
+		int materialIndex = FindMaterialIndex(material.tag);
+		if (materialIndex < 0)
+		{
+			m_materialLookup[material.tag] = (int)m_objectMaterials.size();
+			m_objectMaterials.push_back(material);
+			bChanged = true;
+			continue;
+		}
 
-	// ===== RIGHT DOOR ===== //
+		OBJECT_MATERIAL& defined = m_objectMaterials[materialIndex];
+		if ((defined.diffuseColor != material.diffuseColor) ||
+			(defined.specularColor != material.specularColor) ||
+			(defined.shininess != material.shininess))
+		{
+			defined = material;
+			bChanged = true;
+		}
+	}
 
-	//** Right Door - Left Trim **//
-	//****************************//
+	return(bChanged);
+}
 
-	scaleXYZ = glm::vec3(0.3f, 2.7f, 0.1f);
-	positionXYZ = glm::vec3(0.1f, 3.35f, -0.45f);         // Left edge of right door
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
+/***********************************************************
+ *  ApplySceneLights()
+ *
+ *  This method is used for setting the directional light
+ *  and the point lights from a scene file.  The point
+ *  lights are copied as they are, since the file holds
+ *  them in the shader light layout.
+ ***********************************************************/
+void SceneManager::ApplySceneLights(const SceneFile& sceneFile)
+{
+	const SceneFile::SCENE_ARRAYS& scene = sceneFile.GetArrays();
 
-	//** Right Door - Right Trim **//
-	//*****************************//
+	if (scene.pDirectionalLight != NULL)
+	{
+		m_lights.directionalLight.direction = scene.pDirectionalLight->position;
+		m_lights.directionalLight.ambient = scene.pDirectionalLight->ambient;
+		m_lights.directionalLight.diffuse = scene.pDirectionalLight->diffuse;
+		m_lights.directionalLight.specular = scene.pDirectionalLight->specular;
+		m_lights.directionalLight.bActive = scene.pDirectionalLight->bActive;
+	}
+	else
+	{
+		m_lights.directionalLight.bActive = false;
+	}
 
-	positionXYZ = glm::vec3(2.0f, 3.35f, -0.45f);         // Right edge of right door
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
+	// the file point light records share the byte layout of
+	// POINT_LIGHT, so the list is copied as it is - UploadLights()
+	// packs them into the light block
+	const POINT_LIGHT* pPointLights = (const POINT_LIGHT*)scene.pointLights;
+	m_pointLights.assign(pPointLights, pPointLights + scene.pointLightCount);
 
-	//** Right Door - Top Trim **//
-	//***************************//
+	// upload the light block before the next frame is drawn
+	m_bLightsDirty = true;
+}
 
-	scaleXYZ = glm::vec3(2.2f, 0.3f, 0.1f);               // Horizontal top trim
-	positionXYZ = glm::vec3(1.1f, 4.84f, -0.45f);          // Top of right door
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
+/***********************************************************
+ *  AddSceneFileNodes()
+ *
+ *  This method is used for adding a scene node for each
+ *  node of a scene file.  Each material and texture tag is
+ *  resolved once however many nodes use it.
+ ***********************************************************/
+void SceneManager::AddSceneFileNodes(const SceneFile& sceneFile)
+{
+	const SceneFile::SCENE_ARRAYS& scene = sceneFile.GetArrays();
 
-	//** Right Door - Bottom Trim **//
-	//******************************//
+	// -2 until a tag has been looked up
+	std::vector<int> materialIndices(scene.tagCount, -2);
+	std::vector<int> textureSlots(scene.tagCount, -2);
 
-	positionXYZ = glm::vec3(1.1f, 1.86f, -0.45f);          // Bottom of right door
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
+	m_sceneNodes.reserve(m_sceneNodes.size() + scene.nodeCount);
+	for (int i = 0; i < scene.nodeCount; i++)
+	{
+		int nodeIndex = AddSceneNode(
+			(MESH_TYPE)scene.meshes[i],
+			scene.scales[i],
+			scene.rotations[i].x,
+			scene.rotations[i].y,
+			scene.rotations[i].z,
+			scene.positions[i]);
+		if (ReadSceneFileNode(sceneFile, i, materialIndices, textureSlots, m_sceneNodes[nodeIndex]) == false)
+		{
+			m_sceneNodes.pop_back();
+		}
+	}
+}
 
-//** CABINET: DOOR RING **//
-//********************************//
+/***********************************************************
+ *  ReadSceneFileNode()
+ *
+ *  This method is used for setting the values of a scene
+ *  node from a node of a scene file.  The model matrix is
+ *  not rebuilt here - the caller decides whether the node
+ *  moved.  False when the file node has an unknown mesh or
+ *  pass.
+ ***********************************************************/
+bool SceneManager::ReadSceneFileNode(
+	const SceneFile& sceneFile,
+	int fileIndex,
+	std::vector<int>& materialIndices,
+	std::vector<int>& textureSlots,
+	SCENE_NODE& node)
+{
+	const SceneFile::SCENE_ARRAYS& scene = sceneFile.GetArrays();
+	int i = fileIndex;
 
-//** Left Door Ring Handle **//
-	scaleXYZ = glm::vec3(0.4f, 0.4f, 0.25f);             // Larger diameter
-	positionXYZ = glm::vec3(-1.1f, 3.35f, -0.45f);        // Slightly forward from door face
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);            // Solid black ring
-	m_basicMeshes->DrawTorusMesh();
+	if ((scene.meshes[i] < 0) || (scene.meshes[i] >= MeshBuffers::SHAPE_COUNT) ||
+		(scene.passes[i] < PASS_OPAQUE) || (scene.passes[i] > PASS_ADDITIVE))
+	{
+		std::cout << "Scene node " << i << " has an unknown mesh or pass" << std::endl;
+		return(false);
+	}
 
-	//** Right Door Ring **//
-	positionXYZ = glm::vec3(1.1f, 3.35f, -0.45f);         // Mirror position for right door
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);
-	m_basicMeshes->DrawTorusMesh();
+	node.mesh = (MESH_TYPE)scene.meshes[i];
+	node.pass = (RENDER_PASS)scene.passes[i];
+	node.cullFace = (GLenum)scene.cullFaces[i];
+	node.scaleXYZ = scene.scales[i];
+	node.XrotationDegrees = scene.rotations[i].x;
+	node.YrotationDegrees = scene.rotations[i].y;
+	node.ZrotationDegrees = scene.rotations[i].z;
+	node.positionXYZ = scene.positions[i];
+	node.UVscale = scene.uvScales[i];
+	node.color = scene.colors[i];
+	node.bUseLighting = (scene.lighting[i] != 0);
+
+	node.materialIndex = -1;
+	int materialTag = scene.materialTags[i];
+	if ((materialTag >= 0) && (materialTag < scene.tagCount))
+	{
+		if (materialIndices[materialTag] == -2)
+		{
+			materialIndices[materialTag] = FindMaterialIndex(sceneFile.GetTag(materialTag));
+			if (materialIndices[materialTag] < 0)
+			{
+				std::cout << "Scene file uses unknown material:" << sceneFile.GetTag(materialTag) << std::endl;
+			}
+		}
+		node.materialIndex = materialIndices[materialTag];
+	}
 
-//** CABINET: DOOR HANDLE CONNECTORS **//
-//*************************************//
+	node.textureSlot = -1;
+	int textureTag = scene.textureTags[i];
+	if ((textureTag >= 0) && (textureTag < scene.tagCount))
+	{
+		if (textureSlots[textureTag] == -2)
+		{
+			textureSlots[textureTag] = FindTextureSlot(sceneFile.GetTag(textureTag));
+			if (textureSlots[textureTag] < 0)
+			{
+				std::cout << "Scene file uses unknown texture:" << sceneFile.GetTag(textureTag) << std::endl;
+			}
+		}
+		node.textureSlot = textureSlots[textureTag];
+	}
 
-	// ===== LEFT DOOR ===== //
+	return(true);
+}
 
-	//** Left Door - Vertical Connector (Top) **//
-	//******************************************//
+/***********************************************************
+ *  EnableHotReload()
+ *
+ *  This method is used for watching the files the scene is
+ *  built from - the scene file, the two shader files and
+ *  the image of every texture slot.  It is called once the
+ *  scene is prepared.
+ ***********************************************************/
+void SceneManager::EnableHotReload()
+{
+	if (m_pFileWatcher != NULL)
+	{
+		return;
+	}
 
-	scaleXYZ = glm::vec3(0.2f, 1.1f, 0.1f);              // Thin vertical bar above/below circle
-	positionXYZ = glm::vec3(-1.1f, 4.3f, -0.45f);        // Aligned vertically with circle
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);            // Solid black (reacts with light)
-	m_basicMeshes->DrawBoxMesh();
+	m_pFileWatcher = new FileWatcher();
+	m_pFileWatcher->Watch(m_sceneFilename, WATCH_SCENE_FILE);
+	m_pFileWatcher->Watch(VERTEX_SHADER_FILE, WATCH_SHADERS);
+	m_pFileWatcher->Watch(FRAGMENT_SHADER_FILE, WATCH_SHADERS);
+	for (int i = 0; i < m_loadedTextures; i++)
+	{
+		m_pFileWatcher->Watch(m_textureIDs[i].filename, WATCH_FIRST_TEXTURE + i);
+	}
+}
 
-	//** Left Door - Vertical Connector (Bottom) **//
-	//******************************************//
-
-	positionXYZ = glm::vec3(-1.1f, 2.4f, -0.45f);        // Aligned vertically with circle
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);            // Solid black (reacts with light)
-	m_basicMeshes->DrawBoxMesh();
+/***********************************************************
+ *  ReloadChangedFiles()
+ *
+ *  This method is used for reloading only what the changed
+ *  files feed, at the start of a frame: the shader programs
+ *  for a shader file, the one texture of an image, and the
+ *  changed nodes, lights and materials of the scene file.
+ *  The frame that follows is the first drawn with them.
+ ***********************************************************/
+void SceneManager::ReloadChangedFiles()
+{
+	if (m_pFileWatcher == NULL)
+	{
+		return;
+	}
 
-	//** Left Door - Horizontal Connector (Left) **//
-	//*********************************************//
+	std::vector<int> changedIDs;
+	m_pFileWatcher->Poll(changedIDs);
 
-	scaleXYZ = glm::vec3(0.4f, 0.2f, 0.1f);               // Thin horizontal bar left/right of circle
-	positionXYZ = glm::vec3(-1.75f, 3.35f, -0.45f);        // Same center point as vertical
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
+	for (int i = 0; i < changedIDs.size(); i++)
+	{
+		if (changedIDs[i] == WATCH_SCENE_FILE)
+		{
+			ReloadSceneFile();
+		}
+		else if (changedIDs[i] == WATCH_SHADERS)
+		{
+			ReloadShaders();
+		}
+		else
+		{
+			int slot = changedIDs[i] - WATCH_FIRST_TEXTURE;
+			if (std::find(m_pendingTextureReloads.begin(), m_pendingTextureReloads.end(), slot) == m_pendingTextureReloads.end())
+			{
+				m_pendingTextureReloads.push_back(slot);
+			}
+		}
+	}
 
-	//** Left Door - Horizontal Connector (Right) **//
-	//*********************************************//
+	// the loader only takes new images once the last ones are in
+	if ((m_pendingTextureReloads.size() > 0) && (m_pTextureLoader->IsBusy() == false))
+	{
+		ReloadTextures(m_pendingTextureReloads);
+		m_pendingTextureReloads.clear();
+	}
+}
 
-	positionXYZ = glm::vec3(-0.45f, 3.35f, -0.45f);        // Same center point as vertical
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
+/***********************************************************
+ *  ReloadShaders()
+ *
+ *  This method is used for building every loaded shader
+ *  program again after a shader file changed.  A program
+ *  that fails to build keeps running the last version that
+ *  worked, so a typo only costs its compile log.  The per
+ *  draw uniform locations of the new programs are looked
+ *  up again.  Only the shader permutations built so far
+ *  are rebuilt - the rest are built from the new files
+ *  when first asked for.
+ ***********************************************************/
+void SceneManager::ReloadShaders()
+{
+	bool bLoaded = m_pSceneShaders->Reload();
 
+	if (m_bIndirectDraw == true)
+	{
+		bLoaded = (m_pIndirectShaders->Reload() && bLoaded);
+	}
 
-	// ===== RIGHT DOOR ===== //
+	if (m_bDeferredAvailable == true)
+	{
+		bLoaded = (m_pGBufferShaders->Reload() && bLoaded);
+		bLoaded = (m_pDeferredLightingProgram->Reload() && bLoaded);
 
-	//** Right Door - Vertical Connector (Top) **//
-	//******************************************//
+		ShaderUniforms lightingUniforms;
+		lightingUniforms.ResolveLocations(m_pDeferredLightingProgram->GetProgramID());
+		GBuffer::SetSamplerUnits(m_pDeferredLightingProgram->GetProgramID(), m_gBufferTextureUnit);
+		ShadowMaps::SetSamplerUnits(m_pDeferredLightingProgram->GetProgramID(), m_shadowTextureUnit);
+	}
 
-	scaleXYZ = glm::vec3(0.2f, 1.1f, 0.1f);              // Thin vertical bar above/below circle
-	positionXYZ = glm::vec3(1.1f, 4.3f, -0.45f);        // Aligned vertically with circle
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);            // Solid black (reacts with light)
-	m_basicMeshes->DrawBoxMesh();
-
-	//** Right Door - Vertical Connector (Bottom) **//
-	//******************************************//
-
-	positionXYZ = glm::vec3(1.1f, 2.4f, -0.45f);        // Aligned vertically with circle
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);            // Solid black (reacts with light)
-	m_basicMeshes->DrawBoxMesh();
-
-	//** Right Door - Horizontal Connector (Right) **//
-	//*********************************************//
-
-	scaleXYZ = glm::vec3(0.4f, 0.2f, 0.1f);               // Thin horizontal bar left/right of circle
-	positionXYZ = glm::vec3(1.75f, 3.35f, -0.45f);        // Same center point as vertical
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
-
-	//** Right Door - Horizontal Connector (Left) **//
-	//*********************************************//
-
-	positionXYZ = glm::vec3(0.45f, 3.35f, -0.45f);        // Same center point as vertical
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.05f, 0.05f, 0.05f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
+	if (m_bWeightedAvailable == true)
+	{
+		bLoaded = (m_pWeightedShaders->Reload() && bLoaded);
+		bLoaded = (m_pWeightedCompositeProgram->Reload() && bLoaded);
+		TransparencyBuffers::SetSamplerUnits(m_pWeightedCompositeProgram->GetProgramID(), m_gBufferTextureUnit);
+	}
 
-//** Left Door - Handle Base Plate (Stacked Pyramids)**//
-//****************************************************//
+	if (m_bLinkedListAvailable == true)
+	{
+		bLoaded = (m_pLinkedListShaders->Reload() && bLoaded);
+		bLoaded = (m_pLinkedListResolveProgram->Reload() && bLoaded);
+	}
 
-	//** Upper Pyramid (Flipped) **//
-	//*****************************//
-
-	scaleXYZ = glm::vec3(0.15f, 0.15f, 0.15f);              // Same size
-	positionXYZ = glm::vec3(-0.125f, 3.30f, -0.435f);         // Slightly above the lower pyramid
-	SetTransformations(scaleXYZ, 20.0f, 0.0f, 180.0f, positionXYZ);  // Flipped upside-down
-	SetShaderColor(0.85f, 0.65f, 0.2f, 1.0f);               // Same gold tone
-	m_basicMeshes->DrawPyramid3Mesh();
-
-	//** Lower Pyramid **//
-	//*******************//
-
-	scaleXYZ = glm::vec3(0.15f, 0.15f, 0.15f);             // Same size as upper
-	positionXYZ = glm::vec3(-0.125f, 3.35f, -0.435f);        // Bottom half of base plate
-	SetTransformations(scaleXYZ, 20.0f, 0.0f, 0.0f, positionXYZ);    // Regular orientation
-	SetShaderColor(0.85f, 0.65f, 0.2f, 1.0f);
-	m_basicMeshes->DrawPyramid3Mesh();
+	if (m_bDepthPrePassAvailable == true)
+	{
+		bLoaded = (m_pDepthProgram->Reload() && bLoaded);
+		ShaderUniforms depthUniforms;
+		depthUniforms.ResolveLocations(m_pDepthProgram->GetProgramID());
+		if (m_bIndirectDraw == true)
+		{
+			bLoaded = (m_pIndirectDepthProgram->Reload() && bLoaded);
+			m_pIndirectDepthUniforms->ResolveLocations(m_pIndirectDepthProgram->GetProgramID());
+		}
+	}
 
-//** Right Door - Handle Base Plate (Stacked Pyramids)**//
-//****************************************************//
+	if (m_pResolutionScaler != NULL)
+	{
+		bLoaded = (m_pResolutionScaler->Reload() && bLoaded);
+	}
 
-	//** Upper Pyramid (Flipped) - RIGHT **//
-	//*************************************//
+	// the rebuilt default permutation has a new program
+	UseDefaultSceneProgram();
 
-	scaleXYZ = glm::vec3(0.15f, 0.15f, 0.15f);              // Same size
-	positionXYZ = glm::vec3(0.125f, 3.30f, -0.435f);        // Mirrored X from left side
-	SetTransformations(scaleXYZ, 20.0f, 0.0f, 180.0f, positionXYZ);  // Flipped upside-down
-	SetShaderColor(0.85f, 0.65f, 0.2f, 1.0f);               // Same gold tone
-	m_basicMeshes->DrawPyramid3Mesh();
-
-	//** Lower Pyramid - RIGHT **//
-	//***************************//
+	if (bLoaded == true)
+	{
+		std::cout << "Reloaded the scene shaders" << std::endl;
+	}
+	else
+	{
+		std::cout << "Some scene shaders failed to build, their last working version is kept" << std::endl;
+	}
+}
 
-	scaleXYZ = glm::vec3(0.15f, 0.15f, 0.15f);              // Same size
-	positionXYZ = glm::vec3(0.125f, 3.35f, -0.435f);        // Mirrored X, slightly higher Y
-	SetTransformations(scaleXYZ, 20.0f, 0.0f, 0.0f, positionXYZ);    // Regular orientation
-	SetShaderColor(0.85f, 0.65f, 0.2f, 1.0f);
-	m_basicMeshes->DrawPyramid3Mesh();
-
-//** Gold Spheres Ornate - LEFT Base Plate **//
-//**********************************************//
+/***********************************************************
+ *  ReloadTextures()
+ *
+ *  This method is used for decoding the images of texture
+ *  slots again after their files changed.  Each slot keeps
+ *  drawing its current texture until the new one has been
+ *  uploaded by UpdateTextureUploads().
+ ***********************************************************/
+void SceneManager::ReloadTextures(const std::vector<int>& slots)
+{
+	for (int i = 0; i < slots.size(); i++)
+	{
+		int slot = slots[i];
+		if ((slot >= 0) && (slot < m_loadedTextures))
+		{
+			std::cout << "Reloading texture:" << m_textureIDs[slot].filename << std::endl;
+			m_pTextureLoader->Request(m_textureIDs[slot].filename.c_str(), slot);
+		}
+	}
 
-	scaleXYZ = glm::vec3(0.02f, 0.02f, 0.02f);             // Small sphere size
-	SetShaderColor(0.85f, 0.65f, 0.2f, 1.0f);               // Same gold tone
-
-	// Top-Left
-	positionXYZ = glm::vec3(-0.185f, 3.39f, -0.40f);
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	m_basicMeshes->DrawSphereMesh();
+	m_pTextureLoader->Start(m_bCompressedTextures);
+}
 
-	// Top-Right
-	positionXYZ = glm::vec3(-0.06f, 3.39f, -0.40f);
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	m_basicMeshes->DrawSphereMesh();
+/***********************************************************
+ *  RenderScene()
+ *
+ *  This method is used for rendering the 3D scene by 
+ *  submitting the retained scene nodes in render queue
+ *  order.  With deferred shading only the opaque pass is
+ *  drawn through the G-buffer - the glass and the glow
+ *  still blend over it with forward shading.  With order
+ *  independent transparency the glass is collected in any
+ *  order and blended over the frame once, before the glow.
+ ***********************************************************/
+void SceneManager::RenderScene()
+{	
+	ProfileScope("scene update");
 
-	// Bottom-Left
-	positionXYZ = glm::vec3(-0.19f, 3.26f, -0.40f);
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	m_basicMeshes->DrawSphereMesh();
+	// swap in whatever changed on disk before anything is drawn
+	ReloadChangedFiles();
 
-	// Bottom-Right
-	positionXYZ = glm::vec3(-0.06f, 3.26f, -0.40f);
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	m_basicMeshes->DrawSphereMesh();
-
-//** Gold Spheres Ornate - RIGHT Base Plate **//
-//***********************************************//
-
-	scaleXYZ = glm::vec3(0.02f, 0.02f, 0.02f);             // Small sphere size
-	SetShaderColor(0.85f, 0.65f, 0.2f, 1.0f);               // Same gold tone
-
-	// Top-Left
-	positionXYZ = glm::vec3(0.06f, 3.39f, -0.40f);          // Upper left corner of base plate
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	m_basicMeshes->DrawSphereMesh();
-
-	// Top-Right
-	positionXYZ = glm::vec3(0.185f, 3.39f, -0.40f);         // Upper right corner of base plate
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	m_basicMeshes->DrawSphereMesh();
-
-	// Bottom-Left
-	positionXYZ = glm::vec3(0.06f, 3.26f, -0.40f);          // Lower left corner of base plate
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	m_basicMeshes->DrawSphereMesh();
-
-	// Bottom-Right
-	positionXYZ = glm::vec3(0.185f, 3.26f, -0.40f);         // Lower right corner of base plate
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	m_basicMeshes->DrawSphereMesh();
-
-//** CABINET HANDLE: LEFT CLASP ARMS **//
-//****************************************//
-
-// Left Arm  Cylinder + Cap (Left of base) //
-//******************************************//
-
-	//** Arm Cylinder (Left Side) **//
-	//******************************//
-
-	scaleXYZ = glm::vec3(0.005f, 0.03f, 0.005f);            // Short, thin protrusion
-	positionXYZ = glm::vec3(-0.13f, 3.33f, -0.39f);          // Left side of base plate
-	SetTransformations(scaleXYZ, 90.0f, 0.0f, 0.0f, positionXYZ);  // Point outward
-	SetShaderColor(0.85f, 0.65f, 0.2f, 1.0f);                // Gold material
-	m_basicMeshes->DrawCylinderMesh();
-
-	//** Left Torus End Cap (Left Side) **//
-	//************************************//
-
-	scaleXYZ = glm::vec3(0.005f, 0.005f, 0.005f);            // Ring size and thickness
-	positionXYZ = glm::vec3(-0.13f, 3.33f, -0.36f);          // Positioned at cylinder tip
-	SetTransformations(scaleXYZ, 180.0f, 90.0f, 0.0f, positionXYZ);  // Face forward
-	SetShaderColor(0.85f, 0.65f, 0.2f, 1.0f);                // Gold material
-	m_basicMeshes->DrawTorusMesh();
-
-	//** Inner Sphere Connector (Left Side) **//
-	//****************************************//
-
-	scaleXYZ = glm::vec3(0.0055f, 0.0055f, 0.0055f);         // Fills torus center
-	positionXYZ = glm::vec3(-0.13f, 3.33f, -0.36f);          // Same as torus
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);  // No rotation
-	SetShaderColor(0.85f, 0.65f, 0.2f, 1.0f);                // Gold material
-	m_basicMeshes->DrawSphereMesh();
-
-
-	// Right Arm  Cylinder + Cap (Right of base) //
-	//********************************************//
-
-		//** Arm Cylinder (Right Side) **//
-		//*******************************//
-
-	scaleXYZ = glm::vec3(0.005f, 0.03f, 0.005f);             // Short, thin protrusion
-	positionXYZ = glm::vec3(-0.12f, 3.33f, -0.39f);          // Right side of base plate
-	SetTransformations(scaleXYZ, 90.0f, 0.0f, 0.0f, positionXYZ);  // Point outward
-	SetShaderColor(0.85f, 0.65f, 0.2f, 1.0f);                // Gold material
-	m_basicMeshes->DrawCylinderMesh();
-
-	//** Right Torus End Cap (Right Side) **//
-	//**************************************//
-
-	scaleXYZ = glm::vec3(0.005f, 0.005f, 0.005f);            // Ring size and thickness
-	positionXYZ = glm::vec3(-0.12f, 3.33f, -0.36f);          // Positioned at cylinder tip
-	SetTransformations(scaleXYZ, 180.0f, 90.0f, 0.0f, positionXYZ);  // Face forward
-	SetShaderColor(0.85f, 0.65f, 0.2f, 1.0f);                // Gold material
-	m_basicMeshes->DrawTorusMesh();
-
-	//** Inner Sphere Connector (Right Side) **//
-	//*****************************************//
-
-	scaleXYZ = glm::vec3(0.0055f, 0.0055f, 0.0055f);         // Fills torus center
-	positionXYZ = glm::vec3(-0.12f, 3.33f, -0.36f);          // Same as torus
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);  // No rotation
-	SetShaderColor(0.85f, 0.65f, 0.2f, 1.0f);                // Gold material
-	m_basicMeshes->DrawSphereMesh();
-
-	//** Hanging Torus Between Clasps **//
-	//**********************************//
-
-	scaleXYZ = glm::vec3(0.0060f, 0.0060f, 0.0060f);       // Slightly larger than side rings
-	positionXYZ = glm::vec3(-0.125f, 3.328f, -0.36f);      // Centered between arms, slightly lower and forward
-	SetTransformations(scaleXYZ, 180.0f, 90.0f, 0.0f, positionXYZ);  // Rotated to face outward
-	SetShaderColor(0.85f, 0.65f, 0.2f, 1.0f);              // Same gold tone
-	m_basicMeshes->DrawTorusMesh();
+	// rebuild the model matrix of any node that was moved
+	UpdateSceneNodes();
 
-	//** Hanging Handle  Flattened Tapered Cylinder **//
-	//*************************************************//
-
-	scaleXYZ = glm::vec3(0.02f, 0.11f, 0.000001f);         // Tall and flat with nearly invisible depth
-	positionXYZ = glm::vec3(-0.125f, 3.215f, -0.36f);     // Aligned just below torus loop
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);  // No rotation, hangs straight down
-	SetShaderColor(0.85f, 0.65f, 0.2f, 1.0f);             // Consistent gold finish
-	m_basicMeshes->DrawTaperedCylinderMesh();            // Flat tapered shape completes pendant look
-
-// Bottom Handle Cap  Cylinder + End Spheres //
-//********************************************//
+	// only touch the light block when a light has changed
+	if (m_bLightsDirty == true)
+	{
+		UploadLights();
+	}
 
-	//** Bottom Bar (Horizontal Cylinder) **//
-	//**************************************//
-
-	scaleXYZ = glm::vec3(0.004f, 0.025f, 0.004f);         // Thin and short, stretching across the base
-	positionXYZ = glm::vec3(-0.112f, 3.22f, -0.356f);      // Just below the handles lower tip
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 90.0f, positionXYZ);  // Rotate horizontally across X
-	SetShaderColor(0.85f, 0.65f, 0.2f, 1.0f);              // Same gold tone
-	m_basicMeshes->DrawCylinderMesh();
+	// the camera moves every frame, so the lights are re-clustered
+	if (m_bClusteredLighting == true)
+	{
+		m_pLightClusters->Build(m_lightSpheres, m_viewMatrix);
+		m_pLightClusters->Bind();
+	}
 
-	//** Left End Cap (Sphere) **//
-	//***************************//
+	// swap in the scene textures as they finish decoding
+	if (m_pTextureLoader->IsBusy() == true)
+	{
+		UpdateTextureUploads();
+	}
 
-	scaleXYZ = glm::vec3(0.0045f, 0.0045f, 0.0045f);          // Small ball at end of the bar
-	positionXYZ = glm::vec3(-0.138f, 3.22f, -0.356f);      // Left tip of the bar
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);  // No rotation needed
-	SetShaderColor(0.85f, 0.65f, 0.2f, 1.0f);              // Match handle tone
-	m_basicMeshes->DrawSphereMesh();
+	// the shadow maps are kept until a node or a light changes
+	if (m_bShadowsAvailable == true)
+	{
+		if (m_bShadowsDirty == true)
+		{
+			ProfileScope("shadow maps");
+			UpdateShadowMaps();
+		}
+		m_pShadowMaps->BindTextures(m_shadowTextureUnit);
+	}
 
-	//** Right End Cap (Sphere) **//
-	//****************************//
+	// set the render state for the opaque pass - the cache
+	// leaves out whatever the last frame already left set
+	SetRenderPass(PASS_OPAQUE);
+	RenderState::SetCullFace(GL_NONE);    // default: no culling for floor/wall; enable later as needed
+
+	// leave out the nodes outside the view, pick the detail of
+	// the rest, and sort them by render state, glass back to front
+	ProfileScope("cull and sort");
+	CullSceneNodes();
+	SelectNodeLods();
+	BuildRenderQueue();
+
+	// the opaque pass comes from the persistent indirect command
+	// buffer, which is only refilled when a scene node changes
+	// or a node moves into another depth bucket
+	ProfileScope(g_PassScopeNames[PASS_OPAQUE]);
+	if (m_bIndirectDraw == true)
+	{
+		if ((m_bSceneChanged == true) || (IsIndirectOrderCurrent() == false))
+		{
+			BuildIndirectCommands();
+			m_bSceneChanged = false;
+		}
+		if (m_bDeferredShading == true)
+		{
+			DrawDeferredOpaquePass();
+		}
+		else
+		{
+			DrawDepthPrePass();
+			DrawIndirectBatches(m_pIndirectShaders);
+		}
+	}
+	else
+	{
+		// the instanced opaque draws below test against it
+		DrawDepthPrePass();
+	}
 
-	scaleXYZ = glm::vec3(0.0045f, 0.0045f, 0.0045f);          // Same size as left
-	positionXYZ = glm::vec3(-0.114f, 3.22f, -0.356f);      // Right tip of the bar
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);  // No rotation needed
-	SetShaderColor(0.85f, 0.65f, 0.2f, 1.0f);              // Gold tone
-	m_basicMeshes->DrawSphereMesh();
-
-//** CABINET HANDLE: RIGHT CLASP ARMS **//
-//****************************************//
+	RENDER_PASS currentPass = PASS_OPAQUE;
 
-// Right Arm  Cylinder + Cap (Right of base) //
-//********************************************//
+	// neighbouring queue items that share their draw state are
+	// collected into one instanced draw call - every pass before
+	// this leaves the default permutation in use
+	const SCENE_NODE* pBatchNode = NULL;
+	m_instanceData.clear();
+	m_batchProgramID = m_programID;
 
-	//** Arm Cylinder (Right Side) **//
-	//*******************************//
+	const std::vector<RenderQueue::RENDER_ITEM>& items = m_renderQueue.GetItems();
+	for (int i = 0; i < items.size(); i++)
+	{
+		const SCENE_NODE& node = m_sceneNodes[items[i].nodeIndex];
 
-	scaleXYZ = glm::vec3(0.005f, 0.03f, 0.005f);             // Short, thin protrusion
-	positionXYZ = glm::vec3(0.13f, 3.33f, -0.39f);           // Right side of base plate
-	SetTransformations(scaleXYZ, 90.0f, 0.0f, 0.0f, positionXYZ);  // Point outward
-	SetShaderColor(0.85f, 0.65f, 0.2f, 1.0f);                 // Gold material
-	m_basicMeshes->DrawCylinderMesh();
+		// already drawn by the indirect batches
+		if ((m_bIndirectDraw == true) && (node.pass == PASS_OPAQUE))
+		{
+			continue;
+		}
 
-	//** Right Torus End Cap (Right Side) **//
-	//**************************************//
+		if ((pBatchNode != NULL) && (CanBatchNodes(*pBatchNode, node) == false))
+		{
+			DrawNodeBatch(*pBatchNode);
+			pBatchNode = NULL;
+		}
 
-	scaleXYZ = glm::vec3(0.005f, 0.005f, 0.005f);            // Ring size and thickness
-	positionXYZ = glm::vec3(0.13f, 3.33f, -0.36f);           // Positioned at cylinder tip
-	SetTransformations(scaleXYZ, 180.0f, 90.0f, 0.0f, positionXYZ);  // Face forward
-	SetShaderColor(0.85f, 0.65f, 0.2f, 1.0f);                // Gold material
-	m_basicMeshes->DrawTorusMesh();
-
-	//** Inner Sphere Connector (Right Side) **//
-	//*****************************************//
+		if (pBatchNode == NULL)
+		{
+			// the queue is sorted by pass, so the pass state only
+			// changes a couple of times per frame
+			if (node.pass != currentPass)
+			{
+				EndRenderPass(currentPass);
+				SetRenderPass(node.pass);
+				currentPass = node.pass;
+				ProfileScope(g_PassScopeNames[node.pass]);
+			}
+
+			RenderState::SetCullFace(node.cullFace);
+			pBatchNode = &node;
+		}
 
-	scaleXYZ = glm::vec3(0.0055f, 0.0055f, 0.0055f);         // Fills torus center
-	positionXYZ = glm::vec3(0.13f, 3.33f, -0.36f);           // Same as torus
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);  // No rotation
-	SetShaderColor(0.85f, 0.65f, 0.2f, 1.0f);                // Gold material
-	m_basicMeshes->DrawSphereMesh();
-
-
-// Left Arm  Cylinder + Cap (Left of base) //
-//******************************************//
-
-	//** Arm Cylinder (Left Side) **//
-	//******************************//
-
-	scaleXYZ = glm::vec3(0.005f, 0.03f, 0.005f);             // Short, thin protrusion
-	positionXYZ = glm::vec3(0.12f, 3.33f, -0.39f);           // Left side of base plate
-	SetTransformations(scaleXYZ, 90.0f, 0.0f, 0.0f, positionXYZ);  // Point outward
-	SetShaderColor(0.85f, 0.65f, 0.2f, 1.0f);                // Gold material
-	m_basicMeshes->DrawCylinderMesh();
-
-	//** Left Torus End Cap (Left Side) **//
-	//************************************//
-
-	scaleXYZ = glm::vec3(0.005f, 0.005f, 0.005f);            // Ring size and thickness
-	positionXYZ = glm::vec3(0.12f, 3.33f, -0.36f);           // Positioned at cylinder tip
-	SetTransformations(scaleXYZ, 180.0f, 90.0f, 0.0f, positionXYZ);  // Face forward
-	SetShaderColor(0.85f, 0.65f, 0.2f, 1.0f);                // Gold material
-	m_basicMeshes->DrawTorusMesh();
-
-	//** Inner Sphere Connector (Left Side) **//
-	//****************************************//
-
-	scaleXYZ = glm::vec3(0.0055f, 0.0055f, 0.0055f);         // Fills torus center
-	positionXYZ = glm::vec3(0.12f, 3.33f, -0.36f);           // Same as torus
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);  // No rotation
-	SetShaderColor(0.85f, 0.65f, 0.2f, 1.0f);                // Gold material
-	m_basicMeshes->DrawSphereMesh();
-
-	//** Hanging Torus Between Clasps **//
-	//**********************************//
-
-	scaleXYZ = glm::vec3(0.0060f, 0.0060f, 0.0060f);         // Slightly larger than side rings
-	positionXYZ = glm::vec3(0.125f, 3.328f, -0.36f);         // Centered between arms, slightly lower and forward
-	SetTransformations(scaleXYZ, 180.0f, 90.0f, 0.0f, positionXYZ);  // Rotated to face outward
-	SetShaderColor(0.85f, 0.65f, 0.2f, 1.0f);                // Same gold tone
-	m_basicMeshes->DrawTorusMesh();
-
-	//** Hanging Handle  Flattened Tapered Cylinder **//
-	//*************************************************//
-
-	scaleXYZ = glm::vec3(0.02f, 0.11f, 0.000001f);           // Tall and flat with nearly invisible depth
-	positionXYZ = glm::vec3(0.125f, 3.215f, -0.36f);         // Aligned just below torus loop
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);  // No rotation, hangs straight down
-	SetShaderColor(0.85f, 0.65f, 0.2f, 1.0f);                // Consistent gold finish
-	m_basicMeshes->DrawTaperedCylinderMesh();               // Flat tapered shape completes pendant look
-
-// Bottom Handle Cap  Cylinder + End Spheres //
-//********************************************//
-
-	//** Bottom Bar (Horizontal Cylinder) **//
-	//**************************************//
-
-	scaleXYZ = glm::vec3(0.004f, 0.025f, 0.004f);            // Thin and short, stretching across the base
-	positionXYZ = glm::vec3(0.14f, 3.22f, -0.356f);         // Just below the handles lower tip
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 90.0f, positionXYZ);  // Rotate horizontally across X
-	SetShaderColor(0.85f, 0.65f, 0.2f, 1.0f);                // Same gold tone
-	m_basicMeshes->DrawCylinderMesh();
-
-	//** Left End Cap (Sphere) **//
-	//***************************//
-
-	scaleXYZ = glm::vec3(0.0045f, 0.0045f, 0.0045f);         // Small ball at end of the bar
-	positionXYZ = glm::vec3(0.138f, 3.22f, -0.356f);         // Left tip of the bar
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);  // No rotation needed
-	SetShaderColor(0.85f, 0.65f, 0.2f, 1.0f);                // Match handle tone
-	m_basicMeshes->DrawSphereMesh();
-
-	//** Right End Cap (Sphere) **//
-	//****************************//
-
-	scaleXYZ = glm::vec3(0.0045f, 0.0045f, 0.0045f);         // Same size as left
-	positionXYZ = glm::vec3(0.114f, 3.22f, -0.356f);         // Right tip of the bar
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);  // No rotation needed
-	SetShaderColor(0.85f, 0.65f, 0.2f, 1.0f);                // Gold tone
-	m_basicMeshes->DrawSphereMesh();
-
-//** Decorative Box **//
-//********************//
-
-	//** BOX BASE (Chevron Sides) **//
-	//******************************//
-
-	scaleXYZ = glm::vec3(3.6f, 1.3f, 3.0f);                // Slightly smaller than cabinet top, centered
-	positionXYZ = glm::vec3(0.0f, 6.45f, -3.5f);           // Sits directly above the mirror panel (cabinet top)
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderMaterial("chevronMat");                      // Stitched fur with soft lighting
-	SetShaderTexture("ChevronFur");                       // Chevron pattern fur texture
-	SetTextureUVScale(2.0f, 1.0f);                         // Double tiling scaling
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//** BOX LID (Flat Fur Top) **//
-	//****************************//
-
-	scaleXYZ = glm::vec3(3.6f, 0.3f, 3.0f);                // Thin lid layer to sit on top of box base
-	positionXYZ = glm::vec3(0.0f, 7.25f, -3.5f);            // Slightly above the box base 
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderMaterial("boxFurMat");                        // Solid fur material with soft sheen
-	SetShaderTexture("BoxFur");                            // Matching grey fur texture
-	SetTextureUVScale(1.0f, 1.0f);                          // Standard texture scale
-	m_basicMeshes->DrawBoxMesh();
-
-//** LAMP BASE **//
-//***************//
-
- //** Cylinder 1: Base layer **//
-//****************************//
-	scaleXYZ = glm::vec3(1.15f, 0.1f, 1.15f);       // Wide and flat for a strong base
-	positionXYZ = glm::vec3(0.0f,7.35f, -3.5f);    // Slightly lifted above the floor
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);  // No rotation
-
-	SetShaderMaterial("copper");          // copper material (lighting)
-	SetShaderTexture("Copper");           // copper texture
-	SetTextureUVScale(1.6f, 1.6f);        // UV scale
-	m_pShaderManager->setVec4Value(g_ColorValueName, glm::vec4(1.0f, 1.0f, 1.0f, 1.0f)); // neutral tint (preserve texture color)
-	m_basicMeshes->DrawCylinderMesh();
-
-
-	//** Cylinder 2: Main platform **//
-	//*******************************//
-	scaleXYZ = glm::vec3(1.1f, 0.3f, 1.1f);
-	positionXYZ = glm::vec3(0.0f, 7.41f, -3.5f);
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-
-	SetShaderMaterial("copper");          // copper material (lighting)
-	// Keep texture visible but avoid looking identical to Cylinder 1
-	SetShaderTexture("Copper");
-	SetTextureUVScale(1.4f, 1.4f);                 // slight variation reduces pattern repetition banding
-	m_pShaderManager->setVec4Value(g_ColorValueName, glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
-	m_basicMeshes->DrawCylinderMesh();
-
-
-	//** Cylinder 3: Upper platform **//
-	//*********************************//
-	scaleXYZ = glm::vec3(0.9f, 0.1f, 0.9f);
-	positionXYZ = glm::vec3(0.0f, 7.71f, -3.5f);
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-
-	SetShaderMaterial("copper");          // copper material (lighting)
-	// Slightly tighter to keep the top ring crisp
-	SetShaderTexture("Copper");
-	SetTextureUVScale(1.7f, 1.7f);                 // a touch tighter for a crisp edge read
-	m_pShaderManager->setVec4Value(g_ColorValueName, glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
-	m_basicMeshes->DrawCylinderMesh();
-
-
-	//** Pipe base **//
-	//***************//
-	scaleXYZ = glm::vec3(0.625f, 0.1f, 0.625f);
-	positionXYZ = glm::vec3(0.0f, 7.80f, -3.5f);
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-
-	SetShaderMaterial("copper");          // copper material (lighting)
-	// Pipes look better with tighter brush detail
-	SetShaderTexture("Copper");
-	SetTextureUVScale(1.8f, 1.8f);                 // tighter grain helps smaller parts read as metal
-	m_pShaderManager->setVec4Value(g_ColorValueName, glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
-	m_basicMeshes->DrawCylinderMesh();
-
-
-	//** Torus connector (bottom) **//
-	//******************************//
-	scaleXYZ = glm::vec3(0.55f, 0.55f, 0.55f);
-	positionXYZ = glm::vec3(0.0f, 7.94f, -3.5f);
-	SetTransformations(scaleXYZ, 90.0f, 0.0f, 0.0f, positionXYZ);  // ring alignment
-
-	SetShaderMaterial("copper");          // copper material (lighting)
-	// Slightly different UV to break repetition on circular forms
-	SetShaderTexture("Copper");
-	SetTextureUVScale(1.5f, 1.5f);                 // keeps the ring from showing obvious repeats
-	m_pShaderManager->setVec4Value(g_ColorValueName, glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
-	m_basicMeshes->DrawTorusMesh();
-
-
-	//** Segment 2: Thin ring **//
-	//**************************//
-	scaleXYZ = glm::vec3(0.56f, 0.05f, 0.56f);
-	positionXYZ = glm::vec3(0.0f, 8.05f, -3.5f);
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-
-	SetShaderMaterial("copper");          // copper material (lighting)
-	// Thin parts get a tighter UV so the texture doesnt blur
-	SetShaderTexture("Copper");
-	SetTextureUVScale(2.0f, 2.0f);                 // higher = finer detail, avoids muddy look on thin rings
-	m_pShaderManager->setVec4Value(g_ColorValueName, glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
-	m_basicMeshes->DrawCylinderMesh();
-
-
-	//** Segment 3: Narrow section **//
-	//*******************************//
-	scaleXYZ = glm::vec3(0.4f, 0.20f, 0.4f);
-	positionXYZ = glm::vec3(0.0f, 8.10f, -3.5f);
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-
-	SetShaderMaterial("copper");          // copper material (lighting)
-	// Keep the pipe crisp
-	SetShaderTexture("Copper");
-	SetTextureUVScale(1.9f, 1.9f);
-	m_pShaderManager->setVec4Value(g_ColorValueName, glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
-	m_basicMeshes->DrawCylinderMesh();
-
-
-	//** Segment 4: Mid-section bulge **//
-	//**********************************//
-	scaleXYZ = glm::vec3(0.50f, 0.20f, 0.50f);
-	positionXYZ = glm::vec3(0.0f, 8.30f, -3.5f);
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-
-	SetShaderMaterial("copper");          // copper material (lighting)
-	// Slight variation keeps the eye from spotting repeats
-	SetShaderTexture("Copper");
-	SetTextureUVScale(1.6f, 1.6f);
-	m_pShaderManager->setVec4Value(g_ColorValueName, glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
-	m_basicMeshes->DrawCylinderMesh();
-
-
-	//** Torus connector (mid) **//
-	//***************************//
-	scaleXYZ = glm::vec3(0.35f, 0.35f, 0.35f);
-	positionXYZ = glm::vec3(0.0f, 8.55f, -3.5f);
-	SetTransformations(scaleXYZ, 90.0f, 0.0f, 0.0f, positionXYZ);
-
-	SetShaderMaterial("copper");          // copper material (lighting)
-	// Match lower ring but not identical
-	SetShaderTexture("Copper");
-	SetTextureUVScale(1.7f, 1.7f);
-	m_pShaderManager->setVec4Value(g_ColorValueName, glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
-	m_basicMeshes->DrawTorusMesh();
-
-
-	//** Segment 6: Main section **//
-	//*****************************//
-	scaleXYZ = glm::vec3(0.6f, 0.20f, 0.6f);
-	positionXYZ = glm::vec3(0.0f, 8.60f, -3.5f);
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-
-	SetShaderMaterial("copper");          // copper material (lighting)
-	// Keep the mid body consistent with earlier pipes
-	SetShaderTexture("Copper");
-	SetTextureUVScale(1.8f, 1.8f);
-	m_pShaderManager->setVec4Value(g_ColorValueName, glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
-	m_basicMeshes->DrawCylinderMesh();
-
-
-	//** Segment 7: Slender neck **//
-	//*****************************//
-	scaleXYZ = glm::vec3(0.40f, 0.20f, 0.40f);
-	positionXYZ = glm::vec3(0.0f, 8.8f, -3.5f);
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);  // Upright with no rotation
-
-	SetShaderMaterial("copper");          // copper material (lighting)
-	// Tightest grain on the thinnest piece to avoid blur
-	SetShaderTexture("Copper");
-	SetTextureUVScale(2.2f, 2.2f);                 // thinnest piece -> tightest UV for clarity
-	m_pShaderManager->setVec4Value(g_ColorValueName, glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
-	m_basicMeshes->DrawCylinderMesh();
-
-
-	//** Segment 8: Tall connector pipe **//
-	//************************************//
-	scaleXYZ = glm::vec3(0.12f, 0.45f, 0.12f);     // Long and skinny to create height
-	positionXYZ = glm::vec3(0.0f, 8.9f, -3.5f);     // Extends from the neck vertically
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.0f, 0.0f, 0.0f, 1.0f);        // Solid black for a plastic-like finish
-	SetShaderMaterial("plasticBlack");    // plastic material (lighting)
-	m_basicMeshes->DrawCylinderMesh();
-
-	//** Torus band (plastic connector) **//
-	//************************************//
-	scaleXYZ = glm::vec3(0.15f, 0.15f, 0.15f);     // Small and flush to wrap around pipe
-	positionXYZ = glm::vec3(0.0f, 9.35f, -3.5f);    // Sits at the top of the tall pipe
-	SetTransformations(scaleXYZ, 90.0f, 0.0f, 0.0f, positionXYZ);  // Rotated for horizontal alignment
-	SetShaderColor(0.0f, 0.0f, 0.0f, 1.0f);        // Matches the plastic connector pipe
-	SetShaderMaterial("plasticBlack");    // plastic material (lighting)
-	m_basicMeshes->DrawTorusMesh();
-
-	//** Segment 9: Plastic connector pipe **//
-	//***************************************//
-	scaleXYZ = glm::vec3(0.18f, 0.2f, 0.18f);      // Slightly thicker than the previous pipe
-	positionXYZ = glm::vec3(0.0f, 9.35f, -3.5f);    // Overlaps the torus directly
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.0f, 0.0f, 0.0f, 1.0f);        // Black to keep it consistent with other segments
-	SetShaderMaterial("plasticBlack");    // plastic material (lighting)
-	m_basicMeshes->DrawCylinderMesh();
-
-	//** Segment 10: Short cap segment **//
-	//***********************************//
-	scaleXYZ = glm::vec3(0.22f, 0.1f, 0.22f);      // Wider but shallow to act as a top cap
-	positionXYZ = glm::vec3(0.0f, 9.50f, -3.5f);     // Stacked above segment 9
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.0f, 0.0f, 0.0f, 1.0f);        // Black again for plastic cohesion
-	SetShaderMaterial("plasticBlack");    // plastic material (lighting)
-	m_basicMeshes->DrawCylinderMesh();
-
-	//** Segment 11: Top plastic piece **//
-	//***********************************//
-	scaleXYZ = glm::vec3(0.15f, 0.2f, 0.15f);      // Narrower and taller than the cap
-	positionXYZ = glm::vec3(0.0f, 9.60f, -3.5f);     // Sits directly on Segment 10
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.0f, 0.0f, 0.0f, 1.0f);        // Consistent black plastic color
-	SetShaderMaterial("plasticBlack");    // plastic material (lighting)
-	m_basicMeshes->DrawCylinderMesh();
-
-	//** Bulb neck: transition to glass **//
-	//************************************//
-	scaleXYZ = glm::vec3(0.08f, 0.06f, 0.08f);     // Small and subtle for transition
-	positionXYZ = glm::vec3(0.0f, 9.8f, -3.5f);     // Starts to lead into the bulb
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderColor(0.4f, 0.4f, 0.4f, 1.0f);        // Neutral gray to separate plastic and glass
-	m_basicMeshes->DrawCylinderMesh();
-
-	//** Glass bulb (emissive) **//
-    //***************************//
-	scaleXYZ = glm::vec3(0.22f, 0.32f, 0.22f);   // bulb size
-	positionXYZ = glm::vec3(0.0f,10.15f, -3.5f);     // bulb position
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-
-	m_pShaderManager->setBoolValue("bUseLighting", false);  // emissive draw
-	SetShaderColor(1.3f, 1.1f, 0.65f, 1.0f);              // warm yellow (not pure white)
-	m_basicMeshes->DrawSphereMesh();                        // draw bulb
-	m_pShaderManager->setBoolValue("bUseLighting", true);   // restore lighting
-
-	//** Switch stem: horizontal toggle arm **//
-	//****************************************//
-	scaleXYZ = glm::vec3(0.03f, 0.8f, 0.03f);      // Very slim and long to reach out
-	positionXYZ = glm::vec3(0.9f, 9.55f, -3.5f);    // Positioned off the side
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 90.0f, positionXYZ);  // Rotated to extend sideways
-	SetShaderColor(0.0f, 0.0f, 0.0f, 1.0f);        // Matches the black plastic segments
-	SetShaderMaterial("plasticBlack");    // plastic material (lighting)
-	m_basicMeshes->DrawCylinderMesh();
-
-	//** Switch cap: knob at the end **//
-	//*********************************//
-	scaleXYZ = glm::vec3(0.1f, 0.05f, 0.1f);       // Slightly larger round end
-	positionXYZ = glm::vec3(0.95f, 9.55f, -3.5f);   // Aligned with the end of the stem
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 90.0f, positionXYZ);  // Same orientation as stem
-	SetShaderColor(0.1f, 0.1f, 0.1f, 1.0f);        // Slightly lighter to stand out a bit
-	SetShaderMaterial("plasticBlack");    // plastic material (lighting)
-	m_basicMeshes->DrawCylinderMesh();
-
-	// ================= GLASS SHADE ==================
-// switch to blended rendering for glass
-	glEnable(GL_BLEND);                                            // translucent pass
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);             // standard alpha blend
-	glDepthMask(GL_FALSE);                                         // no depth writes while blending
-	glEnable(GL_CULL_FACE);                                        // cull for inside/outside faces
-
-	const glm::vec4 kGlassRGBA = glm::vec4(0.85f, 0.90f, 1.0f, 0.38f); // shared glass tint
-
-	//** Inner taper (glass funnel) **//
-	//********************************//
-	glCullFace(GL_BACK);
-	scaleXYZ = glm::vec3(0.30f, -1.34f, 0.30f);                 // slightly taller to meet cylinder
-	positionXYZ = glm::vec3(0.0f, 9.46f, -3.5f);                    // nudge up to kiss inner wall
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderMaterial("glass");
-	SetShaderTexture("FrostedGlass");
-	SetTextureUVScale(1.4f, 1.4f);
-	m_pShaderManager->setVec4Value(g_ColorValueName, kGlassRGBA);
-	m_basicMeshes->DrawTaperedCylinderMesh();
-
-	//** Inner glass cylinder (nearly flush) **//
-	//*****************************************//
-	// draw back faces so we see the interior wall
-	glCullFace(GL_FRONT);
-	scaleXYZ = glm::vec3(0.796f, 2.52f, 0.796f);                // radius close to outer (clearance ~0.004)
-	positionXYZ = glm::vec3(0.0f, 9.40f, -3.5f);                     // same center as outer
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderMaterial("glass");
-	SetShaderTexture("FrostedGlass");
-	SetTextureUVScale(1.1f, 1.1f);
-	m_pShaderManager->setVec4Value(g_ColorValueName, kGlassRGBA);
-	m_basicMeshes->DrawCylinderMesh();
-
-	//** Outer glass cylinder **//
-	//**************************//
-	glCullFace(GL_BACK);
-	scaleXYZ = glm::vec3(0.800f, 2.50f, 0.800f);                // outer radius
-	positionXYZ = glm::vec3(0.0f, 9.40f, -3.5f);
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	SetShaderMaterial("glass");
-	SetShaderTexture("FrostedGlass");
-	SetTextureUVScale(1.2f, 1.2f);
-	m_pShaderManager->setVec4Value(g_ColorValueName, kGlassRGBA);
-	m_basicMeshes->DrawCylinderMesh();
+		AddNodeInstance(node);
+	}
+	if (pBatchNode != NULL)
+	{
+		DrawNodeBatch(*pBatchNode);
+	}
+	EndRenderPass(currentPass);
+	if (m_batchProgramID != m_programID)
+	{
+		glUseProgram(m_programID);
+		RenderStats::Add(RenderStats::COUNTER_PROGRAM_BINDS);
+	}
 
 	// --- restore state ---
-	glDisable(GL_CULL_FACE);
-	glDepthMask(GL_TRUE);
-	// ================= END GLASS SHADE =================
-
-	//** Bulb halo (glow) **//
-//**************************//
-	glDepthMask(GL_FALSE);                                          // no depth writes
-	glDisable(GL_DEPTH_TEST);                                       // disable depth test so halo shows through glass
-	glEnable(GL_BLEND);                                             // enable blending
-	glBlendFunc(GL_ONE, GL_ONE);                                    // additive blend
-
-	scaleXYZ = glm::vec3(0.32f, 0.44f, 0.32f);                   // halo size
-	positionXYZ = glm::vec3(0.0f, 10.15f, -3.5f);                     // halo position
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
-	m_pShaderManager->setBoolValue("bUseLighting", false);          // emissive color
-	SetShaderColor(0.22f, 0.19f, 0.08f, 1.0f);                      // warm glow
-	m_basicMeshes->DrawSphereMesh();                                // draw halo
-
-	m_pShaderManager->setBoolValue("bUseLighting", true);           // restore lighting
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);              // restore blend
-	glEnable(GL_DEPTH_TEST);                                        // re-enable depth test
-	glDepthMask(GL_TRUE);                                           // re-enable depth writes
+	// the next frame's clear needs depth writes and the
+	// profiler overlay needs color writes
+	RenderState::SetCullFace(GL_NONE);
+	SetRenderPass(PASS_OPAQUE);
+
+	ProfileScope(NULL);
 }
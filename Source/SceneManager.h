@@ -12,14 +12,107 @@
 //                 including DefineObjectMaterials() and SetupSceneLights(). 
 //                 These functions will configure object surface properties and 
 //                 initialize scene lighting for the lamp project.
+//
+//  Date: 10/14/2026
+//  Edits Summary: Added the retained scene node list (SCENE_NODE) that is
+//                 built once in PrepareScene() and walked by RenderScene().
+//                 Added the ShaderUniforms cache for per-draw uniforms.
+//                 Added std140 mirrors of the shader material and light
+//                 structs, uploaded once into uniform buffer objects.
+//                 Added hashed tag lookups for textures and materials,
+//                 and pass tags by const reference.
+//                 Added the RenderQueue stage - scene nodes are queued with
+//                 a state sort key each frame, and the blended nodes are
+//                 ordered back to front from their bounding spheres.
+//                 Replaced ShapeMeshes with the instanced MeshBuffers and
+//                 removed the per-draw uniform setters it made unused.
+//                 Added the multi-draw indirect path for the opaque pass
+//                 and the FRAME_BLOCK mirror of the shader frame block.
+//                 Added the TextureLoader for decoding the scene textures
+//                 on worker threads behind a placeholder texture.
+//                 Replaced the fixed 16 entry texture array with a list,
+//                 and added bindless texture handles in a TEXTURE_BLOCK.
+//                 Added the runtime point light list and the LightClusters
+//                 culling stage for clustered forward lighting.
+//                 Added the deferred shading programs and the GBuffer,
+//                 selected per frame with SetDeferredShading().
+//                 Added the depth only programs for the optional depth
+//                 pre-pass, selected with SetDepthPrePass().
+//                 Added world bounding boxes to the scene nodes and the
+//                 ViewFrustum and BoundingVolumeTree culling stage.
+//                 Added the per-node mesh level of detail, picked each
+//                 frame from the projected size by SelectNodeLods().
+//                 Added FrameProfiler scopes around the scene update,
+//                 culling and each render pass.
+//                 Added SetSceneCopies() for the benchmark stress preset.
+//                 Moved the draw call count into RenderStats, which
+//                 also counts the triangles, binds, uploads and state
+//                 changes of each frame.
+//                 Moved the blend, depth and culling state into the
+//                 RenderState cache, and removed SetCullFace().
+//                 Added SetFrameRing() - the frame block, instances and
+//                 light cluster lists of each frame are written into
+//                 the persistently mapped FrameRingBuffer.
+//                 Added the JobSystem that spreads the node update,
+//                 culling, level of detail and sort key loops of large
+//                 scenes over worker threads.
+//                 Replaced DefineSceneNodes() with LoadSceneFile(), which
+//                 reads the nodes and lights from a SceneFile, and added
+//                 SetSceneFile() for the --scene option.
+//                 Added EnableHotReload() - a FileWatcher on the scene
+//                 file, the shader files and the texture images, whose
+//                 changes are reloaded at the start of the next frame.
+//                 The object materials moved into the scene file, and
+//                 DefineObjectMaterials() was removed.
+//                 The scene, indirect and G-buffer programs became
+//                 ShaderPermutations, picked per draw by whether it is
+//                 lit and textured and built for the lights that are on.
+//                 Removed the main program's ShaderUniforms, as the
+//                 permutations each keep their own, and the unused
+//                 ShaderManager pointer.
+//                 Added the cached normal matrix to the scene nodes and
+//                 the combined view-projection matrix to FRAME_BLOCK.
+//                 Added ShadowMaps for the directional and bulb lights,
+//                 drawn again only when a node or a light changes, and
+//                 their light space and switches to FRAME_BLOCK.
+//                 Added SetTransparencyMode() - the translucent pass can
+//                 be drawn in any order through weighted blended or
+//                 linked list order independent transparency.
+//                 Added SetResolutionScaler() - its upscale program is
+//                 reloaded with the scene shaders.
+//                 The loaded images and the placeholder are owned by
+//                 GpuResource handles, and the material, light, frame,
+//                 texture and point light blocks are ranges of a
+//                 GpuBufferPool instead of buffers of their own.
 ///////////////////////////////////////////////////////////////////////////////
 
 #pragma once
 
-#include "ShaderManager.h"
-#include "ShapeMeshes.h"
+#include "MeshBuffers.h"
+#include "RenderQueue.h"
+#include "ShaderUniforms.h"
+#include "ShaderProgram.h"
+#include "ShaderPermutations.h"
+#include "IndirectCommandBuffer.h"
+#include "TextureLoader.h"
+#include "LightClusters.h"
+#include "GBuffer.h"
+#include "ShadowMaps.h"
+#include "TransparencyBuffers.h"
+#include "ViewFrustum.h"
+#include "BoundingVolumeTree.h"
+#include "FrameProfiler.h"
+#include "RenderState.h"
+#include "FrameRingBuffer.h"
+#include "JobSystem.h"
+#include "SceneFile.h"
+#include "FileWatcher.h"
+#include "ResolutionScaler.h"
+#include "GpuResources.h"
+#include "GpuBufferPool.h"
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 /***********************************************************
@@ -32,14 +125,23 @@ class SceneManager
 {
 public:
 	// constructor
-	SceneManager(ShaderManager *pShaderManager);
+	SceneManager();
 	// destructor
 	~SceneManager();
 
 	struct TEXTURE_INFO
 	{
 		std::string tag;
+		// image file, loaded again when it changes
+		std::string filename;
 		uint32_t ID;
+		// resident bindless handle, 0 when using texture units
+		GLuint64 handle;
+		// the slot's loaded image, freed when it is replaced -
+		// empty while the slot shows the placeholder
+		GpuResource image;
+
+		TEXTURE_INFO() : ID(0), handle(0), image(GpuResource::RESOURCE_TEXTURE) {}
 	};
 
 	struct OBJECT_MATERIAL
@@ -50,63 +152,513 @@ public:
 		std::string tag;
 	};
 
+	// largest number of materials the shader material block holds,
+	// matches MAX_OBJECT_MATERIALS in fragmentShader.glsl
+	static const int MAX_OBJECT_MATERIALS = 32;
+	// matches TOTAL_POINT_LIGHTS in fragmentShader.glsl
+	static const int TOTAL_POINT_LIGHTS = 5;
+	// largest number of textures the shader texture block holds,
+	// matches MAX_SCENE_TEXTURES in fragmentShader.glsl
+	static const int MAX_SCENE_TEXTURES = 64;
+
+	// the following structs mirror the std140 layout of the
+	// shader structs - vec3 members are padded out to 16 bytes
+	// and bool members are stored as 4 byte ints
+	struct MATERIAL_BLOCK_ENTRY
+	{
+		glm::vec3 diffuseColor;
+		float pad0;
+		glm::vec3 specularColor;
+		float shininess;
+	};
+
+	struct DIRECTIONAL_LIGHT
+	{
+		glm::vec3 direction;
+		float pad0;
+		glm::vec3 ambient;
+		float pad1;
+		glm::vec3 diffuse;
+		float pad2;
+		glm::vec3 specular;
+		int bActive;
+	};
+
+	struct POINT_LIGHT
+	{
+		glm::vec3 position;
+		float pad0;
+		glm::vec3 ambient;
+		float pad1;
+		glm::vec3 diffuse;
+		float pad2;
+		glm::vec3 specular;
+		int bActive;
+	};
+
+	struct SPOT_LIGHT
+	{
+		glm::vec3 position;
+		float pad0;
+		glm::vec3 direction;
+		float cutOff;
+		float outerCutOff;
+		float constant;
+		float linear;
+		float quadratic;
+		glm::vec3 ambient;
+		float pad1;
+		glm::vec3 diffuse;
+		float pad2;
+		glm::vec3 specular;
+		int bActive;
+	};
+
+	// the LightBlock uniform block of the fragment shader
+	struct LIGHT_BLOCK
+	{
+		DIRECTIONAL_LIGHT directionalLight;
+		POINT_LIGHT pointLights[TOTAL_POINT_LIGHTS];
+		SPOT_LIGHT spotLight;
+	};
+
+	// std140 mirror of the shader TextureBlock - each handle
+	// is padded out to a uvec4
+	struct TEXTURE_HANDLE
+	{
+		GLuint64 handle;
+		GLuint64 pad0;
+	};
+
+	struct TEXTURE_BLOCK
+	{
+		TEXTURE_HANDLE textures[MAX_SCENE_TEXTURES];
+	};
+
+	// std140 mirror of the shader FrameBlock
+	struct FRAME_BLOCK
+	{
+		glm::mat4 view;
+		glm::mat4 projection;
+		// projection * view, multiplied once per frame
+		glm::mat4 viewProjection;
+		glm::vec3 viewPosition;
+		float pad0;
+		glm::vec4 clusterScale;
+		// light space of the directional shadow map
+		glm::mat4 shadowViewProjection;
+		// position of the shadowed point light, far plane in w
+		glm::vec4 shadowLightPosition;
+		// directional map drawn, cube drawn, cube near plane and
+		// directional texel size
+		glm::vec4 shadowParams;
+	};
+
+	// basic shape meshes that a scene node can draw
+	enum MESH_TYPE
+	{
+		MESH_BOX = MeshBuffers::SHAPE_BOX,
+		MESH_CYLINDER = MeshBuffers::SHAPE_CYLINDER,
+		MESH_SPHERE = MeshBuffers::SHAPE_SPHERE,
+		MESH_PRISM = MeshBuffers::SHAPE_PRISM,
+		MESH_PLANE = MeshBuffers::SHAPE_PLANE,
+		MESH_TORUS = MeshBuffers::SHAPE_TORUS,
+		MESH_PYRAMID3 = MeshBuffers::SHAPE_PYRAMID3,
+		MESH_TAPERED_CYLINDER = MeshBuffers::SHAPE_TAPERED_CYLINDER
+	};
+
+	// render passes, drawn in this order each frame
+	enum RENDER_PASS
+	{
+		PASS_OPAQUE = 0,      // depth tested and written, no blending
+		PASS_TRANSLUCENT,     // alpha blended, depth tested, no depth writes
+		PASS_ADDITIVE         // additive blended, no depth test
+	};
+
+	// how the translucent pass is blended
+	enum TRANSPARENCY_MODE
+	{
+		TRANSPARENCY_SORTED = 0,     // alpha blended back to front by node
+		TRANSPARENCY_WEIGHTED,       // weighted blended, in any order
+		TRANSPARENCY_LINKED_LIST     // per-pixel lists sorted by depth
+	};
+
+	struct SCENE_NODE
+	{
+		MESH_TYPE mesh;
+		RENDER_PASS pass;
+		// face culling for the node - GL_NONE, GL_FRONT or GL_BACK
+		GLenum cullFace;
+		// transformation values
+		glm::vec3 scaleXYZ;
+		float XrotationDegrees;
+		float YrotationDegrees;
+		float ZrotationDegrees;
+		glm::vec3 positionXYZ;
+		// cached model matrix, rebuilt only when bDirty is set
+		glm::mat4 modelMatrix;
+		// inverse transpose of the model matrix rotation and scale,
+		// rebuilt with it - turns the normals into world space
+		glm::mat3 normalMatrix;
+		bool bDirty;
+		// world space bounding sphere, rebuilt with the model matrix
+		glm::vec3 boundsCenter;
+		float boundsRadius;
+		// world space bounding box, rebuilt with the model matrix
+		ViewFrustum::BOUNDING_BOX worldBox;
+		// mesh level of detail drawn, picked from the projected size
+		int lodLevel;
+		// index into m_objectMaterials, -1 for none
+		int materialIndex;
+		// texture slot, -1 for a solid color
+		int textureSlot;
+		glm::vec4 color;
+		glm::vec2 UVscale;
+		bool bUseLighting;
+	};
+
 private:
-	// pointer to shader manager object
-	ShaderManager* m_pShaderManager;
-	// pointer to basic shapes object
-	ShapeMeshes* m_basicMeshes;
+	// pointer to the basic shape mesh buffers
+	MeshBuffers* m_pMeshBuffers;
+	// decodes the scene texture images on worker threads
+	TextureLoader* m_pTextureLoader;
+	// bound to a texture slot until its image is uploaded
+	GpuResource* m_pPlaceholderTexture;
 	// total number of loaded textures
 	int m_loadedTextures;
-	// loaded textures info
-	TEXTURE_INFO m_textureIDs[16];
+	// loaded textures info, indexed by texture slot
+	std::vector<TEXTURE_INFO> m_textureIDs;
+	// most texture slots available - the texture block size with
+	// bindless textures, otherwise the fragment texture units
+	int m_maxTextureSlots;
+	// true when textures are picked per draw from bindless handles
+	bool m_bBindlessTextures;
+	// pooled range for the texture block
+	GpuBufferPool::POOL_ALLOCATION m_textureBlockRange;
+	// texture slot for each loaded texture tag
+	std::unordered_map<std::string, int> m_textureSlotLookup;
 	// defined object materials
 	std::vector<OBJECT_MATERIAL> m_objectMaterials;
+	// m_objectMaterials index for each material tag
+	std::unordered_map<std::string, int> m_materialLookup;
+	// retained scene nodes, in draw order
+	std::vector<SCENE_NODE> m_sceneNodes;
+	// scene lights, uploaded to the light block when dirty
+	LIGHT_BLOCK m_lights;
+	bool m_bLightsDirty;
+	// every point light in the scene - the light block only holds
+	// the first TOTAL_POINT_LIGHTS, for the unclustered shaders
+	std::vector<POINT_LIGHT> m_pointLights;
+	// true when the point lights are culled into light clusters
+	bool m_bClusteredLighting;
+	LightClusters* m_pLightClusters;
+	// reach of each active point light, in clustered light order
+	std::vector<LightClusters::LIGHT_SPHERE> m_lightSpheres;
+	// pooled range of the active point lights, allocated again
+	// when they outgrow it
+	GpuBufferPool::POOL_ALLOCATION m_pointLightRange;
+	// pooled ranges for the material and light blocks
+	GpuBufferPool::POOL_ALLOCATION m_materialRange;
+	GpuBufferPool::POOL_ALLOCATION m_lightRange;
+	// draws of the current frame in submission order
+	RenderQueue m_renderQueue;
+	// per-instance values of the batch being collected
+	std::vector<MeshBuffers::INSTANCE_DATA> m_instanceData;
+	// view of the current frame
+	glm::mat4 m_viewMatrix;
+	glm::mat4 m_projectionMatrix;
+	glm::vec3 m_viewPosition;
+	// pooled range for the frame block, used when there is no
+	// frame ring
+	GpuBufferPool::POOL_ALLOCATION m_frameBlockRange;
+	// frame block of the current frame, whose shadow values are
+	// kept from the last time the shadow maps were drawn
+	FRAME_BLOCK m_frameBlock;
+	// ring the per-frame data is written to, and the driver's
+	// uniform buffer offset alignment for binding ranges of it
+	FrameRingBuffer* m_pFrameRing;
+	GLint m_uniformAlignment;
+	// scaler the frame is drawn through, whose upscale program is
+	// built from the scene shader files
+	ResolutionScaler* m_pResolutionScaler;
+	// pool the uniform and storage block ranges come from
+	GpuBufferPool* m_pBufferPool;
+	// the program left in use between the passes - the lit and
+	// textured permutation of the scene shaders
+	GLuint m_programID;
+	// program the instanced batches last put in use
+	GLuint m_batchProgramID;
+	// permutations of the scene shaders for the instanced draws -
+	// the OpenGL 4.6 variant, with clustered lighting and bindless
+	// textures when available, or else the GLSL 3.30 one
+	ShaderPermutations* m_pSceneShaders;
+	// multi-draw indirect variant of the scene shaders
+	ShaderPermutations* m_pIndirectShaders;
+	// persistent draw commands of the opaque pass
+	IndirectCommandBuffer* m_pIndirectCommands;
+	// true when the opaque pass is drawn with multi-draw indirect
+	bool m_bIndirectDraw;
+	// set when a scene node changed since the commands were built
+	bool m_bSceneChanged;
+	// deferred shading variants - the geometry pass writes the opaque
+	// surfaces into the G-buffer and the lighting pass shades them
+	ShaderPermutations* m_pGBufferShaders;
+	ShaderProgram* m_pDeferredLightingProgram;
+	GBuffer* m_pGBuffer;
+	// first of the texture units the lighting pass samples the
+	// G-buffer from
+	int m_gBufferTextureUnit;
+	// true when the deferred programs were built
+	bool m_bDeferredAvailable;
+	// true when the opaque pass is drawn with deferred shading
+	bool m_bDeferredShading;
+	// depth only variants for the depth pre-pass, reading only the
+	// position vertex stream
+	ShaderProgram* m_pDepthProgram;
+	ShaderProgram* m_pIndirectDepthProgram;
+	ShaderUniforms* m_pIndirectDepthUniforms;
+	// true when the depth programs were built
+	bool m_bDepthPrePassAvailable;
+	// true when the opaque depth is laid down before shading
+	bool m_bDepthPrePass;
+	// shadow maps of the directional light and the first point
+	// light, drawn with the depth program
+	ShadowMaps* m_pShadowMaps;
+	// first of the texture units the shadow maps are sampled from
+	int m_shadowTextureUnit;
+	// true when the shadow maps were created
+	bool m_bShadowsAvailable;
+	// set when a node or a light changed since the maps were drawn
+	bool m_bShadowsDirty;
+	// order independent transparency - permutations of the scene
+	// shaders that write the translucent fragments into the
+	// buffers, and the full screen pass that blends them over the
+	// frame, for each mode
+	ShaderPermutations* m_pWeightedShaders;
+	ShaderProgram* m_pWeightedCompositeProgram;
+	ShaderPermutations* m_pLinkedListShaders;
+	ShaderProgram* m_pLinkedListResolveProgram;
+	TransparencyBuffers* m_pTransparencyBuffers;
+	// true when the programs of each mode were built
+	bool m_bWeightedAvailable;
+	bool m_bLinkedListAvailable;
+	// how the translucent pass is blended
+	TRANSPARENCY_MODE m_transparencyMode;
+	// permutations the instanced batches of the current pass use
+	ShaderPermutations* m_pBatchShaders;
+	// opaque node of each indirect command, in command order
+	std::vector<int> m_indirectNodeOrder;
+	// planes of the current view, for culling the scene nodes
+	ViewFrustum m_frustum;
+	// tree over the scene node boxes, rebuilt when a node moves
+	BoundingVolumeTree m_boundsTree;
+	bool m_bBoundsChanged;
+	// nonzero for each scene node inside the view this frame
+	std::vector<unsigned char> m_nodeVisible;
+	// scene nodes left out of the current frame
+	int m_culledNodeCount;
+	// worker threads for the per-node loops of large scenes
+	JobSystem* m_pJobSystem;
+	// queue item of each scene node, filled in by the jobs -
+	// a node index of -1 for a culled node
+	std::vector<RenderQueue::RENDER_ITEM> m_nodeItems;
+	// bounds tree subtrees culled as separate jobs
+	std::vector<int> m_cullSubtrees;
+	// height of the viewport in pixels, for the projected node sizes
+	int m_viewportHeight;
+	// times the sections of RenderScene(), owned by the main code -
+	// NULL when the frame is not profiled
+	FrameProfiler* m_pProfiler;
+	// true while RenderScene() holds an open profiler scope
+	bool m_bProfileScopeOpen;
+	// copies of the scene that LoadSceneFile() is repeated into
+	int m_sceneCopies;
+	// the .scene file the nodes and lights are read from
+	std::string m_sceneFilename;
+	// watches the scene, shader and texture files - NULL until
+	// EnableHotReload()
+	FileWatcher* m_pFileWatcher;
+	// texture slots whose images changed while the loader was busy
+	std::vector<int> m_pendingTextureReloads;
+	// true when the texture loader reads the baked BC7 files
+	bool m_bCompressedTextures;
 
-	// load texture images and convert to OpenGL texture data
-	bool CreateGLTexture(const char* filename, std::string tag);
+	// scenes with fewer nodes than this test each node box on
+	// its own instead of walking the bounds tree
+	static const int MIN_TREE_NODES = 64;
+	// scene nodes handed to each job - scenes of one batch run
+	// on the calling thread alone
+	static const int NODE_JOB_BATCH = 512;
+
+	// a run of draw commands that share their render state
+	struct INDIRECT_BATCH
+	{
+		int firstCommand;
+		int commandCount;
+		// first node of the run, for its shared values
+		int nodeIndex;
+	};
+	std::vector<INDIRECT_BATCH> m_indirectBatches;
+
+	// most decoded texture images uploaded in one frame
+	static const int MAX_TEXTURE_UPLOADS_PER_FRAME = 2;
+
+	// reserve a texture slot and queue its image to be decoded
+	bool CreateGLTexture(const char* filename, const std::string& tag);
+	// create the texture shown while an image is decoding
+	void CreatePlaceholderTexture();
+	// upload the decoded images and bind them to their slots
+	void UpdateTextureUploads();
+	// make a texture resident and store its handle in its slot
+	void SetTextureHandle(int slot, GLuint textureID);
 	// bind loaded OpenGL textures to slots in memory
 	void BindGLTextures();
-	// free the loaded OpenGL textures
+	// free the loaded OpenGL textures and their slots
 	void DestroyGLTextures();
 	// find a loaded texture by tag
-	int FindTextureID(std::string tag);
-	int FindTextureSlot(std::string tag);
+	int FindTextureID(const std::string& tag);
+	int FindTextureSlot(const std::string& tag);
 	// find a defined material by tag
-	bool FindMaterial(std::string tag, OBJECT_MATERIAL& material);
+	bool FindMaterial(const std::string& tag, OBJECT_MATERIAL& material);
+	int FindMaterialIndex(const std::string& tag);
+
+	// configure lighting for the 3D scene
+	void SetupSceneLights();
+
+	// create the material and light uniform buffers
+	void CreateUniformBuffers();
+	// copy the defined materials into the material block
+	void UploadMaterials();
+	// copy the scene lights into the light block
+	void UploadLights();
+	// build the scene shader permutations for the lights that are
+	// on, from the packed light block
+	void UpdateLightSetup(int activePointLights);
+	// put the lit and textured scene permutation in use as the
+	// program between the passes
+	void UseDefaultSceneProgram();
+
+	// build the retained scene node list, the materials and the
+	// scene lights from the scene file
+	bool LoadSceneFile();
+	// read the scene file again and update what changed
+	bool ReloadSceneFile();
+	// add the materials of a scene file, or update the ones
+	// already defined - true when any value changed
+	bool ApplySceneMaterials(const SceneFile& sceneFile);
+	// set the scene lights from a scene file
+	void ApplySceneLights(const SceneFile& sceneFile);
+	// add a scene node for each node of a scene file
+	void AddSceneFileNodes(const SceneFile& sceneFile);
+	// set the values of a scene node from a node of a scene file -
+	// the tag lists cache the material and texture of each tag,
+	// -2 for a tag not looked up yet
+	bool ReadSceneFileNode(
+		const SceneFile& sceneFile,
+		int fileIndex,
+		std::vector<int>& materialIndices,
+		std::vector<int>& textureSlots,
+		SCENE_NODE& node);
 
-	// set the transformation values 
-	// into the transform buffer
-	void SetTransformations(
+	// reload the files the file watcher found changed
+	void ReloadChangedFiles();
+	// build every loaded shader program again from the files
+	void ReloadShaders();
+	// decode the image of texture slots again
+	void ReloadTextures(const std::vector<int>& slots);
+	// repeat the scene nodes and point lights into a grid of
+	// m_sceneCopies copies of the scene
+	void ReplicateScene();
+
+	// add a node to the scene node list and return its index
+	int AddSceneNode(
+		MESH_TYPE mesh,
 		glm::vec3 scaleXYZ,
 		float XrotationDegrees,
 		float YrotationDegrees,
 		float ZrotationDegrees,
 		glm::vec3 positionXYZ);
 
-	// set the color values into the shader
-	void SetShaderColor(
+	// move a scene node - flags its model matrix dirty
+	void SetNodeTransform(
+		int nodeIndex,
+		glm::vec3 scaleXYZ,
+		float XrotationDegrees,
+		float YrotationDegrees,
+		float ZrotationDegrees,
+		glm::vec3 positionXYZ);
+
+	// set the surface values of a scene node
+	void SetNodeMaterial(int nodeIndex, const std::string& materialTag);
+	void SetNodeTexture(int nodeIndex, const std::string& textureTag);
+	void SetNodeUVScale(int nodeIndex, float u, float v);
+	void SetNodeColor(
+		int nodeIndex,
 		float redColorValue,
 		float greenColorValue,
 		float blueColorValue,
 		float alphaValue);
+	void SetNodeColor(int nodeIndex, glm::vec4 color);
+	void SetNodeLighting(int nodeIndex, bool bUseLighting);
+	void SetNodePass(int nodeIndex, RENDER_PASS pass, GLenum cullFace);
 
-	// set the texture data into the shader
-	void SetShaderTexture(
-		std::string textureTag);
-
-	// set the UV scale for the texture mapping
-	void SetTextureUVScale(
-		float u, float v);
-
-	// set the object material into the shader
-	void SetShaderMaterial(
-		std::string materialTag);
-
-	// define materials for all objects in the scene
-	void DefineObjectMaterials();
-
-	// configure lighting for the 3D scene
-	void SetupSceneLights();
+	// rebuild the model matrix of the dirty scene nodes
+	void UpdateSceneNodes();
+	// flag the scene nodes that are inside the view
+	void CullSceneNodes();
+	// pick the mesh level of detail of each visible scene node
+	void SelectNodeLods();
+	// close the open profiler scope and open the next one - a
+	// NULL name only closes it
+	void ProfileScope(const char* name);
+	// queue every visible scene node and sort the queue for drawing
+	void BuildRenderQueue();
+	// set the blend and depth state for a render pass
+	void SetRenderPass(RENDER_PASS pass);
+	// finish a render pass that the next one cannot simply follow
+	void EndRenderPass(RENDER_PASS pass);
+	// bind the buffers of the transparency mode for the translucent
+	// pass, and blend them over the frame after it
+	void BeginTransparencyPass();
+	void ResolveTransparencyPass();
+	// check whether two nodes can share an instanced draw
+	bool CanBatchNodes(const SCENE_NODE& a, const SCENE_NODE& b);
+	// add a node to the batch being collected
+	void AddNodeInstance(const SCENE_NODE& node);
+	// get the shader permutation a node is drawn with
+	static int GetNodePermutation(const SCENE_NODE& node);
+	// set the shared shader values of a batch into a program
+	void SetBatchUniforms(ShaderUniforms* pUniforms, const SCENE_NODE& node);
+	// set the shared shader values of a batch and draw it
+	void DrawNodeBatch(const SCENE_NODE& node);
+	// build the OpenGL 4.6 and multi-draw indirect shader variants
+	// when the context supports them
+	void LoadShaderVariants();
+	// build the depth only shader variants
+	void LoadDepthPrograms();
+	// build the order independent transparency programs
+	void LoadTransparencyPrograms();
+	// refill the indirect commands from the sorted opaque nodes
+	void BuildIndirectCommands();
+	// check whether the indirect commands still follow the
+	// opaque order of the render queue
+	bool IsIndirectOrderCurrent();
+	// draw the opaque depth when the pre-pass is selected, and
+	// leave the depth test set for shading against it
+	void DrawDepthPrePass();
+	// draw the opaque pass from the indirect commands with the
+	// permutations of the passed in multi-draw indirect shaders
+	void DrawIndirectBatches(ShaderPermutations* pShaders);
+	// draw the opaque pass into the G-buffer and shade it with
+	// one lighting pass
+	void DrawDeferredOpaquePass();
+	// draw the shadow maps of the lights that are on
+	void UpdateShadowMaps();
+	// draw the depth of the opaque nodes into the bound shadow map
+	void DrawShadowCasters();
+	// copy a frame block into the frame ring, or the frame block
+	// buffer, and bind it
+	void UploadFrameBlock(const FRAME_BLOCK& frame);
 
 public:
 
@@ -116,4 +668,55 @@ public:
 	void LoadSceneTextures();
 	void RenderScene();
 
-};
\ No newline at end of file
+	// set the view of the frame that is about to be rendered
+	void SetSceneView(
+		const glm::mat4& view,
+		const glm::mat4& projection,
+		const glm::vec3& viewPosition);
+
+	// add a point light to the scene and return its index - with
+	// clustered lighting there is no fixed limit
+	int AddPointLight(const POINT_LIGHT& light);
+
+	// select deferred shading for the opaque pass - ignored when
+	// the context cannot build the deferred programs
+	void SetDeferredShading(bool bDeferredShading);
+	// select the depth pre-pass for the opaque pass - ignored
+	// when the depth programs could not be built
+	void SetDepthPrePass(bool bDepthPrePass);
+	// select how the translucent pass is blended - a mode whose
+	// programs could not be built falls back to sorted blending
+	void SetTransparencyMode(TRANSPARENCY_MODE mode);
+	// time the sections of the following frames with a profiler,
+	// or NULL to stop
+	void SetFrameProfiler(FrameProfiler* pProfiler) { m_pProfiler = pProfiler; }
+	// write the per-frame data of the following frames into a
+	// ring, or NULL to upload it into buffers of its own
+	void SetFrameRing(FrameRingBuffer* pFrameRing);
+	// reload the upscale program of a resolution scaler along
+	// with the scene shaders, or NULL for none
+	void SetResolutionScaler(ResolutionScaler* pScaler) { m_pResolutionScaler = pScaler; }
+	// set how many copies of the scene PrepareScene() builds -
+	// more than one is only for stress testing
+	void SetSceneCopies(int copies) { m_sceneCopies = (copies > 1) ? copies : 1; }
+	// set the .scene file read by PrepareScene()
+	void SetSceneFile(const std::string& filename) { m_sceneFilename = filename; }
+	// watch the scene file, the shader files and the texture
+	// images, and reload whichever of them change between frames
+	void EnableHotReload();
+	// check whether scene textures are still being loaded
+	bool IsTextureLoading() const { return(m_pTextureLoader->IsBusy()); }
+
+	// get the number of scene nodes, and how many of them were
+	// culled from the last frame
+	int GetSceneNodeCount() const { return((int)m_sceneNodes.size()); }
+	int GetCulledNodeCount() const { return(m_culledNodeCount); }
+
+};
+// the C++ mirrors above must keep the byte layout of the std140 blocks
+static_assert(sizeof(SceneManager::MATERIAL_BLOCK_ENTRY) == 32, "MATERIAL_BLOCK_ENTRY must match the std140 Material layout");
+static_assert(sizeof(SceneManager::LIGHT_BLOCK) == 480, "LIGHT_BLOCK must match the std140 LightBlock layout");
+static_assert(sizeof(SceneManager::TEXTURE_BLOCK) == 1024, "TEXTURE_BLOCK must match the std140 TextureBlock layout");
+static_assert(sizeof(SceneManager::FRAME_BLOCK) == 320, "FRAME_BLOCK must match the std140 FrameBlock layout");
+static_assert(sizeof(SceneManager::POINT_LIGHT) == sizeof(SceneFile::LIGHT_RECORD), "POINT_LIGHT must match the scene file light records");
+static_assert(sizeof(SceneManager::DIRECTIONAL_LIGHT) == sizeof(SceneFile::LIGHT_RECORD), "DIRECTIONAL_LIGHT must match the scene file light records");
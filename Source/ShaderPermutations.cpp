@@ -0,0 +1,224 @@
+///////////////////////////////////////////////////////////////////////////////
+// shaderpermutations.cpp
+// ============
+// build the scene shaders specialized for each kind of draw and the lights
+// that are on, instead of branching on them at run time
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ShaderPermutations.h"
+
+#include <sstream>
+
+/***********************************************************
+ *  ShaderPermutations()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ShaderPermutations::ShaderPermutations()
+{
+	for (int i = 0; i < PERMUTATION_COUNT; i++)
+	{
+		m_pPrograms[i] = NULL;
+		m_pUniforms[i] = NULL;
+		m_bFailed[i] = false;
+	}
+
+	// everything on until the scene says otherwise
+	m_lightSetup.bDirectionalLight = true;
+	m_lightSetup.bSpotLight = true;
+	m_lightSetup.pointLightCount = 0;
+}
+
+/***********************************************************
+ *  ~ShaderPermutations()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+ShaderPermutations::~ShaderPermutations()
+{
+	Clear();
+}
+
+/***********************************************************
+ *  SetSource()
+ *
+ *  This method is used for setting the shader files,
+ *  version line and defines the permutations are built
+ *  from.
+ ***********************************************************/
+void ShaderPermutations::SetSource(
+	const char* vertexShaderPath,
+	const char* fragmentShaderPath,
+	const char* versionLine,
+	const std::string& defines)
+{
+	Clear();
+
+	m_vertexShaderPath = vertexShaderPath;
+	m_fragmentShaderPath = fragmentShaderPath;
+	m_versionLine = versionLine;
+	m_defines = defines;
+}
+
+/***********************************************************
+ *  SetLightSetup()
+ *
+ *  This method is used for setting the lights that are on.
+ *  A change drops the built permutations, which are built
+ *  again for the new setup as the draws ask for them.
+ ***********************************************************/
+bool ShaderPermutations::SetLightSetup(const LIGHT_SETUP& lightSetup)
+{
+	if ((lightSetup.bDirectionalLight == m_lightSetup.bDirectionalLight) &&
+		(lightSetup.bSpotLight == m_lightSetup.bSpotLight) &&
+		(lightSetup.pointLightCount == m_lightSetup.pointLightCount))
+	{
+		return(false);
+	}
+
+	Clear();
+	m_lightSetup = lightSetup;
+
+	return(true);
+}
+
+/***********************************************************
+ *  GetProgram()
+ *
+ *  This method is used for getting the program of a
+ *  permutation, which is built the first time it is asked
+ *  for.
+ ***********************************************************/
+ShaderProgram* ShaderPermutations::GetProgram(int permutation)
+{
+	if ((m_pPrograms[permutation] == NULL) && (m_bFailed[permutation] == false))
+	{
+		Build(permutation);
+	}
+
+	return(m_pPrograms[permutation]);
+}
+
+/***********************************************************
+ *  Reload()
+ *
+ *  This method is used for building the permutations in
+ *  use again from the changed shader files.  A built one
+ *  keeps its last working program when the rebuild fails,
+ *  and one that failed before is tried again.
+ ***********************************************************/
+bool ShaderPermutations::Reload()
+{
+	bool bLoaded = true;
+	for (int i = 0; i < PERMUTATION_COUNT; i++)
+	{
+		if (m_pPrograms[i] != NULL)
+		{
+			bLoaded = (m_pPrograms[i]->Reload() && bLoaded);
+			m_pUniforms[i]->ResolveLocations(m_pPrograms[i]->GetProgramID());
+		}
+		else if (m_bFailed[i] == true)
+		{
+			m_bFailed[i] = false;
+			bLoaded = (Build(i) && bLoaded);
+		}
+	}
+
+	return(bLoaded);
+}
+
+/***********************************************************
+ *  Clear()
+ *
+ *  This method is used for dropping every built
+ *  permutation.
+ ***********************************************************/
+void ShaderPermutations::Clear()
+{
+	for (int i = 0; i < PERMUTATION_COUNT; i++)
+	{
+		delete m_pPrograms[i];
+		m_pPrograms[i] = NULL;
+		delete m_pUniforms[i];
+		m_pUniforms[i] = NULL;
+		m_bFailed[i] = false;
+	}
+}
+
+/***********************************************************
+ *  GetPermutation()
+ *
+ *  This method is used for getting the permutation index
+ *  of a draw.
+ ***********************************************************/
+int ShaderPermutations::GetPermutation(bool bTextured, bool bLit)
+{
+	int permutation = 0;
+	if (bTextured == true)
+	{
+		permutation |= PERMUTATION_TEXTURED;
+	}
+	if (bLit == true)
+	{
+		permutation |= PERMUTATION_LIT;
+	}
+
+	return(permutation);
+}
+
+/***********************************************************
+ *  GetDefines()
+ *
+ *  This method is used for writing the defines of a
+ *  permutation after the base defines.  See the top of
+ *  the fragment shader for how each one is used.
+ ***********************************************************/
+std::string ShaderPermutations::GetDefines(int permutation) const
+{
+	std::ostringstream defines;
+	defines << m_defines;
+	defines << "#define OBJECT_TEXTURED " << (((permutation & PERMUTATION_TEXTURED) != 0) ? "true" : "false") << "\n";
+	defines << "#define OBJECT_LIT " << (((permutation & PERMUTATION_LIT) != 0) ? "true" : "false") << "\n";
+	defines << "#define DIRECTIONAL_LIGHT_ON " << ((m_lightSetup.bDirectionalLight == true) ? "true" : "false") << "\n";
+	defines << "#define SPOT_LIGHT_ON " << ((m_lightSetup.bSpotLight == true) ? "true" : "false") << "\n";
+	defines << "#define ACTIVE_POINT_LIGHTS " << m_lightSetup.pointLightCount << "\n";
+
+	return(defines.str());
+}
+
+/***********************************************************
+ *  Build()
+ *
+ *  This method is used for building the program of a
+ *  permutation and looking up its per-draw uniforms.
+ ***********************************************************/
+bool ShaderPermutations::Build(int permutation)
+{
+	if (m_vertexShaderPath.empty() == true)
+	{
+		m_bFailed[permutation] = true;
+		return(false);
+	}
+
+	ShaderProgram* pProgram = new ShaderProgram();
+	bool bLoaded = pProgram->Load(
+		m_vertexShaderPath.c_str(),
+		m_fragmentShaderPath.c_str(),
+		m_versionLine.c_str(),
+		GetDefines(permutation));
+	if (bLoaded == false)
+	{
+		delete pProgram;
+		m_bFailed[permutation] = true;
+		return(false);
+	}
+
+	m_pPrograms[permutation] = pProgram;
+	m_pUniforms[permutation] = new ShaderUniforms();
+	m_pUniforms[permutation]->ResolveLocations(pProgram->GetProgramID());
+
+	return(true);
+}
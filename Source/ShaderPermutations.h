@@ -0,0 +1,105 @@
+///////////////////////////////////////////////////////////////////////////////
+// shaderpermutations.h
+// ============
+// build the scene shaders specialized for each kind of draw and the lights
+// that are on, instead of branching on them at run time
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+//  Notes: The scene shaders used to test bUseLighting, bUseTexture and the
+//         bActive flag of every light for each fragment.  A permutation is
+//         built with those fixed by #defines, so the branches fold away and
+//         only the code a draw needs is left.  The draw gives two bits -
+//         textured and lit - and the scene gives the light setup: whether
+//         the directional and spot lights are on, and how many point lights
+//         are packed at the front of the light block.  The four draw
+//         permutations are only built the first time a draw asks for one,
+//         and all of them are dropped when the light setup changes, so only
+//         the programs the current scene uses are ever compiled.  Each one
+//         is a ShaderProgram, so it comes from the program binary cache
+//         after the first run.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShaderProgram.h"
+#include "ShaderUniforms.h"
+
+#include <string>
+
+/***********************************************************
+ *  ShaderPermutations
+ *
+ *  This class holds the source one set of scene shaders is
+ *  built from and the permutations built from it so far.
+ ***********************************************************/
+class ShaderPermutations
+{
+public:
+	// the bits of a permutation index
+	enum PERMUTATION_FLAG
+	{
+		PERMUTATION_TEXTURED = 1,
+		PERMUTATION_LIT = 2,
+		PERMUTATION_COUNT = 4
+	};
+
+	// the lights that are on, the same for every draw of a frame
+	struct LIGHT_SETUP
+	{
+		bool bDirectionalLight;
+		bool bSpotLight;
+		// active point lights at the front of the light block
+		int pointLightCount;
+	};
+
+	// constructor
+	ShaderPermutations();
+	// destructor
+	~ShaderPermutations();
+
+	// set the files, version line and defines the permutations
+	// are built from - the built ones are dropped
+	void SetSource(
+		const char* vertexShaderPath,
+		const char* fragmentShaderPath,
+		const char* versionLine,
+		const std::string& defines);
+	// set the light setup the permutations are built for - the
+	// built ones are dropped when it changed, and true returned
+	bool SetLightSetup(const LIGHT_SETUP& lightSetup);
+
+	// get the program of a permutation, building it the first
+	// time - NULL when it fails to build
+	ShaderProgram* GetProgram(int permutation);
+	// get the uniforms of a built permutation
+	ShaderUniforms* GetUniforms(int permutation) const { return(m_pUniforms[permutation]); }
+
+	// build the permutations that are in use again after the
+	// shader files changed - false when any of them failed
+	bool Reload();
+	// drop every built permutation
+	void Clear();
+
+	// get the permutation of a draw
+	static int GetPermutation(bool bTextured, bool bLit);
+
+private:
+	// built programs, NULL until first asked for
+	ShaderProgram* m_pPrograms[PERMUTATION_COUNT];
+	ShaderUniforms* m_pUniforms[PERMUTATION_COUNT];
+	// set when a permutation failed to build, so a broken shader
+	// is not compiled again for every draw
+	bool m_bFailed[PERMUTATION_COUNT];
+
+	std::string m_vertexShaderPath;
+	std::string m_fragmentShaderPath;
+	std::string m_versionLine;
+	std::string m_defines;
+	LIGHT_SETUP m_lightSetup;
+
+	// get the defines of a permutation, after the base defines
+	std::string GetDefines(int permutation) const;
+	// build the program of a permutation
+	bool Build(int permutation);
+};
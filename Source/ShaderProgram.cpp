@@ -0,0 +1,434 @@
+///////////////////////////////////////////////////////////////////////////////
+// shaderprogram.cpp
+// ============
+// compile and link a shader program from the GLSL files with a different
+// #version line and extra #defines
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ShaderProgram.h"
+#include "RenderStats.h"
+
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <direct.h>
+#endif
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+// declaration of global variables
+namespace
+{
+	// marks the start of a program binary cache file
+	const unsigned int BINARY_CACHE_MAGIC = 0x42505343;
+
+	// start of a program binary cache file, followed by the binary
+	struct BINARY_CACHE_HEADER
+	{
+		unsigned int magic;
+		GLenum format;
+		GLint length;
+	};
+
+	// FNV-1a hash of a string, continued from a previous hash
+	unsigned long long HashText(const char* text, size_t length, unsigned long long hash)
+	{
+		for (size_t i = 0; i < length; i++)
+		{
+			hash ^= (unsigned char)text[i];
+			hash *= 1099511628211ULL;
+		}
+
+		return(hash);
+	}
+}
+
+std::string ShaderProgram::m_binaryCacheFolder = "shadercache";
+
+/***********************************************************
+ *  ShaderProgram()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ShaderProgram::ShaderProgram()
+{
+	m_pProgram = new GpuResource(GpuResource::RESOURCE_PROGRAM);
+}
+
+/***********************************************************
+ *  ~ShaderProgram()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+ShaderProgram::~ShaderProgram()
+{
+	delete m_pProgram;
+	m_pProgram = NULL;
+}
+
+/***********************************************************
+ *  ReadSource()
+ *
+ *  This method is used for reading a shader file into a
+ *  string.  A UTF-8 byte order mark and the file's own
+ *  #version line are dropped, and the passed in version
+ *  line and defines are put at the top instead.
+ ***********************************************************/
+bool ShaderProgram::ReadSource(
+	const char* filePath,
+	const char* versionLine,
+	const std::string& defines,
+	std::string& source)
+{
+	std::ifstream file(filePath, std::ios::in | std::ios::binary);
+	if (!file.is_open())
+	{
+		std::cout << "Could not open shader file:" << filePath << std::endl;
+		return(false);
+	}
+
+	std::stringstream buffer;
+	buffer << file.rdbuf();
+	std::string text = buffer.str();
+
+	// skip the byte order mark
+	if ((text.size() >= 3) && (text.compare(0, 3, "\xEF\xBB\xBF") == 0))
+	{
+		text.erase(0, 3);
+	}
+
+	// drop the first line when it is the #version line
+	size_t start = text.find_first_not_of(" \t\r\n");
+	if ((start != std::string::npos) && (text.compare(start, 8, "#version") == 0))
+	{
+		size_t end = text.find('\n', start);
+		text.erase(0, (end == std::string::npos) ? text.size() : end + 1);
+	}
+
+	source = std::string(versionLine) + "\n" + defines + "#line 2\n" + text;
+
+	return(true);
+}
+
+/***********************************************************
+ *  CompileStage()
+ *
+ *  This method is used for compiling one shader stage.
+ *  The compile log is written out on failure.
+ ***********************************************************/
+GLuint ShaderProgram::CompileStage(
+	GLenum stage,
+	const std::string& source,
+	const char* filePath)
+{
+	GLuint shader = glCreateShader(stage);
+	const char* text = source.c_str();
+	glShaderSource(shader, 1, &text, NULL);
+	glCompileShader(shader);
+
+	GLint bCompiled = GL_FALSE;
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &bCompiled);
+	if (bCompiled == GL_FALSE)
+	{
+		char infoLog[1024];
+		glGetShaderInfoLog(shader, sizeof(infoLog), NULL, infoLog);
+		std::cout << "Shader compile failed:" << filePath << std::endl << infoLog << std::endl;
+		glDeleteShader(shader);
+		return(0);
+	}
+
+	return(shader);
+}
+
+/***********************************************************
+ *  BuildProgram()
+ *
+ *  This method is used for compiling the vertex and
+ *  fragment sources and linking them into a new program.
+ *  The link log is written out on failure.
+ ***********************************************************/
+GLuint ShaderProgram::BuildProgram(const std::string& vertexSource, const std::string& fragmentSource) const
+{
+	GLuint vertexShader = CompileStage(GL_VERTEX_SHADER, vertexSource, m_vertexShaderPath.c_str());
+	GLuint fragmentShader = CompileStage(GL_FRAGMENT_SHADER, fragmentSource, m_fragmentShaderPath.c_str());
+	if ((vertexShader == 0) || (fragmentShader == 0))
+	{
+		glDeleteShader(vertexShader);
+		glDeleteShader(fragmentShader);
+		return(0);
+	}
+
+	GLuint programID = glCreateProgram();
+	if (IsBinaryCacheSupported() == true)
+	{
+		glProgramParameteri(programID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	}
+	glAttachShader(programID, vertexShader);
+	glAttachShader(programID, fragmentShader);
+	glLinkProgram(programID);
+
+	// the stages are no longer needed once linked
+	glDeleteShader(vertexShader);
+	glDeleteShader(fragmentShader);
+
+	GLint bLinked = GL_FALSE;
+	glGetProgramiv(programID, GL_LINK_STATUS, &bLinked);
+	if (bLinked == GL_FALSE)
+	{
+		char infoLog[1024];
+		glGetProgramInfoLog(programID, sizeof(infoLog), NULL, infoLog);
+		std::cout << "Shader program link failed:" << m_vertexShaderPath << ", "
+			<< m_fragmentShaderPath << std::endl << infoLog << std::endl;
+		glDeleteProgram(programID);
+		return(0);
+	}
+
+	return(programID);
+}
+
+/***********************************************************
+ *  IsBinaryCacheSupported()
+ *
+ *  This method is used for checking whether the binary
+ *  cache is turned on and the driver has at least one
+ *  program binary format.
+ ***********************************************************/
+bool ShaderProgram::IsBinaryCacheSupported()
+{
+	if ((m_binaryCacheFolder.empty() == true) ||
+		((GLEW_VERSION_4_1 == GL_FALSE) && (GLEW_ARB_get_program_binary == GL_FALSE)))
+	{
+		return(false);
+	}
+
+	GLint formatCount = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+
+	return(formatCount > 0);
+}
+
+/***********************************************************
+ *  GetBinaryCacheFilename()
+ *
+ *  This method is used for naming the cache file of a pair
+ *  of sources.  The name hashes the sources along with the
+ *  renderer and driver version, since a binary is only
+ *  good for the driver that made it.
+ ***********************************************************/
+std::string ShaderProgram::GetBinaryCacheFilename(const std::string& vertexSource, const std::string& fragmentSource)
+{
+	const char* renderer = (const char*)glGetString(GL_RENDERER);
+	const char* version = (const char*)glGetString(GL_VERSION);
+	std::string driver = std::string(renderer ? renderer : "") + "|" + (version ? version : "");
+
+	// a separator keeps the stage boundary part of the hash
+	unsigned long long hash = 14695981039346656037ULL;
+	hash = HashText(vertexSource.c_str(), vertexSource.size(), hash);
+	hash = HashText("|", 1, hash);
+	hash = HashText(fragmentSource.c_str(), fragmentSource.size(), hash);
+	hash = HashText("|", 1, hash);
+	hash = HashText(driver.c_str(), driver.size(), hash);
+
+	char name[32];
+	snprintf(name, sizeof(name), "%016llx.bin", hash);
+
+	return(m_binaryCacheFolder + "/" + name);
+}
+
+/***********************************************************
+ *  LoadBinary()
+ *
+ *  This method is used for creating a program from a saved
+ *  binary.  A driver that has been updated since the file
+ *  was saved may refuse it, so the link status is checked.
+ ***********************************************************/
+GLuint ShaderProgram::LoadBinary(const std::string& filename)
+{
+	std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+	if (!file.is_open())
+	{
+		return(0);
+	}
+
+	BINARY_CACHE_HEADER header;
+	if ((!file.read((char*)&header, sizeof(header))) ||
+		(header.magic != BINARY_CACHE_MAGIC) ||
+		(header.length <= 0))
+	{
+		return(0);
+	}
+
+	std::vector<char> binary(header.length);
+	if (!file.read(binary.data(), header.length))
+	{
+		return(0);
+	}
+
+	GLuint programID = glCreateProgram();
+	glProgramBinary(programID, header.format, binary.data(), header.length);
+
+	GLint bLinked = GL_FALSE;
+	glGetProgramiv(programID, GL_LINK_STATUS, &bLinked);
+	if (bLinked == GL_FALSE)
+	{
+		glDeleteProgram(programID);
+		return(0);
+	}
+
+	return(programID);
+}
+
+/***********************************************************
+ *  SaveBinary()
+ *
+ *  This method is used for writing the binary of a linked
+ *  program to the cache.  A cache that cannot be written
+ *  only costs the next start its compile time.
+ ***********************************************************/
+void ShaderProgram::SaveBinary(GLuint programID, const std::string& filename)
+{
+	BINARY_CACHE_HEADER header;
+	header.magic = BINARY_CACHE_MAGIC;
+	header.format = 0;
+	header.length = 0;
+	glGetProgramiv(programID, GL_PROGRAM_BINARY_LENGTH, &header.length);
+	if (header.length <= 0)
+	{
+		return;
+	}
+
+	std::vector<char> binary(header.length);
+	glGetProgramBinary(programID, header.length, &header.length, &header.format, binary.data());
+
+	// the folder is made the first time a binary is saved
+#ifdef _WIN32
+	_mkdir(m_binaryCacheFolder.c_str());
+#else
+	mkdir(m_binaryCacheFolder.c_str(), 0755);
+#endif
+
+	std::ofstream file(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+	{
+		return;
+	}
+
+	file.write((const char*)&header, sizeof(header));
+	file.write(binary.data(), header.length);
+}
+
+/***********************************************************
+ *  SetBinaryCacheFolder()
+ *
+ *  This method is used for setting the folder the program
+ *  binaries are saved in.
+ ***********************************************************/
+void ShaderProgram::SetBinaryCacheFolder(const std::string& folder)
+{
+	m_binaryCacheFolder = folder;
+}
+
+/***********************************************************
+ *  Load()
+ *
+ *  This method is used for compiling and linking the
+ *  vertex and fragment shader files into a program.  A
+ *  loaded program is only replaced once the new one has
+ *  linked.  The program comes from the binary cache when
+ *  the same sources were built before on this driver.
+ *
+ *  Edited on: October 14, 2026
+ *  Notes: The program is counted in the GpuResources tally
+ *         by its binary length, when the driver reports it.
+ ***********************************************************/
+bool ShaderProgram::Load(
+	const char* vertexShaderPath,
+	const char* fragmentShaderPath,
+	const char* versionLine,
+	const std::string& defines)
+{
+	m_vertexShaderPath = vertexShaderPath;
+	m_fragmentShaderPath = fragmentShaderPath;
+	m_versionLine = versionLine;
+	m_defines = defines;
+
+	std::string vertexSource;
+	std::string fragmentSource;
+
+	if ((ReadSource(vertexShaderPath, versionLine, defines, vertexSource) == false) ||
+		(ReadSource(fragmentShaderPath, versionLine, defines, fragmentSource) == false))
+	{
+		return(false);
+	}
+
+	GLuint programID = 0;
+	bool bUseCache = IsBinaryCacheSupported();
+	std::string cacheFilename;
+	if (bUseCache == true)
+	{
+		cacheFilename = GetBinaryCacheFilename(vertexSource, fragmentSource);
+		programID = LoadBinary(cacheFilename);
+	}
+
+	if (programID == 0)
+	{
+		programID = BuildProgram(vertexSource, fragmentSource);
+		if (programID == 0)
+		{
+			return(false);
+		}
+
+		if (bUseCache == true)
+		{
+			SaveBinary(programID, cacheFilename);
+		}
+	}
+
+	GLint binaryLength = 0;
+	if (bUseCache == true)
+	{
+		glGetProgramiv(programID, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+	}
+	m_pProgram->Reset(programID, binaryLength);
+
+	return(true);
+}
+
+/***********************************************************
+ *  Reload()
+ *
+ *  This method is used for building the program again from
+ *  the files, version line and defines of the last Load().
+ ***********************************************************/
+bool ShaderProgram::Reload()
+{
+	if (m_vertexShaderPath.empty() == true)
+	{
+		return(false);
+	}
+
+	// Load() overwrites the members, so pass it copies
+	std::string vertexShaderPath = m_vertexShaderPath;
+	std::string fragmentShaderPath = m_fragmentShaderPath;
+	std::string versionLine = m_versionLine;
+	std::string defines = m_defines;
+
+	return(Load(vertexShaderPath.c_str(), fragmentShaderPath.c_str(), versionLine.c_str(), defines));
+}
+
+/***********************************************************
+ *  Use()
+ *
+ *  This method is used for putting the program in use.
+ ***********************************************************/
+void ShaderProgram::Use() const
+{
+	glUseProgram(m_pProgram->GetName());
+	RenderStats::Add(RenderStats::COUNTER_PROGRAM_BINDS);
+}
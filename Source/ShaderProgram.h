@@ -0,0 +1,106 @@
+///////////////////////////////////////////////////////////////////////////////
+// shaderprogram.h
+// ============
+// compile and link a shader program from the GLSL files with a different
+// #version line and extra #defines
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+//  Notes: The ShaderManager compiles the shader files exactly as written.
+//         This class is used for the variants of the same files that need
+//         a newer GLSL version or a feature turned on by a #define, such
+//         as the multi-draw indirect path.
+//         Each program keeps the files, version line and defines it was
+//         built from, so Reload() can rebuild it after the files change.
+//         A rebuild that fails keeps the program that was working.
+//         Linked programs are saved with glGetProgramBinary() under the
+//         shadercache folder, named by a hash of the final sources and the
+//         GL renderer and version.  A later Load() of the same sources on
+//         the same driver hands the saved binary back to the driver instead
+//         of compiling, and compiles as usual when the driver rejects it.
+//         An edited shader file hashes differently, so a reload is never
+//         served a stale binary.
+//         The linked program is owned by a GpuResource, which deletes the
+//         one a reload replaces and counts it in the GpuResources tally.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "GpuResources.h"
+
+#include <GL/glew.h>
+
+#include <string>
+
+/***********************************************************
+ *  ShaderProgram
+ *
+ *  This class owns one linked shader program.
+ ***********************************************************/
+class ShaderProgram
+{
+public:
+	// constructor
+	ShaderProgram();
+	// destructor
+	~ShaderProgram();
+
+	// compile and link the vertex and fragment shader files -
+	// the #version line of each file is replaced by the
+	// passed in one and the defines are added after it
+	bool Load(
+		const char* vertexShaderPath,
+		const char* fragmentShaderPath,
+		const char* versionLine,
+		const std::string& defines);
+
+	// compile and link the program again from the same files,
+	// version line and defines - the old program is kept when
+	// the new one fails to build
+	bool Reload();
+
+	// put the program in use
+	void Use() const;
+	// get the linked program, 0 when not loaded
+	GLuint GetProgramID() const { return(m_pProgram->GetName()); }
+
+	// set the folder the program binaries are saved in - an
+	// empty name turns the binary cache off
+	static void SetBinaryCacheFolder(const std::string& folder);
+
+private:
+	// the program binary cache folder, shared by every program
+	static std::string m_binaryCacheFolder;
+
+	// the linked program
+	GpuResource* m_pProgram;
+	// what the program was last loaded from
+	std::string m_vertexShaderPath;
+	std::string m_fragmentShaderPath;
+	std::string m_versionLine;
+	std::string m_defines;
+
+	// read a shader file and swap in the version and defines
+	static bool ReadSource(
+		const char* filePath,
+		const char* versionLine,
+		const std::string& defines,
+		std::string& source);
+	// compile one shader stage, 0 on failure
+	static GLuint CompileStage(
+		GLenum stage,
+		const std::string& source,
+		const char* filePath);
+	// compile and link the sources into a new program, 0 on failure
+	GLuint BuildProgram(const std::string& vertexSource, const std::string& fragmentSource) const;
+
+	// check whether the driver can save and restore program binaries
+	static bool IsBinaryCacheSupported();
+	// get the cache file of a pair of sources on this driver
+	static std::string GetBinaryCacheFilename(const std::string& vertexSource, const std::string& fragmentSource);
+	// create a program from a saved binary, 0 when there is none
+	// or the driver rejects it
+	static GLuint LoadBinary(const std::string& filename);
+	// save the binary of a linked program
+	static void SaveBinary(GLuint programID, const std::string& filename);
+};
@@ -0,0 +1,205 @@
+///////////////////////////////////////////////////////////////////////////////
+// shaderuniforms.cpp
+// ============
+// resolve the per-draw shader uniform locations once and skip redundant
+// uniform uploads
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ShaderUniforms.h"
+#include "RenderStats.h"
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include <cstring>
+
+// declaration of global variables
+namespace
+{
+	// uniform names, in UNIFORM_ID order
+	const char* g_UniformNames[ShaderUniforms::UNIFORM_COUNT] =
+	{
+		"objectTexture",
+		"directionalShadowMap",
+		"pointShadowMap",
+		"firstDraw"
+	};
+
+	// uniform block names, in UNIFORM_BLOCK_BINDING order
+	const char* g_UniformBlockNames[ShaderUniforms::BLOCK_COUNT] =
+	{
+		"MaterialBlock",
+		"LightBlock",
+		"FrameBlock",
+		"TextureBlock"
+	};
+}
+
+/***********************************************************
+ *  ShaderUniforms()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ShaderUniforms::ShaderUniforms()
+{
+	for (int i = 0; i < UNIFORM_COUNT; i++)
+	{
+		m_slots[i].location = -1;
+		m_slots[i].bValid = false;
+	}
+}
+
+/***********************************************************
+ *  ResolveLocations()
+ *
+ *  This method is used for looking up the location of
+ *  every per-draw uniform in the passed in program.  It is
+ *  called once after the program has been linked.  The
+ *  program's uniform blocks are also attached to the shared
+ *  binding points, so the material and light buffers do not
+ *  depend on which program is bound.
+ ***********************************************************/
+void ShaderUniforms::ResolveLocations(GLuint programID)
+{
+	for (int i = 0; i < UNIFORM_COUNT; i++)
+	{
+		m_slots[i].location = glGetUniformLocation(programID, g_UniformNames[i]);
+	}
+
+	for (int i = 0; i < BLOCK_COUNT; i++)
+	{
+		GLuint blockIndex = glGetUniformBlockIndex(programID, g_UniformBlockNames[i]);
+		if (blockIndex != GL_INVALID_INDEX)
+		{
+			glUniformBlockBinding(programID, blockIndex, i);
+		}
+	}
+
+	Invalidate();
+}
+
+/***********************************************************
+ *  Invalidate()
+ *
+ *  This method is used for dropping the shadowed values,
+ *  for when the uniforms may have been set elsewhere.
+ ***********************************************************/
+void ShaderUniforms::Invalidate()
+{
+	for (int i = 0; i < UNIFORM_COUNT; i++)
+	{
+		m_slots[i].bValid = false;
+	}
+}
+
+/***********************************************************
+ *  UpdateShadow()
+ *
+ *  This method is used for comparing a new value against
+ *  the last uploaded one.  The shadow copy is updated and
+ *  true is returned when the value needs to be uploaded.
+ *  Both outcomes are counted in the render statistics.
+ ***********************************************************/
+bool ShaderUniforms::UpdateShadow(UNIFORM_ID id, const void* value, int size)
+{
+	UNIFORM_SLOT& slot = m_slots[id];
+
+	// nothing to upload for a uniform the program does not use
+	if (slot.location < 0)
+	{
+		return(false);
+	}
+
+	if ((slot.bValid == true) && (memcmp(slot.value, value, size) == 0))
+	{
+		RenderStats::Add(RenderStats::COUNTER_UNIFORM_REDUNDANT);
+		return(false);
+	}
+
+	memcpy(slot.value, value, size);
+	slot.bValid = true;
+	RenderStats::Add(RenderStats::COUNTER_UNIFORM_UPLOADS);
+
+	return(true);
+}
+
+/***********************************************************
+ *  SetInt()
+ *
+ *  This method is used for setting an int, bool or
+ *  sampler uniform value.
+ ***********************************************************/
+void ShaderUniforms::SetInt(UNIFORM_ID id, int value)
+{
+	if (UpdateShadow(id, &value, sizeof(value)) == true)
+	{
+		glUniform1i(m_slots[id].location, value);
+	}
+}
+
+/***********************************************************
+ *  SetFloat()
+ *
+ *  This method is used for setting a float uniform value.
+ ***********************************************************/
+void ShaderUniforms::SetFloat(UNIFORM_ID id, float value)
+{
+	if (UpdateShadow(id, &value, sizeof(value)) == true)
+	{
+		glUniform1f(m_slots[id].location, value);
+	}
+}
+
+/***********************************************************
+ *  SetVec2()
+ *
+ *  This method is used for setting a vec2 uniform value.
+ ***********************************************************/
+void ShaderUniforms::SetVec2(UNIFORM_ID id, const glm::vec2& value)
+{
+	if (UpdateShadow(id, glm::value_ptr(value), sizeof(float) * 2) == true)
+	{
+		glUniform2fv(m_slots[id].location, 1, glm::value_ptr(value));
+	}
+}
+
+/***********************************************************
+ *  SetVec3()
+ *
+ *  This method is used for setting a vec3 uniform value.
+ ***********************************************************/
+void ShaderUniforms::SetVec3(UNIFORM_ID id, const glm::vec3& value)
+{
+	if (UpdateShadow(id, glm::value_ptr(value), sizeof(float) * 3) == true)
+	{
+		glUniform3fv(m_slots[id].location, 1, glm::value_ptr(value));
+	}
+}
+
+/***********************************************************
+ *  SetVec4()
+ *
+ *  This method is used for setting a vec4 uniform value.
+ ***********************************************************/
+void ShaderUniforms::SetVec4(UNIFORM_ID id, const glm::vec4& value)
+{
+	if (UpdateShadow(id, glm::value_ptr(value), sizeof(float) * 4) == true)
+	{
+		glUniform4fv(m_slots[id].location, 1, glm::value_ptr(value));
+	}
+}
+
+/***********************************************************
+ *  SetMat4()
+ *
+ *  This method is used for setting a mat4 uniform value.
+ ***********************************************************/
+void ShaderUniforms::SetMat4(UNIFORM_ID id, const glm::mat4& value)
+{
+	if (UpdateShadow(id, glm::value_ptr(value), sizeof(float) * 16) == true)
+	{
+		glUniformMatrix4fv(m_slots[id].location, 1, GL_FALSE, glm::value_ptr(value));
+	}
+}
@@ -0,0 +1,87 @@
+///////////////////////////////////////////////////////////////////////////////
+// shaderuniforms.h
+// ============
+// resolve the per-draw shader uniform locations once and skip redundant
+// uniform uploads
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+//  Notes: The ShaderManager setters look every uniform up by name on each
+//         call.  This class looks the per-draw uniforms up once after the
+//         program is linked and keeps a shadow copy of the last value sent
+//         to each one, so unchanged values never reach the driver.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <glm/glm.hpp>
+
+/***********************************************************
+ *  ShaderUniforms
+ *
+ *  This class holds the resolved uniform locations of one
+ *  linked shader program along with the last value that
+ *  was uploaded to each of them.
+ ***********************************************************/
+class ShaderUniforms
+{
+public:
+	// the uniforms that are set for every draw - the model matrix,
+	// color, UV scale and material are per-instance attributes, and
+	// whether the draw is lit and textured is built into its shader
+	// permutation
+	enum UNIFORM_ID
+	{
+		UNIFORM_OBJECT_TEXTURE = 0,
+		UNIFORM_DIRECTIONAL_SHADOW_MAP,
+		UNIFORM_POINT_SHADOW_MAP,
+		UNIFORM_FIRST_DRAW,        // multi-draw indirect programs only
+		UNIFORM_COUNT
+	};
+
+	// uniform buffer binding points shared by every program
+	enum UNIFORM_BLOCK_BINDING
+	{
+		BLOCK_MATERIALS = 0,
+		BLOCK_LIGHTS,
+		BLOCK_FRAME,
+		BLOCK_TEXTURES,            // bindless texture programs only
+		BLOCK_COUNT
+	};
+
+	// constructor
+	ShaderUniforms();
+
+	// look up the uniform locations of a linked program and
+	// attach its uniform blocks to the shared binding points
+	void ResolveLocations(GLuint programID);
+	// forget the shadowed values so the next set always uploads
+	void Invalidate();
+
+	// set uniform values - skipped when unchanged
+	void SetInt(UNIFORM_ID id, int value);
+	void SetFloat(UNIFORM_ID id, float value);
+	void SetVec2(UNIFORM_ID id, const glm::vec2& value);
+	void SetVec3(UNIFORM_ID id, const glm::vec3& value);
+	void SetVec4(UNIFORM_ID id, const glm::vec4& value);
+	void SetMat4(UNIFORM_ID id, const glm::mat4& value);
+
+private:
+	struct UNIFORM_SLOT
+	{
+		// location in the linked program, -1 when not used
+		GLint location;
+		// false until a value has been uploaded
+		bool bValid;
+		// last uploaded value - large enough for a mat4
+		float value[16];
+	};
+
+	UNIFORM_SLOT m_slots[UNIFORM_COUNT];
+
+	// store the value in the shadow copy and return
+	// true when it differs from the last upload
+	bool UpdateShadow(UNIFORM_ID id, const void* value, int size);
+};
@@ -0,0 +1,312 @@
+///////////////////////////////////////////////////////////////////////////////
+// shadowmaps.cpp
+// ============
+// hold the shadow maps of the directional light and the lamp bulb
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ShadowMaps.h"
+#include "RenderStats.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	// sampler names in the fragment shader, in texture unit order
+	const char* g_SamplerNames[ShadowMaps::TEXTURE_COUNT] =
+	{
+		"directionalShadowMap",
+		"pointShadowMap"
+	};
+
+	// look and up directions of each cube face, in the face order
+	// the cube map sampler picks them by
+	const glm::vec3 g_CubeFaceDirections[ShadowMaps::CUBE_FACE_COUNT][2] =
+	{
+		{ glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f) },
+		{ glm::vec3(-1.0f, 0.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f) },
+		{ glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f) },
+		{ glm::vec3(0.0f, -1.0f, 0.0f), glm::vec3(0.0f, 0.0f, -1.0f) },
+		{ glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, -1.0f, 0.0f) },
+		{ glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, -1.0f, 0.0f) }
+	};
+
+	/***********************************************************
+	 *  SetShadowSampling()
+	 *
+	 *  Set the bound depth texture to compare against the
+	 *  lookup depth with linear filtering, which gives each
+	 *  tap the blend of its four nearest comparisons.
+	 ***********************************************************/
+	void SetShadowSampling(GLenum target)
+	{
+		glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(target, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+		glTexParameteri(target, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+	}
+}
+
+// near enough for the lamp parts right around the bulb
+const float ShadowMaps::CUBE_NEAR_PLANE = 0.05f;
+
+/***********************************************************
+ *  ShadowMaps()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ShadowMaps::ShadowMaps()
+{
+	m_framebuffer = 0;
+	m_directionalTexture = 0;
+	m_cubeTexture = 0;
+	m_previousFramebuffer = -1;
+	for (int i = 0; i < 4; i++)
+	{
+		m_previousViewport[i] = 0;
+	}
+}
+
+/***********************************************************
+ *  ~ShadowMaps()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+ShadowMaps::~ShadowMaps()
+{
+	Destroy();
+}
+
+/***********************************************************
+ *  Destroy()
+ *
+ *  This method is used for freeing the framebuffer and the
+ *  map textures.
+ ***********************************************************/
+void ShadowMaps::Destroy()
+{
+	if (m_framebuffer != 0)
+	{
+		glDeleteFramebuffers(1, &m_framebuffer);
+		m_framebuffer = 0;
+	}
+	if (m_directionalTexture != 0)
+	{
+		glDeleteTextures(1, &m_directionalTexture);
+		m_directionalTexture = 0;
+	}
+	if (m_cubeTexture != 0)
+	{
+		glDeleteTextures(1, &m_cubeTexture);
+		m_cubeTexture = 0;
+	}
+}
+
+/***********************************************************
+ *  Create()
+ *
+ *  This method is used for creating the directional and
+ *  cube map depth textures and the framebuffer they are
+ *  drawn through.  Lookups past the edge of the directional
+ *  map read the far depth, so nothing outside it is in
+ *  shadow.
+ ***********************************************************/
+bool ShadowMaps::Create()
+{
+	Destroy();
+
+	glGenTextures(1, &m_directionalTexture);
+	glBindTexture(GL_TEXTURE_2D, m_directionalTexture);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, DIRECTIONAL_SIZE, DIRECTIONAL_SIZE, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
+	SetShadowSampling(GL_TEXTURE_2D);
+	const GLfloat border[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+	glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, border);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	glGenTextures(1, &m_cubeTexture);
+	glBindTexture(GL_TEXTURE_CUBE_MAP, m_cubeTexture);
+	for (int face = 0; face < CUBE_FACE_COUNT; face++)
+	{
+		glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, GL_DEPTH_COMPONENT24, CUBE_SIZE, CUBE_SIZE, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
+	}
+	SetShadowSampling(GL_TEXTURE_CUBE_MAP);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+	glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+
+	GLint previousFramebuffer = 0;
+	glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFramebuffer);
+
+	// depth only - there is no color target to write
+	glGenFramebuffers(1, &m_framebuffer);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_framebuffer);
+	glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_directionalTexture, 0);
+	glDrawBuffer(GL_NONE);
+	glReadBuffer(GL_NONE);
+
+	GLenum status = glCheckFramebufferStatus(GL_DRAW_FRAMEBUFFER);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, previousFramebuffer);
+	if (status != GL_FRAMEBUFFER_COMPLETE)
+	{
+		std::cout << "Shadow map framebuffer is incomplete: 0x" << std::hex << status << std::dec << std::endl;
+		Destroy();
+		return(false);
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  SaveTarget()
+ *
+ *  This method is used for saving the framebuffer and the
+ *  viewport the maps are drawn over, the first time one of
+ *  them is bound.
+ ***********************************************************/
+void ShadowMaps::SaveTarget()
+{
+	if (m_previousFramebuffer < 0)
+	{
+		glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &m_previousFramebuffer);
+		glGetIntegerv(GL_VIEWPORT, m_previousViewport);
+	}
+}
+
+/***********************************************************
+ *  BindDirectional()
+ *
+ *  This method is used for binding the directional map for
+ *  drawing and clearing it to the far depth.
+ ***********************************************************/
+void ShadowMaps::BindDirectional()
+{
+	SaveTarget();
+
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_framebuffer);
+	glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_directionalTexture, 0);
+	glViewport(0, 0, DIRECTIONAL_SIZE, DIRECTIONAL_SIZE);
+	glClear(GL_DEPTH_BUFFER_BIT);
+}
+
+/***********************************************************
+ *  BindCubeFace()
+ *
+ *  This method is used for binding one face of the cube
+ *  map for drawing and clearing it to the far depth.
+ ***********************************************************/
+void ShadowMaps::BindCubeFace(int face)
+{
+	SaveTarget();
+
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_framebuffer);
+	glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, m_cubeTexture, 0);
+	glViewport(0, 0, CUBE_SIZE, CUBE_SIZE);
+	glClear(GL_DEPTH_BUFFER_BIT);
+}
+
+/***********************************************************
+ *  Unbind()
+ *
+ *  This method is used for binding back the framebuffer
+ *  and viewport the maps were drawn over.
+ ***********************************************************/
+void ShadowMaps::Unbind()
+{
+	if (m_previousFramebuffer < 0)
+	{
+		return;
+	}
+
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_previousFramebuffer);
+	glViewport(m_previousViewport[0], m_previousViewport[1], m_previousViewport[2], m_previousViewport[3]);
+	m_previousFramebuffer = -1;
+}
+
+/***********************************************************
+ *  BindTextures()
+ *
+ *  This method is used for binding the directional and the
+ *  cube map to consecutive texture units for shading.
+ ***********************************************************/
+void ShadowMaps::BindTextures(int firstUnit) const
+{
+	glActiveTexture(GL_TEXTURE0 + firstUnit);
+	glBindTexture(GL_TEXTURE_2D, m_directionalTexture);
+	glActiveTexture(GL_TEXTURE0 + firstUnit + 1);
+	glBindTexture(GL_TEXTURE_CUBE_MAP, m_cubeTexture);
+	glActiveTexture(GL_TEXTURE0);
+
+	RenderStats::Add(RenderStats::COUNTER_TEXTURE_BINDS, TEXTURE_COUNT);
+}
+
+/***********************************************************
+ *  GetDirectionalViewProjection()
+ *
+ *  This method is used for building the light space of the
+ *  directional map.  An orthographic box around the bounding
+ *  sphere of the scene box, looking down the light, holds
+ *  every caster and receiver whatever the light direction.
+ ***********************************************************/
+glm::mat4 ShadowMaps::GetDirectionalViewProjection(
+	const glm::vec3& direction,
+	const glm::vec3& sceneMinimum,
+	const glm::vec3& sceneMaximum)
+{
+	glm::vec3 center = (sceneMinimum + sceneMaximum) * 0.5f;
+	float radius = std::max(glm::length(sceneMaximum - sceneMinimum) * 0.5f, 0.01f);
+
+	glm::vec3 lightDirection = glm::normalize(direction);
+	// any up direction that is not along the light will do
+	glm::vec3 up = (std::abs(lightDirection.y) > 0.99f) ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+
+	glm::mat4 view = glm::lookAt(center - lightDirection * radius, center, up);
+	glm::mat4 projection = glm::ortho(-radius, radius, -radius, radius, 0.0f, radius * 2.0f);
+
+	return(projection * view);
+}
+
+/***********************************************************
+ *  GetCubeFaceViewProjection()
+ *
+ *  This method is used for building the view-projection of
+ *  one face of the cube map - a 90 degree square frustum
+ *  from the light down the face's axis.
+ ***********************************************************/
+glm::mat4 ShadowMaps::GetCubeFaceViewProjection(const glm::vec3& position, int face, float farPlane)
+{
+	glm::mat4 view = glm::lookAt(
+		position,
+		position + g_CubeFaceDirections[face][0],
+		g_CubeFaceDirections[face][1]);
+	glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f, CUBE_NEAR_PLANE, farPlane);
+
+	return(projection * view);
+}
+
+/***********************************************************
+ *  SetSamplerUnits()
+ *
+ *  This method is used for setting the shadow sampler
+ *  uniforms of a linked program, once after it has been
+ *  linked.  Samplers of different types may not share a
+ *  unit, so they must be set even when no map is drawn.
+ ***********************************************************/
+void ShadowMaps::SetSamplerUnits(GLuint programID, int firstUnit)
+{
+	glUseProgram(programID);
+	RenderStats::Add(RenderStats::COUNTER_PROGRAM_BINDS);
+	for (int i = 0; i < TEXTURE_COUNT; i++)
+	{
+		glUniform1i(glGetUniformLocation(programID, g_SamplerNames[i]), firstUnit + i);
+	}
+}
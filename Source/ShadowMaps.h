@@ -0,0 +1,92 @@
+///////////////////////////////////////////////////////////////////////////////
+// shadowmaps.h
+// ============
+// hold the shadow maps of the directional light and the lamp bulb
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+//  Notes: The directional light casts its shadows through one depth map
+//         fitted around the whole scene, and the bulb point light through
+//         a depth cube map around it.  Both are only drawn when a light or
+//         a scene node changes - the scene is static otherwise, so the
+//         maps are kept from frame to frame and cost nothing to shade
+//         with.  The maps compare their depth in the sampler, so the
+//         fragment shader gets a filtered 0 to 1 result from each tap of
+//         its percentage closer filter.  The cube faces hold ordinary
+//         perspective depth, which lets the depth only program draw them
+//         with nothing but a different view-projection.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <glm/glm.hpp>
+
+/***********************************************************
+ *  ShadowMaps
+ *
+ *  This class owns the shadow map textures and the
+ *  framebuffer they are drawn through.
+ ***********************************************************/
+class ShadowMaps
+{
+public:
+	// size in texels of the directional map, and of each cube face
+	static const int DIRECTIONAL_SIZE = 2048;
+	static const int CUBE_SIZE = 512;
+	// faces of the cube map, in GL_TEXTURE_CUBE_MAP_POSITIVE_X order
+	static const int CUBE_FACE_COUNT = 6;
+	// texture units taken by BindTextures()
+	static const int TEXTURE_COUNT = 2;
+	// near plane of the cube faces
+	static const float CUBE_NEAR_PLANE;
+
+	// constructor
+	ShadowMaps();
+	// destructor
+	~ShadowMaps();
+
+	// create the map textures and the framebuffer - false when
+	// the framebuffer is incomplete
+	bool Create();
+
+	// bind the framebuffer to draw the directional map, or one
+	// face of the cube map, and clear it
+	void BindDirectional();
+	void BindCubeFace(int face);
+	// bind back the framebuffer and viewport that were bound
+	// before the first of the binds above
+	void Unbind();
+
+	// bind the directional and the cube map to TEXTURE_COUNT
+	// texture units, starting at firstUnit
+	void BindTextures(int firstUnit) const;
+
+	// get the light space view-projection of the directional map,
+	// framing a bounding box of the scene
+	static glm::mat4 GetDirectionalViewProjection(
+		const glm::vec3& direction,
+		const glm::vec3& sceneMinimum,
+		const glm::vec3& sceneMaximum);
+	// get the view-projection of one face of the cube map
+	static glm::mat4 GetCubeFaceViewProjection(const glm::vec3& position, int face, float farPlane);
+
+	// point the shadow samplers of a program at the texture units
+	// used by BindTextures()
+	static void SetSamplerUnits(GLuint programID, int firstUnit);
+
+private:
+	GLuint m_framebuffer;
+	GLuint m_directionalTexture;
+	GLuint m_cubeTexture;
+	// framebuffer and viewport bound before drawing the maps, or
+	// -1 when they have not been saved
+	GLint m_previousFramebuffer;
+	GLint m_previousViewport[4];
+
+	// save the framebuffer and viewport to bind back later
+	void SaveTarget();
+	// free the framebuffer and the textures
+	void Destroy();
+};
@@ -0,0 +1,73 @@
+///////////////////////////////////////////////////////////////////////////////
+// snapshotbuffer.h
+// ============
+// hand the newest copy of a value from one thread to another without locks
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+//  Notes: One thread writes snapshots and one thread reads them.  The
+//         writer fills its own slot and swaps it with the shared slot in
+//         one atomic exchange, and the reader swaps the shared slot with
+//         its own when a newer snapshot is there.  Neither side ever waits,
+//         and a snapshot is never changed while it is being read.  With
+//         only two slots a fast writer could overwrite the slot the reader
+//         holds, so a third, shared slot sits between the two.  A reader
+//         that falls behind skips to the newest snapshot.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+
+/***********************************************************
+ *  SnapshotBuffer
+ *
+ *  This class holds the writer's slot, the reader's slot
+ *  and the shared slot between them.
+ ***********************************************************/
+template <class SNAPSHOT>
+class SnapshotBuffer
+{
+public:
+	// constructor
+	SnapshotBuffer()
+	{
+		m_writeIndex = 0;
+		m_shared.store(1);
+		m_readIndex = 2;
+	}
+
+	// get the slot the writer fills in - only the writer thread
+	SNAPSHOT& GetWriteSlot() { return(m_slots[m_writeIndex]); }
+	// hand the filled slot to the reader - only the writer thread
+	void Publish()
+	{
+		int previous = m_shared.exchange(m_writeIndex | NEW_FLAG, std::memory_order_acq_rel);
+		m_writeIndex = previous & INDEX_MASK;
+	}
+
+	// take the newest published snapshot, if there is one the
+	// reader has not taken yet - only the reader thread
+	bool Acquire()
+	{
+		if ((m_shared.load(std::memory_order_relaxed) & NEW_FLAG) == 0)
+		{
+			return(false);
+		}
+		int previous = m_shared.exchange(m_readIndex, std::memory_order_acq_rel);
+		m_readIndex = previous & INDEX_MASK;
+		return(true);
+	}
+	// get the last taken snapshot - only the reader thread
+	const SNAPSHOT& GetReadSlot() const { return(m_slots[m_readIndex]); }
+
+private:
+	// the shared index carries a flag for an untaken snapshot
+	static const int INDEX_MASK = 3;
+	static const int NEW_FLAG = 4;
+
+	SNAPSHOT m_slots[3];
+	std::atomic<int> m_shared;
+	int m_writeIndex;
+	int m_readIndex;
+};
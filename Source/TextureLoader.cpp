@@ -0,0 +1,516 @@
+///////////////////////////////////////////////////////////////////////////////
+// textureloader.cpp
+// ============
+// decode texture images on worker threads and upload them on the GL thread
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TextureLoader.h"
+#include "RenderStats.h"
+
+#include "stb_image.h"
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	/***********************************************************
+	 *  GetBakedFilename()
+	 *
+	 *  Get the name of the baked texture file of an image file
+	 *  - the same name with a .ktx2 extension.
+	 ***********************************************************/
+	std::string GetBakedFilename(const std::string& filename)
+	{
+		size_t extension = filename.find_last_of('.');
+		size_t directory = filename.find_last_of("/\\");
+		if ((extension == std::string::npos) ||
+			((directory != std::string::npos) && (extension < directory)))
+		{
+			return(filename + ".ktx2");
+		}
+
+		return(filename.substr(0, extension) + ".ktx2");
+	}
+
+	/***********************************************************
+	 *  IsBakeCurrent()
+	 *
+	 *  Check whether a baked file is at least as new as its
+	 *  source image.  A baked file with no source image left
+	 *  is also used.
+	 ***********************************************************/
+	bool IsBakeCurrent(const std::string& filename, const std::string& bakedFilename)
+	{
+		struct stat bakedInfo;
+		if (stat(bakedFilename.c_str(), &bakedInfo) != 0)
+		{
+			return(false);
+		}
+
+		struct stat sourceInfo;
+		if (stat(filename.c_str(), &sourceInfo) != 0)
+		{
+			return(true);
+		}
+
+		return(bakedInfo.st_mtime >= sourceInfo.st_mtime);
+	}
+}
+
+/***********************************************************
+ *  TextureLoader()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+TextureLoader::TextureLoader()
+{
+	m_nextJob = 0;
+	m_bUseCompressed = false;
+	m_pendingCount = 0;
+	m_nextUploadBuffer = 0;
+	for (int i = 0; i < UPLOAD_BUFFER_COUNT; i++)
+	{
+		m_uploadBuffers[i] = 0;
+	}
+}
+
+/***********************************************************
+ *  ~TextureLoader()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+TextureLoader::~TextureLoader()
+{
+	// let the workers finish the image they are on, but take
+	// no new ones
+	m_nextJob = (int)m_jobs.size();
+	JoinWorkers();
+
+	for (int i = 0; i < m_decoded.size(); i++)
+	{
+		FreeImage(m_decoded[i]);
+	}
+	m_decoded.clear();
+
+	if (m_uploadBuffers[0] != 0)
+	{
+		glDeleteBuffers(UPLOAD_BUFFER_COUNT, m_uploadBuffers);
+	}
+}
+
+/***********************************************************
+ *  Request()
+ *
+ *  This method is used for queueing an image file to be
+ *  decoded for the passed in texture slot.  Requests must
+ *  be made before Start(), or once IsBusy() is false again
+ *  and followed by another Start().
+ ***********************************************************/
+void TextureLoader::Request(const char* filename, int slot)
+{
+	DECODE_JOB job;
+	job.filename = filename;
+	job.slot = slot;
+
+	m_jobs.push_back(job);
+	m_pendingCount++;
+}
+
+/***********************************************************
+ *  Start()
+ *
+ *  This method is used for launching the worker threads
+ *  that decode the queued images.  One core is left for
+ *  the GL thread.
+ ***********************************************************/
+void TextureLoader::Start(bool bUseCompressed)
+{
+	m_bUseCompressed = bUseCompressed;
+
+	if (m_jobs.size() == 0)
+	{
+		return;
+	}
+
+	// the flip flag is global to stb_image, so it is set once
+	// here rather than by each worker
+	stbi_set_flip_vertically_on_load(true);
+
+	if (m_uploadBuffers[0] == 0)
+	{
+		glGenBuffers(UPLOAD_BUFFER_COUNT, m_uploadBuffers);
+	}
+
+	int workerCount = (int)std::thread::hardware_concurrency() - 1;
+	workerCount = std::max(1, std::min(workerCount, (int)m_jobs.size()));
+
+	m_nextJob = 0;
+	for (int i = 0; i < workerCount; i++)
+	{
+		m_workers.push_back(std::thread(&TextureLoader::DecodeJobs, this));
+	}
+}
+
+/***********************************************************
+ *  DecodeJobs()
+ *
+ *  This method is run by each worker thread.  It takes the
+ *  next queued image until there are none left, decodes it
+ *  and hands the pixels or baked levels to the GL thread.
+ ***********************************************************/
+void TextureLoader::DecodeJobs()
+{
+	int jobIndex = m_nextJob++;
+	while (jobIndex < (int)m_jobs.size())
+	{
+		const DECODE_JOB& job = m_jobs[jobIndex];
+
+		DECODED_IMAGE image;
+		image.slot = job.slot;
+		image.width = 0;
+		image.height = 0;
+		image.colorChannels = 0;
+		image.pixels = NULL;
+		image.pCompressed = NULL;
+		image.bBaked = false;
+		image.filename = job.filename;
+
+		if (m_bUseCompressed == true)
+		{
+			image.pCompressed = new CompressedTexture();
+			if (LoadCompressed(job.filename, *image.pCompressed, image.bBaked) == false)
+			{
+				delete image.pCompressed;
+				image.pCompressed = NULL;
+			}
+		}
+
+		if (image.pCompressed == NULL)
+		{
+			image.pixels = stbi_load(
+				job.filename.c_str(),
+				&image.width,
+				&image.height,
+				&image.colorChannels,
+				0);
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_decodedMutex);
+			m_decoded.push_back(image);
+		}
+
+		jobIndex = m_nextJob++;
+	}
+}
+
+/***********************************************************
+ *  LoadCompressed()
+ *
+ *  This method is used for reading the baked BC7 texture of
+ *  an image file.  When the baked file is missing or older
+ *  than the image, the image is decoded, compressed and
+ *  written out so the next run can skip the decode.
+ ***********************************************************/
+bool TextureLoader::LoadCompressed(const std::string& filename, CompressedTexture& texture, bool& bBaked)
+{
+	std::string bakedFilename = GetBakedFilename(filename);
+
+	bBaked = false;
+	if ((IsBakeCurrent(filename, bakedFilename) == true) &&
+		(texture.Load(bakedFilename) == true))
+	{
+		return(true);
+	}
+
+	int width = 0;
+	int height = 0;
+	int colorChannels = 0;
+	unsigned char* pixels = stbi_load(filename.c_str(), &width, &height, &colorChannels, 0);
+	if ((pixels == NULL) || (colorChannels < 3))
+	{
+		// leave unusual images to the uncompressed path
+		if (pixels != NULL)
+		{
+			stbi_image_free(pixels);
+		}
+		return(false);
+	}
+
+	texture.Compress(pixels, width, height, colorChannels);
+	stbi_image_free(pixels);
+
+	// a failed write only costs the next run another bake
+	bBaked = texture.Save(bakedFilename);
+
+	return(true);
+}
+
+/***********************************************************
+ *  FreeImage()
+ *
+ *  This method is used for freeing the decoded pixels or
+ *  baked levels of an image.
+ ***********************************************************/
+void TextureLoader::FreeImage(DECODED_IMAGE& image)
+{
+	if (image.pixels != NULL)
+	{
+		stbi_image_free(image.pixels);
+		image.pixels = NULL;
+	}
+	delete image.pCompressed;
+	image.pCompressed = NULL;
+}
+
+/***********************************************************
+ *  ProcessUploads()
+ *
+ *  This method is used for uploading up to maxUploads of
+ *  the decoded images into new textures, called once per
+ *  frame on the GL thread.  The slot and texture of each
+ *  upload are added to the loaded list.
+ *
+ *  Edited on: October 14, 2026
+ *  Notes: Each upload carries the bytes of its levels, for
+ *         the GPU resource tally.
+ ***********************************************************/
+void TextureLoader::ProcessUploads(int maxUploads, std::vector<LOADED_TEXTURE>& loaded)
+{
+	std::vector<DECODED_IMAGE> ready;
+	{
+		std::lock_guard<std::mutex> lock(m_decodedMutex);
+		int count = std::min(maxUploads, (int)m_decoded.size());
+		ready.assign(m_decoded.begin(), m_decoded.begin() + count);
+		m_decoded.erase(m_decoded.begin(), m_decoded.begin() + count);
+	}
+
+	for (int i = 0; i < ready.size(); i++)
+	{
+		DECODED_IMAGE& image = ready[i];
+
+		if ((image.pixels != NULL) || (image.pCompressed != NULL))
+		{
+			GLuint textureID = 0;
+			long long bytes = 0;
+			if (image.pCompressed != NULL)
+			{
+				std::cout << "Successfully loaded compressed texture:" << image.filename << ", width:" << image.pCompressed->GetWidth() << ", height:" << image.pCompressed->GetHeight() << ", levels:" << image.pCompressed->GetLevels().size() << std::endl;
+				if (image.bBaked == true)
+				{
+					std::cout << "Baked compressed texture for image:" << image.filename << std::endl;
+				}
+				textureID = UploadCompressed(image);
+				bytes = image.pCompressed->GetData().size();
+			}
+			else
+			{
+				std::cout << "Successfully loaded image:" << image.filename << ", width:" << image.width << ", height:" << image.height << ", channels:" << image.colorChannels << std::endl;
+				textureID = UploadImage(image);
+				bytes = (long long)image.width * image.height * image.colorChannels * 4 / 3;
+			}
+			FreeImage(image);
+
+			if (textureID != 0)
+			{
+				LOADED_TEXTURE texture;
+				texture.slot = image.slot;
+				texture.textureID = textureID;
+				texture.bytes = bytes;
+				loaded.push_back(texture);
+			}
+		}
+		else
+		{
+			std::cout << "Could not load image:" << image.filename << std::endl;
+		}
+
+		m_pendingCount--;
+	}
+
+	// every image is in, the workers and pixel buffers are done
+	// and the next requests start from an empty queue
+	if ((ready.size() > 0) && (m_pendingCount == 0))
+	{
+		JoinWorkers();
+		m_jobs.clear();
+		m_nextJob = 0;
+		glDeleteBuffers(UPLOAD_BUFFER_COUNT, m_uploadBuffers);
+		for (int i = 0; i < UPLOAD_BUFFER_COUNT; i++)
+		{
+			m_uploadBuffers[i] = 0;
+		}
+	}
+}
+
+/***********************************************************
+ *  StageUpload()
+ *
+ *  This method is used for copying upload data into the
+ *  next pixel unpack buffer and leaving it bound, so the
+ *  texture upload returns without waiting for the transfer
+ *  and the two buffers let one upload be filled while the
+ *  previous one is still being read.  The returned pointer
+ *  is what the upload calls are given - offset 0 of the
+ *  bound buffer, or the data itself when it could not be
+ *  mapped.
+ ***********************************************************/
+const unsigned char* TextureLoader::StageUpload(const void* data, GLsizeiptr size)
+{
+	// orphan the buffer's previous contents so mapping it never
+	// waits on an upload that is still in flight
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_uploadBuffers[m_nextUploadBuffer]);
+	glBufferData(GL_PIXEL_UNPACK_BUFFER, size, NULL, GL_STREAM_DRAW);
+	void* pMapped = glMapBufferRange(
+		GL_PIXEL_UNPACK_BUFFER,
+		0,
+		size,
+		GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+	if (pMapped == NULL)
+	{
+		// fall back to a direct upload from the data
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		RenderStats::Add(RenderStats::COUNTER_BYTES_UPLOADED, size);
+		return((const unsigned char*)data);
+	}
+
+	memcpy(pMapped, data, size);
+	glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+	RenderStats::Add(RenderStats::COUNTER_BYTES_UPLOADED, size);
+	m_nextUploadBuffer = (m_nextUploadBuffer + 1) % UPLOAD_BUFFER_COUNT;
+
+	return(NULL);
+}
+
+/***********************************************************
+ *  UploadImage()
+ *
+ *  This method is used for copying a decoded image into a
+ *  new texture through a pixel unpack buffer and generating
+ *  its mipmaps.
+ ***********************************************************/
+GLuint TextureLoader::UploadImage(const DECODED_IMAGE& image)
+{
+	GLenum internalFormat = GL_RGB8;
+	GLenum format = GL_RGB;
+
+	// if the loaded image is in RGB format
+	if (image.colorChannels == 3)
+	{
+		internalFormat = GL_RGB8;
+		format = GL_RGB;
+	}
+	// if the loaded image is in RGBA format - it supports transparency
+	else if (image.colorChannels == 4)
+	{
+		internalFormat = GL_RGBA8;
+		format = GL_RGBA;
+	}
+	else
+	{
+		std::cout << "Not implemented to handle image with " << image.colorChannels << " channels" << std::endl;
+		return(0);
+	}
+
+	GLsizeiptr size = (GLsizeiptr)image.width * image.height * image.colorChannels;
+	const unsigned char* pixels = StageUpload(image.pixels, size);
+
+	GLuint textureID = 0;
+	glGenTextures(1, &textureID);
+	glBindTexture(GL_TEXTURE_2D, textureID);
+
+	// set the texture wrapping parameters
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	// set texture filtering parameters - minification reads the mipmaps
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+	glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, image.width, image.height, 0, format, GL_UNSIGNED_BYTE, pixels);
+
+	// generate the texture mipmaps for mapping textures to lower resolutions
+	glGenerateMipmap(GL_TEXTURE_2D);
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+	return(textureID);
+}
+
+/***********************************************************
+ *  UploadCompressed()
+ *
+ *  This method is used for copying the baked BC7 levels of
+ *  an image into a new texture through a pixel unpack
+ *  buffer.  Every mip level is already in the file, so no
+ *  mipmaps are generated.
+ ***********************************************************/
+GLuint TextureLoader::UploadCompressed(const DECODED_IMAGE& image)
+{
+	const CompressedTexture& texture = *image.pCompressed;
+	const std::vector<CompressedTexture::MIP_LEVEL>& levels = texture.GetLevels();
+	const std::vector<unsigned char>& data = texture.GetData();
+
+	const unsigned char* pData = StageUpload(&data[0], (GLsizeiptr)data.size());
+
+	GLuint textureID = 0;
+	glGenTextures(1, &textureID);
+	glBindTexture(GL_TEXTURE_2D, textureID);
+
+	// set the texture wrapping parameters
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	// set texture filtering parameters - minification reads the mipmaps
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)levels.size() - 1);
+
+	for (int i = 0; i < levels.size(); i++)
+	{
+		// with a bound pixel buffer the pointer is an offset into it
+		const void* pLevel = (pData != NULL) ?
+			(const void*)(pData + levels[i].offset) :
+			(const void*)(size_t)levels[i].offset;
+
+		glCompressedTexImage2D(
+			GL_TEXTURE_2D,
+			i,
+			GL_COMPRESSED_RGBA_BPTC_UNORM,
+			levels[i].width,
+			levels[i].height,
+			0,
+			levels[i].size,
+			pLevel);
+	}
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+	return(textureID);
+}
+
+/***********************************************************
+ *  JoinWorkers()
+ *
+ *  This method is used for waiting for the worker threads
+ *  to run out of images to decode.
+ ***********************************************************/
+void TextureLoader::JoinWorkers()
+{
+	for (int i = 0; i < m_workers.size(); i++)
+	{
+		if (m_workers[i].joinable())
+		{
+			m_workers[i].join();
+		}
+	}
+	m_workers.clear();
+}
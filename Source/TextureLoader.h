@@ -0,0 +1,122 @@
+///////////////////////////////////////////////////////////////////////////////
+// textureloader.h
+// ============
+// decode texture images on worker threads and upload them on the GL thread
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+//  Notes: The image files are decoded by a small pool of worker threads
+//         while the first frames render.  The GL thread only uploads the
+//         decoded images, a couple per frame, through pixel unpack buffers
+//         so the copy to the GPU overlaps the decoding still in flight.
+//         When the context can sample BC7, each image is read from its
+//         baked .ktx2 file instead, and a missing or out of date file is
+//         baked from the source image by the worker that decodes it.
+//         Once every queued image is in, more can be queued and started,
+//         which is how an image that changed on disk is loaded again.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "CompressedTexture.h"
+
+#include <GL/glew.h>
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/***********************************************************
+ *  TextureLoader
+ *
+ *  This class holds the queue of texture images to decode,
+ *  the worker threads decoding them and the pixel unpack
+ *  buffers used for uploading the results.
+ ***********************************************************/
+class TextureLoader
+{
+public:
+	// a texture that finished uploading this frame
+	struct LOADED_TEXTURE
+	{
+		int slot;
+		GLuint textureID;
+		// bytes of the uploaded levels, counting the generated
+		// mipmaps as a third of the image
+		long long bytes;
+	};
+
+	// constructor
+	TextureLoader();
+	// destructor
+	~TextureLoader();
+
+	// queue an image file to be decoded for a texture slot -
+	// only while the loader is not busy
+	void Request(const char* filename, int slot);
+	// start decoding the queued images on the worker threads -
+	// with bUseCompressed the baked BC7 textures are used
+	void Start(bool bUseCompressed);
+	// upload up to maxUploads decoded images into new textures
+	void ProcessUploads(int maxUploads, std::vector<LOADED_TEXTURE>& loaded);
+
+	// check whether any queued image has not been uploaded yet
+	bool IsBusy() const { return(m_pendingCount > 0); }
+
+private:
+	struct DECODE_JOB
+	{
+		std::string filename;
+		int slot;
+	};
+
+	struct DECODED_IMAGE
+	{
+		int slot;
+		int width;
+		int height;
+		int colorChannels;
+		// stbi_load() result, NULL when the file could not be read
+		unsigned char* pixels;
+		// baked BC7 levels, NULL when the pixels are used
+		CompressedTexture* pCompressed;
+		// true when the baked file was written by this run
+		bool bBaked;
+		std::string filename;
+	};
+
+	// number of pixel unpack buffers uploads rotate through
+	static const int UPLOAD_BUFFER_COUNT = 2;
+
+	std::vector<DECODE_JOB> m_jobs;
+	// read or bake BC7 textures instead of uploading the pixels
+	bool m_bUseCompressed;
+	// next m_jobs entry for a worker to take
+	std::atomic<int> m_nextJob;
+	std::vector<std::thread> m_workers;
+	// decoded images waiting for the GL thread
+	std::vector<DECODED_IMAGE> m_decoded;
+	std::mutex m_decodedMutex;
+	// images queued but not uploaded yet
+	int m_pendingCount;
+	GLuint m_uploadBuffers[UPLOAD_BUFFER_COUNT];
+	int m_nextUploadBuffer;
+
+	// decode jobs until none are left - runs on a worker thread
+	void DecodeJobs();
+	// read the baked texture of an image file, baking it when needed
+	bool LoadCompressed(const std::string& filename, CompressedTexture& texture, bool& bBaked);
+	// copy data into the next pixel unpack buffer and return the
+	// pointer the upload calls read from
+	const unsigned char* StageUpload(const void* data, GLsizeiptr size);
+	// copy a decoded image into a new texture through a pixel buffer
+	GLuint UploadImage(const DECODED_IMAGE& image);
+	// copy baked BC7 levels into a new texture through a pixel buffer
+	GLuint UploadCompressed(const DECODED_IMAGE& image);
+	// free the decoded data of an image
+	void FreeImage(DECODED_IMAGE& image);
+	// wait for the worker threads to finish
+	void JoinWorkers();
+};
@@ -0,0 +1,427 @@
+///////////////////////////////////////////////////////////////////////////////
+// transparencybuffers.cpp
+// ============
+// hold the buffers of the order independent transparency passes
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TransparencyBuffers.h"
+#include "RenderStats.h"
+
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	// internal format of each weighted target, in TARGET order -
+	// the weighted sums need more range than eight bits
+	const GLenum g_TargetFormats[TransparencyBuffers::TARGET_COUNT] =
+	{
+		GL_RGBA16F,
+		GL_R16F
+	};
+
+	// sampler names in the composite shader, in texture unit order
+	const char* g_SamplerNames[TransparencyBuffers::TEXTURE_COUNT] =
+	{
+		"oitAccumulationTexture",
+		"oitRevealageTexture"
+	};
+
+	// head value of an empty list, matching OIT_LIST_END in
+	// fragmentShader.glsl
+	const GLuint LIST_END = 0xFFFFFFFFu;
+	// bytes in front of the nodes - the node counter, padded to
+	// the 16 byte alignment of the node array
+	const GLsizeiptr NODE_HEADER_SIZE = 16;
+	// bytes of one node - two half color pairs, depth and next
+	const GLsizeiptr NODE_SIZE = 16;
+}
+
+/***********************************************************
+ *  TransparencyBuffers()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+TransparencyBuffers::TransparencyBuffers()
+{
+	m_framebuffer = 0;
+	for (int i = 0; i < TARGET_COUNT; i++)
+	{
+		m_targets[i] = 0;
+	}
+	m_depthBuffer = 0;
+	m_weightedWidth = 0;
+	m_weightedHeight = 0;
+	m_headTexture = 0;
+	m_nodeBuffer = 0;
+	m_listWidth = 0;
+	m_listHeight = 0;
+	m_emptyVertexArray = 0;
+	m_previousDrawFramebuffer = 0;
+	m_previousReadFramebuffer = 0;
+}
+
+/***********************************************************
+ *  ~TransparencyBuffers()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+TransparencyBuffers::~TransparencyBuffers()
+{
+	DestroyWeighted();
+	DestroyLinkedList();
+
+	if (m_emptyVertexArray != 0)
+	{
+		glDeleteVertexArrays(1, &m_emptyVertexArray);
+		m_emptyVertexArray = 0;
+	}
+}
+
+/***********************************************************
+ *  DestroyWeighted()
+ *
+ *  This method is used for freeing the weighted targets and
+ *  the framebuffer they are attached to.
+ ***********************************************************/
+void TransparencyBuffers::DestroyWeighted()
+{
+	if (m_framebuffer != 0)
+	{
+		glDeleteFramebuffers(1, &m_framebuffer);
+		glDeleteTextures(TARGET_COUNT, m_targets);
+		glDeleteRenderbuffers(1, &m_depthBuffer);
+		m_framebuffer = 0;
+		for (int i = 0; i < TARGET_COUNT; i++)
+		{
+			m_targets[i] = 0;
+		}
+		m_depthBuffer = 0;
+	}
+	m_weightedWidth = 0;
+	m_weightedHeight = 0;
+}
+
+/***********************************************************
+ *  DestroyLinkedList()
+ *
+ *  This method is used for freeing the head image and the
+ *  node buffer.
+ ***********************************************************/
+void TransparencyBuffers::DestroyLinkedList()
+{
+	if (m_headTexture != 0)
+	{
+		glDeleteTextures(1, &m_headTexture);
+		m_headTexture = 0;
+	}
+	if (m_nodeBuffer != 0)
+	{
+		glDeleteBuffers(1, &m_nodeBuffer);
+		m_nodeBuffer = 0;
+	}
+	m_listWidth = 0;
+	m_listHeight = 0;
+}
+
+/***********************************************************
+ *  GetTargetDepthFormat()
+ *
+ *  This method is used for finding the internal format of
+ *  the bound framebuffer's depth.  A depth blit needs the
+ *  same format on both sides.
+ ***********************************************************/
+GLenum TransparencyBuffers::GetTargetDepthFormat()
+{
+	GLint framebuffer = 0;
+	glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &framebuffer);
+
+	// the default framebuffer names its buffers differently
+	GLenum depthAttachment = (framebuffer == 0) ? GL_DEPTH : GL_DEPTH_ATTACHMENT;
+	GLenum stencilAttachment = (framebuffer == 0) ? GL_STENCIL : GL_STENCIL_ATTACHMENT;
+
+	GLint depthBits = 0;
+	GLint componentType = GL_UNSIGNED_NORMALIZED;
+	GLint stencilBits = 0;
+	GLint stencilType = GL_NONE;
+	glGetFramebufferAttachmentParameteriv(GL_DRAW_FRAMEBUFFER, depthAttachment, GL_FRAMEBUFFER_ATTACHMENT_DEPTH_SIZE, &depthBits);
+	glGetFramebufferAttachmentParameteriv(GL_DRAW_FRAMEBUFFER, depthAttachment, GL_FRAMEBUFFER_ATTACHMENT_COMPONENT_TYPE, &componentType);
+	glGetFramebufferAttachmentParameteriv(GL_DRAW_FRAMEBUFFER, stencilAttachment, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE, &stencilType);
+	if (stencilType != GL_NONE)
+	{
+		glGetFramebufferAttachmentParameteriv(GL_DRAW_FRAMEBUFFER, stencilAttachment, GL_FRAMEBUFFER_ATTACHMENT_STENCIL_SIZE, &stencilBits);
+	}
+
+	if (stencilBits > 0)
+	{
+		return((componentType == GL_FLOAT) ? GL_DEPTH32F_STENCIL8 : GL_DEPTH24_STENCIL8);
+	}
+	if (componentType == GL_FLOAT)
+	{
+		return(GL_DEPTH_COMPONENT32F);
+	}
+	if (depthBits > 24)
+	{
+		return(GL_DEPTH_COMPONENT32);
+	}
+	if (depthBits > 16)
+	{
+		return(GL_DEPTH_COMPONENT24);
+	}
+
+	return(GL_DEPTH_COMPONENT16);
+}
+
+/***********************************************************
+ *  ResizeWeighted()
+ *
+ *  This method is used for creating the weighted targets at
+ *  the size of the viewport, with a depth buffer in the
+ *  format of the bound framebuffer's.  Nothing is done
+ *  while the size stays the same.
+ ***********************************************************/
+bool TransparencyBuffers::ResizeWeighted(int width, int height)
+{
+	if ((width <= 0) || (height <= 0))
+	{
+		return(false);
+	}
+	if ((m_framebuffer != 0) && (width == m_weightedWidth) && (height == m_weightedHeight))
+	{
+		return(true);
+	}
+
+	DestroyWeighted();
+
+	if (m_emptyVertexArray == 0)
+	{
+		glGenVertexArrays(1, &m_emptyVertexArray);
+	}
+
+	GLenum depthFormat = GetTargetDepthFormat();
+	bool bStencil = ((depthFormat == GL_DEPTH24_STENCIL8) || (depthFormat == GL_DEPTH32F_STENCIL8));
+
+	GLint previousFramebuffer = 0;
+	glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFramebuffer);
+
+	glGenFramebuffers(1, &m_framebuffer);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_framebuffer);
+
+	// the composite reads one texel per pixel, so no filtering
+	// or mipmaps are needed
+	glGenTextures(TARGET_COUNT, m_targets);
+	GLenum drawBuffers[TARGET_COUNT];
+	for (int i = 0; i < TARGET_COUNT; i++)
+	{
+		glBindTexture(GL_TEXTURE_2D, m_targets[i]);
+		glTexStorage2D(GL_TEXTURE_2D, 1, g_TargetFormats[i], width, height);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, GL_TEXTURE_2D, m_targets[i], 0);
+		drawBuffers[i] = GL_COLOR_ATTACHMENT0 + i;
+	}
+	glDrawBuffers(TARGET_COUNT, drawBuffers);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	// the depth is only tested against, never sampled
+	glGenRenderbuffers(1, &m_depthBuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, m_depthBuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, depthFormat, width, height);
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+	glFramebufferRenderbuffer(
+		GL_DRAW_FRAMEBUFFER,
+		(bStencil == true) ? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT,
+		GL_RENDERBUFFER,
+		m_depthBuffer);
+
+	GLenum status = glCheckFramebufferStatus(GL_DRAW_FRAMEBUFFER);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, previousFramebuffer);
+
+	if (status != GL_FRAMEBUFFER_COMPLETE)
+	{
+		std::cout << "Weighted transparency framebuffer is incomplete, status: " << status << std::endl;
+		DestroyWeighted();
+		return(false);
+	}
+
+	m_weightedWidth = width;
+	m_weightedHeight = height;
+	return(true);
+}
+
+/***********************************************************
+ *  ResizeLinkedList()
+ *
+ *  This method is used for creating the head image and the
+ *  node buffer at the size of the viewport.  Nothing is
+ *  done while the size stays the same.
+ ***********************************************************/
+bool TransparencyBuffers::ResizeLinkedList(int width, int height)
+{
+	if ((width <= 0) || (height <= 0))
+	{
+		return(false);
+	}
+	if ((m_headTexture != 0) && (width == m_listWidth) && (height == m_listHeight))
+	{
+		return(true);
+	}
+
+	DestroyLinkedList();
+
+	if (m_emptyVertexArray == 0)
+	{
+		glGenVertexArrays(1, &m_emptyVertexArray);
+	}
+
+	glGenTextures(1, &m_headTexture);
+	glBindTexture(GL_TEXTURE_2D, m_headTexture);
+	glTexStorage2D(GL_TEXTURE_2D, 1, GL_R32UI, width, height);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	// the shader takes the node array length from the buffer size
+	GLsizeiptr nodeCount = (GLsizeiptr)width * height * AVERAGE_LAYERS;
+	glGenBuffers(1, &m_nodeBuffer);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_nodeBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, NODE_HEADER_SIZE + nodeCount * NODE_SIZE, NULL, GL_DYNAMIC_COPY);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+	if (glGetError() == GL_OUT_OF_MEMORY)
+	{
+		std::cout << "Not enough memory for the transparency node buffer" << std::endl;
+		DestroyLinkedList();
+		return(false);
+	}
+
+	m_listWidth = width;
+	m_listHeight = height;
+	return(true);
+}
+
+/***********************************************************
+ *  BeginWeighted()
+ *
+ *  This method is used for drawing the translucent nodes
+ *  into the weighted targets.  The opaque depth of the
+ *  bound framebuffer is copied over first, so the glass is
+ *  still hidden behind it.  The framebuffers that were
+ *  bound are kept, so EndWeighted() can return to them.
+ *  The color writes must be on for the clears.
+ ***********************************************************/
+void TransparencyBuffers::BeginWeighted()
+{
+	glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &m_previousDrawFramebuffer);
+	glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &m_previousReadFramebuffer);
+
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, m_previousDrawFramebuffer);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_framebuffer);
+	glBlitFramebuffer(
+		0, 0, m_weightedWidth, m_weightedHeight,
+		0, 0, m_weightedWidth, m_weightedHeight,
+		GL_DEPTH_BUFFER_BIT,
+		GL_NEAREST);
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, m_previousReadFramebuffer);
+
+	// nothing accumulated, and the background fully revealed
+	const GLfloat accumulation[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+	const GLfloat revealage[4] = { 1.0f, 0.0f, 0.0f, 0.0f };
+	glClearBufferfv(GL_COLOR, TARGET_ACCUMULATION, accumulation);
+	glClearBufferfv(GL_COLOR, TARGET_REVEALAGE, revealage);
+}
+
+/***********************************************************
+ *  EndWeighted()
+ *
+ *  This method is used for binding back the framebuffer
+ *  that was bound before the translucent draws.
+ ***********************************************************/
+void TransparencyBuffers::EndWeighted()
+{
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_previousDrawFramebuffer);
+}
+
+/***********************************************************
+ *  BeginLinkedList()
+ *
+ *  This method is used for emptying every pixel's list and
+ *  the node counter, and binding the head image and the
+ *  node buffer for the translucent draws.
+ ***********************************************************/
+void TransparencyBuffers::BeginLinkedList()
+{
+	glClearTexImage(m_headTexture, 0, GL_RED_INTEGER, GL_UNSIGNED_INT, &LIST_END);
+
+	const GLuint zero = 0;
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_nodeBuffer);
+	glClearBufferSubData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, 0, sizeof(GLuint), GL_RED_INTEGER, GL_UNSIGNED_INT, &zero);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+	glBindImageTexture(HEAD_IMAGE_UNIT, m_headTexture, 0, GL_FALSE, 0, GL_READ_WRITE, GL_R32UI);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, NODE_BINDING, m_nodeBuffer);
+}
+
+/***********************************************************
+ *  EndLinkedList()
+ *
+ *  This method is used for making the nodes and heads the
+ *  translucent draws stored visible to the resolve pass.
+ ***********************************************************/
+void TransparencyBuffers::EndLinkedList()
+{
+	glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+}
+
+/***********************************************************
+ *  BindTextures()
+ *
+ *  This method is used for binding the weighted targets to
+ *  consecutive texture units for the composite pass.
+ ***********************************************************/
+void TransparencyBuffers::BindTextures(int firstUnit) const
+{
+	for (int i = 0; i < TARGET_COUNT; i++)
+	{
+		glActiveTexture(GL_TEXTURE0 + firstUnit + i);
+		glBindTexture(GL_TEXTURE_2D, m_targets[i]);
+	}
+	glActiveTexture(GL_TEXTURE0);
+
+	RenderStats::Add(RenderStats::COUNTER_TEXTURE_BINDS, TARGET_COUNT);
+}
+
+/***********************************************************
+ *  DrawFullScreenTriangle()
+ *
+ *  This method is used for drawing the composite or the
+ *  resolve pass.  The vertex shader places the three
+ *  corners from gl_VertexID.
+ ***********************************************************/
+void TransparencyBuffers::DrawFullScreenTriangle() const
+{
+	glBindVertexArray(m_emptyVertexArray);
+	glDrawArrays(GL_TRIANGLES, 0, 3);
+	glBindVertexArray(0);
+
+	RenderStats::Add(RenderStats::COUNTER_DRAW_CALLS);
+	RenderStats::Add(RenderStats::COUNTER_TRIANGLES);
+}
+
+/***********************************************************
+ *  SetSamplerUnits()
+ *
+ *  This method is used for setting the weighted target
+ *  sampler uniforms of a linked composite program, once
+ *  after it has been linked.
+ ***********************************************************/
+void TransparencyBuffers::SetSamplerUnits(GLuint programID, int firstUnit)
+{
+	glUseProgram(programID);
+	RenderStats::Add(RenderStats::COUNTER_PROGRAM_BINDS);
+	for (int i = 0; i < TEXTURE_COUNT; i++)
+	{
+		glUniform1i(glGetUniformLocation(programID, g_SamplerNames[i]), firstUnit + i);
+	}
+}
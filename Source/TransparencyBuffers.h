@@ -0,0 +1,116 @@
+///////////////////////////////////////////////////////////////////////////////
+// transparencybuffers.h
+// ============
+// hold the buffers of the order independent transparency passes
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+//  Notes: The glass used to be drawn back to front by its bounding sphere,
+//         which only works while no two translucent shapes cross.  Both
+//         modes here let the translucent draws go out in any order, so
+//         they batch like the opaque ones.  Weighted blended transparency
+//         sums every fragment of a pixel into an accumulation and a
+//         revealage target, weighted by its depth and coverage, and one
+//         full screen pass blends the weighted average over the frame.
+//         It is cheap and needs nothing past OpenGL 4.0, but the order of
+//         close layers is only approximated.  The linked list mode stores
+//         every translucent fragment in a storage buffer, linked from a
+//         head image per pixel, and the full screen pass sorts and blends
+//         each pixel's list exactly.  It needs the OpenGL 4.6 programs.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+/***********************************************************
+ *  TransparencyBuffers
+ *
+ *  This class owns the targets of the weighted blended mode
+ *  and the head image and node buffer of the linked list
+ *  mode, sized to the viewport.
+ ***********************************************************/
+class TransparencyBuffers
+{
+public:
+	// color targets of the weighted blended mode, in fragment
+	// shader output location order
+	enum TARGET
+	{
+		TARGET_ACCUMULATION = 0,   // weighted premultiplied color and alpha
+		TARGET_REVEALAGE,          // product of one minus each alpha
+		TARGET_COUNT
+	};
+
+	// texture units taken by BindTextures()
+	static const int TEXTURE_COUNT = TARGET_COUNT;
+	// storage buffer binding point and image unit of the linked
+	// list, shared with fragmentShader.glsl
+	static const GLuint NODE_BINDING = 4;
+	static const GLuint HEAD_IMAGE_UNIT = 0;
+	// nodes kept per pixel of the viewport - the glass covers a
+	// small part of the frame, so this leaves room for many layers
+	// where it does
+	static const int AVERAGE_LAYERS = 2;
+
+	// constructor
+	TransparencyBuffers();
+	// destructor
+	~TransparencyBuffers();
+
+	// create the weighted targets, or the linked list head image
+	// and node buffer, for a viewport size - they are only rebuilt
+	// when the size changes, false when they cannot be created
+	bool ResizeWeighted(int width, int height);
+	bool ResizeLinkedList(int width, int height);
+
+	// copy the depth of the bound framebuffer into the weighted
+	// targets, bind them and clear them for the translucent draws
+	void BeginWeighted();
+	// bind back the framebuffer that was bound before
+	void EndWeighted();
+	// clear the linked lists and bind them for the translucent
+	// draws, which go to the bound framebuffer's depth test
+	void BeginLinkedList();
+	// make the stored lists visible to the resolve pass
+	void EndLinkedList();
+
+	// bind the weighted targets to TEXTURE_COUNT texture units,
+	// starting at firstUnit
+	void BindTextures(int firstUnit) const;
+	// draw one triangle that covers the viewport
+	void DrawFullScreenTriangle() const;
+
+	// point the weighted samplers of a composite program at the
+	// texture units used by BindTextures()
+	static void SetSamplerUnits(GLuint programID, int firstUnit);
+
+private:
+	// weighted blended targets, and the copy of the frame depth
+	// they are tested against
+	GLuint m_framebuffer;
+	GLuint m_targets[TARGET_COUNT];
+	GLuint m_depthBuffer;
+	int m_weightedWidth;
+	int m_weightedHeight;
+	// linked list head of each pixel and the node buffer with its
+	// node counter in front
+	GLuint m_headTexture;
+	GLuint m_nodeBuffer;
+	int m_listWidth;
+	int m_listHeight;
+	// the full screen triangle has no vertex attributes, but a
+	// core context still needs a vertex array bound
+	GLuint m_emptyVertexArray;
+	// framebuffers bound before BeginWeighted()
+	GLint m_previousDrawFramebuffer;
+	GLint m_previousReadFramebuffer;
+
+	// get the depth format of the bound framebuffer, which the
+	// depth copy must match
+	static GLenum GetTargetDepthFormat();
+	// free the weighted targets
+	void DestroyWeighted();
+	// free the head image and the node buffer
+	void DestroyLinkedList();
+};
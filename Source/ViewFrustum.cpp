@@ -0,0 +1,125 @@
+///////////////////////////////////////////////////////////////////////////////
+// viewfrustum.cpp
+// ============
+// test world space bounding volumes against the six planes of the view
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ViewFrustum.h"
+
+/***********************************************************
+ *  ViewFrustum()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ViewFrustum::ViewFrustum()
+{
+	// until a matrix is set every volume is inside
+	for (int i = 0; i < PLANE_COUNT; i++)
+	{
+		m_planes[i] = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+	}
+}
+
+/***********************************************************
+ *  SetMatrix()
+ *
+ *  This method is used for reading the six planes out of a
+ *  projection times view matrix.  Each plane is the fourth
+ *  row of the matrix plus or minus one of the other rows,
+ *  scaled so signed distances come out in world units.
+ ***********************************************************/
+void ViewFrustum::SetMatrix(const glm::mat4& viewProjection)
+{
+	// glm matrices are indexed by column, so gather the rows
+	glm::vec4 rows[4];
+	for (int row = 0; row < 4; row++)
+	{
+		rows[row] = glm::vec4(
+			viewProjection[0][row],
+			viewProjection[1][row],
+			viewProjection[2][row],
+			viewProjection[3][row]);
+	}
+
+	m_planes[0] = rows[3] + rows[0];   // left
+	m_planes[1] = rows[3] - rows[0];   // right
+	m_planes[2] = rows[3] + rows[1];   // bottom
+	m_planes[3] = rows[3] - rows[1];   // top
+	m_planes[4] = rows[3] + rows[2];   // near
+	m_planes[5] = rows[3] - rows[2];   // far
+
+	for (int i = 0; i < PLANE_COUNT; i++)
+	{
+		float length = glm::length(glm::vec3(m_planes[i]));
+		if (length > 0.0f)
+		{
+			m_planes[i] /= length;
+		}
+	}
+}
+
+/***********************************************************
+ *  TestBox()
+ *
+ *  This method is used for testing a bounding box against
+ *  the planes.  Only the two corners farthest along and
+ *  against each plane normal need testing.
+ ***********************************************************/
+ViewFrustum::TEST_RESULT ViewFrustum::TestBox(const BOUNDING_BOX& box) const
+{
+	TEST_RESULT result = TEST_INSIDE;
+
+	for (int i = 0; i < PLANE_COUNT; i++)
+	{
+		const glm::vec4& plane = m_planes[i];
+
+		glm::vec3 farCorner;
+		glm::vec3 nearCorner;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			bool bPositive = (plane[axis] >= 0.0f);
+			farCorner[axis] = bPositive ? box.maximum[axis] : box.minimum[axis];
+			nearCorner[axis] = bPositive ? box.minimum[axis] : box.maximum[axis];
+		}
+
+		if (glm::dot(glm::vec3(plane), farCorner) + plane.w < 0.0f)
+		{
+			return(TEST_OUTSIDE);
+		}
+		if (glm::dot(glm::vec3(plane), nearCorner) + plane.w < 0.0f)
+		{
+			result = TEST_INTERSECTING;
+		}
+	}
+
+	return(result);
+}
+
+/***********************************************************
+ *  TestSphere()
+ *
+ *  This method is used for testing a bounding sphere
+ *  against the planes.
+ ***********************************************************/
+ViewFrustum::TEST_RESULT ViewFrustum::TestSphere(const glm::vec3& center, float radius) const
+{
+	TEST_RESULT result = TEST_INSIDE;
+
+	for (int i = 0; i < PLANE_COUNT; i++)
+	{
+		float distance = glm::dot(glm::vec3(m_planes[i]), center) + m_planes[i].w;
+		if (distance < -radius)
+		{
+			return(TEST_OUTSIDE);
+		}
+		if (distance < radius)
+		{
+			result = TEST_INTERSECTING;
+		}
+	}
+
+	return(result);
+}
@@ -0,0 +1,59 @@
+///////////////////////////////////////////////////////////////////////////////
+// viewfrustum.h
+// ============
+// test world space bounding volumes against the six planes of the view
+//
+//  Created for CS-330-Computational Graphics and Visualization
+//  Date: 10/14/2026
+//  Notes: The planes are read straight out of the projection times view
+//         matrix, so they follow the camera and the perspective or
+//         orthographic projection without any extra setup.  Each plane
+//         faces into the frustum, so a volume is outside as soon as it
+//         is fully behind any one plane.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+/***********************************************************
+ *  ViewFrustum
+ *
+ *  This class holds the normalized planes of one view and
+ *  tests bounding boxes and spheres against them.
+ ***********************************************************/
+class ViewFrustum
+{
+public:
+	// world space axis aligned bounding box
+	struct BOUNDING_BOX
+	{
+		glm::vec3 minimum;
+		glm::vec3 maximum;
+	};
+
+	// result of testing a volume against the frustum
+	enum TEST_RESULT
+	{
+		TEST_OUTSIDE = 0,     // behind at least one plane
+		TEST_INTERSECTING,    // crosses at least one plane
+		TEST_INSIDE           // in front of every plane
+	};
+
+	static const int PLANE_COUNT = 6;
+
+	// constructor
+	ViewFrustum();
+
+	// read the planes out of a projection times view matrix
+	void SetMatrix(const glm::mat4& viewProjection);
+
+	// test a bounding box against the planes
+	TEST_RESULT TestBox(const BOUNDING_BOX& box) const;
+	// test a bounding sphere against the planes
+	TEST_RESULT TestSphere(const glm::vec3& center, float radius) const;
+
+private:
+	// plane normals in xyz and distances in w, facing inwards
+	glm::vec4 m_planes[PLANE_COUNT];
+};
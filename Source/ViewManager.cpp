@@ -14,40 +14,77 @@
 //    - Added keyboard support for vertical motion (Q/E keys)
 //    - Added toggle between orthographic and perspective views (O/P keys)
 //    - Added dynamic movement speed control using mouse scroll wheel
+// 
+//  Date: October 14, 2026
+//  Notes: 
+//    - Added deferred and forward shading selection (G/F keys)
+//    - Added depth pre-pass on and off keys (Z/X keys)
+//    - Added profiler overlay show and hide keys (V/C keys) and the
+//      frame trace key (T key)
+//    - Added the scripted camera pose of the benchmark mode
+//    - Added render statistics show and hide keys (I/U keys)
+//    - Set the initial blend state through the RenderState cache
+//    - Moved the camera movement onto a fixed-tick update thread, with
+//      the input and camera handed across in SnapshotBuffers, and each
+//      frame applying the input sampled since the last tick to a copy
+//    - Removed the unused ShaderManager pointer
+//    - Added sorted, weighted blended and linked list transparency
+//      selection (1/2/3 keys)
+//    - Made the window size configurable with a full screen option, and
+//      built the projection from the framebuffer size, which a resize
+//      callback keeps up to date
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "ViewManager.h"
+#include "RenderState.h"
 
 // GLM Math Header inclusions
 #include <glm/glm.hpp>
 #include <glm/gtx/transform.hpp>
 #include <glm/gtc/type_ptr.hpp>    
 
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
 // declaration of the global variables and defines
 namespace
 {
-	// Variables for window width and height
+	// Variables for the default window width and height
 	const int WINDOW_WIDTH = 1000;
 	const int WINDOW_HEIGHT = 800;
-	const char* g_ViewName = "view";
-	const char* g_ProjectionName = "projection";
+
+	// size of the window framebuffer, which can differ from the
+	// window size on high density displays, and its aspect ratio
+	// for the projection - read on the camera update thread too
+	int gFramebufferWidth = WINDOW_WIDTH;
+	int gFramebufferHeight = WINDOW_HEIGHT;
+	std::atomic<float> gAspectRatio((float)WINDOW_WIDTH / (float)WINDOW_HEIGHT);
 
 	// camera object used for viewing and interacting with
-	// the 3D scene
+	// the 3D scene - owned by the update thread exclusively while
+	// it runs, when the main thread only reads the copy in each
+	// view snapshot
 	Camera* g_pCamera = nullptr;
 
 	// these variables are used for mouse movement processing
 	float gLastX = WINDOW_WIDTH / 2.0f;
 	float gLastY = WINDOW_HEIGHT / 2.0f;
 	bool gFirstMouse = true;
+	// running totals of the mouse and scroll offsets, sampled
+	// with the keys for the camera update
+	double gMouseOffsetX = 0.0;
+	double gMouseOffsetY = 0.0;
+	double gScrollOffset = 0.0;
 
 	// time between current frame and last frame
 	float gDeltaTime = 0.0f; 
 	float gLastFrame = 0.0f;
 
 	// the following variable is false when orthographic projection
-	// is off and true when it is on
-	bool bOrthographicProjection = false;
+	// is off and true when it is on - written with the camera, and
+	// published with it in each view snapshot
+	std::atomic<bool> bOrthographicProjection(false);
 }
 
 /***********************************************************
@@ -59,12 +96,26 @@ namespace
  *  Updated base perspective view to an elevated, angled position
  *  for better contrast with orthographic projection
  ***********************************************************/
-ViewManager::ViewManager(
-	ShaderManager *pShaderManager)
+ViewManager::ViewManager()
 {
 	// initialize the member variables
-	m_pShaderManager = pShaderManager;
 	m_pWindow = NULL;
+	m_viewMatrix = glm::mat4(1.0f);
+	m_projectionMatrix = glm::mat4(1.0f);
+	m_bDeferredShading = false;
+	m_bDepthPrePass = false;
+	m_transparencyMode = 0;
+	m_bProfilerOverlay = false;
+	m_bRenderStats = false;
+	m_bTraceKeyDown = false;
+	m_bTraceRequested = false;
+	m_bScriptedCamera = false;
+	m_input.heldKeys = 0;
+	m_input.mouseOffsetX = 0.0;
+	m_input.mouseOffsetY = 0.0;
+	m_input.scrollOffset = 0.0;
+	m_lastInput = m_input;
+	m_bUpdateRunning = false;
 	g_pCamera = new Camera();
 	
 	g_pCamera->Position = glm::vec3(0.5f, 8.0f, 16.0f);     // Raised and pulled back for a fuller view
@@ -72,6 +123,7 @@ ViewManager::ViewManager(
 	g_pCamera->Up = glm::vec3(0.0f, 1.0f, 0.0f);            // Standard Y-up orientation
 	g_pCamera->Zoom = 80.0f;                                // Wider field of view to capture full scene
 	g_pCamera->MovementSpeed = 2.5;                         // Lowered movement speed for better control
+	m_cameraPosition = g_pCamera->Position;
 }
 
 /***********************************************************
@@ -81,8 +133,10 @@ ViewManager::ViewManager(
  ***********************************************************/
 ViewManager::~ViewManager()
 {
+	// the update thread uses the camera, so it stops first
+	StopUpdateThread();
+
 	// free up allocated memory
-	m_pShaderManager = NULL;
 	m_pWindow = NULL;
 	if (NULL != g_pCamera)
 	{
@@ -98,17 +152,52 @@ ViewManager::~ViewManager()
  * 
  *  Edited by Jerris English on August 3rd, 2025:
  *  Added scroll callback registration to support camera speed control
+ *
+ *  Edited on October 14, 2026:
+ *  - Added the window size and the full screen window on the
+ *    primary monitor, for the kiosk displays
+ *  - Added the framebuffer size callback registration
  ***********************************************************/
-GLFWwindow* ViewManager::CreateDisplayWindow(const char* windowTitle)
+GLFWwindow* ViewManager::CreateDisplayWindow(
+	const char* windowTitle,
+	int windowWidth,
+	int windowHeight,
+	bool bFullScreen)
 {
 	GLFWwindow* window = nullptr;
+	GLFWmonitor* monitor = NULL;
+
+	if (windowWidth <= 0)
+	{
+		windowWidth = WINDOW_WIDTH;
+	}
+	if (windowHeight <= 0)
+	{
+		windowHeight = WINDOW_HEIGHT;
+	}
+
+	// a full screen window keeps the monitor's own video mode
+	if (bFullScreen == true)
+	{
+		monitor = glfwGetPrimaryMonitor();
+		const GLFWvidmode* videoMode = (monitor != NULL) ? glfwGetVideoMode(monitor) : NULL;
+		if (videoMode != NULL)
+		{
+			windowWidth = videoMode->width;
+			windowHeight = videoMode->height;
+		}
+		else
+		{
+			monitor = NULL;
+		}
+	}
 
 	// try to create the displayed OpenGL window
 	window = glfwCreateWindow(
-		WINDOW_WIDTH,
-		WINDOW_HEIGHT,
+		windowWidth,
+		windowHeight,
 		windowTitle,
-		NULL, NULL);
+		monitor, NULL);
 	if (window == NULL)
 	{
 		std::cout << "Failed to create GLFW window" << std::endl;
@@ -126,9 +215,17 @@ GLFWwindow* ViewManager::CreateDisplayWindow(const char* windowTitle)
 	// this callback is used to receive scroll input for camera speed adjustment
 	glfwSetScrollCallback(window, &ViewManager::Mouse_Scroll_Callback);
 
+	// this callback is used to follow the framebuffer size, starting
+	// from the size the window was created with
+	glfwSetFramebufferSizeCallback(window, &ViewManager::Framebuffer_Size_Callback);
+	int framebufferWidth = 0;
+	int framebufferHeight = 0;
+	glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+	Framebuffer_Size_Callback(window, framebufferWidth, framebufferHeight);
+
 	// enable blending for supporting tranparent rendering
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	RenderState::SetBlend(true);
+	RenderState::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 	m_pWindow = window;
 
@@ -161,8 +258,9 @@ void ViewManager::Mouse_Position_Callback(GLFWwindow* window, double xMousePos,
 	gLastX = xMousePos;
 	gLastY = yMousePos;
 
-	// move the 3D camera according to the calculated offsets
-	g_pCamera->ProcessMouseMovement(xOffset, yOffset);
+	// add the offsets to the totals the 3D camera is moved by
+	gMouseOffsetX += xOffset;
+	gMouseOffsetY += yOffset;
 }
 
 /***********************************************************
@@ -175,8 +273,39 @@ void ViewManager::Mouse_Position_Callback(GLFWwindow* window, double xMousePos,
  ***********************************************************/
 void ViewManager::Mouse_Scroll_Callback(GLFWwindow* window, double xOffset, double yOffset)
 {
-	// Let the camera class handle the speed adjustment logic
-	g_pCamera->ProcessMouseScroll(static_cast<float>(yOffset));
+	// add the offset to the total the camera speed is adjusted by
+	gScrollOffset += yOffset;
+}
+
+/***********************************************************
+ *  Framebuffer_Size_Callback()
+ *
+ *  This method is called whenever the window framebuffer
+ *  changes size.  A minimized window reports a size of
+ *  zero, which is skipped so the last size is kept.
+ ***********************************************************/
+void ViewManager::Framebuffer_Size_Callback(GLFWwindow* window, int width, int height)
+{
+	if ((width <= 0) || (height <= 0))
+	{
+		return;
+	}
+
+	gFramebufferWidth = width;
+	gFramebufferHeight = height;
+	gAspectRatio = (float)width / (float)height;
+}
+
+/***********************************************************
+ *  GetFramebufferSize()
+ *
+ *  This method is used for getting the size in pixels of
+ *  the window framebuffer.
+ ***********************************************************/
+void ViewManager::GetFramebufferSize(int& width, int& height) const
+{
+	width = gFramebufferWidth;
+	height = gFramebufferHeight;
 }
 
 /***********************************************************
@@ -188,6 +317,15 @@ void ViewManager::Mouse_Scroll_Callback(GLFWwindow* window, double xOffset, doub
  *	Edited by Jerris English on August 3rd, 2025:
  *  - Added Q and E keys for vertical camera movement
  *  - Added O and P keys to toggle between orthographic and perspective views
+ *
+ *  Edited on October 14, 2026:
+ *  - Added G and F keys to select deferred or forward shading
+ *  - Added Z and X keys to turn the depth pre-pass on and off
+ *  - Added V and C keys to show and hide the profiler overlay,
+ *    and the T key to write a frame trace
+ *  - Added I and U keys to show and hide the render statistics
+ *  - Moved the camera movement into UpdateCamera(), the held
+ *    camera keys are only sampled here
  ***********************************************************/
 void ViewManager::ProcessKeyboardEvents()
 {
@@ -197,75 +335,234 @@ void ViewManager::ProcessKeyboardEvents()
 		glfwSetWindowShouldClose(m_pWindow, true);
 	}
 
-	// if the camera object is null, then exit this method
-	if (NULL == g_pCamera)
+	// Camera Keys - sampled here, where GLFW must be polled, and
+	// integrated into the camera by UpdateCamera()
+	const int CAMERA_KEYS[][2] =
 	{
-		return;
+		{ GLFW_KEY_W, INPUT_FORWARD },        // move forward (W) - zoom in
+		{ GLFW_KEY_S, INPUT_BACKWARD },       // move backward (S) - zoom out
+		{ GLFW_KEY_A, INPUT_LEFT },           // strafe left (A)
+		{ GLFW_KEY_D, INPUT_RIGHT },          // strafe right (D)
+		{ GLFW_KEY_Q, INPUT_UP },             // move upward (Q)
+		{ GLFW_KEY_E, INPUT_DOWN },           // move downward (E)
+		{ GLFW_KEY_P, INPUT_PERSPECTIVE },    // perspective view (P)
+		{ GLFW_KEY_O, INPUT_ORTHOGRAPHIC }    // orthographic view (O)
+	};
+	m_input.heldKeys = 0;
+	for (int i = 0; i < sizeof(CAMERA_KEYS) / sizeof(CAMERA_KEYS[0]); i++)
+	{
+		if (glfwGetKey(m_pWindow, CAMERA_KEYS[i][0]) == GLFW_PRESS)
+		{
+			m_input.heldKeys |= CAMERA_KEYS[i][1];
+		}
+	}
+	m_input.mouseOffsetX = gMouseOffsetX;
+	m_input.mouseOffsetY = gMouseOffsetY;
+	m_input.scrollOffset = gScrollOffset;
+	if (m_bUpdateRunning == true)
+	{
+		m_inputBuffer.GetWriteSlot() = m_input;
+		m_inputBuffer.Publish();
+	}
+
+	// Shading Mode Keys
+
+	// shade the opaque surfaces from the G-buffer (G)
+	if (glfwGetKey(m_pWindow, GLFW_KEY_G) == GLFW_PRESS)
+	{
+		m_bDeferredShading = true;
+	}
+
+	// shade every surface as it is drawn (F)
+	if (glfwGetKey(m_pWindow, GLFW_KEY_F) == GLFW_PRESS)
+	{
+		m_bDeferredShading = false;
+	}
+
+	// lay down the opaque depth before shading (Z)
+	if (glfwGetKey(m_pWindow, GLFW_KEY_Z) == GLFW_PRESS)
+	{
+		m_bDepthPrePass = true;
+	}
+
+	// shade the opaque surfaces without a depth pre-pass (X)
+	if (glfwGetKey(m_pWindow, GLFW_KEY_X) == GLFW_PRESS)
+	{
+		m_bDepthPrePass = false;
+	}
+
+	// Transparency Keys
+
+	// blend the glass back to front by node (1)
+	if (glfwGetKey(m_pWindow, GLFW_KEY_1) == GLFW_PRESS)
+	{
+		m_transparencyMode = 0;
+	}
+
+	// blend the glass with weighted blended transparency (2)
+	if (glfwGetKey(m_pWindow, GLFW_KEY_2) == GLFW_PRESS)
+	{
+		m_transparencyMode = 1;
+	}
+
+	// sort the glass fragments of each pixel by depth (3)
+	if (glfwGetKey(m_pWindow, GLFW_KEY_3) == GLFW_PRESS)
+	{
+		m_transparencyMode = 2;
+	}
+
+	// Profiler Keys
+
+	// show the CPU and GPU time of each frame section (V)
+	if (glfwGetKey(m_pWindow, GLFW_KEY_V) == GLFW_PRESS)
+	{
+		m_bProfilerOverlay = true;
+	}
+
+	// hide the profiler overlay (C)
+	if (glfwGetKey(m_pWindow, GLFW_KEY_C) == GLFW_PRESS)
+	{
+		m_bProfilerOverlay = false;
+	}
+
+	// show the draw, upload and state change counts of each
+	// frame in the window title (I)
+	if (glfwGetKey(m_pWindow, GLFW_KEY_I) == GLFW_PRESS)
+	{
+		m_bRenderStats = true;
+	}
+
+	// hide the render statistics (U)
+	if (glfwGetKey(m_pWindow, GLFW_KEY_U) == GLFW_PRESS)
+	{
+		m_bRenderStats = false;
+	}
+
+	// write the recorded frames to a trace file (T) - only once
+	// per press, however long the key is held
+	bool bTraceKeyDown = (glfwGetKey(m_pWindow, GLFW_KEY_T) == GLFW_PRESS);
+	if ((bTraceKeyDown == true) && (m_bTraceKeyDown == false))
+	{
+		m_bTraceRequested = true;
+	}
+	m_bTraceKeyDown = bTraceKeyDown;
+}
+
+/***********************************************************
+ *  ConsumeTraceRequest()
+ *
+ *  This method is used for checking whether the trace key
+ *  was pressed since the last call, clearing the request.
+ ***********************************************************/
+bool ViewManager::ConsumeTraceRequest()
+{
+	bool bRequested = m_bTraceRequested;
+	m_bTraceRequested = false;
+	return(bRequested);
+}
+
+/***********************************************************
+ *  UpdateCamera()
+ *
+ *  This method is used for moving a camera by a sampled
+ *  input state over a time step - on the update thread at
+ *  its fixed tick when it runs, else once per frame.  The
+ *  mouse and scroll offsets are the ones since lastInput.
+ *  Each frame also moves a copy of the update thread's
+ *  camera by the input sampled since its last tick.
+ *
+ *	Edited by Jerris English on August 3rd, 2025:
+ *  - Added Q and E keys for vertical camera movement
+ *  - Added O and P keys to toggle between orthographic and perspective views
+ *
+ *  Edited on October 14, 2026:
+ *  - Moved out of ProcessKeyboardEvents() for the update thread
+ ***********************************************************/
+void ViewManager::UpdateCamera(
+	Camera& camera,
+	bool& bOrthographic,
+	const INPUT_STATE& input,
+	const INPUT_STATE& lastInput,
+	float deltaTime)
+{
+	// Mouse Movement - the input holds running totals, so no
+	// motion is lost however many snapshots were skipped
+	float xOffset = (float)(input.mouseOffsetX - lastInput.mouseOffsetX);
+	float yOffset = (float)(input.mouseOffsetY - lastInput.mouseOffsetY);
+	if ((xOffset != 0.0f) || (yOffset != 0.0f))
+	{
+		camera.ProcessMouseMovement(xOffset, yOffset);
+	}
+	float scrollOffset = (float)(input.scrollOffset - lastInput.scrollOffset);
+	if (scrollOffset != 0.0f)
+	{
+		// Let the camera class handle the speed adjustment logic
+		camera.ProcessMouseScroll(scrollOffset);
 	}
 
-	// Movement Keys 
+	// Movement Keys - integrated over the passed in time step
 
 	// move forward (W) - zoom in
-	if (glfwGetKey(m_pWindow, GLFW_KEY_W) == GLFW_PRESS)
+	if ((input.heldKeys & INPUT_FORWARD) != 0)
 	{
-		g_pCamera->ProcessKeyboard(FORWARD, gDeltaTime);
+		camera.ProcessKeyboard(FORWARD, deltaTime);
 	}
 
 	// move backward (S) - zoom out
-	if (glfwGetKey(m_pWindow, GLFW_KEY_S) == GLFW_PRESS)
+	if ((input.heldKeys & INPUT_BACKWARD) != 0)
 	{
-		g_pCamera->ProcessKeyboard(BACKWARD, gDeltaTime);
+		camera.ProcessKeyboard(BACKWARD, deltaTime);
 	}
 
 	// strafe left (A)
-	if (glfwGetKey(m_pWindow, GLFW_KEY_A) == GLFW_PRESS)
+	if ((input.heldKeys & INPUT_LEFT) != 0)
 	{
-		g_pCamera->ProcessKeyboard(LEFT, gDeltaTime);
+		camera.ProcessKeyboard(LEFT, deltaTime);
 	}
 
 	// strafe right (D)
-	if (glfwGetKey(m_pWindow, GLFW_KEY_D) == GLFW_PRESS)
+	if ((input.heldKeys & INPUT_RIGHT) != 0)
 	{
-		g_pCamera->ProcessKeyboard(RIGHT, gDeltaTime);
+		camera.ProcessKeyboard(RIGHT, deltaTime);
 	}
 
 	// move upward (Q)
-	if (glfwGetKey(m_pWindow, GLFW_KEY_Q) == GLFW_PRESS)
+	if ((input.heldKeys & INPUT_UP) != 0)
 	{
-		g_pCamera->ProcessKeyboard(UP, gDeltaTime);
+		camera.ProcessKeyboard(UP, deltaTime);
 	}
 
 	// move downward (E)
-	if (glfwGetKey(m_pWindow, GLFW_KEY_E) == GLFW_PRESS)
+	if ((input.heldKeys & INPUT_DOWN) != 0)
 	{
-		g_pCamera->ProcessKeyboard(DOWN, gDeltaTime);
+		camera.ProcessKeyboard(DOWN, deltaTime);
 	}
 
 	// Projection Mode Toggle Keys
 
 	// switch to perspective view when the P key is pressed
-	if (glfwGetKey(m_pWindow, GLFW_KEY_P) == GLFW_PRESS)
+	if ((input.heldKeys & INPUT_PERSPECTIVE) != 0)
 	{
-		bOrthographicProjection = false;  // disable orthographic mode
+		bOrthographic = false;  // disable orthographic mode
 
 		// Reset camera to a slightly elevated 3D viewpoint
 		// This gives the user a sense of depth and perspective
-		g_pCamera->Position = glm::vec3(0.5f, 10.5f, 22.0f);   // high and back
-		g_pCamera->Front = glm::normalize(glm::vec3(-0.1f, -0.45f, -1.0f));  // angled downward
-		g_pCamera->Up = glm::vec3(0.0f, 1.0f, 0.0f);           // Y-up orientation
+		camera.Position = glm::vec3(0.5f, 10.5f, 22.0f);   // high and back
+		camera.Front = glm::normalize(glm::vec3(-0.1f, -0.45f, -1.0f));  // angled downward
+		camera.Up = glm::vec3(0.0f, 1.0f, 0.0f);           // Y-up orientation
 	}
 
 	// switch to orthographic view when the O key is pressed
-	if (glfwGetKey(m_pWindow, GLFW_KEY_O) == GLFW_PRESS)
+	if ((input.heldKeys & INPUT_ORTHOGRAPHIC) != 0)
 	{
-		bOrthographicProjection = true;  // enable orthographic mode
+		bOrthographic = true;  // enable orthographic mode
 
 		// Reset camera to a centered, head-on orthographic view
 		// Moves the camera higher to align with top of cabinet and lamp
 		// Removes perspective distortion while keeping objects aligned vertically
-		g_pCamera->Position = glm::vec3(0.0f, 7.5f, 12.0f);   // Raise eye-level to match lamp area
-		g_pCamera->Front = glm::vec3(0.0f, 0.0f, -1.0f);      // Look directly toward Z
-		g_pCamera->Up = glm::vec3(0.0f, 1.0f, 0.0f);          // Keep vertical orientation
+		camera.Position = glm::vec3(0.0f, 7.5f, 12.0f);   // Raise eye-level to match lamp area
+		camera.Front = glm::vec3(0.0f, 0.0f, -1.0f);      // Look directly toward Z
+		camera.Up = glm::vec3(0.0f, 1.0f, 0.0f);          // Keep vertical orientation
 	}
 }
 
@@ -278,32 +575,195 @@ void ViewManager::ProcessKeyboardEvents()
  ***********************************************************/
 void ViewManager::PrepareSceneView()
 {
-	glm::mat4 view;
-	glm::mat4 projection;
-
 	// per-frame timing
 	float currentFrame = glfwGetTime();
 	gDeltaTime = currentFrame - gLastFrame;
 	gLastFrame = currentFrame;
 
 	// process any keyboard events that may be waiting in the 
-	// event queue
-	ProcessKeyboardEvents();
+	// event queue - a scripted camera ignores them
+	if (m_bScriptedCamera == false)
+	{
+		ProcessKeyboardEvents();
+	}
 
+	// keep the matrices for the scene manager, which uploads
+	// them into the shader frame block.  With the update thread
+	// the newest tick's camera is copied and moved by the input
+	// sampled just now, over the time since that tick, so the
+	// frame never waits a tick to show it - the next tick then
+	// moves the camera itself by the same input
+	if (m_bUpdateRunning == true)
+	{
+		m_viewBuffer.Acquire();
+		const VIEW_SNAPSHOT& snapshot = m_viewBuffer.GetReadSlot();
+		Camera camera = snapshot.camera;
+		bool bOrthographic = snapshot.bOrthographic;
+
+		std::chrono::duration<float> sinceTick = std::chrono::steady_clock::now() - snapshot.tickTime;
+		float elapsed = std::min(std::max(sinceTick.count(), 0.0f), 1.0f / UPDATE_TICK_RATE);
+		UpdateCamera(camera, bOrthographic, m_input, snapshot.input, elapsed);
+		SetView(camera);
+		return;
+	}
+
+	if (NULL == g_pCamera)
+	{
+		return;
+	}
+
+	// without the update thread the camera moves once per frame
+	if (m_bScriptedCamera == false)
+	{
+		bool bOrthographic = bOrthographicProjection;
+		UpdateCamera(*g_pCamera, bOrthographic, m_input, m_lastInput, gDeltaTime);
+		bOrthographicProjection = bOrthographic;
+		m_lastInput = m_input;
+	}
+	SetView(*g_pCamera);
+}
+
+/***********************************************************
+ *  SetView()
+ *
+ *  This method is used for keeping the view and projection
+ *  matrices and the position of a camera for the frame.
+ ***********************************************************/
+void ViewManager::SetView(Camera& camera)
+{
 	// get the current view matrix from the camera
-	view = g_pCamera->GetViewMatrix();
+	m_viewMatrix = camera.GetViewMatrix();
 
-	// define the current projection matrix
-	projection = glm::perspective(glm::radians(g_pCamera->Zoom), (GLfloat)WINDOW_WIDTH / (GLfloat)WINDOW_HEIGHT, 0.1f, 100.0f);
+	// define the current projection matrix, for the shape of the
+	// window framebuffer
+	m_projectionMatrix = glm::perspective(glm::radians(camera.Zoom), gAspectRatio.load(), 0.1f, 100.0f);
 
-	// if the shader manager object is valid
-	if (NULL != m_pShaderManager)
+	m_cameraPosition = camera.Position;
+}
+
+/***********************************************************
+ *  BuildSnapshot()
+ *
+ *  This method is used for copying the camera, the input it
+ *  was last moved by and the time it is current at into a
+ *  view snapshot.
+ ***********************************************************/
+void ViewManager::BuildSnapshot(VIEW_SNAPSHOT& snapshot, std::chrono::steady_clock::time_point tickTime) const
+{
+	snapshot.camera = *g_pCamera;
+	snapshot.bOrthographic = bOrthographicProjection;
+	snapshot.input = m_lastInput;
+	snapshot.tickTime = tickTime;
+}
+
+/***********************************************************
+ *  StartUpdateThread()
+ *
+ *  This method is used for starting the thread that moves
+ *  the camera at a fixed tick.  The first snapshot is
+ *  published before the thread starts, so a frame always
+ *  has one.  From then on the thread owns the camera.  The
+ *  scripted benchmark camera keeps the per-frame update.
+ ***********************************************************/
+void ViewManager::StartUpdateThread()
+{
+	if ((m_bUpdateRunning == true) || (m_bScriptedCamera == true) || (NULL == g_pCamera))
+	{
+		return;
+	}
+
+	BuildSnapshot(m_viewBuffer.GetWriteSlot(), std::chrono::steady_clock::now());
+	m_viewBuffer.Publish();
+	m_inputBuffer.GetWriteSlot() = m_input;
+	m_inputBuffer.Publish();
+
+	m_bUpdateRunning = true;
+	m_updateThread = std::thread(&ViewManager::RunUpdateThread, this);
+}
+
+/***********************************************************
+ *  StopUpdateThread()
+ *
+ *  This method is used for stopping the update thread and
+ *  waiting for it to finish its last tick.
+ ***********************************************************/
+void ViewManager::StopUpdateThread()
+{
+	m_bUpdateRunning = false;
+	if (m_updateThread.joinable() == true)
+	{
+		m_updateThread.join();
+	}
+}
+
+/***********************************************************
+ *  RunUpdateThread()
+ *
+ *  This method is the loop of the update thread.  Each tick
+ *  takes the newest sampled input, moves the camera by one
+ *  fixed time step and publishes it with the tick time.  A late tick is
+ *  caught up with extra steps, so the camera speed does not
+ *  depend on the frame rate or on the thread being delayed.
+ ***********************************************************/
+void ViewManager::RunUpdateThread()
+{
+	const std::chrono::nanoseconds TICK_DURATION(1000000000 / UPDATE_TICK_RATE);
+	const float TICK_SECONDS = 1.0f / UPDATE_TICK_RATE;
+	// most steps taken to catch up, after a long stall
+	const int MAX_CATCH_UP_TICKS = 8;
+
+	std::chrono::steady_clock::time_point nextTick = std::chrono::steady_clock::now();
+	while (m_bUpdateRunning == true)
+	{
+		nextTick += TICK_DURATION;
+		std::this_thread::sleep_until(nextTick);
+
+		// the steps owed since the last tick
+		int tickCount = 1;
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		while ((now >= nextTick + TICK_DURATION) && (tickCount < MAX_CATCH_UP_TICKS))
+		{
+			nextTick += TICK_DURATION;
+			tickCount++;
+		}
+		if (now >= nextTick + TICK_DURATION)
+		{
+			nextTick = now;
+		}
+
+		m_inputBuffer.Acquire();
+		const INPUT_STATE& input = m_inputBuffer.GetReadSlot();
+		bool bOrthographic = bOrthographicProjection;
+		for (int i = 0; i < tickCount; i++)
+		{
+			UpdateCamera(*g_pCamera, bOrthographic, input, m_lastInput, TICK_SECONDS);
+			m_lastInput = input;
+		}
+		bOrthographicProjection = bOrthographic;
+
+		BuildSnapshot(m_viewBuffer.GetWriteSlot(), nextTick);
+		m_viewBuffer.Publish();
+	}
+}
+
+/***********************************************************
+ *  SetCameraPose()
+ *
+ *  This method is used for placing the camera from a script
+ *  instead of the input, for repeatable benchmark runs.
+ *  The update thread owns the camera, so it is stopped.
+ ***********************************************************/
+void ViewManager::SetCameraPose(const glm::vec3& position, const glm::vec3& front)
+{
+	if (NULL == g_pCamera)
 	{
-		// set the view matrix into the shader for proper rendering
-		m_pShaderManager->setMat4Value(g_ViewName, view);
-		// set the view matrix into the shader for proper rendering
-		m_pShaderManager->setMat4Value(g_ProjectionName, projection);
-		// set the view position of the camera into the shader for proper rendering
-		m_pShaderManager->setVec3Value("viewPosition", g_pCamera->Position);
+		return;
 	}
-}
\ No newline at end of file
+
+	StopUpdateThread();
+
+	g_pCamera->Position = position;
+	g_pCamera->Front = glm::normalize(front);
+	g_pCamera->Up = glm::vec3(0.0f, 1.0f, 0.0f);
+	m_bScriptedCamera = true;
+}
@@ -9,22 +9,45 @@
 //	EDITED BY: Jerris English - SNHU CS Major
 //  DATE: August 3rd, 2025
 //  CHANGES: Added scroll callback declaration and registered it in the constructor
+//
+//  DATE: October 14, 2026
+//  CHANGES: Keep the view and projection matrices of the current frame so
+//           the scene manager can sort and cull against them, and upload
+//           them into the shader frame block shared by every program
+//  CHANGES: Added the G and F keys to select deferred or forward shading
+//  CHANGES: Added the Z and X keys to turn the depth pre-pass on and off
+//  CHANGES: Added the V and C keys to show and hide the profiler overlay,
+//           and the T key to write a frame trace
+//  CHANGES: Added SetCameraPose() for the scripted benchmark camera
+//  CHANGES: Added the I and U keys to show and hide the render statistics
+//  CHANGES: Move the camera on a fixed-tick update thread, fed the sampled
+//           input and handing back the camera through SnapshotBuffers -
+//           each frame applies the input sampled since the tick to a copy
+//  CHANGES: Removed the unused ShaderManager pointer
+//  CHANGES: Added the 1, 2 and 3 keys to select the transparency mode
+//  CHANGES: Added the window size and full screen options, and a
+//           framebuffer size callback the projection aspect follows
 ///////////////////////////////////////////////////////////////////////////////
 
 #pragma once
 
-#include "ShaderManager.h"
+#include <GL/glew.h>
+
+#include "SnapshotBuffer.h"
 #include "camera.h"
 
 // GLFW library
 #include "GLFW/glfw3.h" 
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 class ViewManager
 {
 public:
 	// constructor
-	ViewManager(
-		ShaderManager* pShaderManager);
+	ViewManager();
 	// destructor
 	~ViewManager();
 
@@ -34,19 +57,134 @@ public:
 	// callback to adjust camera speed using scroll wheel (added by Jerris English)
 	static void Mouse_Scroll_Callback(GLFWwindow* window, double xOffset, double yOffset);
 
+	// callback to follow the window framebuffer size when the window is resized
+	static void Framebuffer_Size_Callback(GLFWwindow* window, int width, int height);
+
 private:
-	// pointer to shader manager object
-	ShaderManager* m_pShaderManager;
+	// camera keys held down when the input was sampled
+	enum INPUT_KEY
+	{
+		INPUT_FORWARD = 1,
+		INPUT_BACKWARD = 2,
+		INPUT_LEFT = 4,
+		INPUT_RIGHT = 8,
+		INPUT_UP = 16,
+		INPUT_DOWN = 32,
+		INPUT_PERSPECTIVE = 64,
+		INPUT_ORTHOGRAPHIC = 128
+	};
+
+	// input sampled on the main thread for the camera update -
+	// the mouse and scroll offsets are running totals
+	struct INPUT_STATE
+	{
+		unsigned int heldKeys;
+		double mouseOffsetX;
+		double mouseOffsetY;
+		double scrollOffset;
+	};
+
+	// camera state handed back to the render thread, with the
+	// input it was moved by and the tick time it is current at
+	struct VIEW_SNAPSHOT
+	{
+		Camera camera;
+		bool bOrthographic;
+		INPUT_STATE input;
+		std::chrono::steady_clock::time_point tickTime;
+	};
+
+	// camera update ticks per second
+	static const int UPDATE_TICK_RATE = 120;
+
 	// active OpenGL display window
 	GLFWwindow* m_pWindow;
+	// view and projection of the current frame
+	glm::mat4 m_viewMatrix;
+	glm::mat4 m_projectionMatrix;
+	// true when deferred shading is selected with the G key
+	bool m_bDeferredShading;
+	// true when the depth pre-pass is selected with the Z key
+	bool m_bDepthPrePass;
+	// transparency mode selected with the 1, 2 and 3 keys - a
+	// SceneManager::TRANSPARENCY_MODE
+	int m_transparencyMode;
+	// true when the profiler overlay is shown with the V key
+	bool m_bProfilerOverlay;
+	// true when the render statistics are shown with the I key
+	bool m_bRenderStats;
+	// the T key state of the last frame, and whether a press is
+	// waiting to be handled
+	bool m_bTraceKeyDown;
+	bool m_bTraceRequested;
+	// true once the camera follows SetCameraPose() instead of input
+	bool m_bScriptedCamera;
+	// camera position of the current frame
+	glm::vec3 m_cameraPosition;
+	// input sampled on the main thread, and the input the camera
+	// was last updated with - the update thread's while it runs
+	INPUT_STATE m_input;
+	INPUT_STATE m_lastInput;
+	// input handed to the update thread, and the view handed back
+	SnapshotBuffer<INPUT_STATE> m_inputBuffer;
+	SnapshotBuffer<VIEW_SNAPSHOT> m_viewBuffer;
+	// fixed-tick camera update thread
+	std::thread m_updateThread;
+	std::atomic<bool> m_bUpdateRunning;
 
 	// process keyboard events for interaction with the 3D scene
 	void ProcessKeyboardEvents();
+	// move a camera by the input sampled since lastInput over a
+	// time step - the P and O keys also set the projection flag
+	static void UpdateCamera(
+		Camera& camera,
+		bool& bOrthographic,
+		const INPUT_STATE& input,
+		const INPUT_STATE& lastInput,
+		float deltaTime);
+	// keep the view values of the current frame from a camera
+	void SetView(Camera& camera);
+	// fill a view snapshot from the camera
+	void BuildSnapshot(VIEW_SNAPSHOT& snapshot, std::chrono::steady_clock::time_point tickTime) const;
+	// loop of the update thread, until StopUpdateThread()
+	void RunUpdateThread();
 
 public:
-	// create the initial OpenGL display window
-	GLFWwindow* CreateDisplayWindow(const char* windowTitle);
+	// create the initial OpenGL display window - a size of zero
+	// keeps the default, and a full screen window takes the size
+	// of the primary monitor
+	GLFWwindow* CreateDisplayWindow(
+		const char* windowTitle,
+		int windowWidth = 0,
+		int windowHeight = 0,
+		bool bFullScreen = false);
 	
 	// prepare the conversion from 3D object display to 2D scene display
 	void PrepareSceneView();
+	// move the camera on its own thread at a fixed tick, instead
+	// of once per frame in PrepareSceneView()
+	void StartUpdateThread();
+	void StopUpdateThread();
+
+	// get the view values of the current frame
+	const glm::mat4& GetViewMatrix() const { return(m_viewMatrix); }
+	const glm::mat4& GetProjectionMatrix() const { return(m_projectionMatrix); }
+	const glm::vec3& GetCameraPosition() const { return(m_cameraPosition); }
+	// get the size in pixels of the window framebuffer
+	void GetFramebufferSize(int& width, int& height) const;
+	// check whether deferred shading is selected
+	bool IsDeferredShading() const { return(m_bDeferredShading); }
+	// check whether the depth pre-pass is selected
+	bool IsDepthPrePass() const { return(m_bDepthPrePass); }
+	// get the selected transparency mode
+	int GetTransparencyMode() const { return(m_transparencyMode); }
+	// check whether the profiler overlay is shown
+	bool IsProfilerOverlay() const { return(m_bProfilerOverlay); }
+	// check whether the render statistics are shown
+	bool IsRenderStats() const { return(m_bRenderStats); }
+	// check whether the T key was pressed since the last call
+	bool ConsumeTraceRequest();
+	// place the camera for the next frame - from then on the
+	// keyboard no longer moves it
+	void SetCameraPose(const glm::vec3& position, const glm::vec3& front);
 };
\ No newline at end of file
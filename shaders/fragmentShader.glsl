@@ -1,9 +1,33 @@
 ﻿#version 330 core
+#ifdef USE_BINDLESS_TEXTURE
+#extension GL_ARB_bindless_texture : require
+#endif
+#ifdef USE_DEFERRED_GBUFFER
+// targets of the deferred geometry pass - see GBuffer::TARGET
+layout(location = 0) out vec4 gPosition;
+layout(location = 1) out vec4 gNormal;
+layout(location = 2) out vec4 gAlbedo;
+#elif defined(USE_OIT_WEIGHTED)
+// targets of the weighted blended transparency pass - see
+// TransparencyBuffers
+layout(location = 0) out vec4 oitAccumulation;
+layout(location = 1) out float oitRevealage;
+#else
 out vec4 fragmentColor;
+#endif
+
+#ifdef USE_OIT_LINKED_LIST
+// only the fragments in front of the opaque depth are stored
+layout(early_fragment_tests) in;
+#endif
 
 in vec3 fragmentPosition;
 in vec3 fragmentVertexNormal;
 in vec2 fragmentTextureCoordinate;
+in vec4 instanceColor;
+in vec2 instanceUVscale;
+flat in int instanceMaterial;
+flat in int instanceTexture;
 
 struct Material {
     vec3 diffuseColor;
@@ -42,66 +66,437 @@ struct SpotLight {
 };
 
 #define TOTAL_POINT_LIGHTS 5
+// light cluster grid - see LightClusters::GRID_X, GRID_Y and GRID_Z
+#define CLUSTER_GRID_X 16
+#define CLUSTER_GRID_Y 9
+#define CLUSTER_GRID_Z 24
+#define MAX_OBJECT_MATERIALS 32
+#define MAX_SCENE_TEXTURES 64
+// how far the shadow lookups are moved off the surface along its
+// normal, and how far apart the cube map taps are per unit of distance
+#define SHADOW_NORMAL_OFFSET 0.02
+#define POINT_SHADOW_SPREAD 0.006
+// translucent layers the linked list resolve blends at each pixel, and
+// the head value that ends a list - see TransparencyBuffers
+#define OIT_MAX_LAYERS 8
+#define OIT_LIST_END 0xFFFFFFFFu
+
+// std140 blocks shared by every program - see SceneManager.h for the
+// matching C++ layouts
+layout(std140) uniform MaterialBlock {
+    Material materials[MAX_OBJECT_MATERIALS];
+};
 
-uniform bool bUseTexture = false;
+layout(std140) uniform LightBlock {
+    DirectionalLight directionalLight;
+    PointLight pointLights[TOTAL_POINT_LIGHTS];
+    SpotLight spotLight;
+};
+
+layout(std140) uniform FrameBlock {
+    mat4 view;
+    mat4 projection;
+    // projection * view, multiplied once per frame on the CPU
+    mat4 viewProjection;
+    vec3 viewPosition;
+    // maps a fragment to its light cluster - see LightClusters
+    vec4 clusterScale;
+    // light space of the directional shadow map
+    mat4 shadowViewProjection;
+    // position of the shadowed point light, and the far plane of its cube
+    vec4 shadowLightPosition;
+    // x: directional map drawn, y: point cube drawn, z: cube near plane,
+    // w: texel size of the directional map
+    vec4 shadowParams;
+};
+
+#ifdef USE_CLUSTERED_LIGHTING
+// every active point light, and the lights of each cluster as an
+// offset and count into the packed light index list
+layout(std430, binding = 1) readonly buffer PointLightBlock {
+    PointLight clusteredLights[];
+};
+layout(std430, binding = 2) readonly buffer ClusterBlock {
+    uvec2 clusters[];
+};
+layout(std430, binding = 3) readonly buffer LightIndexBlock {
+    uint lightIndices[];
+};
+#endif
+
+// the permutation defines of ShaderPermutations fix which lights are on
+// and whether the draw is lit and textured when the program is built, so
+// the branches on them fold away.  Built without them, as the shader
+// manager builds this file, everything is still checked at run time.
+#ifdef OBJECT_LIT
+const bool bUseLighting = OBJECT_LIT;
+#else
 uniform bool bUseLighting = false;
-uniform vec4 objectColor = vec4(1.0);
-uniform vec3 viewPosition;
-uniform DirectionalLight directionalLight;
-uniform PointLight pointLights[TOTAL_POINT_LIGHTS];
-uniform SpotLight spotLight;
-uniform Material material;
+#endif
+
+#ifdef ACTIVE_POINT_LIGHTS
+// the active point lights are packed to the front of the light block
+#define POINT_LIGHT_ON(i) true
+#else
+#define ACTIVE_POINT_LIGHTS TOTAL_POINT_LIGHTS
+#define POINT_LIGHT_ON(i) pointLights[i].bActive
+#endif
+#ifndef DIRECTIONAL_LIGHT_ON
+#define DIRECTIONAL_LIGHT_ON directionalLight.bActive
+#endif
+#ifndef SPOT_LIGHT_ON
+#define SPOT_LIGHT_ON spotLight.bActive
+#endif
+
+#ifdef USE_BINDLESS_TEXTURE
+// resident handles of the scene textures, indexed by the instance
+// texture slot - the handle is in .xy, see SceneManager::TEXTURE_BLOCK
+layout(std140) uniform TextureBlock {
+    uvec4 textureHandles[MAX_SCENE_TEXTURES];
+};
+#else
+#ifndef OBJECT_TEXTURED
+uniform bool bUseTexture = false;
+#endif
+
 uniform sampler2D objectTexture;
-uniform vec2 UVscale = vec2(1.0, 1.0);
+#endif
+
+#ifdef OBJECT_TEXTURED
+const bool bUseTexture = OBJECT_TEXTURED;
+#endif
+
+// the shadow maps - see ShadowMaps.  The frame block says whether each
+// one has been drawn.  The bulb's cube is for the first point light in
+// the light block and in the clustered light list.
+uniform sampler2DShadow directionalShadowMap;
+uniform samplerCubeShadow pointShadowMap;
+
+#ifdef USE_DEFERRED_LIGHTING
+// the G-buffer of the deferred geometry pass, read one texel per pixel
+uniform sampler2D gPositionTexture;
+uniform sampler2D gNormalTexture;
+uniform sampler2D gAlbedoTexture;
+uniform sampler2D gDepthTexture;
+#endif
+
+#ifdef USE_OIT_WEIGHTED_COMPOSITE
+// the weighted sums of the translucent fragments, read one texel per pixel
+uniform sampler2D oitAccumulationTexture;
+uniform sampler2D oitRevealageTexture;
+#endif
+
+#ifdef USE_UPSCALE_SHARPEN
+// the scene drawn into the lower left corner of a window sized target -
+// the corner's share of the target in each direction, and how hard the
+// stretched frame is sharpened
+uniform sampler2D sceneColorTexture;
+uniform vec2 upscaleRegion;
+uniform float upscaleSharpness;
+#endif
+
+#if defined(USE_OIT_LINKED_LIST) || defined(USE_OIT_LINKED_LIST_RESOLVE)
+// the translucent fragments of each pixel as a list through the node
+// buffer - each node holds the color as two half pairs, the depth and
+// the index of the next node
+layout(binding = 0, r32ui) uniform coherent uimage2D oitHeads;
+layout(std430, binding = 4) coherent buffer OitNodeBlock {
+    uint oitNodeCount;
+    uvec4 oitNodes[];
+};
+#endif
+
+// material of the current draw, picked from the material block
+Material material;
 
-void CalcDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir, out vec3 ad, out vec3 sp);
-void CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir, out vec3 ad, out vec3 sp);
+void CalcDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir, float shadow, out vec3 ad, out vec3 sp);
+void CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir, float shadow, out vec3 ad, out vec3 sp);
 void CalcSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir, out vec3 ad, out vec3 sp);
 
-void main()
+// how much of the directional light reaches a surface point - a 3x3
+// percentage closer filter over the directional shadow map
+float DirectionalShadow(vec3 position, vec3 normal)
 {
-    vec4 texSample = bUseTexture
-        ? texture(objectTexture, fragmentTextureCoordinate * UVscale)
-        : vec4(objectColor.rgb, objectColor.a);
+    if (shadowParams.x == 0.0) {
+        return 1.0;
+    }
 
-    vec3 baseColor = bUseTexture ? texSample.rgb : objectColor.rgb;
-    float baseAlpha = bUseTexture ? texSample.a : objectColor.a;
+    vec4 lightPosition = shadowViewProjection * vec4(position + normal * SHADOW_NORMAL_OFFSET, 1.0);
+    vec3 coord = lightPosition.xyz / lightPosition.w * 0.5 + 0.5;
 
-    if (!bUseLighting) {
-        fragmentColor = vec4(baseColor * objectColor.rgb, baseAlpha * objectColor.a);
-        return;
+    float lit = 0.0;
+    for (int y = -1; y <= 1; ++y) {
+        for (int x = -1; x <= 1; ++x) {
+            lit += texture(directionalShadowMap, vec3(coord.xy + vec2(x, y) * shadowParams.w, coord.z));
+        }
     }
+    return lit / 9.0;
+}
+
+// how much of the shadowed point light reaches a surface point - four
+// taps around the direction from the light into its cube map
+float PointShadow(vec3 position, vec3 normal)
+{
+    vec3 toPosition = position + normal * SHADOW_NORMAL_OFFSET - shadowLightPosition.xyz;
+
+    // a cube face holds the perspective depth of the major axis
+    // distance, so the compare depth is built the same way
+    float nearPlane = shadowParams.z;
+    float farPlane = shadowLightPosition.w;
+    vec3 axisDistance = abs(toPosition);
+    float majorDistance = max(axisDistance.x, max(axisDistance.y, axisDistance.z));
+    float depth = (farPlane + nearPlane) / (farPlane - nearPlane) -
+        (2.0 * farPlane * nearPlane) / ((farPlane - nearPlane) * majorDistance);
+    depth = depth * 0.5 + 0.5;
+
+    float spread = majorDistance * POINT_SHADOW_SPREAD;
+    float lit = texture(pointShadowMap, vec4(toPosition + vec3(spread, spread, spread), depth));
+    lit += texture(pointShadowMap, vec4(toPosition + vec3(-spread, -spread, spread), depth));
+    lit += texture(pointShadowMap, vec4(toPosition + vec3(-spread, spread, -spread), depth));
+    lit += texture(pointShadowMap, vec4(toPosition + vec3(spread, -spread, -spread), depth));
+    return lit * 0.25;
+}
+
+// sum the lights that reach a surface point into its lit color
+vec3 ShadeSurface(vec3 position, vec3 normal, vec3 baseColor, int materialIndex)
+{
+    material = materials[materialIndex];
 
-    vec3 norm = normalize(fragmentVertexNormal);
-    vec3 viewDir = normalize(viewPosition - fragmentPosition);
+    vec3 viewDir = normalize(viewPosition - position);
 
     vec3 adSum = vec3(0.0);
     vec3 spSum = vec3(0.0);
 
-    if (directionalLight.bActive) {
-        vec3 ad, sp; CalcDirectionalLight(directionalLight, norm, viewDir, ad, sp);
+    if (DIRECTIONAL_LIGHT_ON) {
+        vec3 ad, sp; CalcDirectionalLight(directionalLight, normal, viewDir, DirectionalShadow(position, normal), ad, sp);
         adSum += ad; spSum += sp;
     }
 
-    for (int i = 0; i < TOTAL_POINT_LIGHTS; ++i) {
-        if (pointLights[i].bActive) {
-            vec3 ad, sp; CalcPointLight(pointLights[i], norm, fragmentPosition, viewDir, ad, sp);
+#ifdef USE_CLUSTERED_LIGHTING
+    // only the point lights that reach this fragment's cluster
+    float viewDepth = -(view * vec4(position, 1.0)).z;
+    uvec3 cell = uvec3(
+        clamp(ivec2(gl_FragCoord.xy * clusterScale.xy), ivec2(0), ivec2(CLUSTER_GRID_X - 1, CLUSTER_GRID_Y - 1)),
+        clamp(int(floor(log(max(viewDepth, 1e-4)) * clusterScale.z - clusterScale.w)), 0, CLUSTER_GRID_Z - 1));
+    uvec2 lightRange = clusters[cell.x + CLUSTER_GRID_X * (cell.y + CLUSTER_GRID_Y * cell.z)];
+
+    for (uint i = 0u; i < lightRange.y; ++i) {
+        uint lightIndex = lightIndices[lightRange.x + i];
+        float shadow = ((lightIndex == 0u) && (shadowParams.y != 0.0)) ? PointShadow(position, normal) : 1.0;
+        vec3 ad, sp; CalcPointLight(clusteredLights[lightIndex], normal, position, viewDir, shadow, ad, sp);
+        adSum += ad; spSum += sp;
+    }
+#else
+    for (int i = 0; i < ACTIVE_POINT_LIGHTS; ++i) {
+        if (POINT_LIGHT_ON(i)) {
+            float shadow = ((i == 0) && (shadowParams.y != 0.0)) ? PointShadow(position, normal) : 1.0;
+            vec3 ad, sp; CalcPointLight(pointLights[i], normal, position, viewDir, shadow, ad, sp);
             adSum += ad; spSum += sp;
         }
     }
+#endif
 
-    if (spotLight.bActive) {
-        vec3 ad, sp; CalcSpotLight(spotLight, norm, fragmentPosition, viewDir, ad, sp);
+    if (SPOT_LIGHT_ON) {
+        vec3 ad, sp; CalcSpotLight(spotLight, normal, position, viewDir, ad, sp);
         adSum += ad; spSum += sp;
     }
 
-    vec3 litRGB = adSum * baseColor + spSum;
+    return adSum * baseColor + spSum;
+}
+
+#ifndef USE_DEFERRED_GBUFFER
+// hand the final color of a forward shaded surface to the pass - the
+// frame, or one of the order independent transparency buffers
+void WriteSurfaceColor(vec4 color)
+{
+#if defined(USE_OIT_WEIGHTED)
+    // nearer and more opaque fragments weigh more in the average
+    float weight = clamp(
+        pow(min(1.0, color.a * 10.0) + 0.01, 3.0) * 1e8 * pow(1.0 - gl_FragCoord.z * 0.9, 3.0),
+        1e-2, 3e3);
+    oitAccumulation = vec4(color.rgb * color.a, color.a) * weight;
+    oitRevealage = color.a;
+#elif defined(USE_OIT_LINKED_LIST)
+    // fragments past the end of the node buffer are dropped
+    uint nodeIndex = atomicAdd(oitNodeCount, 1u);
+    if (nodeIndex < uint(oitNodes.length())) {
+        uint nextIndex = imageAtomicExchange(oitHeads, ivec2(gl_FragCoord.xy), nodeIndex);
+        oitNodes[nodeIndex] = uvec4(
+            packHalf2x16(color.rg),
+            packHalf2x16(color.ba),
+            floatBitsToUint(gl_FragCoord.z),
+            nextIndex);
+    }
+#else
+    fragmentColor = color;
+#endif
+}
+#endif
+
+#if defined(USE_DEPTH_ONLY)
+// the depth pre-pass only writes depth, no color is shaded
+void main()
+{
+}
+#elif defined(USE_OIT_WEIGHTED_COMPOSITE)
+// blend the weighted average of the translucent fragments over the frame
+// by how much of the background they leave showing
+void main()
+{
+    ivec2 texel = ivec2(gl_FragCoord.xy);
+
+    float revealage = texelFetch(oitRevealageTexture, texel, 0).r;
+    if (revealage >= 1.0) {
+        discard;
+    }
+
+    vec4 accumulation = texelFetch(oitAccumulationTexture, texel, 0);
+    vec3 averageColor = accumulation.rgb / max(accumulation.a, 1e-5);
+    fragmentColor = vec4(averageColor, 1.0 - revealage);
+}
+#elif defined(USE_OIT_LINKED_LIST_RESOLVE)
+// sort the stored translucent fragments of each pixel front to back and
+// blend them over the frame - the alpha out is what of the frame is left
+void main()
+{
+    uint nodeIndex = imageLoad(oitHeads, ivec2(gl_FragCoord.xy)).r;
+    if (nodeIndex == OIT_LIST_END) {
+        discard;
+    }
+
+    vec4 colors[OIT_MAX_LAYERS];
+    float depths[OIT_MAX_LAYERS];
+    int layerCount = 0;
+    while ((nodeIndex != OIT_LIST_END) && (layerCount < OIT_MAX_LAYERS)) {
+        uvec4 node = oitNodes[nodeIndex];
+        colors[layerCount] = vec4(unpackHalf2x16(node.x), unpackHalf2x16(node.y));
+        depths[layerCount] = uintBitsToFloat(node.z);
+        layerCount++;
+        nodeIndex = node.w;
+    }
+
+    // insertion sort, the lists are only a few layers long
+    for (int i = 1; i < layerCount; ++i) {
+        vec4 color = colors[i];
+        float depth = depths[i];
+        int j = i - 1;
+        while ((j >= 0) && (depths[j] > depth)) {
+            colors[j + 1] = colors[j];
+            depths[j + 1] = depths[j];
+            j--;
+        }
+        colors[j + 1] = color;
+        depths[j + 1] = depth;
+    }
+
+    vec3 color = vec3(0.0);
+    float transmittance = 1.0;
+    for (int i = 0; i < layerCount; ++i) {
+        color += transmittance * colors[i].a * colors[i].rgb;
+        transmittance *= 1.0 - colors[i].a;
+    }
+    fragmentColor = vec4(color, transmittance);
+}
+#elif defined(USE_UPSCALE_SHARPEN)
+// stretch the scene over the window with bilinear filtering, then push
+// each pixel away from the average of its four neighbours one scene texel
+// out - clamped to the range of those five, so an edge is never pushed
+// past the colors around it - see ResolutionScaler
+void main()
+{
+    vec2 targetSize = vec2(textureSize(sceneColorTexture, 0));
+    vec2 texelSize = 1.0 / targetSize;
+    // keep the taps half a texel inside the drawn corner
+    vec2 lowest = 0.5 * texelSize;
+    vec2 highest = upscaleRegion - 0.5 * texelSize;
+    vec2 uv = clamp(gl_FragCoord.xy / targetSize * upscaleRegion, lowest, highest);
+
+    vec3 center = texture(sceneColorTexture, uv).rgb;
+    vec3 north = texture(sceneColorTexture, clamp(uv + vec2(0.0, texelSize.y), lowest, highest)).rgb;
+    vec3 south = texture(sceneColorTexture, clamp(uv - vec2(0.0, texelSize.y), lowest, highest)).rgb;
+    vec3 east = texture(sceneColorTexture, clamp(uv + vec2(texelSize.x, 0.0), lowest, highest)).rgb;
+    vec3 west = texture(sceneColorTexture, clamp(uv - vec2(texelSize.x, 0.0), lowest, highest)).rgb;
+
+    vec3 minimum = min(center, min(min(north, south), min(east, west)));
+    vec3 maximum = max(center, max(max(north, south), max(east, west)));
+    vec3 sharpened = center + upscaleSharpness * (4.0 * center - north - south - east - west);
+    fragmentColor = vec4(clamp(sharpened, minimum, maximum), 1.0);
+}
+#elif defined(USE_DEFERRED_LIGHTING)
+// the lighting pass of the deferred path - one full screen triangle
+// that shades the surface stored at each pixel of the G-buffer
+void main()
+{
+    ivec2 texel = ivec2(gl_FragCoord.xy);
+
+    // keep the frame clear where no opaque surface was drawn
+    float depth = texelFetch(gDepthTexture, texel, 0).r;
+    if (depth >= 1.0) {
+        discard;
+    }
+    // the blended passes that follow are depth tested against it
+    gl_FragDepth = depth;
+
+    vec4 albedo = texelFetch(gAlbedoTexture, texel, 0);
+    vec4 normal = texelFetch(gNormalTexture, texel, 0);
+
+    // unlit surfaces stored their final color
+    if (normal.w < 0.0) {
+        fragmentColor = albedo;
+        return;
+    }
+
+    vec3 position = texelFetch(gPositionTexture, texel, 0).xyz;
+    fragmentColor = vec4(ShadeSurface(position, normalize(normal.xyz), albedo.rgb, int(normal.w + 0.5)), albedo.a);
+}
+#else
+void main()
+{
+    // color, UV scale and material come from the instance
+    vec4 objectColor = instanceColor;
+
+#ifdef USE_BINDLESS_TEXTURE
+#ifndef OBJECT_TEXTURED
+    bool bUseTexture = (instanceTexture >= 0);
+#endif
+    vec4 texSample = bUseTexture
+        ? texture(sampler2D(textureHandles[instanceTexture].xy), fragmentTextureCoordinate * instanceUVscale)
+        : vec4(objectColor.rgb, objectColor.a);
+#else
+    vec4 texSample = bUseTexture
+        ? texture(objectTexture, fragmentTextureCoordinate * instanceUVscale)
+        : vec4(objectColor.rgb, objectColor.a);
+#endif
+
+    vec3 baseColor = bUseTexture ? texSample.rgb : objectColor.rgb;
+    float baseAlpha = bUseTexture ? texSample.a : objectColor.a;
+
+#ifdef USE_DEFERRED_GBUFFER
+    // only the surface is stored, the lighting pass shades it -
+    // unlit surfaces are flagged with a negative material
+    gPosition = vec4(fragmentPosition, 1.0);
+    if (!bUseLighting) {
+        gNormal = vec4(0.0, 0.0, 0.0, -1.0);
+        gAlbedo = vec4(baseColor * objectColor.rgb, baseAlpha * objectColor.a);
+        return;
+    }
+    gNormal = vec4(normalize(fragmentVertexNormal), float(instanceMaterial));
+    gAlbedo = vec4(baseColor, baseAlpha * objectColor.a);
+#else
+    if (!bUseLighting) {
+        WriteSurfaceColor(vec4(baseColor * objectColor.rgb, baseAlpha * objectColor.a));
+        return;
+    }
+
+    vec3 litRGB = ShadeSurface(fragmentPosition, normalize(fragmentVertexNormal), baseColor, instanceMaterial);
     float outA = baseAlpha * objectColor.a;
 
-    fragmentColor = vec4(litRGB, outA);
+    WriteSurfaceColor(vec4(litRGB, outA));
+#endif
 }
+#endif
 
-void CalcDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir, out vec3 ad, out vec3 sp)
+void CalcDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir, float shadow, out vec3 ad, out vec3 sp)
 {
     vec3 L = normalize(-light.direction);
     float diff = max(dot(normal, L), 0.0);
@@ -109,15 +504,16 @@ void CalcDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir, out
     vec3 reflectDir = reflect(-L, normal);
     float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
 
+    // the shadow only takes away the direct light, not the ambient
     vec3 ambient = light.ambient;
-    vec3 diffuse = light.diffuse * diff * material.diffuseColor;
-    vec3 specular = light.specular * spec * material.specularColor;
+    vec3 diffuse = light.diffuse * diff * material.diffuseColor * shadow;
+    vec3 specular = light.specular * spec * material.specularColor * shadow;
 
     ad = ambient + diffuse;
     sp = specular;
 }
 
-void CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir, out vec3 ad, out vec3 sp)
+void CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir, float shadow, out vec3 ad, out vec3 sp)
 {
     vec3 L = normalize(light.position - fragPos);
     float diff = max(dot(normal, L), 0.0);
@@ -126,11 +522,12 @@ void CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir, o
     float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
 
     float distance = length(light.position - fragPos);
+    // SceneManager::GetPointLightRange() solves this for the light's reach
     float attenuation = 1.0 / (1.0 + 0.09 * distance + 0.032 * distance * distance);
 
     vec3 ambient = light.ambient * attenuation;
-    vec3 diffuse = light.diffuse * diff * material.diffuseColor * attenuation;
-    vec3 specular = light.specular * spec * material.specularColor * attenuation;
+    vec3 diffuse = light.diffuse * diff * material.diffuseColor * attenuation * shadow;
+    vec3 specular = light.specular * spec * material.specularColor * attenuation * shadow;
 
     ad = ambient + diffuse;
     sp = specular;
@@ -3,18 +3,97 @@ layout (location = 0) in vec3 inVertexPosition;
 layout (location = 1) in vec3 inVertexNormal;
 layout (location = 2) in vec2 inTextureCoordinate;
 
+#ifdef USE_INDIRECT_DRAW
+// per-draw values of the multi-draw indirect path, picked by gl_DrawID -
+// see MeshBuffers::INSTANCE_DATA
+struct DrawData {
+    mat4 model;
+    vec4 color;
+    vec2 UVscale;
+    int materialIndex;
+    int textureIndex;
+    mat3 normalMatrix;
+};
+
+layout(std430, binding = 0) readonly buffer DrawBlock {
+    DrawData draws[];
+};
+
+// command index of the first draw of the current multi-draw call
+uniform int firstDraw = 0;
+#else
+// per-instance values - see MeshBuffers::INSTANCE_DATA
+layout (location = 3) in mat4 inInstanceModel;
+layout (location = 7) in vec4 inInstanceColor;
+layout (location = 8) in vec2 inInstanceUVscale;
+layout (location = 9) in int inInstanceMaterial;
+layout (location = 10) in int inInstanceTexture;
+// inverse transpose of the model rotation and scale, built on the CPU
+layout (location = 11) in mat3 inInstanceNormalMatrix;
+#endif
+
 out vec3 fragmentPosition;
 out vec3 fragmentVertexNormal;
 out vec2 fragmentTextureCoordinate;
+out vec4 instanceColor;
+out vec2 instanceUVscale;
+flat out int instanceMaterial;
+flat out int instanceTexture;
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+// the depth pre-pass and the passes tested against it with GL_EQUAL are
+// different programs, so their positions must come out bit for bit equal
+invariant gl_Position;
+
+// std140 block shared by every program - see SceneManager::FRAME_BLOCK
+layout(std140) uniform FrameBlock {
+    mat4 view;
+    mat4 projection;
+    // projection * view, multiplied once per frame on the CPU
+    mat4 viewProjection;
+    vec3 viewPosition;
+    // maps a fragment to its light cluster - see LightClusters
+    vec4 clusterScale;
+    // light space of the directional shadow map
+    mat4 shadowViewProjection;
+    // position of the shadowed point light, and the far plane of its cube
+    vec4 shadowLightPosition;
+    // x: directional map drawn, y: point cube drawn, z: cube near plane,
+    // w: texel size of the directional map
+    vec4 shadowParams;
+};
 
 void main()
 {
-   fragmentPosition = vec3(model * vec4(inVertexPosition, 1.0));
-   gl_Position = projection * view * model * vec4(inVertexPosition, 1.0f);
-   fragmentVertexNormal = inVertexNormal;
+#if defined(USE_DEFERRED_LIGHTING) || defined(USE_OIT_WEIGHTED_COMPOSITE) || defined(USE_OIT_LINKED_LIST_RESOLVE) || defined(USE_UPSCALE_SHARPEN)
+   // one triangle covering the viewport, from the vertex index alone -
+   // see GBuffer::DrawFullScreenTriangle()
+   vec2 corner = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+   gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+#else
+#ifdef USE_INDIRECT_DRAW
+   DrawData draw = draws[firstDraw + gl_DrawID];
+   mat4 model = draw.model;
+   mat3 normalMatrix = draw.normalMatrix;
+   instanceColor = draw.color;
+   instanceUVscale = draw.UVscale;
+   instanceMaterial = draw.materialIndex;
+   instanceTexture = draw.textureIndex;
+#else
+   mat4 model = inInstanceModel;
+   mat3 normalMatrix = inInstanceNormalMatrix;
+   instanceColor = inInstanceColor;
+   instanceUVscale = inInstanceUVscale;
+   instanceMaterial = inInstanceMaterial;
+   instanceTexture = inInstanceTexture;
+#endif
+
+   vec4 worldPosition = model * vec4(inVertexPosition, 1.0f);
+   gl_Position = viewProjection * worldPosition;
+#ifndef USE_DEPTH_ONLY
+   // a depth only draw reads nothing but the position stream
+   fragmentPosition = vec3(worldPosition);
+   fragmentVertexNormal = normalMatrix * inVertexNormal;
    fragmentTextureCoordinate = inTextureCoordinate;
+#endif
+#endif
 }
\ No newline at end of file